@@ -309,6 +309,7 @@ void TunnelManager::doRegistration(){
 	if (lProxy) {
 		ms_message("TunnelManager: New registration");
 		lProxy->commit = TRUE;
+		linphone_core_schedule_proxy_update(mCore);
 	}
 }
 
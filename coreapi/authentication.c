@@ -40,6 +40,8 @@
 #include "c-wrapper/c-wrapper.h"
 #include "auth-info/auth-info.h"
 
+#include <unordered_set>
+
 
 // TODO: From coreapi. Remove me later.
 #include "private.h"
@@ -96,39 +98,120 @@ static bool_t check_algorithm_compatibility(const LinphoneAuthInfo *ai, const ch
 	return FALSE;
 }
 
-static const LinphoneAuthInfo *find_auth_info(LinphoneCore *lc, const char *username, const char *realm, const char *domain, const char *algorithm, bool_t ignore_realm){
+/* Auth infos are indexed by username; entries sharing a username keep the order of the auth info list. */
+static void auth_info_index_add(LinphoneCore *lc, LinphoneAuthInfo *ai){
+	const char *username = linphone_auth_info_get_username(ai);
+	if (!username) return;
+	if (!lc->auth_info_by_username) lc->auth_info_by_username = bctbx_mmap_cchar_new();
+	bctbx_pair_t *pair = (bctbx_pair_t *)bctbx_pair_cchar_new(username, ai);
+	bctbx_map_cchar_insert_and_delete(lc->auth_info_by_username, pair);
+}
+
+/* Looks for the index entry of ai under the given username and erases it if asked, returns FALSE if there is none. */
+static bool_t auth_info_index_find_entry(LinphoneCore *lc, const char *username, const LinphoneAuthInfo *ai, bool_t erase){
+	bool_t found = FALSE;
+	bctbx_iterator_t *it = bctbx_map_cchar_find_key(lc->auth_info_by_username, username);
+	bctbx_iterator_t *end = bctbx_map_cchar_end(lc->auth_info_by_username);
+	while (!bctbx_iterator_cchar_equals(it, end)) {
+		bctbx_pair_t *pair = bctbx_iterator_cchar_get_pair(it);
+		const char *key = bctbx_pair_cchar_get_first(reinterpret_cast<bctbx_pair_cchar_t *>(pair));
+		if (!key || strcmp(username, key) != 0) break;
+		if (bctbx_pair_cchar_get_second(pair) == ai) {
+			if (erase) bctbx_map_cchar_erase(lc->auth_info_by_username, it);
+			found = TRUE;
+			break;
+		}
+		it = bctbx_iterator_cchar_get_next(it);
+	}
+	bctbx_iterator_cchar_delete(it);
+	bctbx_iterator_cchar_delete(end);
+	return found;
+}
+
+static void auth_info_index_remove(LinphoneCore *lc, const LinphoneAuthInfo *ai){
+	const char *username = linphone_auth_info_get_username(ai);
+	if (!lc->auth_info_by_username) return;
+	if (username && auth_info_index_find_entry(lc, username, ai, TRUE)) return;
+
+	/* the username of the auth info was changed after it was added, look for its entry under the former one */
+	bctbx_iterator_t *it = bctbx_map_cchar_begin(lc->auth_info_by_username);
+	bctbx_iterator_t *end = bctbx_map_cchar_end(lc->auth_info_by_username);
+	while (!bctbx_iterator_cchar_equals(it, end)) {
+		bctbx_pair_t *pair = bctbx_iterator_cchar_get_pair(it);
+		if (bctbx_pair_cchar_get_second(pair) == ai) {
+			bctbx_map_cchar_erase(lc->auth_info_by_username, it);
+			break;
+		}
+		it = bctbx_iterator_cchar_get_next(it);
+	}
+	bctbx_iterator_cchar_delete(it);
+	bctbx_iterator_cchar_delete(end);
+}
+
+/*
+ * Indexes again the auth infos renamed to username since they were added, with linphone_auth_info_set_username().
+ * Called when the index has no match for username, returns TRUE if any was found.
+ */
+static bool_t auth_info_index_refresh(LinphoneCore *lc, const char *username){
+	bool_t found = FALSE;
 	bctbx_list_t *elem;
+	for (elem = lc->auth_info; elem != NULL; elem = bctbx_list_next(elem)) {
+		LinphoneAuthInfo *ai = (LinphoneAuthInfo *)bctbx_list_get_data(elem);
+		const char *ai_username = linphone_auth_info_get_username(ai);
+		if (!ai_username || strcmp(ai_username, username) != 0) continue;
+		if (lc->auth_info_by_username && auth_info_index_find_entry(lc, username, ai, FALSE)) continue;
+		auth_info_index_remove(lc, ai);
+		auth_info_index_add(lc, ai);
+		found = TRUE;
+	}
+	return found;
+}
+
+static const LinphoneAuthInfo *find_auth_info(LinphoneCore *lc, const char *username, const char *realm, const char *domain, const char *algorithm, bool_t ignore_realm){
 	const LinphoneAuthInfo *ret=NULL;
+	bctbx_iterator_t *it;
+	bctbx_iterator_t *end;
 
-	for (elem=lc->auth_info;elem!=NULL;elem=elem->next) {
-		LinphoneAuthInfo *pinfo = (LinphoneAuthInfo*)elem->data;
+	if (!username || !lc->auth_info_by_username) return NULL;
+	it = bctbx_map_cchar_find_key(lc->auth_info_by_username, username);
+	end = bctbx_map_cchar_end(lc->auth_info_by_username);
+	for (; !bctbx_iterator_cchar_equals(it, end); it = bctbx_iterator_cchar_get_next(it)) {
+		bctbx_pair_t *pair = bctbx_iterator_cchar_get_pair(it);
+		const char *key = bctbx_pair_cchar_get_first(reinterpret_cast<bctbx_pair_cchar_t *>(pair));
+		LinphoneAuthInfo *pinfo = (LinphoneAuthInfo*)bctbx_pair_cchar_get_second(pair);
 
-		if (username && linphone_auth_info_get_username(pinfo) && strcmp(username, linphone_auth_info_get_username(pinfo))==0) 
-		{
-			
-			if (!check_algorithm_compatibility(pinfo, algorithm)) {
-				continue;
+		if (!key || strcmp(username, key) != 0) break;
+		/* the username of an auth info may have been changed after it was added */
+		if (!linphone_auth_info_get_username(pinfo) || strcmp(username, linphone_auth_info_get_username(pinfo)) != 0) continue;
+
+		if (!check_algorithm_compatibility(pinfo, algorithm)) {
+			continue;
+		}
+		if (realm && domain){
+			if (linphone_auth_info_get_realm(pinfo) && realm_match(realm, linphone_auth_info_get_realm(pinfo))
+				&& linphone_auth_info_get_domain(pinfo) && strcmp(domain, linphone_auth_info_get_domain(pinfo))==0) {
+				ret=pinfo;
+				break;
 			}
-			if (realm && domain){
-				if (linphone_auth_info_get_realm(pinfo) && realm_match(realm, linphone_auth_info_get_realm(pinfo))
-					&& linphone_auth_info_get_domain(pinfo) && strcmp(domain, linphone_auth_info_get_domain(pinfo))==0) {
-					return pinfo;
-				}
-			} else if (realm) {
-				if (linphone_auth_info_get_realm(pinfo) && realm_match(realm, linphone_auth_info_get_realm(pinfo))) {
-					if (ret!=NULL) {
-						ms_warning("Non unique realm found for %s",username);
-						return NULL;
-					}
-					ret=pinfo;
+		} else if (realm) {
+			if (linphone_auth_info_get_realm(pinfo) && realm_match(realm, linphone_auth_info_get_realm(pinfo))) {
+				if (ret!=NULL) {
+					ms_warning("Non unique realm found for %s",username);
+					ret=NULL;
+					break;
 				}
-			} else if (domain && linphone_auth_info_get_domain(pinfo) && strcmp(domain,linphone_auth_info_get_domain(pinfo))==0 && (linphone_auth_info_get_ha1(pinfo)==NULL || ignore_realm)) {
-				return pinfo;
-			} else if (!domain && (linphone_auth_info_get_ha1(pinfo)==NULL || ignore_realm)) {
-				return pinfo;
+				ret=pinfo;
 			}
+		} else if (domain && linphone_auth_info_get_domain(pinfo) && strcmp(domain,linphone_auth_info_get_domain(pinfo))==0 && (linphone_auth_info_get_ha1(pinfo)==NULL || ignore_realm)) {
+			ret=pinfo;
+			break;
+		} else if (!domain && (linphone_auth_info_get_ha1(pinfo)==NULL || ignore_realm)) {
+			ret=pinfo;
+			break;
 		}
 	}
+	bctbx_iterator_cchar_delete(it);
+	bctbx_iterator_cchar_delete(end);
 	return ret;
 }
 
@@ -159,6 +242,9 @@ const LinphoneAuthInfo *_linphone_core_find_auth_info(LinphoneCore *lc, const ch
 	if (ai==NULL){
 		ai=find_auth_info(lc,username,NULL,NULL, algorithm, ignore_realm);
 	}
+	if (ai==NULL && username && auth_info_index_refresh(lc, username)){
+		return _linphone_core_find_auth_info(lc, realm, username, domain, algorithm, ignore_realm);
+	}
 	
 	if (ai) ms_message("linphone_core_find_auth_info(): returning auth info username=%s, realm=%s", linphone_auth_info_get_username(ai) ? linphone_auth_info_get_username(ai) : "", linphone_auth_info_get_realm(ai) ? linphone_auth_info_get_realm(ai) : "");
 	return ai;
@@ -182,6 +268,20 @@ void linphone_core_write_auth_info(LinphoneCore *lc, LinphoneAuthInfo *ai){
 	}
 }
 
+/* write the auth info appended last to the list, without rewriting the ones before it */
+static void write_last_auth_info(LinphoneCore *lc){
+	bctbx_list_t *last;
+	int i;
+
+	if (!linphone_core_ready(lc)) return;
+	if (!lc->sip_conf.save_auth_info) return;
+	last = bctbx_list_last_elem(lc->auth_info);
+	if (!last) return;
+	i = (int)bctbx_list_size(lc->auth_info) - 1;
+	linphone_auth_info_write_config(lc->config, (LinphoneAuthInfo *)last->data, i);
+	linphone_auth_info_write_config(lc->config, NULL, i + 1); /* mark the end */
+}
+
 static void write_auth_infos(LinphoneCore *lc){
 	bctbx_list_t *elem;
 	int i;
@@ -199,33 +299,46 @@ LinphoneAuthInfo *linphone_core_create_auth_info(LinphoneCore *lc, const char *u
 	return linphone_auth_info_new(username, userid, passwd, ha1, realm, domain);	
 }
 
-void linphone_core_add_auth_info(LinphoneCore *lc, const LinphoneAuthInfo *info){
+/* Stores a copy of info, replacing the auth info it updates if any. Returns FALSE if info holds no credentials. */
+static bool_t auth_info_store(LinphoneCore *lc, const LinphoneAuthInfo *info, bool_t *updating){
 	LinphoneAuthInfo *ai=NULL;
-	int restarted_op_count=0;
-	bool_t updating=FALSE;
 
 	if (!linphone_auth_info_get_tls_key(info) && !linphone_auth_info_get_tls_key_path(info) && !linphone_auth_info_get_ha1(info) && !linphone_auth_info_get_password(info) ){
 		ms_error("linphone_core_add_auth_info(): info supplied with empty password, ha1 or TLS client/key");
-		return;
+		return FALSE;
 	}
 	/* find if we are attempting to modify an existing auth info */
 	ai=(LinphoneAuthInfo*)linphone_core_find_auth_info(lc,linphone_auth_info_get_realm(info),linphone_auth_info_get_username(info),linphone_auth_info_get_domain(info));
 	if (ai!=NULL && linphone_auth_info_get_domain(ai) && linphone_auth_info_get_domain(info) && strcmp(linphone_auth_info_get_domain(ai), linphone_auth_info_get_domain(info))==0){
+		auth_info_index_remove(lc,ai);
 		lc->auth_info=bctbx_list_remove(lc->auth_info,ai);
 		linphone_auth_info_unref(ai);
-		updating=TRUE;
+		*updating=TRUE;
 	}
-	lc->auth_info=bctbx_list_append(lc->auth_info,linphone_auth_info_clone(info));
+	ai=linphone_auth_info_clone(info);
+	lc->auth_info=bctbx_list_append(lc->auth_info,ai);
+	auth_info_index_add(lc,ai);
+	return TRUE;
+}
 
-	/* retry pending authentication operations */
+/* Retries the pending authentication operations for which an auth info is now known. Returns the number of restarted operations. */
+static int retry_pending_authentications(LinphoneCore *lc, size_t *pending_count){
+	int restarted_op_count=0;
 	auto pendingAuths = lc->sal->getPendingAuths();
+	std::unordered_set<const void *> proxies;
+
+	*pending_count=pendingAuths.size();
+	if (pendingAuths.empty()) return 0;
+	/* The user pointer of a REGISTER op is its proxy config. */
+	for (const bctbx_list_t *elem=linphone_core_get_proxy_config_list(lc);elem!=NULL;elem=elem->next)
+		proxies.insert(elem->data);
+
 	for (const auto &op : pendingAuths) {
 		LinphoneAuthInfo *ai;
 		const SalAuthInfo *req_sai=op->getAuthRequested();
 		ai=(LinphoneAuthInfo*)_linphone_core_find_auth_info(lc, req_sai->realm, req_sai->username, req_sai->domain, req_sai->algorithm, FALSE);
 		if (ai){
 			SalAuthInfo sai;
-			bctbx_list_t* proxy;
 			sai.username = (char *) linphone_auth_info_get_username(ai);
 			sai.userid = (char *)linphone_auth_info_get_userid(ai);
 			sai.realm = (char *) linphone_auth_info_get_realm(ai);
@@ -240,17 +353,26 @@ void linphone_core_add_auth_info(LinphoneCore *lc, const LinphoneAuthInfo *info)
 				sal_signing_key_parse_file(&sai, linphone_auth_info_get_tls_key_path(ai), "");
 			}
 			/*proxy case*/
-			for (proxy=(bctbx_list_t*)linphone_core_get_proxy_config_list(lc);proxy!=NULL;proxy=proxy->next) {
-				if (proxy->data == op->getUserPointer()) {
-					linphone_proxy_config_set_state((LinphoneProxyConfig*)(proxy->data),LinphoneRegistrationProgress,"Authentication...");
-					break;
-				}
+			if (proxies.find(op->getUserPointer()) != proxies.end()) {
+				linphone_proxy_config_set_state((LinphoneProxyConfig*)op->getUserPointer(),LinphoneRegistrationProgress,"Authentication...");
 			}
 			op->authenticate(&sai);
 			restarted_op_count++;
 		}
 	}
-	if (!pendingAuths.empty()) {
+	return restarted_op_count;
+}
+
+void linphone_core_add_auth_info(LinphoneCore *lc, const LinphoneAuthInfo *info){
+	int restarted_op_count;
+	size_t pending_count;
+	bool_t updating=FALSE;
+
+	if (!auth_info_store(lc, info, &updating)) return;
+
+	/* retry pending authentication operations */
+	restarted_op_count=retry_pending_authentications(lc, &pending_count);
+	if (pending_count > 0) {
 		ms_message("linphone_core_add_auth_info(): restarted [%i] operation(s) after %s auth info for\n"
 			"\tusername: [%s]\n"
 			"\trealm [%s]\n"
@@ -261,6 +383,26 @@ void linphone_core_add_auth_info(LinphoneCore *lc, const LinphoneAuthInfo *info)
 			linphone_auth_info_get_realm(info) ? linphone_auth_info_get_realm(info) : "",
 			linphone_auth_info_get_domain(info) ? linphone_auth_info_get_domain(info) : "");
 	}
+	/* when updating, the following auth infos moved up by one and all of them must be rewritten */
+	if (updating) write_auth_infos(lc);
+	else write_last_auth_info(lc);
+}
+
+void linphone_core_add_auth_infos(LinphoneCore *lc, const bctbx_list_t *infos){
+	const bctbx_list_t *elem;
+	int added=0, restarted_op_count;
+	size_t pending_count;
+	bool_t updating=FALSE;
+
+	for (elem=infos;elem!=NULL;elem=elem->next){
+		if (auth_info_store(lc, (const LinphoneAuthInfo*)elem->data, &updating)) added++;
+	}
+	if (added == 0) return;
+
+	/* pending authentication operations are retried once for all the new auth infos */
+	restarted_op_count=retry_pending_authentications(lc, &pending_count);
+	ms_message("linphone_core_add_auth_infos(): added [%i] auth info(s), restarted [%i] of [%i] pending operation(s)",
+		added, restarted_op_count, (int)pending_count);
 	write_auth_infos(lc);
 }
 
@@ -271,6 +413,7 @@ void linphone_core_remove_auth_info(LinphoneCore *lc, const LinphoneAuthInfo *in
 	LinphoneAuthInfo *r;
 	r=(LinphoneAuthInfo*)linphone_core_find_auth_info(lc, linphone_auth_info_get_realm(info), linphone_auth_info_get_username(info), linphone_auth_info_get_domain(info));
 	if (r){
+		auth_info_index_remove(lc,r);
 		lc->auth_info=bctbx_list_remove(lc->auth_info,r);
 		linphone_auth_info_unref(r);
 		write_auth_infos(lc);
@@ -291,6 +434,10 @@ void linphone_core_clear_all_auth_info(LinphoneCore *lc){
 	}
 	bctbx_list_free(lc->auth_info);
 	lc->auth_info=NULL;
+	if (lc->auth_info_by_username) {
+		bctbx_mmap_cchar_delete(lc->auth_info_by_username);
+		lc->auth_info_by_username=NULL;
+	}
 }
 
 void linphone_auth_info_fill_belle_sip_event(const LinphoneAuthInfo *auth_info, belle_sip_auth_event *event) {
@@ -27,6 +27,7 @@
 
 belle_sdp_session_description_t * media_description_to_sdp(const SalMediaDescription *desc);
 int sdp_to_media_description(belle_sdp_session_description_t  *sdp, SalMediaDescription *desc);
+void media_description_enable_rtcp_fb_payloads(const SalMediaDescription *desc);
 
 bool_t _sal_compute_sal_errors(belle_sip_response_t* response, SalReason* sal_reason, char* reason, size_t reason_size);
 SalReason _sal_reason_from_sip_code(int code);
@@ -495,6 +495,208 @@ belle_sdp_session_description_t * media_description_to_sdp(const SalMediaDescrip
 	return session_desc;
 }
 
+/*
+ * Structural hash (64 bits FNV-1a) of everything media_description_to_sdp() puts in the SDP.
+ * Strings are hashed up to their terminating null character so that stale bytes left after it are ignored.
+ */
+#define SDP_HASH_OFFSET_BASIS 14695981039346656037ULL
+#define SDP_HASH_PRIME 1099511628211ULL
+#define SDP_HASH_VALUE(hash, value) hash = sdp_hash_bytes(hash, &(value), sizeof(value))
+
+static uint64_t sdp_hash_bytes(uint64_t hash, const void *data, size_t size) {
+	const unsigned char *bytes = (const unsigned char *)data;
+	size_t i;
+	for (i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= SDP_HASH_PRIME;
+	}
+	return hash;
+}
+
+static uint64_t sdp_hash_string(uint64_t hash, const char *str) {
+	/* A null string and an empty one must not give the same hash. */
+	if (!str) return sdp_hash_bytes(hash, "\xff", 1);
+	return sdp_hash_bytes(hash, str, strlen(str) + 1);
+}
+
+static uint64_t sdp_hash_custom_attributes(uint64_t hash, const SalCustomSdpAttribute *csa) {
+	const belle_sip_list_t *elem;
+	if (!csa) return hash;
+	for (elem = belle_sdp_session_description_get_attributes((belle_sdp_session_description_t *)csa); elem != NULL; elem = elem->next) {
+		belle_sdp_attribute_t *attr = (belle_sdp_attribute_t *)elem->data;
+		hash = sdp_hash_string(hash, belle_sdp_attribute_get_name(attr));
+		hash = sdp_hash_string(hash, belle_sdp_attribute_get_value(attr));
+	}
+	return hash;
+}
+
+static uint64_t sdp_hash_rtcp_xr(uint64_t hash, const OrtpRtcpXrConfiguration *config) {
+	SDP_HASH_VALUE(hash, config->enabled);
+	SDP_HASH_VALUE(hash, config->rcvr_rtt_mode);
+	SDP_HASH_VALUE(hash, config->rcvr_rtt_max_size);
+	SDP_HASH_VALUE(hash, config->stat_summary_enabled);
+	SDP_HASH_VALUE(hash, config->stat_summary_flags);
+	SDP_HASH_VALUE(hash, config->voip_metrics_enabled);
+	return hash;
+}
+
+static uint64_t sdp_hash_payloads(uint64_t hash, const bctbx_list_t *payloads) {
+	const bctbx_list_t *elem;
+	for (elem = payloads; elem != NULL; elem = elem->next) {
+		const PayloadType *pt = (const PayloadType *)elem->data;
+		int number = payload_type_get_number(pt);
+		SDP_HASH_VALUE(hash, number);
+		SDP_HASH_VALUE(hash, pt->type);
+		SDP_HASH_VALUE(hash, pt->clock_rate);
+		SDP_HASH_VALUE(hash, pt->channels);
+		SDP_HASH_VALUE(hash, pt->normal_bitrate);
+		/* PAYLOAD_TYPE_RTCP_FEEDBACK_ENABLED changes the rtcp-fb trr-int attributes. */
+		SDP_HASH_VALUE(hash, pt->flags);
+		hash = sdp_hash_string(hash, pt->mime_type);
+		hash = sdp_hash_string(hash, pt->recv_fmtp);
+		hash = sdp_hash_string(hash, pt->send_fmtp);
+		SDP_HASH_VALUE(hash, pt->avpf.features);
+		SDP_HASH_VALUE(hash, pt->avpf.rpsi_compatibility);
+		SDP_HASH_VALUE(hash, pt->avpf.trr_interval);
+	}
+	/* Terminate the list so that payloads of two consecutive streams can't be mixed up. */
+	return sdp_hash_bytes(hash, "\xfe", 1);
+}
+
+static uint64_t sdp_hash_stream(uint64_t hash, const SalStreamDescription *sd) {
+	int i;
+
+	hash = sdp_hash_string(hash, sd->name);
+	SDP_HASH_VALUE(hash, sd->proto);
+	SDP_HASH_VALUE(hash, sd->type);
+	hash = sdp_hash_string(hash, sd->typeother);
+	hash = sdp_hash_string(hash, sd->proto_other);
+	hash = sdp_hash_string(hash, sd->rtp_addr);
+	hash = sdp_hash_string(hash, sd->rtcp_addr);
+	SDP_HASH_VALUE(hash, sd->rtp_ssrc);
+	hash = sdp_hash_string(hash, sd->rtcp_cname);
+	SDP_HASH_VALUE(hash, sd->rtp_port);
+	SDP_HASH_VALUE(hash, sd->rtcp_port);
+	hash = sdp_hash_payloads(hash, sd->payloads);
+	SDP_HASH_VALUE(hash, sd->bandwidth);
+	SDP_HASH_VALUE(hash, sd->ptime);
+	SDP_HASH_VALUE(hash, sd->maxptime);
+	SDP_HASH_VALUE(hash, sd->dir);
+	for (i = 0; i < SAL_CRYPTO_ALGO_MAX; i++) {
+		SDP_HASH_VALUE(hash, sd->crypto[i].tag);
+		SDP_HASH_VALUE(hash, sd->crypto[i].algo);
+		hash = sdp_hash_string(hash, sd->crypto[i].master_key);
+	}
+	SDP_HASH_VALUE(hash, sd->max_rate);
+	SDP_HASH_VALUE(hash, sd->bundle_only);
+	SDP_HASH_VALUE(hash, sd->implicit_rtcp_fb);
+	SDP_HASH_VALUE(hash, sd->rtcp_fb.generic_nack_enabled);
+	SDP_HASH_VALUE(hash, sd->rtcp_fb.tmmbr_enabled);
+	hash = sdp_hash_rtcp_xr(hash, &sd->rtcp_xr);
+	hash = sdp_hash_custom_attributes(hash, sd->custom_sdp_attributes);
+	for (i = 0; i < SAL_MEDIA_DESCRIPTION_MAX_ICE_CANDIDATES; i++) {
+		const SalIceCandidate *candidate = &sd->ice_candidates[i];
+		if ((candidate->addr[0] == '\0') || (candidate->port == 0)) break;
+		hash = sdp_hash_string(hash, candidate->addr);
+		hash = sdp_hash_string(hash, candidate->raddr);
+		hash = sdp_hash_string(hash, candidate->foundation);
+		hash = sdp_hash_string(hash, candidate->type);
+		SDP_HASH_VALUE(hash, candidate->componentID);
+		SDP_HASH_VALUE(hash, candidate->priority);
+		SDP_HASH_VALUE(hash, candidate->port);
+		SDP_HASH_VALUE(hash, candidate->rport);
+	}
+	for (i = 0; i < SAL_MEDIA_DESCRIPTION_MAX_ICE_REMOTE_CANDIDATES; i++) {
+		hash = sdp_hash_string(hash, sd->ice_remote_candidates[i].addr);
+		SDP_HASH_VALUE(hash, sd->ice_remote_candidates[i].port);
+	}
+	hash = sdp_hash_string(hash, sd->ice_ufrag);
+	hash = sdp_hash_string(hash, sd->ice_pwd);
+	hash = sdp_hash_string(hash, sd->mid);
+	SDP_HASH_VALUE(hash, sd->mid_rtp_ext_header_id);
+	SDP_HASH_VALUE(hash, sd->ice_mismatch);
+	SDP_HASH_VALUE(hash, sd->set_nortpproxy);
+	SDP_HASH_VALUE(hash, sd->rtcp_mux);
+	SDP_HASH_VALUE(hash, sd->haveZrtpHash);
+	SDP_HASH_VALUE(hash, sd->haveLimeIk);
+	if (sd->haveZrtpHash == 1) hash = sdp_hash_string(hash, (const char *)sd->zrtphash);
+	hash = sdp_hash_string(hash, sd->dtls_fingerprint);
+	SDP_HASH_VALUE(hash, sd->dtls_role);
+	SDP_HASH_VALUE(hash, sd->ttl);
+	SDP_HASH_VALUE(hash, sd->multicast_role);
+	return hash;
+}
+
+uint64_t sal_media_description_hash(const SalMediaDescription *desc) {
+	uint64_t hash = SDP_HASH_OFFSET_BASIS;
+	const bctbx_list_t *elem;
+	int i;
+
+	hash = sdp_hash_string(hash, desc->name);
+	hash = sdp_hash_string(hash, desc->addr);
+	hash = sdp_hash_string(hash, desc->username);
+	SDP_HASH_VALUE(hash, desc->nb_streams);
+	SDP_HASH_VALUE(hash, desc->bandwidth);
+	SDP_HASH_VALUE(hash, desc->session_ver);
+	SDP_HASH_VALUE(hash, desc->session_id);
+	SDP_HASH_VALUE(hash, desc->dir);
+	hash = sdp_hash_custom_attributes(hash, desc->custom_sdp_attributes);
+	hash = sdp_hash_rtcp_xr(hash, &desc->rtcp_xr);
+	hash = sdp_hash_string(hash, desc->ice_ufrag);
+	hash = sdp_hash_string(hash, desc->ice_pwd);
+	for (elem = desc->bundles; elem != NULL; elem = elem->next) {
+		const SalStreamBundle *bundle = (const SalStreamBundle *)elem->data;
+		const bctbx_list_t *mid;
+		for (mid = bundle->mids; mid != NULL; mid = mid->next)
+			hash = sdp_hash_string(hash, (const char *)mid->data);
+		hash = sdp_hash_bytes(hash, "\xfe", 1);
+	}
+	SDP_HASH_VALUE(hash, desc->ice_lite);
+	SDP_HASH_VALUE(hash, desc->set_nortpproxy);
+	/* The session c= line depends on the direction of all the streams, not only of the serialized ones. */
+	for (i = 0; i < SAL_MEDIA_DESCRIPTION_MAX_STREAMS; i++) {
+		if (i < desc->nb_streams) hash = sdp_hash_stream(hash, &desc->streams[i]);
+		else SDP_HASH_VALUE(hash, desc->streams[i].dir);
+	}
+	return hash;
+}
+
+char *sal_media_description_to_sdp_string(const SalMediaDescription *md) {
+	belle_sdp_session_description_t *sdp = media_description_to_sdp(md);
+	char *str = belle_sip_object_to_string(sdp);
+	belle_sip_object_unref(sdp);
+	return str;
+}
+
+SalMediaDescription *sal_media_description_from_sdp_string(const char *str) {
+	SalMediaDescription *md;
+	belle_sdp_session_description_t *sdp = belle_sdp_session_description_parse(str);
+	if (!sdp) return NULL;
+	md = sal_media_description_new();
+	if (sdp_to_media_description(sdp, md) != 0) {
+		sal_media_description_unref(md);
+		md = NULL;
+	}
+	belle_sip_object_unref(sdp);
+	return md;
+}
+
+/*
+ * media_description_to_sdp() enables RTCP feedback on the payload types of AVPF streams.
+ * This does the same for a description whose SDP is taken from a cache instead of being generated again.
+ */
+void media_description_enable_rtcp_fb_payloads(const SalMediaDescription *desc) {
+	int i;
+	for (i = 0; i < desc->nb_streams; i++) {
+		const SalStreamDescription *stream = &desc->streams[i];
+		bctbx_list_t *pt_it;
+		if (!sal_stream_description_enabled(stream)) continue;
+		if (!sal_stream_description_has_avpf(stream) && !sal_stream_description_has_implicit_avpf(stream)) continue;
+		for (pt_it = stream->payloads; pt_it != NULL; pt_it = pt_it->next)
+			payload_type_set_flag((PayloadType *)pt_it->data, PAYLOAD_TYPE_RTCP_FEEDBACK_ENABLED);
+	}
+}
+
 
 static void sdp_parse_payload_types(belle_sdp_media_description_t *media_desc, SalStreamDescription *stream) {
 	PayloadType *pt;
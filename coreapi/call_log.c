@@ -39,6 +39,7 @@
 typedef struct _CallLogStorageResult {
 	LinphoneCore *core;
 	bctbx_list_t *result;
+	LinphoneObjectArray *array; /* When set, logs are appended to it instead of result. */
 } CallLogStorageResult;
 
 /*******************************************************************************
@@ -456,6 +457,11 @@ static LinphoneCallLog * find_call_log_by_storage_id(bctbx_list_t *call_logs, un
 	return NULL;
 }
 
+static void call_log_storage_result_add(CallLogStorageResult *clsres, LinphoneCallLog *log) {
+	if (clsres->array) _linphone_object_array_append(clsres->array, log);
+	else clsres->result = bctbx_list_append(clsres->result, log);
+}
+
 /* DB layout:
  * | 0  | storage_id
  * | 1  | from
@@ -481,7 +487,7 @@ static int create_call_log(void *data, int argc, char **argv, char **colName) {
 
 	log = find_call_log_by_storage_id(clsres->core->call_logs, storage_id);
 	if (log != NULL) {
-		clsres->result = bctbx_list_append(clsres->result, linphone_call_log_ref(log));
+		call_log_storage_result_add(clsres, linphone_call_log_ref(log));
 		return 0;
 	}
 
@@ -511,7 +517,7 @@ static int create_call_log(void *data, int argc, char **argv, char **colName) {
 		}
 	}
 
-	clsres->result = bctbx_list_append(clsres->result, log);
+	call_log_storage_result_add(clsres, log);
 	return 0;
 
 error:
@@ -595,6 +601,7 @@ const bctbx_list_t *linphone_core_get_call_history(LinphoneCore *lc) {
 
 	clsres.core = lc;
 	clsres.result = NULL;
+	clsres.array = NULL;
 	begin = ortp_get_cur_time_ms();
 	linphone_sql_request_call_log(lc->logs_db, buf, &clsres);
 	end = ortp_get_cur_time_ms();
@@ -605,6 +612,41 @@ const bctbx_list_t *linphone_core_get_call_history(LinphoneCore *lc) {
 	return lc->call_logs;
 }
 
+LinphoneObjectArray *linphone_core_get_call_history_array(LinphoneCore *lc, int offset, int count) {
+	LinphoneObjectArray *array;
+	const bctbx_list_t *it;
+	char *buf;
+	uint64_t begin,end;
+	CallLogStorageResult clsres;
+
+	if (offset < 0) offset = 0;
+	if (count < 0) count = 0;
+	if (!lc || lc->logs_db == NULL) {
+		int index = 0;
+		array = _linphone_object_array_new((size_t)count);
+		if (!lc) return array;
+		for (it = lc->call_logs; it != NULL && (count == 0 || index < offset + count); it = bctbx_list_next(it), index++) {
+			if (index >= offset)
+				_linphone_object_array_append(array, linphone_call_log_ref((LinphoneCallLog *)bctbx_list_get_data(it)));
+		}
+		return array;
+	}
+
+	if (count == 0) count = -1; /* No limit for sqlite. */
+	buf = sqlite3_mprintf("SELECT * FROM call_history ORDER BY id DESC LIMIT %i OFFSET %i", count, offset);
+
+	clsres.core = lc;
+	clsres.result = NULL;
+	clsres.array = _linphone_object_array_new(count > 0 ? (size_t)count : 0);
+	begin = ortp_get_cur_time_ms();
+	linphone_sql_request_call_log(lc->logs_db, buf, &clsres);
+	end = ortp_get_cur_time_ms();
+	ms_message("%s(): completed in %i ms",__FUNCTION__, (int)(end-begin));
+	sqlite3_free(buf);
+
+	return clsres.array;
+}
+
 void linphone_core_delete_call_history(LinphoneCore *lc) {
 	char *buf;
 
@@ -663,6 +705,7 @@ bctbx_list_t * linphone_core_get_call_history_for_address(LinphoneCore *lc, cons
 
 	clsres.core = lc;
 	clsres.result = NULL;
+	clsres.array = NULL;
 	begin = ortp_get_cur_time_ms();
 	linphone_sql_request_call_log(lc->logs_db, buf, &clsres);
 	end = ortp_get_cur_time_ms();
@@ -701,6 +744,7 @@ bctbx_list_t *linphone_core_get_call_history_2(
 
 	clsres.core = lc;
 	clsres.result = NULL;
+	clsres.array = NULL;
 	begin = ortp_get_cur_time_ms();
 	linphone_sql_request_call_log(lc->logs_db, buf, &clsres);
 	end = ortp_get_cur_time_ms();
@@ -725,6 +769,7 @@ LinphoneCallLog * linphone_core_get_last_outgoing_call_log(LinphoneCore *lc) {
 
 	clsres.core = lc;
 	clsres.result = NULL;
+	clsres.array = NULL;
 	begin = ortp_get_cur_time_ms();
 	linphone_sql_request_call_log(lc->logs_db, buf, &clsres);
 	end = ortp_get_cur_time_ms();
@@ -751,6 +796,7 @@ LinphoneCallLog * linphone_core_find_call_log_from_call_id(LinphoneCore *lc, con
 
 	clsres.core = lc;
 	clsres.result = NULL;
+	clsres.array = NULL;
 	begin = ortp_get_cur_time_ms();
 	linphone_sql_request_call_log(lc->logs_db, buf, &clsres);
 	end = ortp_get_cur_time_ms();
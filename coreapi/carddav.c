@@ -17,12 +17,17 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "linphone/core.h"
 #include "private.h"
 #include "linphone/api/c-auth-info.h"
 
+using namespace std;
 
-
+typedef unordered_map<string, LinphoneFriend *> CardDavFriendIndex;
 
 LinphoneCardDavContext* linphone_carddav_context_new(LinphoneFriendList *lfl) {
 	LinphoneCardDavContext *carddav_context = NULL;
@@ -50,6 +55,8 @@ void linphone_carddav_context_destroy(LinphoneCardDavContext *cdc) {
 			linphone_auth_info_unref(cdc->auth_info);
 			cdc->auth_info = NULL;
 		}
+		if (cdc->sync_token) ms_free(cdc->sync_token);
+		if (cdc->new_sync_token) ms_free(cdc->new_sync_token);
 		ms_free(cdc);
 	}
 }
@@ -64,6 +71,8 @@ void* linphone_carddav_get_user_data(LinphoneCardDavContext *cdc) {
 
 void linphone_carddav_synchronize(LinphoneCardDavContext *cdc) {
 	cdc->ctag = cdc->friend_list->revision;
+	if (cdc->sync_token) ms_free(cdc->sync_token);
+	cdc->sync_token = cdc->friend_list->sync_token ? ms_strdup(cdc->friend_list->sync_token) : NULL;
 	linphone_carddav_get_current_ctag(cdc);
 }
 
@@ -79,8 +88,13 @@ static void linphone_carddav_client_to_server_sync_done(LinphoneCardDavContext *
 
 static void linphone_carddav_server_to_client_sync_done(LinphoneCardDavContext *cdc, bool_t success, const char *msg) {
 	if (success) {
-		ms_debug("CardDAV sync successful, saving new cTag: %i", cdc->ctag);
-		linphone_friend_list_update_revision(cdc->friend_list, cdc->ctag);
+		LinphoneFriendList *list = cdc->friend_list;
+		ms_debug("CardDAV sync successful, saving new cTag: %i and sync-token: %s", cdc->ctag, cdc->new_sync_token);
+		if (cdc->new_sync_token) {
+			if (list->sync_token) ms_free(list->sync_token);
+			list->sync_token = ms_strdup(cdc->new_sync_token);
+		}
+		linphone_friend_list_update_revision(list, cdc->ctag);
 	} else {
 		ms_error("[carddav] CardDAV server to client sync failure: %s", msg);
 	}
@@ -90,21 +104,6 @@ static void linphone_carddav_server_to_client_sync_done(LinphoneCardDavContext *
 	}
 }
 
-static int find_matching_friend(LinphoneFriend *lf1, LinphoneFriend *lf2) {
-	LinphoneVcard *lvc1 = linphone_friend_get_vcard(lf1);
-	LinphoneVcard *lvc2 = linphone_friend_get_vcard(lf2);
-	const char *uid1 = NULL, *uid2 = NULL;
-	if (!lvc1 || !lvc2) {
-		return 1;
-	}
-	uid1 = linphone_vcard_get_uid(lvc1);
-	uid2 = linphone_vcard_get_uid(lvc2);
-	if (!uid1 || !uid2) {
-		return 1;
-	}
-	return strcmp(uid1, uid2);
-}
-
 static void linphone_carddav_response_free(LinphoneCardDavResponse *response) {
 	if (response->etag) ms_free(response->etag);
 	if (response->url) ms_free(response->url);
@@ -112,16 +111,79 @@ static void linphone_carddav_response_free(LinphoneCardDavResponse *response) {
 	ms_free(response);
 }
 
-static void linphone_carddav_vcards_pulled(LinphoneCardDavContext *cdc, bctbx_list_t *vCards) {
+/*
+ * Name of a vCard in the address book, i.e. the last segment of its URL.
+ * Servers give either the full URL or only the path of a vCard, the name is the same for both.
+ */
+static const char *carddav_vcard_name(const char *url) {
+	const char *name;
+	if (!url) return NULL;
+	name = strrchr(url, '/');
+	return name ? name + 1 : url;
+}
+
+static void index_friends_by_vcard_name(const bctbx_list_t *friends, CardDavFriendIndex &index) {
+	for (; friends; friends = bctbx_list_next(friends)) {
+		LinphoneFriend *lf = (LinphoneFriend *)bctbx_list_get_data(friends);
+		LinphoneVcard *lvc = lf ? linphone_friend_get_vcard(lf) : NULL;
+		const char *name = lvc ? carddav_vcard_name(linphone_vcard_get_url(lvc)) : NULL;
+		if (name) index.insert(make_pair(string(name), lf));
+	}
+}
+
+static void index_friends_by_vcard_uid(const bctbx_list_t *friends, CardDavFriendIndex &index) {
+	for (; friends; friends = bctbx_list_next(friends)) {
+		LinphoneFriend *lf = (LinphoneFriend *)bctbx_list_get_data(friends);
+		LinphoneVcard *lvc = lf ? linphone_friend_get_vcard(lf) : NULL;
+		const char *uid = lvc ? linphone_vcard_get_uid(lvc) : NULL;
+		if (uid) index.insert(make_pair(string(uid), lf));
+	}
+}
+
+static bool_t friend_has_etag(LinphoneFriend *lf, const char *etag) {
+	LinphoneVcard *lvc = linphone_friend_get_vcard(lf);
+	const char *local_etag = lvc ? linphone_vcard_get_etag(lvc) : NULL;
+	return local_etag && etag && strcmp(local_etag, etag) == 0;
+}
+
+/*
+ * Lists are built with bctbx_list_prepend to stay linear, this restores the order in which the items were added,
+ * i.e. the order of the server's answer.
+ */
+static bctbx_list_t *carddav_list_reverse(bctbx_list_t *list) {
+	bctbx_list_t *result = NULL;
+	bctbx_list_t *it;
+	for (it = list; it; it = bctbx_list_next(it))
+		result = bctbx_list_prepend(result, bctbx_list_get_data(it));
+	bctbx_list_free(list);
+	return result;
+}
+
+/*
+ * Tells a multistatus answer without any response, i.e. an empty address book, from a body that can't be parsed.
+ */
+static bool_t carddav_is_multistatus(xmlparsing_context_t *xml_ctx) {
+	xmlNodePtr root = xmlDocGetRootElement(xml_ctx->doc);
+	return root && root->name && xmlStrcmp(root->name, (const xmlChar *)"multistatus") == 0;
+}
+
+static void linphone_carddav_vcards_pulled(LinphoneCardDavContext *cdc, bctbx_list_t *vCards, bool_t valid) {
 	bctbx_list_t *vCards_remember = vCards;
+	if (!valid) {
+		bctbx_list_free_with_data(vCards, (void (*)(void *))linphone_carddav_response_free);
+		linphone_carddav_server_to_client_sync_done(cdc, FALSE, "Unable to parse the vCards sent by the server");
+		return;
+	}
 	if (vCards != NULL && bctbx_list_size(vCards) > 0) {
-		bctbx_list_t *friends = cdc->friend_list->friends;
+		CardDavFriendIndex friends_by_uid;
+		index_friends_by_vcard_uid(cdc->friend_list->friends, friends_by_uid);
+		// The pulled friends are saved by the callbacks, do it in a single transaction.
+		linphone_core_begin_friends_db_transaction(cdc->friend_list->lc);
 		while (vCards) {
 			LinphoneCardDavResponse *vCard = (LinphoneCardDavResponse *)vCards->data;
 			if (vCard) {
 				LinphoneVcard *lvc = linphone_vcard_context_get_vcard_from_buffer(cdc->friend_list->lc->vcard_context, vCard->vcard);
 				LinphoneFriend *lf = NULL;
-				bctbx_list_t *local_friend = NULL;
 
 				if (lvc) {
 					// Compute downloaded vCards' URL and save it (+ eTag)
@@ -135,10 +197,13 @@ static void linphone_carddav_vcards_pulled(LinphoneCardDavContext *cdc, bctbx_li
 					lf = linphone_friend_new_from_vcard(lvc);
 					linphone_vcard_unref(lvc); /*ref is now owned by friend*/
 					if (lf) {
-						local_friend = bctbx_list_find_custom(friends, (int (*)(const void*, const void*))find_matching_friend, lf);
+						const char *uid = linphone_vcard_get_uid(linphone_friend_get_vcard(lf));
+						CardDavFriendIndex::iterator local_friend = uid ? friends_by_uid.find(uid) : friends_by_uid.end();
 
-						if (local_friend) {
-							LinphoneFriend *lf2 = (LinphoneFriend *)local_friend->data;
+						if (local_friend != friends_by_uid.end()) {
+							LinphoneFriend *lf2 = local_friend->second;
+							// The local friend is replaced, it may be released by the callback.
+							friends_by_uid.erase(local_friend);
 							lf->storage_id = lf2->storage_id;
 							lf->pol = lf2->pol;
 							lf->subscribe = lf2->subscribe;
@@ -167,19 +232,22 @@ static void linphone_carddav_vcards_pulled(LinphoneCardDavContext *cdc, bctbx_li
 			}
 			vCards = bctbx_list_next(vCards);
 		}
+		linphone_core_end_friends_db_transaction(cdc->friend_list->lc);
 		bctbx_list_free_with_data(vCards_remember, (void (*)(void *))linphone_carddav_response_free);
 	}
 	linphone_carddav_server_to_client_sync_done(cdc, TRUE, NULL);
 }
 
-static bctbx_list_t* parse_vcards_from_xml_response(const char *body) {
+static bctbx_list_t* parse_vcards_from_xml_response(const char *body, bool_t *valid) {
 	bctbx_list_t *result = NULL;
+	*valid = FALSE;
 	xmlparsing_context_t *xml_ctx = linphone_xmlparsing_context_new();
 	xmlSetGenericErrorFunc(xml_ctx, linphone_xmlparsing_genericxml_error);
 	xml_ctx->doc = xmlReadDoc((const unsigned char*)body, 0, NULL, 0);
 	if (xml_ctx->doc != NULL) {
 		if (linphone_create_xml_xpath_context(xml_ctx) < 0) goto end;
 		linphone_xml_xpath_context_init_carddav_ns(xml_ctx);
+		*valid = carddav_is_multistatus(xml_ctx);
 		{
 			xmlXPathObjectPtr responses = linphone_get_xml_xpath_object_for_node_list(xml_ctx, "/d:multistatus/d:response");
 			if (responses != NULL && responses->nodesetval != NULL) {
@@ -197,7 +265,7 @@ static bctbx_list_t* parse_vcards_from_xml_response(const char *body) {
 							response->etag = ms_strdup(etag);
 							response->url = ms_strdup(url);
 							response->vcard = ms_strdup(vcard);
-							result = bctbx_list_append(result, response);
+							result = bctbx_list_prepend(result, response);
 							ms_debug("Added vCard object with eTag %s, URL %s and vCard %s", etag, url, vcard);
 							linphone_free_xml_text_content(etag);
 							linphone_free_xml_text_content(url);
@@ -211,71 +279,118 @@ static bctbx_list_t* parse_vcards_from_xml_response(const char *body) {
 	}
 end:
 	linphone_xmlparsing_context_destroy(xml_ctx);
-	return result;
+	return carddav_list_reverse(result);
 }
 
-static int find_matching_vcard(LinphoneCardDavResponse *response, LinphoneFriend *lf) {
-	if (!response->url || !lf || !lf->vcard || !linphone_vcard_get_url(lf->vcard)) {
-		return 1;
+static void linphone_carddav_notify_removed_friends(LinphoneCardDavContext *cdc, bctbx_list_t *friends_to_remove) {
+	bctbx_list_t *it;
+	linphone_core_begin_friends_db_transaction(cdc->friend_list->lc);
+	for (it = friends_to_remove; it; it = bctbx_list_next(it)) {
+		LinphoneFriend *lf = (LinphoneFriend *)bctbx_list_get_data(it);
+		if (cdc->contact_removed_cb) {
+			ms_debug("Contact removed: %s", linphone_friend_get_name(lf));
+			cdc->contact_removed_cb(cdc, lf);
+		}
 	}
-	return strcmp(response->url, linphone_vcard_get_url(lf->vcard));
+	linphone_core_end_friends_db_transaction(cdc->friend_list->lc);
+	bctbx_list_free_with_data(friends_to_remove, (void (*)(void *))linphone_friend_unref);
 }
 
-static void linphone_carddav_vcards_fetched(LinphoneCardDavContext *cdc, bctbx_list_t *vCards) {
-	if (vCards != NULL && bctbx_list_size(vCards) > 0) {
-		bctbx_list_t *friends = cdc->friend_list->friends;
-		bctbx_list_t *friends_to_remove = NULL;
-		bctbx_list_t *temp_list = NULL;
-
-		while (friends) {
-			LinphoneFriend *lf = (LinphoneFriend *)friends->data;
-			if (lf) {
-				bctbx_list_t *vCard = bctbx_list_find_custom(vCards, (int (*)(const void*, const void*))find_matching_vcard, lf);
-				if (!vCard) {
-					ms_debug("Local friend %s isn't in the remote vCard list, delete it", linphone_friend_get_name(lf));
-					temp_list = bctbx_list_append(temp_list, linphone_friend_ref(lf));
-				} else {
-					LinphoneCardDavResponse *response = (LinphoneCardDavResponse *)vCard->data;
-					ms_debug("Local friend %s is in the remote vCard list, check eTag", linphone_friend_get_name(lf));
-					if (response) {
-						LinphoneVcard *lvc = linphone_friend_get_vcard(lf);
-						const char *etag = linphone_vcard_get_etag(lvc);
-						ms_debug("Local friend eTag is %s, remote vCard eTag is %s", etag, response->etag);
-						if (lvc && etag && strcmp(etag, response->etag) == 0) {
-							bctbx_list_remove(vCards, vCard);
-							linphone_carddav_response_free(response);
-						}
-					}
-				}
-			}
-			friends = bctbx_list_next(friends);
-		}
-		friends_to_remove = temp_list;
-		while(friends_to_remove) {
-			LinphoneFriend *lf = (LinphoneFriend *)friends_to_remove->data;
-			if (lf) {
-				if (cdc->contact_removed_cb) {
-					ms_debug("Contact removed: %s", linphone_friend_get_name(lf));
-					cdc->contact_removed_cb(cdc, lf);
-				}
+static void linphone_carddav_pull_changed_vcards(LinphoneCardDavContext *cdc, bctbx_list_t *vCards_to_pull) {
+	if (vCards_to_pull) {
+		linphone_carddav_pull_vcards(cdc, vCards_to_pull);
+		bctbx_list_free_with_data(vCards_to_pull, (void (*)(void *))linphone_carddav_response_free);
+	} else {
+		linphone_carddav_server_to_client_sync_done(cdc, TRUE, NULL);
+	}
+}
+
+static void linphone_carddav_vcards_fetched(LinphoneCardDavContext *cdc, bctbx_list_t *vCards, bool_t valid) {
+	CardDavFriendIndex friends_by_name;
+	unordered_set<LinphoneFriend *> remote_friends;
+	bctbx_list_t *vCards_to_pull = NULL;
+	bctbx_list_t *friends_to_remove = NULL;
+	bctbx_list_t *it;
+
+	if (!valid) {
+		bctbx_list_free_with_data(vCards, (void (*)(void *))linphone_carddav_response_free);
+		linphone_carddav_server_to_client_sync_done(cdc, FALSE, "Unable to parse the address book sent by the server");
+		return;
+	}
+
+	index_friends_by_vcard_name(cdc->friend_list->friends, friends_by_name);
+	for (it = vCards; it; it = bctbx_list_next(it)) {
+		LinphoneCardDavResponse *response = (LinphoneCardDavResponse *)bctbx_list_get_data(it);
+		const char *name = carddav_vcard_name(response->url);
+		CardDavFriendIndex::const_iterator local_friend = name ? friends_by_name.find(name) : friends_by_name.end();
+		if (local_friend != friends_by_name.end()) {
+			remote_friends.insert(local_friend->second);
+			if (friend_has_etag(local_friend->second, response->etag)) {
+				linphone_carddav_response_free(response);
+				continue;
 			}
-			friends_to_remove = bctbx_list_next(friends_to_remove);
 		}
-		temp_list = bctbx_list_free_with_data(temp_list, (void (*)(void *))linphone_friend_unref);
+		vCards_to_pull = bctbx_list_prepend(vCards_to_pull, response);
+	}
+	bctbx_list_free(vCards);
 
-		linphone_carddav_pull_vcards(cdc, vCards);
-		bctbx_list_free_with_data(vCards, (void (*)(void *))linphone_carddav_response_free);
+	for (it = cdc->friend_list->friends; it; it = bctbx_list_next(it)) {
+		LinphoneFriend *lf = (LinphoneFriend *)bctbx_list_get_data(it);
+		if (lf && remote_friends.find(lf) == remote_friends.end()) {
+			ms_debug("Local friend %s isn't in the remote vCard list, delete it", linphone_friend_get_name(lf));
+			friends_to_remove = bctbx_list_prepend(friends_to_remove, linphone_friend_ref(lf));
+		}
 	}
+	linphone_carddav_notify_removed_friends(cdc, carddav_list_reverse(friends_to_remove));
+	linphone_carddav_pull_changed_vcards(cdc, carddav_list_reverse(vCards_to_pull));
 }
 
-static bctbx_list_t* parse_vcards_etags_from_xml_response(const char *body) {
+static void linphone_carddav_vcards_synced(LinphoneCardDavContext *cdc, bctbx_list_t *changes, bool_t valid) {
+	CardDavFriendIndex friends_by_name;
+	bctbx_list_t *vCards_to_pull = NULL;
+	bctbx_list_t *friends_to_remove = NULL;
+	bctbx_list_t *it;
+
+	if (!valid) {
+		bctbx_list_free_with_data(changes, (void (*)(void *))linphone_carddav_response_free);
+		linphone_carddav_server_to_client_sync_done(cdc, FALSE, "Unable to parse the changes sent by the server");
+		return;
+	}
+
+	index_friends_by_vcard_name(cdc->friend_list->friends, friends_by_name);
+	for (it = changes; it; it = bctbx_list_next(it)) {
+		LinphoneCardDavResponse *response = (LinphoneCardDavResponse *)bctbx_list_get_data(it);
+		const char *name = carddav_vcard_name(response->url);
+		CardDavFriendIndex::const_iterator local_friend = name ? friends_by_name.find(name) : friends_by_name.end();
+		if (response->removed) {
+			if (local_friend != friends_by_name.end())
+				friends_to_remove = bctbx_list_prepend(friends_to_remove, linphone_friend_ref(local_friend->second));
+			linphone_carddav_response_free(response);
+		} else if (local_friend != friends_by_name.end() && friend_has_etag(local_friend->second, response->etag)) {
+			// Already up to date, e.g. a vCard pushed by this client.
+			linphone_carddav_response_free(response);
+		} else {
+			vCards_to_pull = bctbx_list_prepend(vCards_to_pull, response);
+		}
+	}
+	bctbx_list_free(changes);
+
+	ms_message("[carddav] %i vCard(s) changed and %i removed since last synchronization",
+		(int)bctbx_list_size(vCards_to_pull), (int)bctbx_list_size(friends_to_remove));
+	linphone_carddav_notify_removed_friends(cdc, carddav_list_reverse(friends_to_remove));
+	linphone_carddav_pull_changed_vcards(cdc, carddav_list_reverse(vCards_to_pull));
+}
+
+static bctbx_list_t* parse_vcards_etags_from_xml_response(const char *body, bool_t *valid) {
 	bctbx_list_t *result = NULL;
+	*valid = FALSE;
 	xmlparsing_context_t *xml_ctx = linphone_xmlparsing_context_new();
 	xmlSetGenericErrorFunc(xml_ctx, linphone_xmlparsing_genericxml_error);
 	xml_ctx->doc = xmlReadDoc((const unsigned char*)body, 0, NULL, 0);
 	if (xml_ctx->doc != NULL) {
 		if (linphone_create_xml_xpath_context(xml_ctx) < 0) goto end;
 		linphone_xml_xpath_context_init_carddav_ns(xml_ctx);
+		*valid = carddav_is_multistatus(xml_ctx);
 		{
 			xmlXPathObjectPtr responses = linphone_get_xml_xpath_object_for_node_list(xml_ctx, "/d:multistatus/d:response");
 			if (responses != NULL && responses->nodesetval != NULL) {
@@ -291,7 +406,7 @@ static bctbx_list_t* parse_vcards_etags_from_xml_response(const char *body) {
 							LinphoneCardDavResponse *response = ms_new0(LinphoneCardDavResponse, 1);
 							response->etag = ms_strdup(etag);
 							response->url = ms_strdup(url);
-							result = bctbx_list_append(result, response);
+							result = bctbx_list_prepend(result, response);
 							ms_debug("Added vCard object with eTag %s and URL %s", etag, url);
 							linphone_free_xml_text_content(etag);
 							linphone_free_xml_text_content(url);
@@ -304,27 +419,96 @@ static bctbx_list_t* parse_vcards_etags_from_xml_response(const char *body) {
 	}
 end:
 	linphone_xmlparsing_context_destroy(xml_ctx);
-	return result;
+	return carddav_list_reverse(result);
 }
 
-static void linphone_carddav_ctag_fetched(LinphoneCardDavContext *cdc, int ctag) {
+/*
+ * Parses the result of a sync-collection report (RFC 6578): the vCards changed since the given sync-token,
+ * with their eTag, and the removed ones, answered with a 404 status.
+ */
+static bctbx_list_t* parse_vcards_changes_from_xml_response(const char *body, char **sync_token, bool_t *valid) {
+	bctbx_list_t *result = NULL;
+	xmlparsing_context_t *xml_ctx = linphone_xmlparsing_context_new();
+	*sync_token = NULL;
+	*valid = FALSE;
+	xmlSetGenericErrorFunc(xml_ctx, linphone_xmlparsing_genericxml_error);
+	xml_ctx->doc = xmlReadDoc((const unsigned char*)body, 0, NULL, 0);
+	if (xml_ctx->doc != NULL) {
+		char *token = NULL;
+		if (linphone_create_xml_xpath_context(xml_ctx) < 0) goto end;
+		linphone_xml_xpath_context_init_carddav_ns(xml_ctx);
+		*valid = carddav_is_multistatus(xml_ctx);
+		token = linphone_get_xml_text_content(xml_ctx, "/d:multistatus/d:sync-token");
+		if (token) {
+			if (token[0] != '\0') *sync_token = ms_strdup(token);
+			linphone_free_xml_text_content(token);
+		}
+		{
+			xmlXPathObjectPtr responses = linphone_get_xml_xpath_object_for_node_list(xml_ctx, "/d:multistatus/d:response");
+			if (responses != NULL && responses->nodesetval != NULL) {
+				xmlNodeSetPtr responses_nodes = responses->nodesetval;
+				int i;
+				for (i = 0; i < responses_nodes->nodeNr; i++) {
+					xmlNodePtr response_node = responses_nodes->nodeTab[i];
+					xml_ctx->xpath_ctx->node = response_node;
+					{
+						char *url = linphone_get_xml_text_content(xml_ctx, "d:href");
+						char *status = linphone_get_xml_text_content(xml_ctx, "d:status");
+						char *etag = linphone_get_xml_text_content(xml_ctx, "d:propstat/d:prop/d:getetag");
+						bool_t removed = status && strstr(status, " 404") != NULL;
+						// Other responses are about the collection itself, e.g. a 507 when the result is truncated.
+						if (url && (removed || etag)) {
+							LinphoneCardDavResponse *response = ms_new0(LinphoneCardDavResponse, 1);
+							response->etag = ms_strdup(etag);
+							response->url = ms_strdup(url);
+							response->removed = removed;
+							result = bctbx_list_prepend(result, response);
+							ms_debug("Added vCard change with eTag %s and URL %s, removed: %i", etag, url, removed);
+						}
+						linphone_free_xml_text_content(url);
+						linphone_free_xml_text_content(status);
+						linphone_free_xml_text_content(etag);
+					}
+				}
+			}
+			if (responses != NULL) xmlXPathFreeObject(responses);
+		}
+	}
+end:
+	linphone_xmlparsing_context_destroy(xml_ctx);
+	return carddav_list_reverse(result);
+}
+
+static void linphone_carddav_ctag_fetched(LinphoneCardDavContext *cdc, int ctag, char *sync_token) {
 	ms_debug("Remote cTag for CardDAV addressbook is %i, local one is %i", ctag, cdc->ctag);
-	if (ctag == -1 || ctag > cdc->ctag) {
+	if (cdc->new_sync_token) ms_free(cdc->new_sync_token);
+	cdc->new_sync_token = sync_token;
+
+	if (sync_token && cdc->sync_token) {
+		ms_debug("Remote sync-token for CardDAV addressbook is %s, local one is %s", sync_token, cdc->sync_token);
+		if (strcmp(sync_token, cdc->sync_token) != 0) {
+			cdc->ctag = ctag;
+			linphone_carddav_sync_collection(cdc);
+			return;
+		}
+	} else if (ctag == -1 || ctag > cdc->ctag) {
 		cdc->ctag = ctag;
 		linphone_carddav_fetch_vcards(cdc);
-	} else {
-		ms_message("No changes found on server, skipping sync");
-		linphone_carddav_server_to_client_sync_done(cdc, TRUE, "Synchronization skipped because cTag already up to date");
+		return;
 	}
+	ms_message("No changes found on server, skipping sync");
+	linphone_carddav_server_to_client_sync_done(cdc, TRUE, "Synchronization skipped because cTag already up to date");
 }
 
-static int parse_ctag_value_from_xml_response(const char *body) {
+static int parse_ctag_value_from_xml_response(const char *body, char **sync_token) {
 	int result = -1;
 	xmlparsing_context_t *xml_ctx = linphone_xmlparsing_context_new();
+	*sync_token = NULL;
 	xmlSetGenericErrorFunc(xml_ctx, linphone_xmlparsing_genericxml_error);
 	xml_ctx->doc = xmlReadDoc((const unsigned char*)body, 0, NULL, 0);
 	if (xml_ctx->doc != NULL) {
 		char *response = NULL;
+		char *token = NULL;
 		if (linphone_create_xml_xpath_context(xml_ctx) < 0) goto end;
 		linphone_xml_xpath_context_init_carddav_ns(xml_ctx);
 		response = linphone_get_xml_text_content(xml_ctx, "/d:multistatus/d:response/d:propstat/d:prop/x1:getctag");
@@ -332,6 +516,12 @@ static int parse_ctag_value_from_xml_response(const char *body) {
 			result = atoi(response);
 			linphone_free_xml_text_content(response);
 		}
+		// Servers without sync-collection support answer it as an empty property with a 404 status.
+		token = linphone_get_xml_text_content(xml_ctx, "/d:multistatus/d:response/d:propstat/d:prop/d:sync-token");
+		if (token) {
+			if (token[0] != '\0') *sync_token = ms_strdup(token);
+			linphone_free_xml_text_content(token);
+		}
 	}
 end:
 	linphone_xmlparsing_context_destroy(xml_ctx);
@@ -370,6 +560,7 @@ static bool_t is_query_client_to_server_sync(LinphoneCardDavQuery *query) {
 		case LinphoneCardDavQueryTypePropfind:
 		case LinphoneCardDavQueryTypeAddressbookQuery:
 		case LinphoneCardDavQueryTypeAddressbookMultiget:
+		case LinphoneCardDavQueryTypeSyncCollection:
 			return FALSE;
 		case LinphoneCardDavQueryTypePut:
 		case LinphoneCardDavQueryTypeDelete:
@@ -389,13 +580,37 @@ static void process_response_from_carddav_request(void *data, const belle_http_r
 			const char *body = belle_sip_message_get_body((belle_sip_message_t *)event->response);
 			switch(query->type) {
 			case LinphoneCardDavQueryTypePropfind:
-				linphone_carddav_ctag_fetched(query->context, parse_ctag_value_from_xml_response(body));
+				{
+					char *sync_token = NULL;
+					int ctag = parse_ctag_value_from_xml_response(body, &sync_token);
+					linphone_carddav_ctag_fetched(query->context, ctag, sync_token);
+				}
 				break;
 			case LinphoneCardDavQueryTypeAddressbookQuery:
-				linphone_carddav_vcards_fetched(query->context, parse_vcards_etags_from_xml_response(body));
+				{
+					bool_t valid = FALSE;
+					bctbx_list_t *vCards = parse_vcards_etags_from_xml_response(body, &valid);
+					linphone_carddav_vcards_fetched(query->context, vCards, valid);
+				}
 				break;
 			case LinphoneCardDavQueryTypeAddressbookMultiget:
-				linphone_carddav_vcards_pulled(query->context, parse_vcards_from_xml_response(body));
+				{
+					bool_t valid = FALSE;
+					bctbx_list_t *vCards = parse_vcards_from_xml_response(body, &valid);
+					linphone_carddav_vcards_pulled(query->context, vCards, valid);
+				}
+				break;
+			case LinphoneCardDavQueryTypeSyncCollection:
+				{
+					char *sync_token = NULL;
+					bool_t valid = FALSE;
+					bctbx_list_t *changes = parse_vcards_changes_from_xml_response(body, &sync_token, &valid);
+					if (sync_token) {
+						if (query->context->new_sync_token) ms_free(query->context->new_sync_token);
+						query->context->new_sync_token = sync_token;
+					}
+					linphone_carddav_vcards_synced(query->context, changes, valid);
+				}
 				break;
 			case LinphoneCardDavQueryTypePut:
 				{
@@ -437,6 +652,10 @@ static void process_response_from_carddav_request(void *data, const belle_http_r
 				ms_error("[carddav] Unknown request: %i", query->type);
 				break;
 			}
+		} else if (query->type == LinphoneCardDavQueryTypeSyncCollection && code >= 400 && code < 500) {
+			// The sync-token is no longer valid (RFC 6578 3.2), fall back to a full synchronization.
+			ms_warning("[carddav] sync-collection report refused with code %i, fetching all vCards", code);
+			linphone_carddav_fetch_vcards(query->context);
 		} else {
 			char msg[100];
 			snprintf(msg, sizeof(msg), "Unexpected HTTP response code: %i", code);
@@ -702,7 +921,7 @@ static LinphoneCardDavQuery* linphone_carddav_create_propfind_query(LinphoneCard
 	query->context = cdc;
 	query->depth = "0";
 	query->ifmatch = NULL;
-	query->body = ms_strdup("<d:propfind xmlns:d=\"DAV:\" xmlns:cs=\"http://calendarserver.org/ns/\"><d:prop><cs:getctag /></d:prop></d:propfind>");
+	query->body = ms_strdup("<d:propfind xmlns:d=\"DAV:\" xmlns:cs=\"http://calendarserver.org/ns/\"><d:prop><cs:getctag /><d:sync-token /></d:prop></d:propfind>");
 	query->method = "PROPFIND";
 	query->url = ms_strdup(cdc->friend_list->uri);
 	query->type = LinphoneCardDavQueryTypePropfind;
@@ -731,10 +950,42 @@ void linphone_carddav_fetch_vcards(LinphoneCardDavContext *cdc) {
 	linphone_carddav_send_query(query);
 }
 
+static void append_xml_escaped(string &out, const char *text) {
+	for (; text && *text; text++) {
+		switch (*text) {
+			case '&': out += "&amp;"; break;
+			case '<': out += "&lt;"; break;
+			case '>': out += "&gt;"; break;
+			default: out += *text; break;
+		}
+	}
+}
+
+static LinphoneCardDavQuery* linphone_carddav_create_sync_collection_query(LinphoneCardDavContext *cdc) {
+	LinphoneCardDavQuery *query = (LinphoneCardDavQuery *)ms_new0(LinphoneCardDavQuery, 1);
+	string body = "<d:sync-collection xmlns:d=\"DAV:\"><d:sync-token>";
+	append_xml_escaped(body, cdc->sync_token);
+	body += "</d:sync-token><d:sync-level>1</d:sync-level><d:prop><d:getetag /></d:prop></d:sync-collection>";
+
+	query->context = cdc;
+	query->depth = "0";
+	query->ifmatch = NULL;
+	query->body = ms_strdup(body.c_str());
+	query->method = "REPORT";
+	query->url = ms_strdup(cdc->friend_list->uri);
+	query->type = LinphoneCardDavQueryTypeSyncCollection;
+	return query;
+}
+
+void linphone_carddav_sync_collection(LinphoneCardDavContext *cdc) {
+	LinphoneCardDavQuery *query = linphone_carddav_create_sync_collection_query(cdc);
+	linphone_carddav_send_query(query);
+}
+
 static LinphoneCardDavQuery* linphone_carddav_create_addressbook_multiget_query(LinphoneCardDavContext *cdc, bctbx_list_t *vcards) {
 	LinphoneCardDavQuery *query = (LinphoneCardDavQuery *)ms_new0(LinphoneCardDavQuery, 1);
-	char *body = (char *)ms_malloc((bctbx_list_size(vcards) + 1) * 300 * sizeof(char));
-	bctbx_list_t *iterator = vcards;
+	string body = "<card:addressbook-multiget xmlns:d=\"DAV:\" xmlns:card=\"urn:ietf:params:xml:ns:carddav\"><d:prop><d:getetag /><card:address-data content-type='text/vcard' version='4.0'/></d:prop>";
+	bctbx_list_t *iterator;
 
 	query->context = cdc;
 	query->depth = "1";
@@ -743,19 +994,16 @@ static LinphoneCardDavQuery* linphone_carddav_create_addressbook_multiget_query(
 	query->url = ms_strdup(cdc->friend_list->uri);
 	query->type = LinphoneCardDavQueryTypeAddressbookMultiget;
 
-	sprintf(body, "%s", "<card:addressbook-multiget xmlns:d=\"DAV:\" xmlns:card=\"urn:ietf:params:xml:ns:carddav\"><d:prop><d:getetag /><card:address-data content-type='text/vcard' version='4.0'/></d:prop>");
-	while (iterator) {
+	for (iterator = vcards; iterator; iterator = bctbx_list_next(iterator)) {
 		LinphoneCardDavResponse *response = (LinphoneCardDavResponse *)iterator->data;
 		if (response) {
-			char temp_body[300];
-			snprintf(temp_body, sizeof(temp_body), "<d:href>%s</d:href>", response->url);
-			strcat(body, temp_body);
-			iterator = bctbx_list_next(iterator);
+			body += "<d:href>";
+			append_xml_escaped(body, response->url);
+			body += "</d:href>";
 		}
 	}
-	strcat(body, "</card:addressbook-multiget>");
-	query->body = ms_strdup(body);
-	ms_free(body);
+	body += "</card:addressbook-multiget>";
+	query->body = ms_strdup(body.c_str());
 
 	return query;
 }
@@ -38,7 +38,8 @@ typedef enum _LinphoneCardDavQueryType {
 	LinphoneCardDavQueryTypeAddressbookQuery,
 	LinphoneCardDavQueryTypeAddressbookMultiget,
 	LinphoneCardDavQueryTypePut,
-	LinphoneCardDavQueryTypeDelete
+	LinphoneCardDavQueryTypeDelete,
+	LinphoneCardDavQueryTypeSyncCollection
 } LinphoneCardDavQueryType;
 
 typedef struct _LinphoneCardDavQuery LinphoneCardDavQuery;
@@ -152,6 +153,12 @@ void linphone_carddav_get_current_ctag(LinphoneCardDavContext *cdc);
  */
 void linphone_carddav_fetch_vcards(LinphoneCardDavContext *cdc);
 
+/**
+ * Retrieves the vCards changed or removed on server side since the last synchronization, using the sync-token of the friend list (RFC 6578)
+ * @param cdc LinphoneCardDavContext object
+ */
+void linphone_carddav_sync_collection(LinphoneCardDavContext *cdc);
+
 /**
  * Download asked vCards from the server
  * @param cdc LinphoneCardDavContext object
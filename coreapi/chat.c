@@ -58,6 +58,7 @@
 #include "chat/chat-room/real-time-text-chat-room.h"
 #include "content/content-type.h"
 #include "core/core-p.h"
+#include "event-log/event-log.h"
 #include "linphone/api/c-chat-room-params.h"
 
 using namespace std;
@@ -160,6 +161,10 @@ void linphone_core_delete_chat_room (LinphoneCore *, LinphoneChatRoom *cr) {
 	L_GET_CPP_PTR_FROM_C_OBJECT(cr)->deleteFromDb();
 }
 
+bctbx_list_t *linphone_core_search_chat_messages (LinphoneCore *lc, const char *text, int begin, int end) {
+	return L_GET_RESOLVED_C_LIST_FROM_CPP_LIST(L_GET_CPP_PTR_FROM_C_OBJECT(lc)->searchChatMessages(L_C_TO_STRING(text), begin, end));
+}
+
 LinphoneChatRoom *linphone_core_get_chat_room_from_uri(LinphoneCore *lc, const char *to) {
 	return L_GET_C_BACK_PTR(L_GET_CPP_PTR_FROM_C_OBJECT(lc)->getOrCreateBasicChatRoomFromUri(L_C_TO_STRING(to)));
 }
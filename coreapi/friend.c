@@ -295,13 +295,7 @@ void linphone_core_interpret_friend_uri(LinphoneCore *lc, const char *uri, char
 
 const LinphoneAddress * linphone_friend_get_address(const LinphoneFriend *lf) {
 	if (linphone_core_vcard_supported()) {
-		if (lf->vcard) {
-			const bctbx_list_t *sip_addresses = linphone_vcard_get_sip_addresses(lf->vcard);
-			if (sip_addresses) {
-				LinphoneAddress *addr = (LinphoneAddress *)bctbx_list_nth_data(sip_addresses, 0);
-				return addr;
-			}
-		}
+		if (lf->vcard) return linphone_vcard_get_main_sip_address(lf->vcard);
 		return NULL;
 	}
 	if (lf->uri) return lf->uri;
@@ -603,7 +597,10 @@ static void _linphone_friend_destroy(LinphoneFriend *lf){
 	if (lf->phone_number_sip_uri_map) bctbx_list_free_with_data(lf->phone_number_sip_uri_map, (bctbx_list_free_func)free_phone_number_sip_uri);
 	if (lf->uri!=NULL) linphone_address_unref(lf->uri);
 	if (lf->info!=NULL) buddy_info_free(lf->info);
-	if (lf->vcard != NULL) linphone_vcard_unref(lf->vcard);
+	if (lf->vcard != NULL) {
+		linphone_vcard_set_parsed_callback(lf->vcard, NULL, NULL);
+		linphone_vcard_unref(lf->vcard);
+	}
 	if (lf->refkey != NULL) ms_free(lf->refkey);
 }
 
@@ -1166,7 +1163,10 @@ void linphone_friend_set_vcard(LinphoneFriend *fr, LinphoneVcard *vcard) {
 
 	if (vcard) linphone_vcard_ref(vcard);
 
-	if (fr->vcard) linphone_vcard_unref(fr->vcard);
+	if (fr->vcard) {
+		linphone_vcard_set_parsed_callback(fr->vcard, NULL, NULL);
+		linphone_vcard_unref(fr->vcard);
+	}
 	fr->vcard = vcard;
 	linphone_friend_save(fr, fr->lc);
 }
@@ -1283,7 +1283,8 @@ static void linphone_create_friends_table(sqlite3* db) {
 						"display_name      TEXT,"
 						"rls_uri           TEXT,"
 						"uri               TEXT,"
-						"revision          INTEGER"
+						"revision          INTEGER,"
+						"sync_token        TEXT"
 						");",
 			0, 0, &errmsg);
 	if (ret != SQLITE_OK) {
@@ -1335,6 +1336,38 @@ static bool_t linphone_update_friends_table(sqlite3* db) {
 	return FALSE;
 }
 
+static void linphone_update_friends_lists_table(sqlite3* db) {
+	sqlite3_stmt *stmt = NULL;
+	char *errmsg = NULL;
+
+	// The sync_token column was added after Linphone 3.10.0.
+	if (sqlite3_prepare_v2(db, "SELECT sync_token FROM friends_lists LIMIT 0;", -1, &stmt, NULL) == SQLITE_OK) {
+		sqlite3_finalize(stmt);
+		return;
+	}
+	sqlite3_finalize(stmt);
+	if (sqlite3_exec(db, "ALTER TABLE friends_lists ADD COLUMN sync_token TEXT;", 0, 0, &errmsg) != SQLITE_OK) {
+		ms_error("Error altering table friends_lists: %s.", errmsg);
+		sqlite3_free(errmsg);
+	}
+}
+
+static void linphone_update_friends_display_name_column(sqlite3* db) {
+	sqlite3_stmt *stmt = NULL;
+	char *errmsg = NULL;
+
+	// The display_name column is added after the table rebuild of Linphone 3.10.0, it lets friends be loaded without parsing their vCard.
+	if (sqlite3_prepare_v2(db, "SELECT display_name FROM friends LIMIT 0;", -1, &stmt, NULL) == SQLITE_OK) {
+		sqlite3_finalize(stmt);
+		return;
+	}
+	sqlite3_finalize(stmt);
+	if (sqlite3_exec(db, "ALTER TABLE friends ADD COLUMN display_name TEXT;", 0, 0, &errmsg) != SQLITE_OK) {
+		ms_error("Error altering table friends: %s.", errmsg);
+		sqlite3_free(errmsg);
+	}
+}
+
 void linphone_core_friends_storage_init(LinphoneCore *lc) {
 	int ret;
 	const char *errmsg;
@@ -1357,8 +1390,12 @@ void linphone_core_friends_storage_init(LinphoneCore *lc) {
 		sqlite3_close(db);
 		_linphone_sqlite3_open(lc->friends_db_file, &db);
 	}
+	linphone_update_friends_lists_table(db);
+	linphone_update_friends_display_name_column(db);
 
 	lc->friends_db = db;
+	lc->friends_db_rows_written = 0;
+	lc->friends_db_write_time = 0;
 
 	friends_lists = linphone_core_fetch_friends_lists_from_db(lc);
 	if (friends_lists) {
@@ -1376,6 +1413,14 @@ void linphone_core_friends_storage_init(LinphoneCore *lc) {
 
 void linphone_core_friends_storage_close(LinphoneCore *lc) {
 	if (lc->friends_db) {
+		if (lc->friends_db_transaction_depth > 0) {
+			lc->friends_db_transaction_depth = 1;
+			linphone_core_end_friends_db_transaction(lc);
+		}
+		sqlite3_finalize(lc->friends_db_insert_stmt);
+		lc->friends_db_insert_stmt = NULL;
+		sqlite3_finalize(lc->friends_db_update_stmt);
+		lc->friends_db_update_stmt = NULL;
 		sqlite3_close(lc->friends_db);
 		lc->friends_db = NULL;
 	}
@@ -1387,6 +1432,7 @@ void linphone_core_friends_storage_close(LinphoneCore *lc) {
  * | 2  | rls_uri
  * | 3  | uri
  * | 4  | revision
+ * | 5  | sync_token
  */
 static int create_friend_list(void *data, int argc, char **argv, char **colName) {
 	bctbx_list_t **list = (bctbx_list_t **)data;
@@ -1398,6 +1444,8 @@ static int create_friend_list(void *data, int argc, char **argv, char **colName)
 	linphone_friend_list_set_rls_uri(lfl, argv[2]);
 	linphone_friend_list_set_uri(lfl, argv[3]);
 	lfl->revision = atoi(argv[4]);
+	if (argc > 5 && argv[5])
+		lfl->sync_token = ms_strdup(argv[5]);
 
 	*list = bctbx_list_append(*list, linphone_friend_list_ref(lfl));
 	linphone_friend_list_unref(lfl);
@@ -1423,15 +1471,28 @@ static int create_friend_list(void *data, int argc, char **argv, char **colName)
  * | 7  | vCard eTag
  * | 8  | vCard URL
  * | 9  | presence_received
+ * | 10 | display_name
  */
+typedef struct _LinphoneFriendsFetchContext {
+	LinphoneVcardContext *vcard_context;
+	bctbx_list_t *result;
+	bool_t lazy_vcards;
+} LinphoneFriendsFetchContext;
+
 static int create_friend(void *data, int argc, char **argv, char **colName) {
-	LinphoneVcardContext *context = (LinphoneVcardContext *)data;
-	bctbx_list_t **list = (bctbx_list_t **)linphone_vcard_context_get_user_data(context);
+	LinphoneFriendsFetchContext *context = (LinphoneFriendsFetchContext *)data;
+	bctbx_list_t **list = &context->result;
 	LinphoneFriend *lf = NULL;
 	LinphoneVcard *vcard = NULL;
 	unsigned int storage_id = (unsigned int)atoi(argv[0]);
 
-	vcard = linphone_vcard_context_get_vcard_from_buffer(context, argv[6]);
+	if (context->lazy_vcards) {
+		// The vCard is parsed on the first access to a field other than the name and the main SIP address.
+		if (argv[6] && linphone_core_vcard_supported())
+			vcard = linphone_vcard_new_lazy(argv[6], argc > 10 ? argv[10] : NULL, argv[2]);
+	} else {
+		vcard = linphone_vcard_context_get_vcard_from_buffer(context->vcard_context, argv[6]);
+	}
 	if (vcard) {
 		linphone_vcard_set_etag(vcard, argv[7]);
 		linphone_vcard_set_url(vcard, argv[8]);
@@ -1462,7 +1523,7 @@ static int create_friend(void *data, int argc, char **argv, char **colName) {
 #pragma GCC diagnostic pop
 #endif
 
-static int linphone_sql_request_friend(sqlite3* db, const char *stmt, LinphoneVcardContext *context) {
+static int linphone_sql_request_friend(sqlite3* db, const char *stmt, LinphoneFriendsFetchContext *context) {
 	char* errmsg = NULL;
 	int ret;
 	ret = sqlite3_exec(db, stmt, create_friend, context, &errmsg);
@@ -1495,13 +1556,63 @@ static int linphone_sql_request_generic(sqlite3* db, const char *stmt) {
 	return ret;
 }
 
+static sqlite3_stmt *linphone_core_get_friends_db_statement(LinphoneCore *lc, sqlite3_stmt **stmt, const char *sql) {
+	if (!*stmt && sqlite3_prepare_v2(lc->friends_db, sql, -1, stmt, NULL) != SQLITE_OK) {
+		ms_error("Couldn't prepare statement %s: %s.", sql, sqlite3_errmsg(lc->friends_db));
+		sqlite3_finalize(*stmt);
+		*stmt = NULL;
+	}
+	return *stmt;
+}
+
+void linphone_core_begin_friends_db_transaction(LinphoneCore *lc) {
+	if (!lc || !lc->friends_db) return;
+
+	// Transactions may be nested, e.g. a friend list saved while its friends are imported.
+	if (lc->friends_db_transaction_depth++ == 0)
+		linphone_sql_request_generic(lc->friends_db, "BEGIN TRANSACTION;");
+}
+
+void linphone_core_end_friends_db_transaction(LinphoneCore *lc) {
+	uint64_t begin;
+
+	if (!lc || !lc->friends_db || lc->friends_db_transaction_depth == 0) return;
+	if (--lc->friends_db_transaction_depth > 0) return;
+
+	begin = ortp_get_cur_time_ms();
+	linphone_sql_request_generic(lc->friends_db, "COMMIT;");
+	lc->friends_db_write_time += ortp_get_cur_time_ms() - begin;
+}
+
+unsigned int linphone_core_get_friends_database_rows_written(const LinphoneCore *lc) {
+	return lc->friends_db_rows_written;
+}
+
+unsigned int linphone_core_get_friends_database_write_time(const LinphoneCore *lc) {
+	return (unsigned int)lc->friends_db_write_time;
+}
+
+/* Parameters of the prepared statements, the id is only bound when updating:
+ * | 1  | friend_list_id
+ * | 2  | sip_uri
+ * | 3  | subscribe_policy
+ * | 4  | send_subscribe
+ * | 5  | ref_key
+ * | 6  | vCard
+ * | 7  | vCard eTag
+ * | 8  | vCard URL
+ * | 9  | presence_received
+ * | 10 | display_name
+ * | 11 | id
+ */
 void linphone_core_store_friend_in_db(LinphoneCore *lc, LinphoneFriend *lf) {
 	if (lc && lc->friends_db) {
-		char *buf;
+		sqlite3_stmt *stmt;
 		int store_friends = lp_config_get_int(lc->config, "misc", "store_friends", 1);
 		LinphoneVcard *vcard = NULL;
 		const LinphoneAddress *addr;
 		char *addr_str = NULL;
+		uint64_t begin;
 
 		if (!store_friends) {
 			return;
@@ -1517,49 +1628,52 @@ void linphone_core_store_friend_in_db(LinphoneCore *lc, LinphoneFriend *lf) {
 			linphone_core_store_friends_list_in_db(lc, lf->friend_list);
 		}
 
-		if (linphone_core_vcard_supported()) vcard = linphone_friend_get_vcard(lf);
-		addr = linphone_friend_get_address(lf);
-		if (addr != NULL) addr_str = linphone_address_as_string(addr);
 		if (lf->storage_id > 0) {
-			buf = sqlite3_mprintf("UPDATE friends SET friend_list_id=%u,sip_uri=%Q,subscribe_policy=%i,send_subscribe=%i,ref_key=%Q,vCard=%Q,vCard_etag=%Q,vCard_url=%Q,presence_received=%i WHERE (id = %u);",
-				lf->friend_list->storage_id,
-				addr_str,
-				lf->pol,
-				lf->subscribe,
-				lf->refkey,
-				vcard ? linphone_vcard_as_vcard4_string(vcard) : NULL,
-				vcard ? linphone_vcard_get_etag(vcard) : NULL,
-				vcard ? linphone_vcard_get_url(vcard): NULL,
-				lf->presence_received,
-				lf->storage_id
-			);
+			stmt = linphone_core_get_friends_db_statement(lc, &lc->friends_db_update_stmt,
+				"UPDATE friends SET friend_list_id=?,sip_uri=?,subscribe_policy=?,send_subscribe=?,ref_key=?,vCard=?,vCard_etag=?,vCard_url=?,presence_received=?,display_name=? WHERE (id = ?);");
 		} else {
-			buf = sqlite3_mprintf("INSERT INTO friends VALUES(NULL,%u,%Q,%i,%i,%Q,%Q,%Q,%Q,%i);",
-				lf->friend_list->storage_id,
-				addr_str,
-				lf->pol,
-				lf->subscribe,
-				lf->refkey,
-				vcard ? linphone_vcard_as_vcard4_string(vcard) : NULL,
-				vcard ? linphone_vcard_get_etag(vcard) : NULL,
-				vcard ? linphone_vcard_get_url(vcard) : NULL,
-				lf->presence_received
-			);
+			stmt = linphone_core_get_friends_db_statement(lc, &lc->friends_db_insert_stmt,
+				"INSERT INTO friends (friend_list_id,sip_uri,subscribe_policy,send_subscribe,ref_key,vCard,vCard_etag,vCard_url,presence_received,display_name) VALUES(?,?,?,?,?,?,?,?,?,?);");
 		}
-		if (addr_str != NULL) ms_free(addr_str);
+		if (!stmt) return;
 
-		linphone_sql_request_generic(lc->friends_db, buf);
-		sqlite3_free(buf);
+		if (linphone_core_vcard_supported()) vcard = linphone_friend_get_vcard(lf);
+		addr = linphone_friend_get_address(lf);
+		if (addr != NULL) addr_str = linphone_address_as_string(addr);
 
-		if (lf->storage_id == 0) {
-			lf->storage_id = (unsigned int)sqlite3_last_insert_rowid(lc->friends_db);
+		begin = ortp_get_cur_time_ms();
+		sqlite3_bind_int64(stmt, 1, lf->friend_list->storage_id);
+		sqlite3_bind_text(stmt, 2, addr_str, -1, SQLITE_TRANSIENT);
+		sqlite3_bind_int(stmt, 3, lf->pol);
+		sqlite3_bind_int(stmt, 4, lf->subscribe);
+		sqlite3_bind_text(stmt, 5, lf->refkey, -1, SQLITE_TRANSIENT);
+		sqlite3_bind_text(stmt, 6, vcard ? linphone_vcard_as_vcard4_string(vcard) : NULL, -1, SQLITE_TRANSIENT);
+		sqlite3_bind_text(stmt, 7, vcard ? linphone_vcard_get_etag(vcard) : NULL, -1, SQLITE_TRANSIENT);
+		sqlite3_bind_text(stmt, 8, vcard ? linphone_vcard_get_url(vcard) : NULL, -1, SQLITE_TRANSIENT);
+		sqlite3_bind_int(stmt, 9, lf->presence_received);
+		sqlite3_bind_text(stmt, 10, linphone_friend_get_name(lf), -1, SQLITE_TRANSIENT);
+		if (lf->storage_id > 0) sqlite3_bind_int64(stmt, 11, lf->storage_id);
+
+		if (sqlite3_step(stmt) == SQLITE_DONE) {
+			lc->friends_db_rows_written++;
+			if (lf->storage_id == 0) {
+				lf->storage_id = (unsigned int)sqlite3_last_insert_rowid(lc->friends_db);
+			}
+		} else {
+			ms_error("Couldn't store friend [%p] in db: %s.", lf, sqlite3_errmsg(lc->friends_db));
 		}
+		sqlite3_reset(stmt);
+		sqlite3_clear_bindings(stmt);
+		lc->friends_db_write_time += ortp_get_cur_time_ms() - begin;
+
+		if (addr_str != NULL) ms_free(addr_str);
 	}
 }
 
 void linphone_core_store_friends_list_in_db(LinphoneCore *lc, LinphoneFriendList *list) {
 	if (lc && lc->friends_db) {
 		char *buf;
+		uint64_t begin;
 		int store_friends = lp_config_get_int(lc->config, "misc", "store_friends", 1);
 
 		if (!store_friends) {
@@ -1567,22 +1681,27 @@ void linphone_core_store_friends_list_in_db(LinphoneCore *lc, LinphoneFriendList
 		}
 
 		if (list->storage_id > 0) {
-			buf = sqlite3_mprintf("UPDATE friends_lists SET display_name=%Q,rls_uri=%Q,uri=%Q,revision=%i WHERE (id = %u);",
+			buf = sqlite3_mprintf("UPDATE friends_lists SET display_name=%Q,rls_uri=%Q,uri=%Q,revision=%i,sync_token=%Q WHERE (id = %u);",
 				list->display_name,
 				list->rls_uri,
 				list->uri,
 				list->revision,
+				list->sync_token,
 				list->storage_id
 			);
 		} else {
-			buf = sqlite3_mprintf("INSERT INTO friends_lists VALUES(NULL,%Q,%Q,%Q,%i);",
+			buf = sqlite3_mprintf("INSERT INTO friends_lists VALUES(NULL,%Q,%Q,%Q,%i,%Q);",
 				list->display_name,
 				list->rls_uri,
 				list->uri,
-				list->revision
+				list->revision,
+				list->sync_token
 			);
 		}
-		linphone_sql_request_generic(lc->friends_db, buf);
+		begin = ortp_get_cur_time_ms();
+		if (linphone_sql_request_generic(lc->friends_db, buf) == SQLITE_OK)
+			lc->friends_db_rows_written++;
+		lc->friends_db_write_time += ortp_get_cur_time_ms() - begin;
 		sqlite3_free(buf);
 
 		if (list->storage_id == 0) {
@@ -1623,15 +1742,10 @@ void linphone_core_remove_friends_list_from_db(LinphoneCore *lc, LinphoneFriendL
 	}
 }
 
-void linphone_friend_add_addresses_and_numbers_into_maps(LinphoneFriend *lf, LinphoneFriendList *list) {
+static void linphone_friend_add_numbers_and_addresses_into_uri_map(LinphoneFriend *lf) {
 	bctbx_list_t *iterator;
 	bctbx_list_t *phone_numbers;
 	const bctbx_list_t *addresses;
-	
-	if (lf->refkey) {
-		bctbx_pair_t *pair = (bctbx_pair_t*) bctbx_pair_cchar_new(lf->refkey, linphone_friend_ref(lf));
-		bctbx_map_cchar_insert_and_delete(list->friends_map, pair);
-	}
 
 	phone_numbers = linphone_friend_get_phone_numbers(lf);
 	iterator = phone_numbers;
@@ -1657,10 +1771,36 @@ void linphone_friend_add_addresses_and_numbers_into_maps(LinphoneFriend *lf, Lin
 	}
 }
 
+static void linphone_friend_lazy_vcard_parsed(LinphoneVcard *vcard, void *user_data) {
+	LinphoneFriend *lf = (LinphoneFriend *)user_data;
+	if (lf->friend_list) linphone_friend_add_numbers_and_addresses_into_uri_map(lf);
+}
+
+void linphone_friend_add_addresses_and_numbers_into_maps(LinphoneFriend *lf, LinphoneFriendList *list) {
+	if (lf->refkey) {
+		bctbx_pair_t *pair = (bctbx_pair_t*) bctbx_pair_cchar_new(lf->refkey, linphone_friend_ref(lf));
+		bctbx_map_cchar_insert_and_delete(list->friends_map, pair);
+	}
+
+	if (lf->vcard && !linphone_vcard_is_parsed(lf->vcard)) {
+		// Don't parse a lazy vCard for its phone numbers and secondary addresses, they are indexed once it is parsed.
+		const LinphoneAddress *lfaddr = linphone_friend_get_address(lf);
+		if (lfaddr) {
+			char *uri = linphone_address_as_string_uri_only(lfaddr);
+			add_friend_to_list_map_if_not_in_it_yet(lf, uri);
+			ms_free(uri);
+		}
+		linphone_vcard_set_parsed_callback(lf->vcard, linphone_friend_lazy_vcard_parsed, lf);
+		return;
+	}
+
+	linphone_friend_add_numbers_and_addresses_into_uri_map(lf);
+}
+
 bctbx_list_t* linphone_core_fetch_friends_from_db(LinphoneCore *lc, LinphoneFriendList *list) {
 	char *buf;
 	uint64_t begin,end;
-	bctbx_list_t *result = NULL;
+	LinphoneFriendsFetchContext context = { 0 };
 	bctbx_list_t *elem = NULL;
 
 	if (!lc || lc->friends_db == NULL || list == NULL) {
@@ -1668,25 +1808,25 @@ bctbx_list_t* linphone_core_fetch_friends_from_db(LinphoneCore *lc, LinphoneFrie
 		return NULL;
 	}
 
-	linphone_vcard_context_set_user_data(lc->vcard_context, &result);
+	context.vcard_context = lc->vcard_context;
+	context.lazy_vcards = !!lp_config_get_int(lc->config, "misc", "lazy_vcard_loading", 0);
 
 	buf = sqlite3_mprintf("SELECT * FROM friends WHERE friend_list_id = %u ORDER BY id", list->storage_id);
 
 	begin = ortp_get_cur_time_ms();
-	linphone_sql_request_friend(lc->friends_db, buf, lc->vcard_context);
+	linphone_sql_request_friend(lc->friends_db, buf, &context);
 	end = ortp_get_cur_time_ms();
-	ms_message("%s(): %u results fetched, completed in %i ms",__FUNCTION__, (unsigned int)bctbx_list_size(result), (int)(end-begin));
+	ms_message("%s(): %u results fetched, completed in %i ms",__FUNCTION__, (unsigned int)bctbx_list_size(context.result), (int)(end-begin));
 	sqlite3_free(buf);
 
-	for (elem = result; elem != NULL; elem = bctbx_list_next(elem)) {
+	for (elem = context.result; elem != NULL; elem = bctbx_list_next(elem)) {
 		LinphoneFriend *lf = (LinphoneFriend *)bctbx_list_get_data(elem);
 		lf->lc = lc;
 		lf->friend_list = list;
 		linphone_friend_add_addresses_and_numbers_into_maps(lf, list);
 	}
-	linphone_vcard_context_set_user_data(lc->vcard_context, NULL);
 
-	return result;
+	return context.result;
 }
 
 bctbx_list_t* linphone_core_fetch_friends_lists_from_db(LinphoneCore *lc) {
@@ -481,6 +481,7 @@ static void linphone_friend_list_destroy(LinphoneFriendList *list) {
 		list->event = NULL;
 	}
 	if (list->uri != NULL) ms_free(list->uri);
+	if (list->sync_token != NULL) ms_free(list->sync_token);
 	if (list->cbs) linphone_friend_list_cbs_unref(list->cbs);
 	bctbx_list_free_with_data(list->callbacks, (bctbx_list_free_func)linphone_friend_list_cbs_unref);
 	list->callbacks = nullptr;
@@ -654,6 +655,24 @@ LinphoneFriendListStatus linphone_friend_list_add_local_friend(LinphoneFriendLis
 	return _linphone_friend_list_add_friend(list, lf, FALSE);
 }
 
+int linphone_friend_list_add_friends(LinphoneFriendList *list, const bctbx_list_t *friends) {
+	const bctbx_list_t *it;
+	int count = 0;
+
+	if (!list) {
+		ms_error("linphone_friend_list_add_friends(): invalid list, null");
+		return 0;
+	}
+
+	linphone_core_begin_friends_db_transaction(list->lc);
+	for (it = friends; it != NULL; it = bctbx_list_next(it)) {
+		if (_linphone_friend_list_add_friend(list, (LinphoneFriend *)bctbx_list_get_data(it), TRUE) == LinphoneFriendListOK)
+			count++;
+	}
+	linphone_core_end_friends_db_transaction(list->lc);
+	return count;
+}
+
 void linphone_friend_list_invalidate_friends_maps(LinphoneFriendList *list) {
 	if (list->friends_map) bctbx_mmap_cchar_delete_with_data(list->friends_map, (void (*)(void *))linphone_friend_unref);
 	list->friends_map = bctbx_mmap_cchar_new();
@@ -806,7 +825,8 @@ void linphone_friend_list_update_dirty_friends(LinphoneFriendList *list) {
 static void carddav_created(LinphoneCardDavContext *cdc, LinphoneFriend *lf) {
 	if (cdc) {
 		LinphoneFriendList *list = cdc->friend_list;
-		linphone_friend_list_import_friend(list, lf, FALSE);
+		if (linphone_friend_list_import_friend(list, lf, FALSE) == LinphoneFriendListOK)
+			linphone_friend_save(lf, lf->lc);
 		if (cdc->friend_list->cbs->contact_created_cb) {
 			cdc->friend_list->cbs->contact_created_cb(list, lf);
 		}
@@ -1163,6 +1183,11 @@ const char * linphone_friend_list_get_uri(const LinphoneFriendList *list) {
 
 void linphone_friend_list_set_uri(LinphoneFriendList *list, const char *uri) {
 	if (list->uri != NULL) {
+		if (!uri || strcmp(list->uri, uri) != 0) {
+			// The sync-token is only valid for the address book that gave it.
+			if (list->sync_token != NULL) ms_free(list->sync_token);
+			list->sync_token = NULL;
+		}
 		ms_free(list->uri);
 		list->uri = NULL;
 	}
@@ -1223,6 +1248,7 @@ static LinphoneStatus linphone_friend_list_import_friends_from_vcard4(LinphoneFr
 
 	vcards_iterator = vcards;
 
+	linphone_core_begin_friends_db_transaction(list->lc);
 	while (vcards_iterator != NULL && bctbx_list_get_data(vcards_iterator) != NULL) {
 		LinphoneVcard *vcard = (LinphoneVcard *)bctbx_list_get_data(vcards_iterator);
 		LinphoneFriend *lf = linphone_friend_new_from_vcard(vcard);
@@ -1238,6 +1264,7 @@ static LinphoneStatus linphone_friend_list_import_friends_from_vcard4(LinphoneFr
 	}
 	bctbx_list_free(vcards);
 	linphone_core_store_friends_list_in_db(list->lc, list);
+	linphone_core_end_friends_db_transaction(list->lc);
 	return count;
 
 }
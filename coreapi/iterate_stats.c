@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bctoolbox/port.h>
+
+#include "linphone/core.h"
+#include "linphone/iterate_stats.h"
+
+#include "c-wrapper/c-wrapper.h"
+#include "private.h"
+
+static void _linphone_iterate_stats_clone(LinphoneIterateStats *obj, const LinphoneIterateStats *orig) {
+	memcpy(obj->histograms, orig->histograms, sizeof(obj->histograms));
+	obj->over_budget_count = orig->over_budget_count;
+}
+
+BELLE_SIP_DECLARE_NO_IMPLEMENTED_INTERFACES(LinphoneIterateStats);
+
+BELLE_SIP_INSTANCIATE_VPTR(LinphoneIterateStats, belle_sip_object_t,
+	NULL, // destroy
+	(belle_sip_object_clone_t)_linphone_iterate_stats_clone, // clone
+	NULL, // marshal
+	FALSE
+);
+
+static LinphoneIterateStats *linphone_iterate_stats_new(void) {
+	return belle_sip_object_new(LinphoneIterateStats);
+}
+
+LinphoneIterateStats *linphone_iterate_stats_ref(LinphoneIterateStats *stats) {
+	belle_sip_object_ref(stats);
+	return stats;
+}
+
+void linphone_iterate_stats_unref(LinphoneIterateStats *stats) {
+	belle_sip_object_unref(stats);
+}
+
+// -----------------------------------------------------------------------------
+// Histograms.
+// -----------------------------------------------------------------------------
+
+#define SUB_BUCKET_COUNT (1 << LINPHONE_ITERATE_HISTOGRAM_SUB_BUCKET_BITS)
+
+static size_t iterate_histogram_bucket_index(uint32_t value) {
+	int msb = 0;
+	uint32_t tmp;
+	if (value < SUB_BUCKET_COUNT) return value;
+	for (tmp = value; tmp > 1; tmp >>= 1) msb++;
+	int shift = msb - LINPHONE_ITERATE_HISTOGRAM_SUB_BUCKET_BITS;
+	return (size_t)(SUB_BUCKET_COUNT + shift * SUB_BUCKET_COUNT + ((value >> shift) & (SUB_BUCKET_COUNT - 1)));
+}
+
+/* Highest value falling into a bucket. */
+static uint32_t iterate_histogram_bucket_upper_bound(size_t index) {
+	if (index < SUB_BUCKET_COUNT) return (uint32_t)index;
+	int shift = (int)(index / SUB_BUCKET_COUNT) - 1;
+	uint64_t sub_bucket = index % SUB_BUCKET_COUNT;
+	uint64_t upper = ((SUB_BUCKET_COUNT + sub_bucket + 1) << shift) - 1;
+	return upper > UINT32_MAX ? UINT32_MAX : (uint32_t)upper;
+}
+
+static void iterate_histogram_record(LinphoneIterateHistogram *histogram, uint32_t value) {
+	histogram->buckets[iterate_histogram_bucket_index(value)]++;
+	histogram->count++;
+	histogram->sum += value;
+	if (value > histogram->max) histogram->max = value;
+}
+
+static const LinphoneIterateHistogram *iterate_stats_get_histogram(const LinphoneIterateStats *stats, LinphoneIterateStep step) {
+	if ((int)step < 0 || step >= LinphoneIterateStepCount) return NULL;
+	return &stats->histograms[step];
+}
+
+unsigned int linphone_iterate_stats_get_count(const LinphoneIterateStats *stats, LinphoneIterateStep step) {
+	const LinphoneIterateHistogram *histogram = iterate_stats_get_histogram(stats, step);
+	return histogram ? (unsigned int)histogram->count : 0;
+}
+
+unsigned int linphone_iterate_stats_get_mean(const LinphoneIterateStats *stats, LinphoneIterateStep step) {
+	const LinphoneIterateHistogram *histogram = iterate_stats_get_histogram(stats, step);
+	if (!histogram || histogram->count == 0) return 0;
+	return (unsigned int)(histogram->sum / histogram->count);
+}
+
+unsigned int linphone_iterate_stats_get_max(const LinphoneIterateStats *stats, LinphoneIterateStep step) {
+	const LinphoneIterateHistogram *histogram = iterate_stats_get_histogram(stats, step);
+	return histogram ? histogram->max : 0;
+}
+
+unsigned int linphone_iterate_stats_get_percentile(const LinphoneIterateStats *stats, LinphoneIterateStep step, float percentile) {
+	const LinphoneIterateHistogram *histogram = iterate_stats_get_histogram(stats, step);
+	uint64_t threshold;
+	uint64_t cumulated = 0;
+	size_t i;
+
+	if (!histogram || histogram->count == 0) return 0;
+	if (percentile < 0.f) percentile = 0.f;
+	else if (percentile > 100.f) percentile = 100.f;
+
+	threshold = (uint64_t)((double)percentile * (double)histogram->count / 100. + 0.5);
+	if (threshold == 0) threshold = 1;
+	for (i = 0; i < LINPHONE_ITERATE_HISTOGRAM_SIZE; i++) {
+		cumulated += histogram->buckets[i];
+		if (cumulated >= threshold) {
+			uint32_t value = iterate_histogram_bucket_upper_bound(i);
+			return value > histogram->max ? histogram->max : value;
+		}
+	}
+	return histogram->max;
+}
+
+unsigned int linphone_iterate_stats_get_over_budget_count(const LinphoneIterateStats *stats) {
+	return stats->over_budget_count;
+}
+
+const char *linphone_iterate_step_to_string(LinphoneIterateStep step) {
+	switch (step) {
+		case LinphoneIterateStepTotal: return "Total";
+		case LinphoneIterateStepSal: return "Sal";
+		case LinphoneIterateStepEventQueue: return "EventQueue";
+		case LinphoneIterateStepProxyUpdate: return "ProxyUpdate";
+		case LinphoneIterateStepCalls: return "Calls";
+		case LinphoneIterateStepVideoPreview: return "VideoPreview";
+		case LinphoneIterateStepHooks: return "Hooks";
+		case LinphoneIterateStepPluginTasks: return "PluginTasks";
+		case LinphoneIterateStepSubscribes: return "Subscribes";
+		case LinphoneIterateStepConfigSync: return "ConfigSync";
+		case LinphoneIterateStepFriendLists: return "FriendLists";
+		case LinphoneIterateStepCount: break;
+	}
+	return "Unknown";
+}
+
+// -----------------------------------------------------------------------------
+// Core.
+// -----------------------------------------------------------------------------
+
+void linphone_core_enable_iterate_stats(LinphoneCore *lc, bool_t enable) {
+	if (enable && !lc->iterate_stats) {
+		lc->iterate_stats = linphone_iterate_stats_new();
+	} else if (!enable && lc->iterate_stats) {
+		linphone_iterate_stats_unref(lc->iterate_stats);
+		lc->iterate_stats = NULL;
+	}
+	linphone_config_set_int(lc->config, "misc", "iterate_stats_enabled", enable);
+}
+
+bool_t linphone_core_iterate_stats_enabled(const LinphoneCore *lc) {
+	return lc->iterate_stats != NULL;
+}
+
+LinphoneIterateStats *linphone_core_get_iterate_stats(const LinphoneCore *lc) {
+	if (!lc->iterate_stats) return NULL;
+	return (LinphoneIterateStats *)belle_sip_object_clone(BELLE_SIP_OBJECT(lc->iterate_stats));
+}
+
+void linphone_core_reset_iterate_stats(LinphoneCore *lc) {
+	if (!lc->iterate_stats) return;
+	memset(lc->iterate_stats->histograms, 0, sizeof(lc->iterate_stats->histograms));
+	lc->iterate_stats->over_budget_count = 0;
+}
+
+void linphone_core_set_iterate_budget(LinphoneCore *lc, int budget_ms) {
+	lc->iterate_budget_ms = MAX(budget_ms, 0);
+	linphone_config_set_int(lc->config, "misc", "iterate_budget_ms", lc->iterate_budget_ms);
+}
+
+int linphone_core_get_iterate_budget(const LinphoneCore *lc) {
+	return lc->iterate_budget_ms;
+}
+
+// -----------------------------------------------------------------------------
+// Iteration timer.
+// -----------------------------------------------------------------------------
+
+static uint64_t iterate_timer_now(void) {
+	bctoolboxTimeSpec ts;
+	bctbx_get_cur_time(&ts);
+	return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+void linphone_iterate_timer_start(const LinphoneCore *lc, LinphoneIterateTimer *timer) {
+	timer->enabled = lc->iterate_stats != NULL || lc->iterate_budget_ms > 0;
+	if (!timer->enabled) return;
+	memset(timer->durations, 0, sizeof(timer->durations));
+	timer->measured_steps = 1 << LinphoneIterateStepTotal;
+	timer->start = timer->last = iterate_timer_now();
+}
+
+void linphone_iterate_timer_lap(LinphoneIterateTimer *timer, LinphoneIterateStep step) {
+	uint64_t now;
+	if (!timer->enabled) return;
+	now = iterate_timer_now();
+	timer->durations[step] += (uint32_t)MIN(now - timer->last, (uint64_t)UINT32_MAX);
+	timer->measured_steps |= 1 << step;
+	timer->last = now;
+}
+
+void linphone_iterate_timer_stop(LinphoneCore *lc, LinphoneIterateTimer *timer) {
+	bool_t over_budget;
+	int step;
+
+	if (!timer->enabled) return;
+	timer->durations[LinphoneIterateStepTotal] = (uint32_t)MIN(iterate_timer_now() - timer->start, (uint64_t)UINT32_MAX);
+	over_budget = lc->iterate_budget_ms > 0 && timer->durations[LinphoneIterateStepTotal] > (uint32_t)lc->iterate_budget_ms * 1000;
+
+	if (lc->iterate_stats) {
+		/* Steps that did not run during this iteration, like the once per second tasks, are not recorded. */
+		for (step = 0; step < LinphoneIterateStepCount; step++) {
+			if (timer->measured_steps & (1 << step))
+				iterate_histogram_record(&lc->iterate_stats->histograms[step], timer->durations[step]);
+		}
+		if (over_budget) lc->iterate_stats->over_budget_count++;
+	}
+
+	if (over_budget) {
+		char details[512] = {0};
+		size_t offset = 0;
+		for (step = LinphoneIterateStepTotal + 1; step < LinphoneIterateStepCount && offset < sizeof(details); step++) {
+			int written = snprintf(details + offset, sizeof(details) - offset, " %s=%uus",
+				linphone_iterate_step_to_string((LinphoneIterateStep)step), timer->durations[step]);
+			if (written < 0) break;
+			offset += (size_t)written;
+		}
+		ms_warning("linphone_core_iterate() on core [%p] took %uus, over the budget of %dms:%s",
+			lc, timer->durations[LinphoneIterateStepTotal], lc->iterate_budget_ms, details);
+	}
+}
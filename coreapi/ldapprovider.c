@@ -24,6 +24,63 @@
 #include "mediastreamer2/mscommon.h"
 #include <belle-sip/dict.h>
 
+static const char* linphone_ldap_strcasestr(const char* haystack, const char* needle)
+{
+	size_t len = strlen(needle);
+	for( ; *haystack; haystack++ ){
+		if( strncasecmp(haystack, needle, len) == 0 ) return haystack;
+	}
+	return len == 0 ? haystack : NULL;
+}
+
+/*
+ * Searches can only be narrowed locally from the result of a broader one when the filter is a single
+ * substring assertion on the predicate, like "uid=*%s*" or "(cn=%s*)".
+ * Returns the attribute of the assertion, or NULL when the filter can't be used to narrow searches.
+ */
+char* linphone_ldap_parse_narrowing_filter(const char* filter, bool_t* prefix_only)
+{
+	size_t len = strlen(filter);
+	const char* value;
+	size_t attr_len, value_len;
+	char* attr;
+
+	if( len >= 2 && filter[0] == '(' && filter[len-1] == ')' ){
+		filter++;
+		len -= 2;
+	}
+	value = (const char*)memchr(filter, '=', len);
+	if( !value || value == filter ) return NULL;
+	attr_len = (size_t)(value - filter);
+	value++;
+	value_len = len - attr_len - 1;
+
+	if( strcspn(filter, "()&|!~<>:*% ") < attr_len ) return NULL;
+	if( value_len == 4 && strncmp(value, "*%s*", 4) == 0 ){
+		*prefix_only = FALSE;
+	} else if( value_len == 3 && strncmp(value, "%s*", 3) == 0 ){
+		*prefix_only = TRUE;
+	} else {
+		return NULL;
+	}
+
+	attr = (char*)ms_malloc(attr_len + 1);
+	memcpy(attr, filter, attr_len);
+	attr[attr_len] = 0;
+	return attr;
+}
+
+/*
+ * Whether a value matches the narrowing filter for the given predicate, like the server would do with
+ * a case insensitive substring match.
+ */
+bool_t linphone_ldap_narrowing_value_matches(const char* value, const char* predicate, bool_t prefix_only)
+{
+	if( prefix_only )
+		return strncasecmp(value, predicate, strlen(predicate)) == 0;
+	return linphone_ldap_strcasestr(value, predicate) != NULL;
+}
+
 #ifdef BUILD_LDAP
 #include <ldap.h>
 #include <sasl/sasl.h>
@@ -35,8 +92,17 @@
 struct LDAPFriendData {
 	char* name;
 	char* sip;
+	bctbx_list_t* match_values; // values of the attribute used to narrow searches locally
 };
 
+/* Results of a finished search, kept cache_ttl seconds */
+typedef struct _LDAPCachedSearch {
+	char*         predicate;
+	bctbx_list_t* contacts; // struct LDAPFriendData*
+	uint64_t      expires;  // ms
+	bool_t        complete; // all the matching entries were returned
+} LDAPCachedSearch;
+
 struct _LinphoneLDAPContactProvider
 {
 	LinphoneContactProvider base;
@@ -72,6 +138,16 @@ struct _LinphoneLDAPContactProvider
 	int    deref_aliases;
 	int    max_results;
 
+	int    cache_ttl;      // seconds, 0 disables the cache
+	int    cache_size;     // max number of cached searches
+	int    page_size;      // 0 disables the paged results control
+	int    iterate_budget; // ms spent reading results in each iteration
+
+	// set when the filter is a single substring assertion, to answer narrower searches from the cache
+	char*  narrowing_attr;
+	bool_t narrowing_prefix_only;
+
+	bctbx_list_t* cache; // LDAPCachedSearch*, most recent first
 };
 
 struct _LinphoneLDAPContactSearch
@@ -81,6 +157,10 @@ struct _LinphoneLDAPContactSearch
 	int     msgid;
 	char*   filter;
 	bool_t  complete;
+	bool_t  truncated;  // the server didn't return all the matching entries
+	bool_t  from_cache; // answered from the cache, delivered by the next iteration
+	struct berval* cookie; // paged results cookie of the next page
+	bctbx_list_t* contacts; // struct LDAPFriendData* received so far
 	bctbx_list_t* found_entries;
 	unsigned int found_count;
 };
@@ -111,6 +191,23 @@ void linphone_ldap_contact_search_destroy_friend( void* entry )
 	linphone_friend_destroy((LinphoneFriend*)entry);
 }
 
+static void linphone_ldap_friend_data_free( void* entry )
+{
+	struct LDAPFriendData* data = (struct LDAPFriendData*)entry;
+	if( data->name ) ms_free(data->name);
+	if( data->sip ) ms_free(data->sip);
+	bctbx_list_free_with_data(data->match_values, ms_free);
+	ms_free(data);
+}
+
+static void linphone_ldap_cached_search_free( void* entry )
+{
+	LDAPCachedSearch* cached = (LDAPCachedSearch*)entry;
+	ms_free(cached->predicate);
+	bctbx_list_free_with_data(cached->contacts, linphone_ldap_friend_data_free);
+	ms_free(cached);
+}
+
 unsigned int linphone_ldap_contact_search_result_count(LinphoneLDAPContactSearch* obj)
 {
 	return obj->found_count;
@@ -121,6 +218,8 @@ static void linphone_ldap_contact_search_destroy( LinphoneLDAPContactSearch* obj
 	//ms_message("~LinphoneLDAPContactSearch(%p)", obj);
 	bctbx_list_for_each(obj->found_entries, linphone_ldap_contact_search_destroy_friend);
 	obj->found_entries = bctbx_list_free(obj->found_entries);
+	obj->contacts = bctbx_list_free_with_data(obj->contacts, linphone_ldap_friend_data_free);
+	if( obj->cookie ) ber_bvfree(obj->cookie);
 	if( obj->filter ) ms_free(obj->filter);
 }
 
@@ -162,16 +261,22 @@ static void linphone_ldap_contact_provider_destroy( LinphoneLDAPContactProvider*
 
 	if( obj->config ) linphone_dictionary_unref(obj->config);
 
+	obj->cache = bctbx_list_free_with_data(obj->cache, linphone_ldap_cached_search_free);
+
 	linphone_ldap_contact_provider_conf_destroy(obj);
 }
 
 static int linphone_ldap_contact_provider_complete_contact( LinphoneLDAPContactProvider* obj, struct LDAPFriendData* lf, const char* attr_name, const char* attr_value)
 {
-	if( strcmp(attr_name, obj->name_attr ) == 0 ){
+	if( !lf->name && strcmp(attr_name, obj->name_attr ) == 0 ){
 		lf->name = ms_strdup(attr_value);
-	} else if( strcmp(attr_name, obj->sip_attr) == 0 ) {
+	}
+	if( !lf->sip && strcmp(attr_name, obj->sip_attr) == 0 ) {
 		lf->sip = ms_strdup(attr_value);
 	}
+	if( obj->narrowing_attr && strcmp(attr_name, obj->narrowing_attr) == 0 ){
+		lf->match_values = bctbx_list_prepend(lf->match_values, ms_strdup(attr_value));
+	}
 
 	// return 1 if the structure has enough data to create a linphone friend
 	if( lf->name && lf->sip )
@@ -181,62 +286,227 @@ static int linphone_ldap_contact_provider_complete_contact( LinphoneLDAPContactP
 
 }
 
-static void linphone_ldap_contact_provider_handle_search_result( LinphoneLDAPContactProvider* obj, LinphoneLDAPContactSearch* req, LDAPMessage* message )
+static bool_t linphone_ldap_contact_provider_value_matches( const LinphoneLDAPContactProvider* obj, const char* value, const char* predicate)
 {
-	int msgtype = ldap_msgtype(message);
+	return linphone_ldap_narrowing_value_matches(value, predicate, obj->narrowing_prefix_only);
+}
 
-	switch(msgtype){
+static bool_t linphone_ldap_contact_provider_contact_matches( const LinphoneLDAPContactProvider* obj, const struct LDAPFriendData* data, const char* predicate)
+{
+	const bctbx_list_t* it;
+	for( it = data->match_values; it; it = bctbx_list_next(it) ){
+		if( linphone_ldap_contact_provider_value_matches(obj, (const char*)bctbx_list_get_data(it), predicate) ) return TRUE;
+	}
+	return FALSE;
+}
 
-	case LDAP_RES_SEARCH_ENTRY:
-	case LDAP_RES_EXTENDED:
-	{
-		LDAPMessage *entry = ldap_first_entry(obj->ld, message);
-		LinphoneCore*   lc = LINPHONE_CONTACT_PROVIDER(obj)->lc;
+/* Create the friends of a search result, keeping only the ones matching predicate when it is not NULL */
+static bctbx_list_t* linphone_ldap_contact_provider_create_friends( LinphoneLDAPContactProvider* obj, const bctbx_list_t* contacts, const char* predicate)
+{
+	LinphoneCore* lc = LINPHONE_CONTACT_PROVIDER(obj)->lc;
+	bctbx_list_t* friends = NULL;
+
+	for( ; contacts; contacts = bctbx_list_next(contacts) ){
+		const struct LDAPFriendData* data = (const struct LDAPFriendData*)bctbx_list_get_data(contacts);
+		LinphoneAddress* la;
+
+		if( predicate && !linphone_ldap_contact_provider_contact_matches(obj, data, predicate) ) continue;
+
+		la = linphone_core_interpret_url(lc, data->sip);
+		if( la ){
+			LinphoneFriend* lf = linphone_core_create_friend(lc);
+			linphone_friend_set_address(lf, la);
+			linphone_friend_set_name(lf, data->name);
+			friends = bctbx_list_append(friends, lf);
+			//ms_message("Added friend %s / %s", data->name, data->sip);
+			linphone_address_unref(la);
+		}
+	}
+	return friends;
+}
 
-		while( entry != NULL ){
+static void linphone_ldap_contact_provider_purge_cache( LinphoneLDAPContactProvider* obj )
+{
+	uint64_t now = ms_get_cur_time_ms();
+	bctbx_list_t* it = obj->cache;
+	int count = 0;
+
+	while( it ){
+		LDAPCachedSearch* cached = (LDAPCachedSearch*)bctbx_list_get_data(it);
+		bctbx_list_t* next = bctbx_list_next(it);
+		if( cached->expires <= now || count >= obj->cache_size ){
+			obj->cache = bctbx_list_erase_link(obj->cache, it);
+			linphone_ldap_cached_search_free(cached);
+		} else {
+			count++;
+		}
+		it = next;
+	}
+}
 
-			struct LDAPFriendData ldap_data = {0};
-			bool_t contact_complete = FALSE;
-			BerElement*  ber = NULL;
-			char*       attr = ldap_first_attribute(obj->ld, entry, &ber);
+/* Keep the entries of a finished search, the search gives them up */
+static void linphone_ldap_contact_provider_cache_results( LinphoneLDAPContactProvider* obj, LinphoneLDAPContactSearch* req )
+{
+	const char* predicate = linphone_contact_search_get_predicate(LINPHONE_CONTACT_SEARCH(req));
+	LDAPCachedSearch* cached;
+	bctbx_list_t* it;
 
-			while( attr ){
-				struct berval** values = ldap_get_values_len(obj->ld, entry, attr);
-				struct berval**     it = values;
+	if( obj->cache_ttl <= 0 || obj->cache_size <= 0 ) return;
 
-				while( values && *it && (*it)->bv_val && (*it)->bv_len )
-				{
-					contact_complete = linphone_ldap_contact_provider_complete_contact(obj, &ldap_data, attr, (*it)->bv_val);
-					if( contact_complete ) break;
+	for( it = obj->cache; it; it = bctbx_list_next(it) ){
+		cached = (LDAPCachedSearch*)bctbx_list_get_data(it);
+		if( strcmp(cached->predicate, predicate) == 0 ){
+			obj->cache = bctbx_list_erase_link(obj->cache, it);
+			linphone_ldap_cached_search_free(cached);
+			break;
+		}
+	}
 
-					it++;
-				}
+	cached = ms_new0(LDAPCachedSearch, 1);
+	cached->predicate = ms_strdup(predicate);
+	cached->contacts = req->contacts;
+	cached->expires = ms_get_cur_time_ms() + (uint64_t)obj->cache_ttl * 1000;
+	cached->complete = !req->truncated;
+	req->contacts = NULL;
 
-				if( values ) ldap_value_free_len(values);
-				ldap_memfree(attr);
+	obj->cache = bctbx_list_prepend(obj->cache, cached);
+	linphone_ldap_contact_provider_purge_cache(obj);
+}
 
-				if( contact_complete ) break;
+/*
+ * Answer a new search from the cache: either the same predicate was searched recently, or the filter
+ * allows to narrow the complete result of a broader predicate, e.g. when more characters are typed.
+ */
+static bool_t linphone_ldap_contact_provider_search_cache( LinphoneLDAPContactProvider* obj, LinphoneLDAPContactSearch* req )
+{
+	const char* predicate = linphone_contact_search_get_predicate(LINPHONE_CONTACT_SEARCH(req));
+	// special characters would be interpreted by the server, the local match wouldn't be the same
+	bool_t can_narrow = obj->narrowing_attr && strpbrk(predicate, "*()\\") == NULL;
+	LDAPCachedSearch* broader = NULL;
+	bctbx_list_t* it;
+
+	if( obj->cache_ttl <= 0 ) return FALSE;
+	linphone_ldap_contact_provider_purge_cache(obj);
+
+	for( it = obj->cache; it; it = bctbx_list_next(it) ){
+		LDAPCachedSearch* cached = (LDAPCachedSearch*)bctbx_list_get_data(it);
+		if( strcmp(cached->predicate, predicate) == 0 ){
+			broader = NULL;
+			req->found_entries = linphone_ldap_contact_provider_create_friends(obj, cached->contacts, NULL);
+			break;
+		}
+		if( can_narrow && cached->complete
+			&& linphone_ldap_contact_provider_value_matches(obj, predicate, cached->predicate)
+			&& (!broader || strlen(cached->predicate) > strlen(broader->predicate)) ){
+			broader = cached;
+		}
+	}
+	if( !it && !broader ) return FALSE;
 
-				attr = ldap_next_attribute(obj->ld, entry, ber);
-			}
+	if( broader ){
+		ms_message("[LDAP] Search for '%s' narrowed from the cached results of '%s'", predicate, broader->predicate);
+		req->found_entries = linphone_ldap_contact_provider_create_friends(obj, broader->contacts, predicate);
+	} else {
+		ms_message("[LDAP] Search for '%s' answered from the cache", predicate);
+	}
+	req->found_count = (unsigned int)bctbx_list_size(req->found_entries);
+	req->complete = TRUE;
+	req->from_cache = TRUE;
+	return TRUE;
+}
 
-			if( contact_complete ) {
-				LinphoneAddress* la = linphone_core_interpret_url(lc, ldap_data.sip);
-				if( la ){
-					LinphoneFriend* lf = linphone_core_create_friend(lc);
-					linphone_friend_set_address(lf, la);
-					linphone_friend_set_name(lf, ldap_data.name);
-					req->found_entries = bctbx_list_append(req->found_entries, lf);
-					req->found_count++;
-					//ms_message("Added friend %s / %s", ldap_data.name, ldap_data.sip);
-					ms_free(ldap_data.sip);
-					ms_free(ldap_data.name);
-					linphone_address_unref(la);
+static void linphone_ldap_contact_provider_read_entry( LinphoneLDAPContactProvider* obj, LinphoneLDAPContactSearch* req, LDAPMessage* entry )
+{
+	struct LDAPFriendData* ldap_data = ms_new0(struct LDAPFriendData, 1);
+	bool_t contact_complete = FALSE;
+	BerElement*  ber = NULL;
+	char*       attr = ldap_first_attribute(obj->ld, entry, &ber);
+
+	// read all the attributes, the one used to narrow searches can come after the name and sip address
+	while( attr ){
+		struct berval** values = ldap_get_values_len(obj->ld, entry, attr);
+		struct berval**     it = values;
+
+		while( values && *it && (*it)->bv_val && (*it)->bv_len )
+		{
+			contact_complete = linphone_ldap_contact_provider_complete_contact(obj, ldap_data, attr, (*it)->bv_val);
+			it++;
+		}
+
+		if( values ) ldap_value_free_len(values);
+		ldap_memfree(attr);
+
+		attr = ldap_next_attribute(obj->ld, entry, ber);
+	}
+
+	if( ber ) ber_free(ber, 0);
+
+	if( contact_complete ){
+		req->contacts = bctbx_list_append(req->contacts, ldap_data);
+		req->found_count++;
+	} else {
+		linphone_ldap_friend_data_free(ldap_data);
+	}
+}
+
+/*
+ * Read the status of a finished search request. Returns TRUE when the server has another page for it,
+ * the next page is then requested by the following iteration.
+ */
+static bool_t linphone_ldap_contact_provider_search_done( LinphoneLDAPContactProvider* obj, LinphoneLDAPContactSearch* req, LDAPMessage* message )
+{
+	int err = LDAP_SUCCESS;
+	LDAPControl** server_controls = NULL;
+	bool_t next_page = FALSE;
+
+	if( ldap_parse_result(obj->ld, message, &err, NULL, NULL, NULL, &server_controls, 0) != LDAP_SUCCESS ){
+		req->truncated = TRUE;
+		return FALSE;
+	}
+	if( err != LDAP_SUCCESS ){
+		if( err != LDAP_SIZELIMIT_EXCEEDED ) ms_warning("[LDAP] Search for %s ended with error %d (%s)", req->filter, err, ldap_err2string(err));
+		req->truncated = TRUE;
+	}
+
+	if( req->cookie ) ber_bvfree(req->cookie);
+	req->cookie = NULL;
+	if( server_controls && obj->page_size > 0 ){
+		LDAPControl* page_control = ldap_control_find(LDAP_CONTROL_PAGEDRESULTS, server_controls, NULL);
+		ber_int_t estimate = 0;
+		struct berval cookie = { 0, NULL };
+
+		if( page_control && ldap_parse_pageresponse_control(obj->ld, page_control, &estimate, &cookie) == LDAP_SUCCESS ){
+			if( cookie.bv_len > 0 && err == LDAP_SUCCESS ){
+				if( (int)req->found_count < obj->max_results ){
+					req->cookie = ber_bvdup(&cookie);
+					req->msgid = 0;
+					next_page = TRUE;
+				} else {
+					req->truncated = TRUE;
 				}
 			}
+			if( cookie.bv_val ) ber_memfree(cookie.bv_val);
+		}
+	}
+	if( server_controls ) ldap_controls_free(server_controls);
+	return next_page;
+}
 
-			if( ber ) ber_free(ber, 0);
+static void linphone_ldap_contact_provider_handle_search_result( LinphoneLDAPContactProvider* obj, LinphoneLDAPContactSearch* req, LDAPMessage* message )
+{
+	int msgtype = ldap_msgtype(message);
+
+	if( req == NULL ) return; // the search was cancelled
+
+	switch(msgtype){
+
+	case LDAP_RES_SEARCH_ENTRY:
+	case LDAP_RES_EXTENDED:
+	{
+		LDAPMessage *entry = ldap_first_entry(obj->ld, message);
 
+		while( entry != NULL ){
+			linphone_ldap_contact_provider_read_entry(obj, req, entry);
 			entry = ldap_next_entry(obj->ld, entry);
 		}
 	}
@@ -244,8 +514,13 @@ static void linphone_ldap_contact_provider_handle_search_result( LinphoneLDAPCon
 
 	case LDAP_RES_SEARCH_RESULT:
 	{
-		// this one is received when a request is finished
+		// this one is received when a request (or one of its pages) is finished
+		if( linphone_ldap_contact_provider_search_done(obj, req, message) ) break;
+
 		req->complete = TRUE;
+		req->found_entries = linphone_ldap_contact_provider_create_friends(obj, req->contacts, NULL);
+		req->found_count = (unsigned int)bctbx_list_size(req->found_entries);
+		linphone_ldap_contact_provider_cache_results(obj, req);
 		linphone_contact_search_invoke_cb(LINPHONE_CONTACT_SEARCH(req), req->found_entries);
 	}
 	break;
@@ -255,11 +530,12 @@ static void linphone_ldap_contact_provider_handle_search_result( LinphoneLDAPCon
 	}
 }
 
-static bool_t linphone_ldap_contact_provider_iterate(void *data)
+/* Handle all the results already received, within the iteration time budget */
+static void linphone_ldap_contact_provider_read_results( LinphoneLDAPContactProvider* obj )
 {
-	LinphoneLDAPContactProvider* obj = LINPHONE_LDAP_CONTACT_PROVIDER(data);
-	if( obj->ld && obj->connected && (obj->req_count > 0) ){
+	uint64_t deadline = ms_get_cur_time_ms() + (uint64_t)obj->iterate_budget;
 
+	do {
 		// never block
 		struct timeval timeout = {0,0};
 		LDAPMessage* results = NULL;
@@ -287,14 +563,17 @@ static bool_t linphone_ldap_contact_provider_iterate(void *data)
 		{
 			LDAPMessage* message = ldap_first_message(obj->ld, results);
 			LinphoneLDAPContactSearch* req = linphone_ldap_contact_provider_request_search(obj, ldap_msgid(message));
+			// the search callback may cancel the search
+			if( req ) belle_sip_object_ref(req);
 			while( message != NULL ){
 				linphone_ldap_contact_provider_handle_search_result(obj, req, message );
 				message = ldap_next_message(obj->ld, message);
 			}
-			if( req && ret == LDAP_RES_SEARCH_RESULT)
+			if( req && ret == LDAP_RES_SEARCH_RESULT && req->complete && bctbx_list_find(obj->requests, req) )
 				linphone_ldap_contact_provider_cancel_search(
 							LINPHONE_CONTACT_PROVIDER(obj),
 							LINPHONE_CONTACT_SEARCH(req));
+			if( req ) belle_sip_object_unref(req);
 			break;
 		}
 		case LDAP_RES_MODIFY:
@@ -309,27 +588,54 @@ static bool_t linphone_ldap_contact_provider_iterate(void *data)
 
 		if( results )
 			ldap_msgfree(results);
+		if( ret <= 0 ) break;
+	} while( obj->req_count > 0 && ms_get_cur_time_ms() < deadline );
+}
+
+static bool_t linphone_ldap_contact_provider_iterate(void *data)
+{
+	LinphoneLDAPContactProvider* obj = LINPHONE_LDAP_CONTACT_PROVIDER(data);
+	bctbx_list_t* answered = NULL;
+	bctbx_list_t* it;
+
+	if( obj->ld && obj->connected && (obj->req_count > 0) ){
+		linphone_ldap_contact_provider_read_results(obj);
 	}
 
-	if( obj->ld && obj->connected ){
-		// check for pending searches
-		unsigned int i;
-
-		for( i=0; i<obj->req_count; i++){
-			LinphoneLDAPContactSearch* search = (LinphoneLDAPContactSearch*)bctbx_list_nth_data( obj->requests, i );
-			if( search && search->msgid == 0){
-				int ret;
-				ms_message("Found pending search %p (for %s), launching...", search, search->filter);
-				ret = linphone_ldap_contact_provider_perform_search(obj, search);
-				if( ret != LDAP_SUCCESS ){
-					linphone_ldap_contact_provider_cancel_search(
-								LINPHONE_CONTACT_PROVIDER(obj),
-								LINPHONE_CONTACT_SEARCH(search));
-				}
+	// launch the pending searches, and collect the ones answered from the cache
+	it = obj->requests;
+	while( it ){
+		LinphoneLDAPContactSearch* search = (LinphoneLDAPContactSearch*)bctbx_list_get_data(it);
+		it = bctbx_list_next(it);
+
+		if( search->from_cache ){
+			answered = bctbx_list_append(answered, belle_sip_object_ref(search));
+		} else if( search->msgid == 0 && obj->ld && obj->connected ){
+			int ret;
+			ms_message("Found pending search %p (for %s), launching...", search, search->filter);
+			ret = linphone_ldap_contact_provider_perform_search(obj, search);
+			if( ret != LDAP_SUCCESS ){
+				linphone_ldap_contact_provider_cancel_search(
+							LINPHONE_CONTACT_PROVIDER(obj),
+							LINPHONE_CONTACT_SEARCH(search));
 			}
 		}
 	}
 
+	// deliver them once the list is no longer walked, a callback may cancel or start any search
+	for( it = answered; it; it = bctbx_list_next(it) ){
+		LinphoneLDAPContactSearch* search = (LinphoneLDAPContactSearch*)bctbx_list_get_data(it);
+		if( bctbx_list_find(obj->requests, search) ){
+			linphone_contact_search_invoke_cb(LINPHONE_CONTACT_SEARCH(search), search->found_entries);
+		}
+		if( bctbx_list_find(obj->requests, search) ){
+			linphone_ldap_contact_provider_cancel_search(
+						LINPHONE_CONTACT_PROVIDER(obj),
+						LINPHONE_CONTACT_SEARCH(search));
+		}
+	}
+	bctbx_list_free_with_data(answered, belle_sip_object_unref);
+
 	return TRUE;
 }
 
@@ -341,9 +647,19 @@ static void linphone_ldap_contact_provider_conf_destroy(LinphoneLDAPContactProvi
 			ms_free(obj->attributes[i]);
 		}
 		ms_free(obj->attributes);
+		obj->attributes = NULL;
+	}
+	if(obj->narrowing_attr){
+		ms_free(obj->narrowing_attr);
+		obj->narrowing_attr = NULL;
 	}
 }
 
+static void linphone_ldap_contact_provider_parse_narrowing_filter(LinphoneLDAPContactProvider* obj)
+{
+	obj->narrowing_attr = linphone_ldap_parse_narrowing_filter(obj->filter, &obj->narrowing_prefix_only);
+}
+
 static char* required_config_keys[] = {
 	// connection
 	"server",
@@ -419,6 +735,12 @@ static void linphone_ldap_contact_provider_loadconfig(LinphoneLDAPContactProvide
 	obj->sasl_authname = linphone_dictionary_get_string(obj->config, "sasl_authname",  "");
 	obj->sasl_realm    = linphone_dictionary_get_string(obj->config, "sasl_realm",  "");
 
+	// optional
+	obj->cache_ttl      = linphone_dictionary_get_int(obj->config, "cache_ttl",      0);
+	obj->cache_size     = linphone_dictionary_get_int(obj->config, "cache_size",     20);
+	obj->page_size      = linphone_dictionary_get_int(obj->config, "page_size",      0);
+	obj->iterate_budget = linphone_dictionary_get_int(obj->config, "iterate_budget", 20);
+
 	/*
 	 * parse the attributes list
 	 */
@@ -445,6 +767,19 @@ static void linphone_ldap_contact_provider_loadconfig(LinphoneLDAPContactProvide
 	if( attr_idx != attr_count+1) ms_error("Invalid attribute number!!! %d expected, got %d", attr_count+1, attr_idx);
 
 	ms_free(attributes_list);
+
+	/*
+	 * the attribute of the filter must be returned with the entries to narrow cached results
+	 */
+	linphone_ldap_contact_provider_parse_narrowing_filter(obj);
+	if( obj->narrowing_attr ){
+		for( i=0; i<attr_idx && strcmp(obj->attributes[i], obj->narrowing_attr) != 0; i++);
+		if( i == attr_idx ){
+			obj->attributes = ms_realloc(obj->attributes, (attr_idx+2) * sizeof(char*));
+			obj->attributes[attr_idx] = ms_strdup(obj->narrowing_attr);
+			obj->attributes[attr_idx+1] = NULL;
+		}
+	}
 }
 
 static int linphone_ldap_contact_provider_bind_interact(LDAP *ld,
@@ -615,7 +950,7 @@ static int linphone_ldap_request_entry_compare_strong(const void*a, const void*
 {
 	const LinphoneLDAPContactSearch* ra = (const LinphoneLDAPContactSearch*)a;
 	const LinphoneLDAPContactSearch* rb = (const LinphoneLDAPContactSearch*)b;
-	return !(ra->msgid == rb->msgid) && !(ra == rb);
+	return !(ra->msgid == rb->msgid && ra == rb);
 }
 
 static inline LinphoneLDAPContactSearch* linphone_ldap_contact_provider_request_search( LinphoneLDAPContactProvider* obj, int msgid )
@@ -638,6 +973,9 @@ static unsigned int linphone_ldap_contact_provider_cancel_search(LinphoneContact
 	bctbx_list_t* list_entry = bctbx_list_find_custom(ldap_cp->requests, linphone_ldap_request_entry_compare_strong, req);
 	if( list_entry ) {
 		ms_message("Delete search %p", req);
+		// a search cancelled before its end must not keep the server busy
+		if( !ldap_req->complete && ldap_req->msgid > 0 && ldap_cp->ld )
+			ldap_abandon_ext(ldap_cp->ld, ldap_req->msgid, NULL, NULL);
 		ldap_cp->requests = bctbx_list_erase_link(ldap_cp->requests, list_entry);
 		ldap_cp->req_count--;
 		ret = 0; // return OK if we found it in the monitored requests
@@ -652,8 +990,19 @@ static int linphone_ldap_contact_provider_perform_search( LinphoneLDAPContactPro
 {
 	int ret = -1;
 	struct timeval timeout = { obj->timeout, 0 };
+	LDAPControl* page_control = NULL;
+	LDAPControl* server_controls[2] = { NULL, NULL };
 
 	if( req->msgid == 0 ){
+		if( obj->page_size > 0 ){
+			// the control is not critical, servers without paging support return all the results at once
+			ret = ldap_create_page_control(obj->ld, obj->page_size, req->cookie, 0, &page_control);
+			if( ret != LDAP_SUCCESS ){
+				ms_error("Error ldap_create_page_control returned %d (%s)", ret, ldap_err2string(ret));
+				return ret;
+			}
+			server_controls[0] = page_control;
+		}
 		ms_message ( "Calling ldap_search_ext with predicate '%s' on base '%s', ld %p, attrs '%s', maxres = %d", req->filter, obj->base_object, obj->ld, obj->attributes[0], obj->max_results );
 		ret = ldap_search_ext(obj->ld,
 						obj->base_object,// base from which to start
@@ -661,12 +1010,14 @@ static int linphone_ldap_contact_provider_perform_search( LinphoneLDAPContactPro
 						req->filter,     // search predicate
 						obj->attributes, // which attributes to get
 						0,               // 0 = get attrs AND value, 1 = get attrs only
-						NULL,
+						page_control ? server_controls : NULL,
 						NULL,
 						&timeout,        // server timeout for the search
 						obj->max_results,// max result number
 						&req->msgid );
 
+		if( page_control ) ldap_control_free(page_control);
+
 		if( ret != LDAP_SUCCESS ){
 			ms_error("Error ldap_search_ext returned %d (%s)", ret, ldap_err2string(ret));
 		} else {
@@ -694,7 +1045,9 @@ static LinphoneLDAPContactSearch* linphone_ldap_contact_provider_begin_search (
 
 	request = linphone_ldap_contact_search_create( obj, predicate, cb, cb_data );
 
-	if( connected ){
+	if( linphone_ldap_contact_provider_search_cache(obj, request) ){
+		// delivered by the next iteration, like the server results
+	} else if( connected ){
 		int ret = linphone_ldap_contact_provider_perform_search(obj, request);
 		ms_message ( "Created search %d for '%s', msgid %d, @%p", obj->req_count, predicate, request->msgid, request );
 		if( ret != LDAP_SUCCESS ){
@@ -737,6 +1090,9 @@ static int linphone_ldap_contact_provider_marshal(LinphoneLDAPContactProvider* o
 							   "timeout: %d \n"
 							   "deref: %d \n"
 							   "max_res: %d \n"
+							   "cache_ttl: %d \n"
+							   "cache_size: %d \n"
+							   "page_size: %d \n"
 							   "sip_attr:%s \n"
 							   "name_attr:%s \n"
 							   "attrs:\n",
@@ -745,6 +1101,7 @@ static int linphone_ldap_contact_provider_marshal(LinphoneLDAPContactProvider* o
 							   obj->base_object, obj->filter,
 							   obj->timeout, obj->deref_aliases,
 							   obj->max_results,
+							   obj->cache_ttl, obj->cache_size, obj->page_size,
 							   obj->sip_attr, obj->name_attr);
 	if(error!= BELLE_SIP_OK) return error;
 
@@ -202,6 +202,7 @@ void _linphone_core_cbs_set_v_table(LinphoneCoreCbs *cbs, LinphoneCoreVTable *vt
 	ms_free(cbs->vtable);
 	cbs->vtable = vtable;
 	cbs->autorelease = autorelease;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbs *linphone_core_cbs_ref(LinphoneCoreCbs *cbs) {
@@ -230,6 +231,7 @@ LinphoneCoreCbsGlobalStateChangedCb linphone_core_cbs_get_global_state_changed(L
 
 void linphone_core_cbs_set_global_state_changed(LinphoneCoreCbs *cbs, LinphoneCoreCbsGlobalStateChangedCb cb) {
 	cbs->vtable->global_state_changed = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsRegistrationStateChangedCb linphone_core_cbs_get_registration_state_changed(LinphoneCoreCbs *cbs) {
@@ -238,6 +240,7 @@ LinphoneCoreCbsRegistrationStateChangedCb linphone_core_cbs_get_registration_sta
 
 void linphone_core_cbs_set_registration_state_changed(LinphoneCoreCbs *cbs, LinphoneCoreCbsRegistrationStateChangedCb cb) {
 	cbs->vtable->registration_state_changed = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsCallStateChangedCb linphone_core_cbs_get_call_state_changed(LinphoneCoreCbs *cbs) {
@@ -246,6 +249,7 @@ LinphoneCoreCbsCallStateChangedCb linphone_core_cbs_get_call_state_changed(Linph
 
 void linphone_core_cbs_set_call_state_changed(LinphoneCoreCbs *cbs, LinphoneCoreCbsCallStateChangedCb cb) {
 	cbs->vtable->call_state_changed = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsNotifyPresenceReceivedCb linphone_core_cbs_get_notify_presence_received(LinphoneCoreCbs *cbs) {
@@ -254,6 +258,7 @@ LinphoneCoreCbsNotifyPresenceReceivedCb linphone_core_cbs_get_notify_presence_re
 
 void linphone_core_cbs_set_notify_presence_received(LinphoneCoreCbs *cbs, LinphoneCoreCbsNotifyPresenceReceivedCb cb) {
 	cbs->vtable->notify_presence_received = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsNotifyPresenceReceivedForUriOrTelCb linphone_core_cbs_get_notify_presence_received_for_uri_or_tel(LinphoneCoreCbs *cbs) {
@@ -262,6 +267,7 @@ LinphoneCoreCbsNotifyPresenceReceivedForUriOrTelCb linphone_core_cbs_get_notify_
 
 void linphone_core_cbs_set_notify_presence_received_for_uri_or_tel(LinphoneCoreCbs *cbs, LinphoneCoreCbsNotifyPresenceReceivedForUriOrTelCb cb) {
 	cbs->vtable->notify_presence_received_for_uri_or_tel = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsNewSubscriptionRequestedCb linphone_core_cbs_get_new_subscription_requested(LinphoneCoreCbs *cbs) {
@@ -270,6 +276,7 @@ LinphoneCoreCbsNewSubscriptionRequestedCb linphone_core_cbs_get_new_subscription
 
 void linphone_core_cbs_set_new_subscription_requested(LinphoneCoreCbs *cbs, LinphoneCoreCbsNewSubscriptionRequestedCb cb) {
 	cbs->vtable->new_subscription_requested = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsAuthenticationRequestedCb linphone_core_cbs_get_authentication_requested(LinphoneCoreCbs *cbs) {
@@ -278,6 +285,7 @@ LinphoneCoreCbsAuthenticationRequestedCb linphone_core_cbs_get_authentication_re
 
 void linphone_core_cbs_set_authentication_requested(LinphoneCoreCbs *cbs, LinphoneCoreCbsAuthenticationRequestedCb cb) {
 	cbs->vtable->authentication_requested = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsCallLogUpdatedCb linphone_core_cbs_get_call_log_updated(LinphoneCoreCbs *cbs) {
@@ -286,6 +294,7 @@ LinphoneCoreCbsCallLogUpdatedCb linphone_core_cbs_get_call_log_updated(LinphoneC
 
 void linphone_core_cbs_set_call_log_updated(LinphoneCoreCbs *cbs, LinphoneCoreCbsCallLogUpdatedCb cb) {
 	cbs->vtable->call_log_updated = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsChatRoomReadCb linphone_core_cbs_get_chat_room_read(LinphoneCoreCbs *cbs) {
@@ -294,6 +303,7 @@ LinphoneCoreCbsChatRoomReadCb linphone_core_cbs_get_chat_room_read(LinphoneCoreC
 
 void linphone_core_cbs_set_chat_room_read(LinphoneCoreCbs *cbs, LinphoneCoreCbsChatRoomReadCb cb) {
 	cbs->vtable->chat_room_read = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsMessageReceivedCb linphone_core_cbs_get_message_sent(LinphoneCoreCbs *cbs) {
@@ -302,6 +312,7 @@ LinphoneCoreCbsMessageReceivedCb linphone_core_cbs_get_message_sent(LinphoneCore
 
 void linphone_core_cbs_set_message_sent(LinphoneCoreCbs *cbs, LinphoneCoreCbsMessageReceivedCb cb) {
 	cbs->vtable->message_sent = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsMessageReceivedCb linphone_core_cbs_get_message_received(LinphoneCoreCbs *cbs) {
@@ -310,6 +321,7 @@ LinphoneCoreCbsMessageReceivedCb linphone_core_cbs_get_message_received(Linphone
 
 void linphone_core_cbs_set_message_received(LinphoneCoreCbs *cbs, LinphoneCoreCbsMessageReceivedCb cb) {
 	cbs->vtable->message_received = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsMessageReceivedUnableDecryptCb linphone_core_cbs_get_message_received_unable_decrypt(LinphoneCoreCbs *cbs) {
@@ -318,6 +330,7 @@ LinphoneCoreCbsMessageReceivedUnableDecryptCb linphone_core_cbs_get_message_rece
 
 void linphone_core_cbs_set_message_received_unable_decrypt(LinphoneCoreCbs *cbs, LinphoneCoreCbsMessageReceivedUnableDecryptCb cb) {
 	cbs->vtable->message_received_unable_decrypt = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsIsComposingReceivedCb linphone_core_cbs_get_is_composing_received(LinphoneCoreCbs *cbs) {
@@ -326,6 +339,7 @@ LinphoneCoreCbsIsComposingReceivedCb linphone_core_cbs_get_is_composing_received
 
 void linphone_core_cbs_set_is_composing_received(LinphoneCoreCbs *cbs, LinphoneCoreCbsIsComposingReceivedCb cb) {
 	cbs->vtable->is_composing_received = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsDtmfReceivedCb linphone_core_cbs_get_dtmf_received(LinphoneCoreCbs *cbs) {
@@ -334,6 +348,7 @@ LinphoneCoreCbsDtmfReceivedCb linphone_core_cbs_get_dtmf_received(LinphoneCoreCb
 
 void linphone_core_cbs_set_dtmf_received(LinphoneCoreCbs *cbs, LinphoneCoreCbsDtmfReceivedCb cb) {
 	cbs->vtable->dtmf_received = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsReferReceivedCb linphone_core_cbs_get_refer_received(LinphoneCoreCbs *cbs) {
@@ -342,6 +357,7 @@ LinphoneCoreCbsReferReceivedCb linphone_core_cbs_get_refer_received(LinphoneCore
 
 void linphone_core_cbs_set_refer_received(LinphoneCoreCbs *cbs, LinphoneCoreCbsReferReceivedCb cb) {
 	cbs->vtable->refer_received = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsCallEncryptionChangedCb linphone_core_cbs_get_call_encryption_changed(LinphoneCoreCbs *cbs) {
@@ -350,6 +366,7 @@ LinphoneCoreCbsCallEncryptionChangedCb linphone_core_cbs_get_call_encryption_cha
 
 void linphone_core_cbs_set_call_encryption_changed(LinphoneCoreCbs *cbs, LinphoneCoreCbsCallEncryptionChangedCb cb) {
 	cbs->vtable->call_encryption_changed = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsTransferStateChangedCb linphone_core_cbs_get_transfer_state_changed(LinphoneCoreCbs *cbs) {
@@ -358,6 +375,7 @@ LinphoneCoreCbsTransferStateChangedCb linphone_core_cbs_get_transfer_state_chang
 
 void linphone_core_cbs_set_transfer_state_changed(LinphoneCoreCbs *cbs, LinphoneCoreCbsTransferStateChangedCb cb) {
 	cbs->vtable->transfer_state_changed = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsBuddyInfoUpdatedCb linphone_core_cbs_get_buddy_info_updated(LinphoneCoreCbs *cbs) {
@@ -366,6 +384,7 @@ LinphoneCoreCbsBuddyInfoUpdatedCb linphone_core_cbs_get_buddy_info_updated(Linph
 
 void linphone_core_cbs_set_buddy_info_updated(LinphoneCoreCbs *cbs, LinphoneCoreCbsBuddyInfoUpdatedCb cb) {
 	cbs->vtable->buddy_info_updated = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsCallStatsUpdatedCb linphone_core_cbs_get_call_stats_updated(LinphoneCoreCbs *cbs) {
@@ -374,6 +393,7 @@ LinphoneCoreCbsCallStatsUpdatedCb linphone_core_cbs_get_call_stats_updated(Linph
 
 void linphone_core_cbs_set_call_stats_updated(LinphoneCoreCbs *cbs, LinphoneCoreCbsCallStatsUpdatedCb cb) {
 	cbs->vtable->call_stats_updated = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsInfoReceivedCb linphone_core_cbs_get_info_received(LinphoneCoreCbs *cbs) {
@@ -382,6 +402,7 @@ LinphoneCoreCbsInfoReceivedCb linphone_core_cbs_get_info_received(LinphoneCoreCb
 
 void linphone_core_cbs_set_info_received(LinphoneCoreCbs *cbs, LinphoneCoreCbsInfoReceivedCb cb) {
 	cbs->vtable->info_received = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsSubscriptionStateChangedCb linphone_core_cbs_get_subscription_state_changed(LinphoneCoreCbs *cbs) {
@@ -390,6 +411,7 @@ LinphoneCoreCbsSubscriptionStateChangedCb linphone_core_cbs_get_subscription_sta
 
 void linphone_core_cbs_set_subscription_state_changed(LinphoneCoreCbs *cbs, LinphoneCoreCbsSubscriptionStateChangedCb cb) {
 	cbs->vtable->subscription_state_changed = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsNotifyReceivedCb linphone_core_cbs_get_notify_received(LinphoneCoreCbs *cbs) {
@@ -398,6 +420,7 @@ LinphoneCoreCbsNotifyReceivedCb linphone_core_cbs_get_notify_received(LinphoneCo
 
 void linphone_core_cbs_set_notify_received(LinphoneCoreCbs *cbs, LinphoneCoreCbsNotifyReceivedCb cb) {
 	cbs->vtable->notify_received = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsSubscribeReceivedCb linphone_core_cbs_get_subscribe_received(LinphoneCoreCbs *cbs) {
@@ -406,6 +429,7 @@ LinphoneCoreCbsSubscribeReceivedCb linphone_core_cbs_get_subscribe_received(Linp
 
 void linphone_core_cbs_set_subscribe_received(LinphoneCoreCbs *cbs, LinphoneCoreCbsSubscribeReceivedCb cb) {
 	cbs->vtable->subscribe_received = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsPublishStateChangedCb linphone_core_cbs_get_rpublish_state_changed(LinphoneCoreCbs *cbs) {
@@ -414,6 +438,7 @@ LinphoneCoreCbsPublishStateChangedCb linphone_core_cbs_get_rpublish_state_change
 
 void linphone_core_cbs_set_publish_state_changed(LinphoneCoreCbs *cbs, LinphoneCoreCbsPublishStateChangedCb cb) {
 	cbs->vtable->publish_state_changed = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsConfiguringStatusCb linphone_core_cbs_get_configuring_status(LinphoneCoreCbs *cbs) {
@@ -422,6 +447,7 @@ LinphoneCoreCbsConfiguringStatusCb linphone_core_cbs_get_configuring_status(Linp
 
 void linphone_core_cbs_set_configuring_status(LinphoneCoreCbs *cbs, LinphoneCoreCbsConfiguringStatusCb cb) {
 	cbs->vtable->configuring_status = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsNetworkReachableCb linphone_core_cbs_get_network_reachable(LinphoneCoreCbs *cbs) {
@@ -430,6 +456,7 @@ LinphoneCoreCbsNetworkReachableCb linphone_core_cbs_get_network_reachable(Linpho
 
 void linphone_core_cbs_set_network_reachable(LinphoneCoreCbs *cbs, LinphoneCoreCbsNetworkReachableCb cb) {
 	cbs->vtable->network_reachable = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsLogCollectionUploadStateChangedCb linphone_core_cbs_log_collection_upload_state_changed(LinphoneCoreCbs *cbs) {
@@ -438,6 +465,7 @@ LinphoneCoreCbsLogCollectionUploadStateChangedCb linphone_core_cbs_log_collectio
 
 void linphone_core_cbs_set_log_collection_upload_state_changed(LinphoneCoreCbs *cbs, LinphoneCoreCbsLogCollectionUploadStateChangedCb cb) {
 	cbs->vtable->log_collection_upload_state_changed = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsLogCollectionUploadProgressIndicationCb linphone_core_cbs_get_rlog_collection_upload_progress_indication(LinphoneCoreCbs *cbs) {
@@ -446,6 +474,7 @@ LinphoneCoreCbsLogCollectionUploadProgressIndicationCb linphone_core_cbs_get_rlo
 
 void linphone_core_cbs_set_log_collection_upload_progress_indication(LinphoneCoreCbs *cbs, LinphoneCoreCbsLogCollectionUploadProgressIndicationCb cb) {
 	cbs->vtable->log_collection_upload_progress_indication = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsFriendListCreatedCb linphone_core_cbs_get_friend_list_created(LinphoneCoreCbs *cbs) {
@@ -454,6 +483,7 @@ LinphoneCoreCbsFriendListCreatedCb linphone_core_cbs_get_friend_list_created(Lin
 
 void linphone_core_cbs_set_friend_list_created(LinphoneCoreCbs *cbs, LinphoneCoreCbsFriendListCreatedCb cb) {
 	cbs->vtable->friend_list_created = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsFriendListRemovedCb linphone_core_cbs_get_friend_list_removed(LinphoneCoreCbs *cbs) {
@@ -462,6 +492,7 @@ LinphoneCoreCbsFriendListRemovedCb linphone_core_cbs_get_friend_list_removed(Lin
 
 void linphone_core_cbs_set_friend_list_removed(LinphoneCoreCbs *cbs, LinphoneCoreCbsFriendListRemovedCb cb) {
 	cbs->vtable->friend_list_removed = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsCallCreatedCb linphone_core_cbs_get_call_created(LinphoneCoreCbs *cbs) {
@@ -470,6 +501,7 @@ LinphoneCoreCbsCallCreatedCb linphone_core_cbs_get_call_created(LinphoneCoreCbs
 
 void linphone_core_cbs_set_call_created(LinphoneCoreCbs *cbs, LinphoneCoreCbsCallCreatedCb cb) {
 	cbs->vtable->call_created = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsVersionUpdateCheckResultReceivedCb linphone_core_cbs_get_version_update_check_result_received(LinphoneCoreCbs *cbs) {
@@ -478,6 +510,7 @@ LinphoneCoreCbsVersionUpdateCheckResultReceivedCb linphone_core_cbs_get_version_
 
 void linphone_core_cbs_set_version_update_check_result_received(LinphoneCoreCbs *cbs, LinphoneCoreCbsVersionUpdateCheckResultReceivedCb cb) {
 	cbs->vtable->version_update_check_result_received = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsChatRoomStateChangedCb linphone_core_cbs_get_chat_room_state_changed (LinphoneCoreCbs *cbs) {
@@ -486,6 +519,7 @@ LinphoneCoreCbsChatRoomStateChangedCb linphone_core_cbs_get_chat_room_state_chan
 
 void linphone_core_cbs_set_chat_room_state_changed (LinphoneCoreCbs *cbs, LinphoneCoreCbsChatRoomStateChangedCb cb) {
 	cbs->vtable->chat_room_state_changed = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsChatRoomSubjectChangedCb linphone_core_cbs_get_chat_room_subject_changed (LinphoneCoreCbs *cbs) {
@@ -494,6 +528,7 @@ LinphoneCoreCbsChatRoomSubjectChangedCb linphone_core_cbs_get_chat_room_subject_
 
 void linphone_core_cbs_set_chat_room_subject_changed (LinphoneCoreCbs *cbs, LinphoneCoreCbsChatRoomSubjectChangedCb cb) {
 	cbs->vtable->chat_room_subject_changed = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsChatRoomEphemeralMessageDeleteCb linphone_core_cbs_get_chat_room_ephemeral_message_deleted (LinphoneCoreCbs *cbs) {
@@ -502,6 +537,7 @@ LinphoneCoreCbsChatRoomEphemeralMessageDeleteCb linphone_core_cbs_get_chat_room_
 
 void linphone_core_cbs_set_chat_room_ephemeral_message_deleted (LinphoneCoreCbs *cbs, LinphoneCoreCbsChatRoomEphemeralMessageDeleteCb cb) {
 	cbs->vtable->chat_room_ephemeral_message_deleted = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneCoreCbsQrcodeFoundCb linphone_core_cbs_get_qrcode_found(LinphoneCoreCbs *cbs) {
@@ -510,18 +546,22 @@ LinphoneCoreCbsQrcodeFoundCb linphone_core_cbs_get_qrcode_found(LinphoneCoreCbs
 
 void linphone_core_cbs_set_qrcode_found(LinphoneCoreCbs *cbs, LinphoneCoreCbsQrcodeFoundCb cb) {
 	cbs->vtable->qrcode_found = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 void linphone_core_cbs_set_ec_calibration_result(LinphoneCoreCbs *cbs, LinphoneCoreCbsEcCalibrationResultCb cb) {
 	cbs->vtable->ec_calibration_result = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 void linphone_core_cbs_set_ec_calibration_audio_init(LinphoneCoreCbs *cbs, LinphoneCoreCbsEcCalibrationAudioInitCb cb) {
 	cbs->vtable->ec_calibration_audio_init = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 void linphone_core_cbs_set_ec_calibration_audio_uninit(LinphoneCoreCbs *cbs, LinphoneCoreCbsEcCalibrationAudioUninitCb cb) {
 	cbs->vtable->ec_calibration_audio_uninit = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 
@@ -1590,6 +1630,13 @@ static void sip_config_read(LinphoneCore *lc) {
 	linphone_core_set_sip_transport_timeout(lc, lp_config_get_int(lc->config, "sip", "transport_timeout", 63000));
 	lc->sal->setSupportedTags(lp_config_get_string(lc->config,"sip","supported","replaces, outbound, gruu"));
 	lc->sip_conf.save_auth_info = !!lp_config_get_int(lc->config, "sip", "save_auth_info", 1);
+	lc->sip_conf.register_rate_limit = lp_config_get_int(lc->config, "sip", "register_rate_limit", 0);
+	lc->sip_conf.register_burst = lp_config_get_int(lc->config, "sip", "register_burst", 1);
+	lc->sip_conf.register_jitter = lp_config_get_int(lc->config, "sip", "register_jitter", 0);
+	lc->sip_conf.register_backoff = lp_config_get_int(lc->config, "sip", "register_backoff", 0);
+	lc->sip_conf.register_backoff_max = lp_config_get_int(lc->config, "sip", "register_backoff_max", 300000);
+	if (lc->sip_conf.register_burst < 1) lc->sip_conf.register_burst = 1;
+	lc->sip_conf.register_tokens = (float)lc->sip_conf.register_burst;
 
 	linphone_core_create_im_notif_policy(lc);
 
@@ -2161,6 +2208,10 @@ static void misc_config_read (LinphoneCore *lc) {
 		lc->user_certificates_path = bctbx_strdup(lp_config_get_string(config, "misc", "user_certificates_path", "."));
 
 	lc->send_call_stats_periodical_updates = !!lp_config_get_int(config, "misc", "send_call_stats_periodical_updates", 0);
+
+	lc->iterate_budget_ms = MAX(lp_config_get_int(config, "misc", "iterate_budget_ms", 0), 0);
+	if (lp_config_get_int(config, "misc", "iterate_stats_enabled", 0) && !lc->iterate_stats)
+		linphone_core_enable_iterate_stats(lc, TRUE);
 }
 
 void linphone_core_reload_ms_plugins(LinphoneCore *lc, const char *path){
@@ -3228,6 +3279,7 @@ static void __linphone_core_invalidate_registers(LinphoneCore* lc){
 			cfg->commit = TRUE;
 		}
 	}
+	linphone_core_schedule_proxy_update(lc);
 }
 
 int _linphone_core_apply_transports(LinphoneCore *lc){
@@ -3489,9 +3541,15 @@ static void notify_network_reachable_change (LinphoneCore *lc) {
 		linphone_core_resolve_stun_server(lc);
 }
 
-static void proxy_update(LinphoneCore *lc){
+static void proxy_update(LinphoneCore *lc, bool_t one_second_elapsed){
 	bctbx_list_t *elem,*next;
-	bctbx_list_for_each(lc->sip_conf.proxies,(void (*)(void*))&linphone_proxy_config_update);
+	/* Proxy configs only have work to do after a change flagged with linphone_core_schedule_proxy_update().
+	 * Conditions they wait for (network, dependency registered) are re-checked every second. */
+	if (lc->sip_conf.proxies_update_pending || one_second_elapsed) {
+		lc->sip_conf.proxies_update_pending = FALSE;
+		bctbx_list_for_each(lc->sip_conf.proxies,(void (*)(void*))&linphone_proxy_config_update);
+	}
+	if (lc->sip_conf.register_queue) linphone_core_process_register_queue(lc);
 	for(elem=lc->sip_conf.deleted_proxies;elem!=NULL;elem=next){
 		LinphoneProxyConfig* cfg = (LinphoneProxyConfig*)elem->data;
 		next=elem->next;
@@ -3578,7 +3636,9 @@ void linphone_core_iterate(LinphoneCore *lc){
 	time_t current_real_time = ms_time(NULL);
 	int64_t diff_time;
 	bool one_second_elapsed = false;
+	LinphoneIterateTimer timer;
 
+	linphone_iterate_timer_start(lc, &timer);
 	if (lc->prevtime_ms == 0){
 		lc->prevtime_ms = curtime_ms;
 	}
@@ -3619,15 +3679,21 @@ void linphone_core_iterate(LinphoneCore *lc){
 	}
 
 	lc->sal->iterate();
+	linphone_iterate_timer_lap(&timer, LinphoneIterateStepSal);
 	if (lc->msevq) ms_event_queue_pump(lc->msevq);
-	if (linphone_core_get_global_state(lc) == LinphoneGlobalConfiguring)
+	linphone_iterate_timer_lap(&timer, LinphoneIterateStepEventQueue);
+	if (linphone_core_get_global_state(lc) == LinphoneGlobalConfiguring) {
 		// Avoid registration before getting remote configuration results
+		linphone_iterate_timer_stop(lc, &timer);
 		return;
+	}
 
-	proxy_update(lc);
+	proxy_update(lc, one_second_elapsed);
+	linphone_iterate_timer_lap(&timer, LinphoneIterateStepProxyUpdate);
 
 	/* We have to iterate for each call */
 	L_GET_PRIVATE_FROM_C_OBJECT(lc)->iterateCalls(current_real_time, one_second_elapsed);
+	linphone_iterate_timer_lap(&timer, LinphoneIterateStepCalls);
 
 	if (linphone_core_video_preview_enabled(lc)){
 		if (lc->previewstream==NULL && !L_GET_PRIVATE_FROM_C_OBJECT(lc)->hasCalls())
@@ -3639,26 +3705,32 @@ void linphone_core_iterate(LinphoneCore *lc){
 		if (lc->previewstream!=NULL)
 			toggle_video_preview(lc,FALSE);
 	}
+	linphone_iterate_timer_lap(&timer, LinphoneIterateStepVideoPreview);
 
 	linphone_core_run_hooks(lc);
+	linphone_iterate_timer_lap(&timer, LinphoneIterateStepHooks);
 	linphone_core_do_plugin_tasks(lc);
+	linphone_iterate_timer_lap(&timer, LinphoneIterateStepPluginTasks);
 
 	if (lc->sip_network_state.global_state && lc->netup_time!=0 && (current_real_time-lc->netup_time)>=2){
 		/*not do that immediately, take your time.*/
 		linphone_core_send_initial_subscribes(lc);
 	}
+	linphone_iterate_timer_lap(&timer, LinphoneIterateStepSubscribes);
 
 	if (one_second_elapsed) {
 		bctbx_list_t *elem = NULL;
 		if (lp_config_needs_commit(lc->config)) {
 			lp_config_sync(lc->config);
 		}
+		linphone_iterate_timer_lap(&timer, LinphoneIterateStepConfigSync);
 		for (elem = lc->friends_lists; elem != NULL; elem = bctbx_list_next(elem)) {
 			LinphoneFriendList *list = (LinphoneFriendList *)elem->data;
 			if (list->dirty_friends_to_update) {
 				linphone_friend_list_update_dirty_friends(list);
 			}
 		}
+		linphone_iterate_timer_lap(&timer, LinphoneIterateStepFriendLists);
 	}
 
 	if (liblinphone_serialize_logs == TRUE) {
@@ -3670,6 +3742,8 @@ void linphone_core_iterate(LinphoneCore *lc){
 			_linphone_core_stop_async_end(lc);
 		}
 	}
+
+	linphone_iterate_timer_stop(lc, &timer);
 }
 
 LinphoneAddress * linphone_core_interpret_url(LinphoneCore *lc, const char *url){
@@ -3787,7 +3861,8 @@ LinphoneProxyConfig * linphone_core_lookup_proxy_by_identity(LinphoneCore *lc, c
 }
 
 LinphoneProxyConfig * linphone_core_lookup_known_proxy(LinphoneCore *lc, const LinphoneAddress *uri){
-	const bctbx_list_t *elem;
+	bctbx_map_t *proxies_index;
+	bctbx_iterator_t *it, *it_end;
 	LinphoneProxyConfig *found_cfg=NULL;
 	LinphoneProxyConfig *found_reg_cfg=NULL;
 	LinphoneProxyConfig *found_noreg_cfg=NULL;
@@ -3811,20 +3886,25 @@ LinphoneProxyConfig * linphone_core_lookup_known_proxy(LinphoneCore *lc, const L
 	}
 
 	/*otherwise return first registered, then first registering matching, otherwise first matching */
-	for (elem=linphone_core_get_proxy_config_list(lc);elem!=NULL;elem=elem->next){
-		LinphoneProxyConfig *cfg=(LinphoneProxyConfig*)elem->data;
-		const char *domain=linphone_proxy_config_get_domain(cfg);
-		if (domain!=NULL && strcmp(domain,linphone_address_get_domain(uri))==0){
-			if (linphone_proxy_config_get_state(cfg) == LinphoneRegistrationOk ){
-				found_cfg=cfg;
-				break;
-			} else if (!found_reg_cfg && linphone_proxy_config_register_enabled(cfg)) {
-				found_reg_cfg=cfg;
-			} else if (!found_noreg_cfg){
-				found_noreg_cfg=cfg;
-			}
+	proxies_index = linphone_core_get_proxy_configs_by_domain(lc);
+	it = bctbx_map_cchar_find_key(proxies_index, linphone_address_get_domain(uri));
+	it_end = bctbx_map_cchar_end(proxies_index);
+	for (; !bctbx_iterator_cchar_equals(it, it_end); it = bctbx_iterator_cchar_get_next(it)){
+		bctbx_pair_t *pair = bctbx_iterator_cchar_get_pair(it);
+		const char *domain = bctbx_pair_cchar_get_first(reinterpret_cast<bctbx_pair_cchar_t *>(pair));
+		LinphoneProxyConfig *cfg=(LinphoneProxyConfig*)bctbx_pair_cchar_get_second(pair);
+		if (strcmp(domain,linphone_address_get_domain(uri))!=0) break;
+		if (linphone_proxy_config_get_state(cfg) == LinphoneRegistrationOk ){
+			found_cfg=cfg;
+			break;
+		} else if (!found_reg_cfg && linphone_proxy_config_register_enabled(cfg)) {
+			found_reg_cfg=cfg;
+		} else if (!found_noreg_cfg){
+			found_noreg_cfg=cfg;
 		}
 	}
+	bctbx_iterator_cchar_delete(it);
+	bctbx_iterator_cchar_delete(it_end);
 end:
 	if     ( !found_cfg && found_reg_cfg)    found_cfg = found_reg_cfg;
 	else if( !found_cfg && found_noreg_cfg ) found_cfg = found_noreg_cfg;
@@ -4093,6 +4173,35 @@ const bctbx_list_t *linphone_core_get_calls(LinphoneCore *lc) {
 	return lc->callsCache;
 }
 
+LinphoneStatus linphone_core_dump_calls_stats_history(LinphoneCore *lc, const char *path) {
+	static const LinphoneStreamType types[] = { LinphoneStreamTypeAudio, LinphoneStreamTypeVideo, LinphoneStreamTypeText };
+	const bctbx_list_t *elem;
+	FILE *f = fopen(path, "w");
+
+	if (!f) {
+		ms_error("Cannot open [%s] to dump calls stats history", path);
+		return -1;
+	}
+	fprintf(f, "call_id,stream,time,receiver_interarrival_jitter,receiver_loss_rate,round_trip_delay,download_bandwidth,upload_bandwidth,jitter_buffer_size_ms\n");
+	for (elem = linphone_core_get_calls(lc); elem != NULL; elem = elem->next) {
+		LinphoneCall *call = (LinphoneCall *)elem->data;
+		const char *call_id = linphone_call_log_get_call_id(linphone_call_get_call_log(call));
+		size_t i;
+		for (i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+			unsigned int count = linphone_call_get_stats_history_size(call, types[i]);
+			unsigned int j;
+			for (j = 0; j < count; j++) {
+				const LinphoneCallStatsSample *sample = linphone_call_get_stats_history_sample(call, types[i], j);
+				fprintf(f, "%s,%s,%llu,%f,%f,%f,%f,%f,%f\n", call_id ? call_id : "", linphone_stream_type_to_string(types[i]),
+					(unsigned long long)sample->time, sample->receiver_interarrival_jitter, sample->receiver_loss_rate,
+					sample->round_trip_delay, sample->download_bandwidth, sample->upload_bandwidth, sample->jitter_buffer_size_ms);
+			}
+		}
+	}
+	fclose(f);
+	return 0;
+}
+
 bool_t linphone_core_in_call(const LinphoneCore *lc){
 	return linphone_core_get_current_call((LinphoneCore *)lc)!=NULL || linphone_core_is_in_conference(lc);
 }
@@ -6037,6 +6146,14 @@ void linphone_core_set_mtu(LinphoneCore *lc, int mtu){
 	}else ms_factory_set_mtu(lc->factory, 0);//use mediastreamer2 default value
 }
 
+unsigned int linphone_core_get_route_cache_hit_count(const LinphoneCore *lc){
+	return L_GET_PRIVATE_FROM_C_OBJECT(lc)->getRouteCache().getHitCount();
+}
+
+unsigned int linphone_core_get_route_cache_miss_count(const LinphoneCore *lc){
+	return L_GET_PRIVATE_FROM_C_OBJECT(lc)->getRouteCache().getMissCount();
+}
+
 void linphone_core_set_waiting_callback(LinphoneCore *lc, LinphoneCoreWaitingCallback cb, void *user_context){
 	lc->wait_cb=cb;
 	lc->wait_ctx=user_context;
@@ -6139,15 +6256,24 @@ void sip_config_uninit(LinphoneCore *lc)
 		if (i>=20) ms_warning("Cannot complete unregistration, giving up");
 	}
 
+	config->register_queue=bctbx_list_free(config->register_queue);
 	elem = config->proxies;
 	config->proxies=NULL; /*to make sure proxies cannot be referenced during deletion*/
 	bctbx_list_free_with_data(elem,(void (*)(void*)) _linphone_proxy_config_release);
 
 	config->deleted_proxies=bctbx_list_free_with_data(config->deleted_proxies,(void (*)(void*)) _linphone_proxy_config_release);
+	if (config->proxies_by_domain) {
+		bctbx_mmap_cchar_delete(config->proxies_by_domain);
+		config->proxies_by_domain = NULL;
+	}
 
 	/*no longuer need to write proxy config if not changed linphone_proxy_config_write_to_config_file(lc->config,NULL,i);*/	/*mark the end */
 
 	lc->auth_info=bctbx_list_free_with_data(lc->auth_info,(void (*)(void*))linphone_auth_info_unref);
+	if (lc->auth_info_by_username) {
+		bctbx_mmap_cchar_delete(lc->auth_info_by_username);
+		lc->auth_info_by_username = NULL;
+	}
 	lc->default_proxy = NULL;
 
 	if (lc->vcard_context) {
@@ -6347,6 +6473,7 @@ LinphoneXmlRpcSession * linphone_core_create_xml_rpc_session(LinphoneCore *lc, c
  * Called by linphone_core_stop_async() to begin the async stop process and change the state to "Shutdown"
  */
 static void _linphone_core_stop_async_start(LinphoneCore *lc) {
+	linphone_reporting_stop(lc);
 	linphone_task_list_free(&lc->hooks);
 	lc->video_conf.show_local = FALSE;
 	lc->async_stop = TRUE;
@@ -6448,6 +6575,7 @@ static void _linphone_core_stop_async_end(LinphoneCore *lc) {
 	linphone_core_call_log_storage_close(lc);
 	linphone_core_friends_storage_close(lc);
 	linphone_core_zrtp_cache_close(lc);
+	linphone_reporting_uninit(lc);
 	ms_bandwidth_controller_destroy(lc->bw_controller);
 	lc->bw_controller = NULL;
 	ms_factory_destroy(lc->factory);
@@ -6462,6 +6590,7 @@ static void _linphone_core_stop(LinphoneCore *lc) {
 	bctbx_list_t *elem = NULL;
 	int i=0;
 	bool_t wait_until_unsubscribe = FALSE;
+	linphone_reporting_stop(lc);
 	linphone_task_list_free(&lc->hooks);
 	lc->video_conf.show_local = FALSE;
 	lc->async_stop = FALSE;
@@ -6565,6 +6694,7 @@ static void _linphone_core_stop(LinphoneCore *lc) {
 	linphone_core_call_log_storage_close(lc);
 	linphone_core_friends_storage_close(lc);
 	linphone_core_zrtp_cache_close(lc);
+	linphone_reporting_uninit(lc);
 	ms_bandwidth_controller_destroy(lc->bw_controller);
 	lc->bw_controller = NULL;
 	ms_factory_destroy(lc->factory);
@@ -6602,6 +6732,11 @@ void _linphone_core_uninit(LinphoneCore *lc)
 
 	linphone_core_deactivate_log_serialization_if_needed();
 	bctbx_list_free_with_data(lc->vtable_refs,(void (*)(void *))v_table_reference_destroy);
+	_linphone_core_free_vtable_index(lc);
+	if (lc->iterate_stats) {
+		linphone_iterate_stats_unref(lc->iterate_stats);
+		lc->iterate_stats = NULL;
+	}
 	bctbx_uninit_logger();
 }
 
@@ -6614,6 +6749,7 @@ static void stop_refreshing_proxy_config(bool_t is_sip_reachable, LinphoneProxyC
 			cfg->commit=TRUE;
 			if (linphone_proxy_config_publish_enabled(cfg))
 				cfg->send_publish=TRUE; /*not sure if really the best place*/
+			linphone_core_schedule_proxy_update(cfg->lc);
 		}
 	}
 }
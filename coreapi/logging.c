@@ -27,6 +27,7 @@
 #include "linphone/logging.h"
 
 #include "c-wrapper/c-wrapper.h"
+#include "logger/logger.h"
 #include "logging-private.h"
 
 
@@ -259,6 +260,14 @@ void linphone_logging_service_set_log_file(const LinphoneLoggingService *service
 	bctbx_add_log_handler(log_handler);
 }
 
+void linphone_logging_service_enable_async_sink(LinphoneLoggingService *log_service, bool_t enable) {
+	LinphonePrivate::Logger::enableAsyncSink(!!enable);
+}
+
+bool_t linphone_logging_service_async_sink_enabled(const LinphoneLoggingService *log_service) {
+	return LinphonePrivate::Logger::asyncSinkEnabled() ? TRUE : FALSE;
+}
+
 BELLE_SIP_INSTANCIATE_VPTR(LinphoneLoggingService, belle_sip_object_t,
 	_linphone_logging_service_uninit, // uninit
 	NULL,                         // clone
@@ -35,6 +35,7 @@
 
 #define MAX_LEN 16384
 
+#include "bctoolbox/map.h"
 #include "bctoolbox/vfs.h"
 #include "belle-sip/object.h"
 #include "xml2lpc.h"
@@ -101,6 +102,7 @@ struct _LpConfig{
 	char *tmpfilename;
 	char *factory_filename;
 	bctbx_list_t *sections;
+	bctbx_map_t *sections_by_name; /* index of sections, holding the first section added for a given name first */
 	bool_t modified;
 	bool_t readonly;
 	bctbx_vfs_t* g_bctbx_vfs;
@@ -185,6 +187,8 @@ void lp_section_add_item(LpSection *sec,LpItem *item){
 
 void linphone_config_add_section(LpConfig *lpconfig, LpSection *section){
 	lpconfig->sections=bctbx_list_append(lpconfig->sections,(void *)section);
+	if (!lpconfig->sections_by_name) lpconfig->sections_by_name=bctbx_mmap_cchar_new();
+	bctbx_map_cchar_insert_and_delete(lpconfig->sections_by_name,(bctbx_pair_t*)bctbx_pair_cchar_new(section->name,section));
 }
 
 void linphone_config_add_section_param(LpSection *section, LpSectionParam *param){
@@ -193,6 +197,21 @@ void linphone_config_add_section_param(LpSection *section, LpSectionParam *param
 
 void linphone_config_remove_section(LpConfig *lpconfig, LpSection *section){
 	lpconfig->sections=bctbx_list_remove(lpconfig->sections,(void *)section);
+	if (lpconfig->sections_by_name){
+		bctbx_iterator_t *it=bctbx_map_cchar_find_key(lpconfig->sections_by_name,section->name);
+		bctbx_iterator_t *end=bctbx_map_cchar_end(lpconfig->sections_by_name);
+		while (!bctbx_iterator_cchar_equals(it,end)){
+			bctbx_pair_t *pair=bctbx_iterator_cchar_get_pair(it);
+			if (strcmp(bctbx_pair_cchar_get_first((bctbx_pair_cchar_t*)pair),section->name)!=0) break;
+			if (bctbx_pair_cchar_get_second(pair)==section){
+				bctbx_map_cchar_erase(lpconfig->sections_by_name,it);
+				break;
+			}
+			it=bctbx_iterator_cchar_get_next(it);
+		}
+		bctbx_iterator_cchar_delete(it);
+		bctbx_iterator_cchar_delete(end);
+	}
 	lp_section_destroy(section);
 }
 
@@ -218,17 +237,17 @@ static int is_a_comment(const char *str){
 }
 
 LpSection *linphone_config_find_section(const LpConfig *lpconfig, const char *name){
-	LpSection *sec;
-	bctbx_list_t *elem = lpconfig->sections;
-	/*printf("Looking for section %s\n",name);*/
-	for (;elem!=NULL;elem=bctbx_list_next(elem)){
-		sec=(LpSection*)elem->data;
-		if (strcmp(sec->name,name)==0){
-			/*printf("Section %s found\n",name);*/
-			return sec;
-		}
-	}
-	return NULL;
+	LpSection *sec=NULL;
+	bctbx_iterator_t *it;
+	bctbx_iterator_t *end;
+	if (!lpconfig->sections_by_name) return NULL;
+	it=bctbx_map_cchar_find_key(lpconfig->sections_by_name,name);
+	end=bctbx_map_cchar_end(lpconfig->sections_by_name);
+	if (!bctbx_iterator_cchar_equals(it,end))
+		sec=(LpSection*)bctbx_pair_cchar_get_second(bctbx_iterator_cchar_get_pair(it));
+	bctbx_iterator_cchar_delete(it);
+	bctbx_iterator_cchar_delete(end);
+	return sec;
 }
 
 LpSectionParam *lp_section_find_param(const LpSection *sec, const char *key){
@@ -587,6 +606,7 @@ static void _linphone_config_uninit(LpConfig *lpconfig){
 	if (lpconfig->factory_filename) bctbx_free(lpconfig->factory_filename);
 	bctbx_list_for_each(lpconfig->sections,(void (*)(void*))lp_section_destroy);
 	bctbx_list_free(lpconfig->sections);
+	if (lpconfig->sections_by_name) bctbx_mmap_cchar_delete(lpconfig->sections_by_name);
 }
 
 LpConfig *linphone_config_ref(LpConfig *lpconfig){
@@ -24,6 +24,37 @@
 
 #include "utils/payload-type-handler.h"
 
+#include <cctype>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+ * Local payload types indexed by mime type (case insensitive), clock rate and channels.
+ * It is built once per negotiated stream so that matching a remote payload type is a lookup
+ * instead of a walk of the local list.
+ */
+typedef std::unordered_map<std::string, PayloadType *> PayloadTypeIndex;
+
+static std::string payload_type_index_key(const char *mime_type, int clock_rate, int channels){
+	std::string key(mime_type);
+	for (auto &c : key) c = (char)tolower((unsigned char)c);
+	key += '/';
+	key += std::to_string(clock_rate);
+	key += '/';
+	key += std::to_string(channels);
+	return key;
+}
+
+static void payload_type_index_build(PayloadTypeIndex &index, const bctbx_list_t *payloads){
+	for (; payloads != NULL; payloads = payloads->next){
+		PayloadType *pt = (PayloadType *)payloads->data;
+		if (!pt->mime_type) continue;
+		/* The first payload type of the list wins, like when walking it. */
+		index.emplace(payload_type_index_key(pt->mime_type, pt->clock_rate, pt->channels), pt);
+	}
+}
+
 static bool_t only_telephone_event(const bctbx_list_t *l){
 	for(;l!=NULL;l=l->next){
 		PayloadType *p=(PayloadType*)l->data;
@@ -134,20 +165,10 @@ MSOfferAnswerProvider red_offer_answer_provider={
 	red_offer_answer_create_context
 };
 
-static PayloadType * generic_match(const bctbx_list_t *local_payloads, const PayloadType *refpt, const bctbx_list_t *remote_payloads){
-	PayloadType *pt;
-	const bctbx_list_t *elem;
-
-	for (elem=local_payloads;elem!=NULL;elem=elem->next){
-		pt=(PayloadType*)elem->data;
-		
-		if ( pt->mime_type && refpt->mime_type 
-			&& strcasecmp(pt->mime_type, refpt->mime_type)==0
-			&& pt->clock_rate==refpt->clock_rate
-			&& pt->channels==refpt->channels)
-			return payload_type_clone(pt);
-	}
-	return NULL;
+static PayloadType * generic_match(const PayloadTypeIndex &local_index, const PayloadType *refpt){
+	if (!refpt->mime_type) return NULL;
+	auto it = local_index.find(payload_type_index_key(refpt->mime_type, refpt->clock_rate, refpt->channels));
+	return (it != local_index.end()) ? payload_type_clone(it->second) : NULL;
 }
 
 
@@ -161,8 +182,8 @@ void linphone_core_register_offer_answer_providers(LinphoneCore *lc){
 /*
  * Returns a PayloadType from the local list that matches a PayloadType offered or answered in the remote list
 */
-static PayloadType * find_payload_type_best_match(MSFactory *factory, const bctbx_list_t *local_payloads, const PayloadType *refpt,
-						  const bctbx_list_t *remote_payloads, bool_t reading_response){
+static PayloadType * find_payload_type_best_match(MSFactory *factory, const bctbx_list_t *local_payloads, const PayloadTypeIndex &local_index,
+						  const PayloadType *refpt, const bctbx_list_t *remote_payloads, bool_t reading_response){
 	PayloadType *ret = NULL;
 	MSOfferAnswerContext *ctx = NULL;
 
@@ -173,7 +194,7 @@ static PayloadType * find_payload_type_best_match(MSFactory *factory, const bctb
 		ms_offer_answer_context_destroy(ctx);
 		return ret;
 	}
-	return generic_match(local_payloads, refpt, remote_payloads);
+	return generic_match(local_index, refpt);
 }
 
 
@@ -182,10 +203,12 @@ static bctbx_list_t *match_payloads(MSFactory *factory, const bctbx_list_t *loca
 	bctbx_list_t *res=NULL;
 	PayloadType *matched;
 	bool_t found_codec=FALSE;
+	PayloadTypeIndex local_index;
 
+	payload_type_index_build(local_index, local);
 	for(e2=remote;e2!=NULL;e2=e2->next){
 		PayloadType *p2=(PayloadType*)e2->data;
-		matched=find_payload_type_best_match(factory, local, p2, remote, reading_response);
+		matched=find_payload_type_best_match(factory, local, local_index, p2, remote, reading_response);
 		if (matched){
 			int local_number=payload_type_get_number(matched);
 			int remote_number=payload_type_get_number(p2);
@@ -240,17 +263,14 @@ static bctbx_list_t *match_payloads(MSFactory *factory, const bctbx_list_t *loca
 	}
 	if (reading_response){
 		/* add remaning local payload as CAN_RECV only so that if we are in front of a non-compliant equipment we are still able to decode the RTP stream*/
+		/* Numbers of the payloads of res, including the unnumbered ones (-1) which are compared like the others. */
+		std::unordered_set<int> used_numbers;
+		for(e2=res;e2!=NULL;e2=e2->next)
+			used_numbers.insert(payload_type_get_number((PayloadType*)e2->data));
 		for(e1=local;e1!=NULL;e1=e1->next){
 			PayloadType *p1=(PayloadType*)e1->data;
-			bool_t found=FALSE;
-			for(e2=res;e2!=NULL;e2=e2->next){
-				PayloadType *p2=(PayloadType*)e2->data;
-				if (payload_type_get_number(p2)==payload_type_get_number(p1)){
-					found=TRUE;
-					break;
-				}
-			}
-			if (!found){
+			int number=payload_type_get_number(p1);
+			if (used_numbers.insert(number).second){
 				ms_message("Adding %s/%i for compatibility, just in case.",p1->mime_type,p1->clock_rate);
 				p1=payload_type_clone(p1);
 				payload_type_set_flag(p1, PAYLOAD_TYPE_FLAG_CAN_RECV);
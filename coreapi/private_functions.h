@@ -137,6 +137,11 @@ int linphone_proxy_config_send_publish(LinphoneProxyConfig *cfg, LinphonePresenc
 void linphone_proxy_config_set_state(LinphoneProxyConfig *cfg, LinphoneRegistrationState rstate, const char *message);
 void linphone_proxy_config_stop_refreshing(LinphoneProxyConfig *obj);
 void linphone_proxy_config_write_all_to_config_file(LinphoneCore *lc);
+void linphone_proxy_config_write_to_config_file_if_listed(LinphoneProxyConfig *cfg);
+void linphone_core_schedule_proxy_update(LinphoneCore *lc);
+void linphone_core_invalidate_proxy_configs_index(LinphoneCore *lc);
+bctbx_map_t *linphone_core_get_proxy_configs_by_domain(LinphoneCore *lc);
+void linphone_core_process_register_queue(LinphoneCore *lc);
 void _linphone_proxy_config_release(LinphoneProxyConfig *cfg);
 void _linphone_proxy_config_unpublish(LinphoneProxyConfig *obj);
 void linphone_proxy_config_notify_publish_state_changed(LinphoneProxyConfig *cfg, LinphonePublishState state);
@@ -186,6 +191,8 @@ void _linphone_friend_list_update_subscriptions(LinphoneFriendList *list, Linpho
 void linphone_core_friends_storage_init(LinphoneCore *lc);
 void linphone_core_friends_storage_close(LinphoneCore *lc);
 void linphone_core_store_friend_in_db(LinphoneCore *lc, LinphoneFriend *lf);
+void linphone_core_begin_friends_db_transaction(LinphoneCore *lc);
+void linphone_core_end_friends_db_transaction(LinphoneCore *lc);
 void linphone_core_remove_friend_from_db(LinphoneCore *lc, LinphoneFriend *lf);
 void linphone_core_store_friends_list_in_db(LinphoneCore *lc, LinphoneFriendList *list);
 void linphone_core_remove_friends_list_from_db(LinphoneCore *lc, LinphoneFriendList *list);
@@ -261,6 +268,9 @@ void _linphone_call_stats_set_ip_family_of_remote (LinphoneCallStats *stats, Lin
 // FIXME: Remove this declaration, use LINPHONE_PUBLIC as ugly workaround, already defined in tester_utils.h
 LINPHONE_PUBLIC bool_t _linphone_call_stats_rtcp_received_via_mux (const LinphoneCallStats *stats);
 
+// FIXME: Remove this declaration, use LINPHONE_PUBLIC as ugly workaround, already defined in tester_utils.h
+LINPHONE_PUBLIC bool_t _linphone_call_stats_has_received_rtcp (const LinphoneCallStats *stats);
+
 bool_t linphone_core_media_description_contains_video_stream(const SalMediaDescription *md);
 
 void linphone_core_send_initial_subscribes(LinphoneCore *lc);
@@ -343,6 +353,8 @@ void _linphone_chat_message_notify_ephemeral_message_timer_started(LinphoneChatM
 void _linphone_chat_message_notify_ephemeral_message_deleted(LinphoneChatMessage* msg);
 void _linphone_chat_message_clear_callbacks (LinphoneChatMessage *msg);
 
+void _linphone_buffer_reuse_content(LinphoneBuffer *buffer, const uint8_t *content, size_t size);
+
 
 const LinphoneParticipantImdnState *_linphone_participant_imdn_state_from_cpp_obj (const LinphonePrivate::ParticipantImdnState &state);
 
@@ -556,7 +568,8 @@ bool_t linphone_core_dtmf_received_has_listener(const LinphoneCore* lc);
 void linphone_core_notify_refer_received(LinphoneCore *lc, const char *refer_to);
 void linphone_core_notify_buddy_info_updated(LinphoneCore *lc, LinphoneFriend *lf);
 void linphone_core_notify_transfer_state_changed(LinphoneCore *lc, LinphoneCall *transfered, LinphoneCallState new_call_state);
-void linphone_core_notify_call_stats_updated(LinphoneCore *lc, LinphoneCall *call, const LinphoneCallStats *stats);
+// FIXME: Remove this declaration, use LINPHONE_PUBLIC as ugly workaround, already defined in tester_utils.h
+LINPHONE_PUBLIC void linphone_core_notify_call_stats_updated(LinphoneCore *lc, LinphoneCall *call, const LinphoneCallStats *stats);
 void linphone_core_notify_info_received(LinphoneCore *lc, LinphoneCall *call, const LinphoneInfoMessage *msg);
 void linphone_core_notify_configuring_status(LinphoneCore *lc, LinphoneConfiguringState status, const char *message);
 void linphone_core_notify_network_reachable(LinphoneCore *lc, bool_t reachable);
@@ -598,6 +611,12 @@ void ** linphone_content_get_cryptoContext_address(LinphoneContent *content);
 
 void v_table_reference_destroy(VTableReference *ref);
 
+void linphone_iterate_timer_start(const LinphoneCore *lc, LinphoneIterateTimer *timer);
+void linphone_iterate_timer_lap(LinphoneIterateTimer *timer, LinphoneIterateStep step);
+void linphone_iterate_timer_stop(LinphoneCore *lc, LinphoneIterateTimer *timer);
+void _linphone_core_free_vtable_index(LinphoneCore *lc);
+void _linphone_core_cbs_vtable_changed(void);
+
 LINPHONE_PUBLIC void _linphone_core_add_callbacks(LinphoneCore *lc, LinphoneCoreCbs *vtable, bool_t internal);
 
 MSWebCam *get_nowebcam_device(MSFactory *f);
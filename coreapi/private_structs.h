@@ -103,6 +103,9 @@ struct _LinphoneProxyConfig
 	char *type;
 	struct _SipSetupContext *ssctx;
 	int auth_failures;
+	int register_failures; /* consecutive failed registrations, used to back off scheduled REGISTERs */
+	uint64_t register_queued_time; /* when the REGISTER was put in the registration queue, in ms */
+	uint64_t register_not_before; /* earliest time the queued REGISTER may be sent, in ms */
 	char *dial_prefix;
 	LinphoneRegistrationState state;
 	LinphoneAVPFMode avpf_mode;
@@ -120,6 +123,7 @@ struct _LinphoneProxyConfig
 	bool_t quality_reporting_enabled;
 	uint8_t avpf_rr_interval;
 	bool_t register_changed;
+	bool_t register_queued;
 
 	time_t deletion_date;
 	LinphonePrivacyMask privacy;
@@ -211,6 +215,7 @@ struct _LinphoneFriendList {
 	char *uri;
 	MSList *dirty_friends_to_update;
 	int revision;
+	char *sync_token;
 	LinphoneFriendListCbs *cbs; // Deprecated, use a list of Cbs instead
 	bctbx_list_t *callbacks;
 	LinphoneFriendListCbs *currentCbs;
@@ -226,6 +231,18 @@ struct sip_config
 	char *guessed_contact;
 	MSList *proxies;
 	MSList *deleted_proxies;
+	bctbx_map_t *proxies_by_domain; /* proxies indexed by identity domain, rebuilt lazily when proxies_index_dirty is set */
+	MSList *register_queue; /* proxies waiting for their REGISTER to be sent, sorted by register_not_before */
+	int register_rate_limit; /* max REGISTERs sent per second by the registration queue, 0 for unlimited */
+	int register_burst; /* number of REGISTERs that can be sent at once before register_rate_limit applies */
+	int register_jitter; /* max random delay in ms added to a queued REGISTER */
+	int register_backoff; /* base delay in ms added to a REGISTER after a failure, doubled on each consecutive failure */
+	int register_backoff_max; /* max backoff delay in ms, 0 for no limit */
+	float register_tokens;
+	uint64_t register_tokens_time;
+	unsigned int registers_scheduled; /* REGISTERs sent through the registration queue */
+	uint64_t register_queue_latency_total; /* cumulated time spent in the registration queue, in ms */
+	uint64_t register_queue_latency_max;
 	int inc_timeout;	/*timeout after an un-answered incoming call is rejected*/
 	int in_call_timeout;	/*timeout after a call is hangup */
 	int delayed_timeout; 	/*timeout after a delayed call is resumed */
@@ -242,6 +259,8 @@ struct sip_config
 	bool_t tcp_tls_keepalive;
 	bool_t vfu_with_info; /*use to enable vfu request using sip info*/
 	bool_t save_auth_info; // if true, auth infos will be write in the config file when they are added to the list
+	bool_t proxies_index_dirty;
+	bool_t proxies_update_pending; // if true, proxy configs have a registration or publish to (re)send at next iteration
 };
 
 struct rtp_config
@@ -469,6 +488,7 @@ struct _LinphoneBuffer {
 	void *user_data;
 	uint8_t *content;	/**< A pointer to the buffer content */
 	size_t size;	/**< The size of the buffer content */
+	size_t capacity;	/**< The size of the memory allocated for the buffer content */
 };
 
 BELLE_SIP_DECLARE_VPTR_NO_EXPORT(LinphoneBuffer);
@@ -561,6 +581,8 @@ BELLE_SIP_DECLARE_VPTR_NO_EXPORT(LinphoneXmlRpcSession);
 struct _LinphoneCardDavContext {
 	LinphoneFriendList *friend_list;
 	int ctag;
+	char *sync_token; /* The one of the last synchronization, sent in sync-collection reports */
+	char *new_sync_token; /* The one given by the server, saved when the synchronization succeeds */
 	void *user_data;
 	LinphoneCardDavContactCreatedCb contact_created_cb;
 	LinphoneCardDavContactUpdatedCb contact_updated_cb;
@@ -585,6 +607,7 @@ struct _LinphoneCardDavResponse {
 	char *etag;
 	char *url;
 	char *vcard;
+	bool_t removed;
 };
 
 
@@ -695,6 +718,7 @@ BELLE_SIP_DECLARE_VPTR_NO_EXPORT(LinphoneVideoActivationPolicy);
 
 struct _VTableReference{
 	LinphoneCoreCbs *cbs;
+	unsigned int order; /*creation order, used to notify listeners added while dispatching*/
 	bool_t valid;
 	bool_t autorelease;
 	bool_t internal;
@@ -726,6 +750,34 @@ struct _LinphoneVideoDefinition {
 
 BELLE_SIP_DECLARE_VPTR_NO_EXPORT(LinphoneVideoDefinition);
 
+/* Log-linear histogram of durations in microseconds: values below 16 have their own bucket,
+above each power of two is split in 16 buckets, giving a relative precision of about 6%. */
+#define LINPHONE_ITERATE_HISTOGRAM_SUB_BUCKET_BITS 4
+#define LINPHONE_ITERATE_HISTOGRAM_SIZE ((32 - LINPHONE_ITERATE_HISTOGRAM_SUB_BUCKET_BITS + 1) << LINPHONE_ITERATE_HISTOGRAM_SUB_BUCKET_BITS)
+
+typedef struct _LinphoneIterateHistogram {
+	uint64_t count;
+	uint64_t sum;
+	uint32_t max;
+	uint32_t buckets[LINPHONE_ITERATE_HISTOGRAM_SIZE];
+} LinphoneIterateHistogram;
+
+struct _LinphoneIterateStats {
+	belle_sip_object_t base;
+	LinphoneIterateHistogram histograms[LinphoneIterateStepCount];
+	unsigned int over_budget_count;
+};
+
+BELLE_SIP_DECLARE_VPTR_NO_EXPORT(LinphoneIterateStats);
+
+struct _LinphoneIterateTimer {
+	uint64_t start;
+	uint64_t last;
+	uint32_t durations[LinphoneIterateStepCount];
+	unsigned int measured_steps; /* bit mask of the steps run during the iteration */
+	bool_t enabled;
+};
+
 struct _LinphoneUpdateCheck {
 	LinphoneCore *lc;
 	char* current_version;
@@ -739,6 +791,7 @@ namespace LinphonePrivate {
 #define LINPHONE_CORE_STRUCT_BASE_FIELDS \
 	MSFactory* factory; \
 	MSList* vtable_refs; \
+	VTableIndex *vtable_index; \
 	int vtable_notify_recursion; \
 	LinphonePrivate::Sal *sal; \
 	void *platform_helper; \
@@ -759,6 +812,7 @@ namespace LinphonePrivate {
 	LinphoneProxyConfig *default_proxy; \
 	MSList *friends_lists; \
 	MSList *auth_info; \
+	bctbx_map_t *auth_info_by_username; \
 	struct _RingStream *ringstream; \
 	LCCallbackObj preview_finished_cb; \
 	MSList *queued_calls; \
@@ -838,7 +892,10 @@ namespace LinphonePrivate {
 	bool_t dns_set_by_app; \
 	int auto_download_incoming_files_max_size; \
 	bool_t sender_name_hidden_in_forward_message; \
-	bool_t async_stop;
+	bool_t async_stop; \
+	LinphoneIterateStats *iterate_stats; \
+	int iterate_budget_ms; \
+	struct reporting_aggregator *reporting_aggregator;
 
 #define LINPHONE_CORE_STRUCT_FIELDS \
 	LINPHONE_CORE_STRUCT_BASE_FIELDS \
@@ -846,6 +903,11 @@ namespace LinphonePrivate {
 	bctbx_mutex_t zrtp_cache_db_mutex; \
 	sqlite3 *logs_db; \
 	sqlite3 *friends_db; \
+	sqlite3_stmt *friends_db_insert_stmt; \
+	sqlite3_stmt *friends_db_update_stmt; \
+	int friends_db_transaction_depth; \
+	unsigned int friends_db_rows_written; \
+	uint64_t friends_db_write_time; \
 	bool_t debug_storage; \
 	void *system_context; \
 	bool_t is_unreffing;
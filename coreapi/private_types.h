@@ -63,6 +63,10 @@ typedef struct _xmlparsing_context xmlparsing_context_t;
 
 typedef struct _VTableReference  VTableReference;
 
+typedef struct _VTableIndex VTableIndex;
+
+typedef struct _LinphoneIterateTimer LinphoneIterateTimer;
+
 typedef struct _EchoTester EchoTester;
 
 typedef struct _LinphoneXmlRpcArg LinphoneXmlRpcArg;
@@ -33,6 +33,7 @@
  */
 
 #include <ctype.h>
+#include <limits.h>
 
 #include <bctoolbox/defs.h>
 #include "linphone/core_utils.h"
@@ -131,6 +132,103 @@ void linphone_proxy_config_write_all_to_config_file(LinphoneCore *lc){
 	lp_config_set_int(lc->config,"sip","default_proxy",linphone_core_get_default_proxy_config_index(lc));
 }
 
+/* rewrite only the given proxy config, its index in the config file is its position in the proxy list */
+void linphone_proxy_config_write_to_config_file_if_listed(LinphoneProxyConfig *cfg){
+	LinphoneCore *lc=cfg->lc;
+	const bctbx_list_t *elem;
+	int i;
+	if (!lc || !linphone_core_ready(lc)) return;
+
+	for(elem=lc->sip_conf.proxies,i=0;elem!=NULL;elem=bctbx_list_next(elem),i++){
+		if (elem->data==cfg) break;
+	}
+	if (!elem) return;
+	linphone_proxy_config_write_to_config_file(lc->config,cfg,i);
+	if (elem->next==NULL) linphone_proxy_config_write_to_config_file(lc->config,NULL,i+1); /*mark the end*/
+	lp_config_set_int(lc->config,"sip","default_proxy",linphone_core_get_default_proxy_config_index(lc));
+}
+
+void linphone_core_schedule_proxy_update(LinphoneCore *lc){
+	lc->sip_conf.proxies_update_pending=TRUE;
+}
+
+/* Removes the proxy config from the registration queue, see linphone_core_process_register_queue(). */
+static void linphone_proxy_config_dequeue_register(LinphoneProxyConfig *cfg){
+	if (!cfg->register_queued) return;
+	cfg->register_queued=FALSE;
+	if (cfg->lc) cfg->lc->sip_conf.register_queue=bctbx_list_remove(cfg->lc->sip_conf.register_queue,cfg);
+}
+
+static bool_t linphone_core_register_queue_enabled(const LinphoneCore *lc){
+	return lc->sip_conf.register_rate_limit > 0 || lc->sip_conf.register_jitter > 0 || lc->sip_conf.register_backoff > 0;
+}
+
+/* Random jitter plus the backoff of the account after the given number of consecutive failures, in ms. */
+static uint64_t linphone_proxy_config_get_register_delay(const LinphoneProxyConfig *cfg, int failures){
+	const LinphoneCore *lc=cfg->lc;
+	uint64_t delay=0;
+
+	if (lc->sip_conf.register_jitter > 0)
+		delay+=ortp_random() % (unsigned int)lc->sip_conf.register_jitter;
+	if (lc->sip_conf.register_backoff > 0 && failures > 0){
+		uint64_t backoff=(uint64_t)lc->sip_conf.register_backoff << MIN(failures-1, 16);
+		if (lc->sip_conf.register_backoff_max > 0 && backoff > (uint64_t)lc->sip_conf.register_backoff_max)
+			backoff=(uint64_t)lc->sip_conf.register_backoff_max;
+		delay+=backoff;
+	}
+	return delay;
+}
+
+/*
+ * Refreshes are sent by the belle-sip refresher when the registration is about to expire: the requested expiry is
+ * shortened by up to register_jitter so that accounts registered together do not refresh together.
+ */
+static int linphone_proxy_config_get_register_expires(const LinphoneProxyConfig *cfg){
+	int max_jitter;
+
+	if (cfg->expires <= 0 || !cfg->lc || cfg->lc->sip_conf.register_jitter <= 0) return cfg->expires;
+	max_jitter=MIN((cfg->lc->sip_conf.register_jitter+999)/1000, cfg->expires/2);
+	if (max_jitter <= 0) return cfg->expires;
+	return cfg->expires-(int)(ortp_random() % (unsigned int)(max_jitter+1));
+}
+
+/*
+ * The refresher also retries failed REGISTERs by itself, after [sip] refresher_retry_after. The delay is set in advance
+ * for the next failure, with the same jitter and per account backoff as the registration queue.
+ */
+static void linphone_proxy_config_update_register_retry(LinphoneProxyConfig *cfg){
+	LinphoneCore *lc=cfg->lc;
+	uint64_t retry;
+
+	if (!cfg->op || !lc || !linphone_core_register_queue_enabled(lc)) return;
+	retry=(uint64_t)lc->sal->getRefresherRetryAfter()+linphone_proxy_config_get_register_delay(cfg,cfg->register_failures+1);
+	cfg->op->setRetryAfter((int)MIN(retry, (uint64_t)INT_MAX));
+}
+
+void linphone_core_invalidate_proxy_configs_index(LinphoneCore *lc){
+	lc->sip_conf.proxies_index_dirty=TRUE;
+}
+
+/* Proxy configs by identity domain, in proxy list order for a given domain. */
+bctbx_map_t *linphone_core_get_proxy_configs_by_domain(LinphoneCore *lc){
+	const bctbx_list_t *elem;
+	if (lc->sip_conf.proxies_by_domain && !lc->sip_conf.proxies_index_dirty)
+		return lc->sip_conf.proxies_by_domain;
+
+	if (lc->sip_conf.proxies_by_domain) bctbx_mmap_cchar_delete(lc->sip_conf.proxies_by_domain);
+	lc->sip_conf.proxies_by_domain=bctbx_mmap_cchar_new();
+	for(elem=lc->sip_conf.proxies;elem!=NULL;elem=bctbx_list_next(elem)){
+		LinphoneProxyConfig *cfg=(LinphoneProxyConfig*)elem->data;
+		const char *domain=linphone_proxy_config_get_domain(cfg);
+		if (domain){
+			bctbx_pair_t *pair=(bctbx_pair_t*)bctbx_pair_cchar_new(domain,cfg);
+			bctbx_map_cchar_insert_and_delete(lc->sip_conf.proxies_by_domain,pair);
+		}
+	}
+	lc->sip_conf.proxies_index_dirty=FALSE;
+	return lc->sip_conf.proxies_by_domain;
+}
+
 static void linphone_proxy_config_init(LinphoneCore* lc, LinphoneProxyConfig *cfg) {
 	const char *dial_prefix = lc ? lp_config_get_default_string(lc->config,"proxy","dial_prefix",NULL) : NULL;
   	const char *identity = lc ? lp_config_get_default_string(lc->config, "proxy", "reg_identity", NULL) : NULL;
@@ -367,6 +465,7 @@ LinphoneStatus linphone_proxy_config_set_identity_address(LinphoneProxyConfig *c
 		linphone_address_unref(cfg->identity_address);
 	}
 	cfg->identity_address=linphone_address_clone(addr);
+	if (cfg->lc) linphone_core_invalidate_proxy_configs_index(cfg->lc);
 
 	if (cfg->reg_identity!=NULL) {
 		ms_free(cfg->reg_identity);
@@ -621,7 +720,7 @@ static void linphone_proxy_config_register(LinphoneProxyConfig *cfg){
 		if (cfg->op->sendRegister(
 			proxy_string,
 			cfg->reg_identity,
-			cfg->expires,
+			linphone_proxy_config_get_register_expires(cfg),
 			cfg->pending_contact ? L_GET_PRIVATE_FROM_C_OBJECT(cfg->pending_contact)->getInternalAddress() : NULL
 		)==0) {
 			if (cfg->pending_contact) {
@@ -645,7 +744,7 @@ static void linphone_proxy_config_register(LinphoneProxyConfig *cfg){
 
 void linphone_proxy_config_refresh_register(LinphoneProxyConfig *cfg){
 	if (cfg->reg_sendregister && cfg->op && cfg->state!=LinphoneRegistrationProgress){
-		if (cfg->op->refreshRegister(cfg->expires) == 0) {
+		if (cfg->op->refreshRegister(linphone_proxy_config_get_register_expires(cfg)) == 0) {
 			linphone_proxy_config_set_state(cfg,LinphoneRegistrationProgress, "Refresh registration");
 		}
 	}
@@ -963,7 +1062,8 @@ LinphoneStatus linphone_proxy_config_done(LinphoneProxyConfig *cfg)
 	} else {
 		ms_message("Publish params have not changed on proxy config [%p]",cfg);
 	}
-	linphone_proxy_config_write_all_to_config_file(cfg->lc);
+	if (cfg->lc && (cfg->commit || cfg->send_publish)) linphone_core_schedule_proxy_update(cfg->lc);
+	linphone_proxy_config_write_to_config_file_if_listed(cfg);
 	return 0;
 }
 
@@ -1036,7 +1136,10 @@ int linphone_proxy_config_send_publish(LinphoneProxyConfig *proxy, LinphonePrese
 			bctbx_free(contact);
 		}
 
-	}else proxy->send_publish=TRUE; /*otherwise do not send publish if registration is in progress, this will be done later*/
+	}else{
+		proxy->send_publish=TRUE; /*otherwise do not send publish if registration is in progress, this will be done later*/
+		if (proxy->lc) linphone_core_schedule_proxy_update(proxy->lc);
+	}
 	return err;
 }
 
@@ -1177,6 +1280,7 @@ LinphoneStatus linphone_core_add_proxy_config(LinphoneCore *lc, LinphoneProxyCon
 		return 0;
 	}
 	lc->sip_conf.proxies=bctbx_list_append(lc->sip_conf.proxies,(void *)linphone_proxy_config_ref(cfg));
+	linphone_core_invalidate_proxy_configs_index(lc);
 	linphone_proxy_config_apply(cfg,lc);
 	return 0;
 }
@@ -1191,6 +1295,7 @@ void linphone_core_remove_dependent_proxy_config(LinphoneCore *lc, LinphoneProxy
 		 	ms_message("Updating dependent proxy config [%p] caused by removal of 'master' proxy config idkey[%s]", tmp, cfg->idkey);
 			linphone_proxy_config_set_dependency(tmp, NULL);
 			cfg->commit = TRUE;
+			linphone_core_schedule_proxy_update(lc);
 			linphone_proxy_config_update(tmp);
 		}
 	}
@@ -1203,6 +1308,8 @@ void linphone_core_remove_proxy_config(LinphoneCore *lc, LinphoneProxyConfig *cf
 		return;
 	}
 	lc->sip_conf.proxies=bctbx_list_remove(lc->sip_conf.proxies,cfg);
+	linphone_proxy_config_dequeue_register(cfg);
+	linphone_core_invalidate_proxy_configs_index(lc);
 	linphone_core_remove_dependent_proxy_config(lc, cfg);
 	/* add to the list of destroyed proxies, so that the possible unREGISTER request can succeed authentication */
 	lc->sip_conf.deleted_proxies=bctbx_list_append(lc->sip_conf.deleted_proxies,cfg);
@@ -1479,6 +1586,87 @@ static bool_t can_register(LinphoneProxyConfig *cfg){
 	return TRUE;
 }
 
+/*
+ * Registration queue: when [sip] register_rate_limit, register_jitter or register_backoff are set, REGISTERs
+ * triggered by a commit (startup, network change, account edition) are queued instead of all being sent at once.
+ * They leave the queue after a random jitter, a per account backoff after failures, and at register_rate_limit per second.
+ * Unregistrations are never delayed.
+ */
+static int register_queue_compare(const void *a, const void *b){
+	const LinphoneProxyConfig *cfg_a=(const LinphoneProxyConfig*)a;
+	const LinphoneProxyConfig *cfg_b=(const LinphoneProxyConfig*)b;
+	if (cfg_a->register_not_before < cfg_b->register_not_before) return -1;
+	if (cfg_a->register_not_before > cfg_b->register_not_before) return 1;
+	return 0;
+}
+
+static void linphone_proxy_config_queue_register(LinphoneProxyConfig *cfg){
+	LinphoneCore *lc=cfg->lc;
+	uint64_t now=ortp_get_cur_time_ms();
+	uint64_t delay;
+
+	if (cfg->register_queued) return;
+	delay=linphone_proxy_config_get_register_delay(cfg,cfg->register_failures);
+	cfg->register_queued=TRUE;
+	cfg->register_queued_time=now;
+	cfg->register_not_before=now+delay;
+	lc->sip_conf.register_queue=bctbx_list_insert_sorted(lc->sip_conf.register_queue,cfg,register_queue_compare);
+}
+
+void linphone_core_process_register_queue(LinphoneCore *lc){
+	uint64_t now=ortp_get_cur_time_ms();
+	int rate=lc->sip_conf.register_rate_limit;
+
+	if (rate > 0){
+		if (lc->sip_conf.register_tokens_time != 0){
+			lc->sip_conf.register_tokens+=(float)(now-lc->sip_conf.register_tokens_time)*(float)rate/1000.f;
+			if (lc->sip_conf.register_tokens > (float)lc->sip_conf.register_burst)
+				lc->sip_conf.register_tokens=(float)lc->sip_conf.register_burst;
+		}
+		lc->sip_conf.register_tokens_time=now;
+	}
+	while (lc->sip_conf.register_queue){
+		LinphoneProxyConfig *cfg=(LinphoneProxyConfig*)lc->sip_conf.register_queue->data;
+		uint64_t latency;
+
+		if (cfg->register_not_before > now) break;
+		if (rate > 0){
+			if (lc->sip_conf.register_tokens < 1.f) break;
+			lc->sip_conf.register_tokens-=1.f;
+		}
+		lc->sip_conf.register_queue=bctbx_list_erase_link(lc->sip_conf.register_queue,lc->sip_conf.register_queue);
+		cfg->register_queued=FALSE;
+
+		latency=now-cfg->register_queued_time;
+		lc->sip_conf.registers_scheduled++;
+		lc->sip_conf.register_queue_latency_total+=latency;
+		if (latency > lc->sip_conf.register_queue_latency_max) lc->sip_conf.register_queue_latency_max=latency;
+
+		/*if conditions changed while queued, the next linphone_proxy_config_update() queues it again*/
+		if (cfg->commit && can_register(cfg)){
+			linphone_proxy_config_register(cfg);
+			cfg->commit=FALSE;
+		}
+	}
+}
+
+unsigned int linphone_core_get_pending_registrations_count(const LinphoneCore *lc){
+	return (unsigned int)bctbx_list_size(lc->sip_conf.register_queue);
+}
+
+unsigned int linphone_core_get_scheduled_registrations_count(const LinphoneCore *lc){
+	return lc->sip_conf.registers_scheduled;
+}
+
+unsigned int linphone_core_get_registration_queue_average_latency(const LinphoneCore *lc){
+	if (lc->sip_conf.registers_scheduled == 0) return 0;
+	return (unsigned int)(lc->sip_conf.register_queue_latency_total / lc->sip_conf.registers_scheduled);
+}
+
+unsigned int linphone_core_get_registration_queue_max_latency(const LinphoneCore *lc){
+	return (unsigned int)lc->sip_conf.register_queue_latency_max;
+}
+
 void linphone_proxy_config_update(LinphoneProxyConfig *cfg){
 	LinphoneCore *lc=cfg->lc;
 	if (cfg->commit){
@@ -1486,8 +1674,13 @@ void linphone_proxy_config_update(LinphoneProxyConfig *cfg){
 			linphone_proxy_config_activate_sip_setup(cfg);
 		}
 		if (can_register(cfg)){
-			linphone_proxy_config_register(cfg);
-			cfg->commit=FALSE;
+			if (cfg->reg_sendregister && linphone_core_register_queue_enabled(lc)){
+				linphone_proxy_config_queue_register(cfg);
+			}else{
+				linphone_proxy_config_dequeue_register(cfg);
+				linphone_proxy_config_register(cfg);
+				cfg->commit=FALSE;
+			}
 		}
 	}
 	if (cfg->send_publish && (cfg->state==LinphoneRegistrationOk || cfg->state==LinphoneRegistrationCleared)){
@@ -1561,6 +1754,14 @@ void _linphone_update_dependent_proxy_config(LinphoneProxyConfig *cfg, LinphoneR
 void linphone_proxy_config_set_state(LinphoneProxyConfig *cfg, LinphoneRegistrationState state, const char *message){
 	LinphoneCore *lc = cfg->lc;
 
+	/* counted even when already failed: the refresher retries without going through the progress state */
+	if (state == LinphoneRegistrationFailed) {
+		cfg->register_failures++;
+	} else if (state == LinphoneRegistrationOk) {
+		cfg->register_failures = 0;
+	}
+	linphone_proxy_config_update_register_retry(cfg);
+
 	if (cfg->state!=state || state==LinphoneRegistrationOk) { /*allow multiple notification of LinphoneRegistrationOk for refreshing*/
 		ms_message("Proxy config [%p] for identity [%s] moving from state [%s] to [%s] on core [%p]"	,
 					cfg,
@@ -1586,6 +1787,8 @@ void linphone_proxy_config_set_state(LinphoneProxyConfig *cfg, LinphoneRegistrat
 			_linphone_update_dependent_proxy_config(cfg, state, message);
 		}
 		if (lc) {
+			/* a pending publish or a dependent registration may now be sent */
+			linphone_core_schedule_proxy_update(lc);
 			linphone_core_notify_registration_state_changed(lc,cfg,state,message);
 		}
 	} else {
@@ -42,6 +42,8 @@
 #include "c-wrapper/c-wrapper.h"
 #include "call/call-p.h"
 #include "conference/session/media-session-p.h"
+#include "content/content-manager.h"
+#include "content/content.h"
 
 #define STR_REASSIGN(dest, src) {\
 	if (dest != NULL) \
@@ -77,8 +79,8 @@ static void append_to_buffer_valist(char **buff, size_t *buff_size, size_t *offs
 	if (ret == BELLE_SIP_BUFFER_OVERFLOW) {
 		/*some compilers complain that size_t cannot be formatted as unsigned long, hence forcing cast*/
 		ms_debug("QualityReporting: Buffer was too small to contain the whole report - increasing its size from %lu to %lu",
-			(unsigned long)*buff_size, (unsigned long)*buff_size + 2048);
-		*buff_size += 2048;
+			(unsigned long)*buff_size, (unsigned long)*buff_size * 2);
+		*buff_size *= 2;
 		*buff = (char *) ms_realloc(*buff, *buff_size);
 
 		*offset = prevoffset;
@@ -277,21 +279,236 @@ static void append_metrics_to_buffer(char ** buffer, size_t * size, size_t * off
 	ms_free(moscq_str);
 }
 
+typedef enum _ReportingMode {
+	ReportingModePublish,
+	ReportingModeBatch,
+	ReportingModeFile
+} ReportingMode;
+
+typedef struct reporting_batch {
+	char *collector_uri;
+	bctbx_list_t *contents;
+	int count;
+	time_t first_report_date;
+} reporting_batch_t;
+
+struct reporting_aggregator {
+	ReportingMode mode;
+	// Serialization buffer kept between reports, it only grows.
+	char *buffer;
+	size_t buffer_size;
+	bctbx_list_t *batches;
+	int batch_max_reports;
+	int batch_delay;
+	FILE *file;
+	bool_t file_dirty;
+	bool_t iterate_hook_added;
+	reporting_stats_t stats;
+};
+
+static int publish_report_content(LinphoneCore *lc, const char *collector_uri, const LinphoneContent *content) {
+	LinphoneEvent *lev;
+	LinphoneAddress *request_uri;
+	const SalAddress *salAddress;
+	int ret = 0;
+
+	request_uri = linphone_address_new(collector_uri);
+	if (!request_uri) {
+		ms_error("QualityReporting: invalid collector URI %s", collector_uri);
+		return 3;
+	}
+	lev = linphone_core_create_one_shot_publish(lc, request_uri, "vq-rtcpxr");
+	/* Special exception for quality report PUBLISH: if the collector_uri has any transport related parameters
+	 * (port, transport, maddr), then it is sent directly.
+	 * Otherwise it is routed as any LinphoneEvent publish, following proxy config policy.
+	 **/
+	salAddress = L_GET_PRIVATE_FROM_C_OBJECT(request_uri)->getInternalAddress();
+	if (sal_address_has_uri_param(salAddress, "transport") ||
+		sal_address_has_uri_param(salAddress, "maddr") ||
+		linphone_address_get_port(request_uri) != 0) {
+		ms_message("Publishing report with custom route %s", collector_uri);
+		lev->op->setRoute(collector_uri);
+	}
+
+	if (linphone_event_send_publish(lev, content) != 0) {
+		ret = 4;
+	} else if (lc->reporting_aggregator) {
+		lc->reporting_aggregator->stats.publishes++;
+	}
+	linphone_address_unref(request_uri);
+	return ret;
+}
+
+static void reporting_batch_destroy(reporting_batch_t *batch) {
+	ms_free(batch->collector_uri);
+	bctbx_list_free_with_data(batch->contents, (bctbx_list_free_func)linphone_content_unref);
+	ms_free(batch);
+}
+
+static void reporting_batch_send(LinphoneCore *lc, reporting_batch_t *batch) {
+	reporting_aggregator *aggregator = lc->reporting_aggregator;
+	int ret;
+
+	if (batch->count == 1) {
+		ret = publish_report_content(lc, batch->collector_uri, (const LinphoneContent *)bctbx_list_get_data(batch->contents));
+	} else {
+		std::list<LinphonePrivate::Content *> parts;
+		for (const bctbx_list_t *it = batch->contents; it; it = bctbx_list_next(it))
+			parts.push_back(L_GET_CPP_PTR_FROM_C_OBJECT((LinphoneContent *)bctbx_list_get_data(it)));
+		LinphonePrivate::Content multipart = LinphonePrivate::ContentManager::contentListToMultipart(parts);
+		ret = publish_report_content(lc, batch->collector_uri, L_GET_C_BACK_PTR(&multipart));
+	}
+
+	ms_message("QualityReporting: Send %d report(s) to %s with status %d", batch->count, batch->collector_uri, ret);
+	if (ret != 0)
+		aggregator->stats.dropped += (unsigned int)batch->count;
+	else if (batch->count > 1)
+		aggregator->stats.batched += (unsigned int)batch->count;
+	batch->contents = bctbx_list_free_with_data(batch->contents, (bctbx_list_free_func)linphone_content_unref);
+	batch->count = 0;
+}
+
+static bool_t reporting_aggregator_iterate(void *data) {
+	LinphoneCore *lc = (LinphoneCore *)data;
+	reporting_aggregator *aggregator = lc->reporting_aggregator;
+	time_t now = ms_time(NULL);
+
+	for (bctbx_list_t *it = aggregator->batches; it; it = bctbx_list_next(it)) {
+		reporting_batch_t *batch = (reporting_batch_t *)bctbx_list_get_data(it);
+		if (batch->count > 0 && now - batch->first_report_date >= aggregator->batch_delay)
+			reporting_batch_send(lc, batch);
+	}
+	if (aggregator->file_dirty) {
+		fflush(aggregator->file);
+		aggregator->file_dirty = FALSE;
+	}
+	return TRUE;
+}
+
+static reporting_aggregator *get_reporting_aggregator(LinphoneCore *lc) {
+	reporting_aggregator *aggregator = lc->reporting_aggregator;
+	const char *mode;
+
+	if (aggregator)
+		return aggregator;
+
+	aggregator = ms_new0(reporting_aggregator, 1);
+	aggregator->buffer_size = (size_t)lp_config_get_int(lc->config, "quality_reporting", "buffer_size", 4096);
+	if (aggregator->buffer_size < 256)
+		aggregator->buffer_size = 256;
+	aggregator->buffer = (char *)ms_malloc(aggregator->buffer_size);
+	aggregator->batch_max_reports = lp_config_get_int(lc->config, "quality_reporting", "batch_max_reports", 20);
+	aggregator->batch_delay = lp_config_get_int(lc->config, "quality_reporting", "batch_delay", 5);
+
+	mode = lp_config_get_string(lc->config, "quality_reporting", "mode", "publish");
+	if (strcmp(mode, "batch") == 0) {
+		aggregator->mode = ReportingModeBatch;
+	} else if (strcmp(mode, "file") == 0) {
+		const char *path = lp_config_get_string(lc->config, "quality_reporting", "file", NULL);
+		aggregator->file = path ? fopen(path, "a") : NULL;
+		if (aggregator->file)
+			aggregator->mode = ReportingModeFile;
+		else
+			ms_error("QualityReporting: Cannot open report file [%s], reports will be published", path ? path : "");
+	} else if (strcmp(mode, "publish") != 0) {
+		ms_warning("QualityReporting: Unknown reporting mode [%s], reports will be published", mode);
+	}
+
+	lc->reporting_aggregator = aggregator;
+	if (aggregator->mode != ReportingModePublish) {
+		linphone_core_add_iterate_hook(lc, reporting_aggregator_iterate, lc);
+		aggregator->iterate_hook_added = TRUE;
+	}
+	return aggregator;
+}
+
+static void reporting_aggregator_enqueue(LinphoneCore *lc, const char *collector_uri, LinphoneContent *content) {
+	reporting_aggregator *aggregator = lc->reporting_aggregator;
+	reporting_batch_t *batch = NULL;
+
+	for (bctbx_list_t *it = aggregator->batches; it; it = bctbx_list_next(it)) {
+		reporting_batch_t *candidate = (reporting_batch_t *)bctbx_list_get_data(it);
+		if (strcmp(candidate->collector_uri, collector_uri) == 0) {
+			batch = candidate;
+			break;
+		}
+	}
+	if (!batch) {
+		batch = ms_new0(reporting_batch_t, 1);
+		batch->collector_uri = ms_strdup(collector_uri);
+		aggregator->batches = bctbx_list_append(aggregator->batches, batch);
+	}
+
+	if (batch->count == 0)
+		batch->first_report_date = ms_time(NULL);
+	batch->contents = bctbx_list_append(batch->contents, linphone_content_ref(content));
+	batch->count++;
+	if (batch->count >= aggregator->batch_max_reports)
+		reporting_batch_send(lc, batch);
+}
+
+reporting_stats_t linphone_reporting_get_stats(const LinphoneCore *lc) {
+	reporting_stats_t stats = { 0 };
+	if (lc->reporting_aggregator)
+		stats = lc->reporting_aggregator->stats;
+	return stats;
+}
+
+static void reporting_aggregator_remove_iterate_hook(LinphoneCore *lc, reporting_aggregator *aggregator) {
+	if (!aggregator->iterate_hook_added)
+		return;
+	linphone_core_remove_iterate_hook(lc, reporting_aggregator_iterate, lc);
+	aggregator->iterate_hook_added = FALSE;
+}
+
+void linphone_reporting_stop(LinphoneCore *lc) {
+	reporting_aggregator *aggregator = lc->reporting_aggregator;
+	if (!aggregator)
+		return;
+
+	reporting_aggregator_remove_iterate_hook(lc, aggregator);
+	for (bctbx_list_t *it = aggregator->batches; it; it = bctbx_list_next(it)) {
+		reporting_batch_t *batch = (reporting_batch_t *)bctbx_list_get_data(it);
+		if (batch->count > 0)
+			reporting_batch_send(lc, batch);
+	}
+	if (aggregator->file)
+		fflush(aggregator->file);
+}
+
+void linphone_reporting_uninit(LinphoneCore *lc) {
+	reporting_aggregator *aggregator = lc->reporting_aggregator;
+	if (!aggregator)
+		return;
+
+	// Reports queued after the flush of the core shutdown can't be sent anymore.
+	for (bctbx_list_t *it = aggregator->batches; it; it = bctbx_list_next(it))
+		aggregator->stats.dropped += (unsigned int)((reporting_batch_t *)bctbx_list_get_data(it))->count;
+	ms_message("QualityReporting: %u report(s) produced, %u batched in %u PUBLISH, %u dropped",
+		aggregator->stats.produced, aggregator->stats.batched, aggregator->stats.publishes, aggregator->stats.dropped);
+
+	reporting_aggregator_remove_iterate_hook(lc, aggregator);
+	bctbx_list_free_with_data(aggregator->batches, (bctbx_list_free_func)reporting_batch_destroy);
+	if (aggregator->file)
+		fclose(aggregator->file);
+	ms_free(aggregator->buffer);
+	ms_free(aggregator);
+	lc->reporting_aggregator = NULL;
+}
+
 static int send_report(LinphoneCall* call, reporting_session_report_t * report, const char * report_event) {
+	LinphoneCore *lc = linphone_call_get_core(call);
+	reporting_aggregator *aggregator = get_reporting_aggregator(lc);
 	LinphoneContent *content;
 	size_t offset = 0;
-	size_t size = 2048;
-	char * buffer;
 	int ret = 0;
-	LinphoneEvent *lev;
-	LinphoneAddress *request_uri;
 	const char* collector_uri;
 	char *collector_uri_allocated = NULL;
-	const SalAddress *salAddress;
 
 	/*if we are on a low bandwidth network, do not send reports to not overload it*/
 	if (linphone_call_params_low_bandwidth_enabled(linphone_call_get_current_params(call))){
 		ms_message("QualityReporting[%p]: Avoid sending reports on low bandwidth network", call);
+		aggregator->stats.dropped++;
 		ret = 1;
 		goto end;
 	}
@@ -306,46 +523,47 @@ static int send_report(LinphoneCall* call, reporting_session_report_t * report,
 			, report_event
 			, linphone_call_get_duration(call)
 			, (report->info.local_addr.ip == NULL || strlen(report->info.local_addr.ip) == 0) ? "local" : "remote");
+		aggregator->stats.dropped++;
 		ret = 2;
 		goto end;
 	}
 
-	buffer = (char *) ms_malloc0(size);
+	aggregator->buffer[0] = '\0';
 	content = linphone_content_new();
 	linphone_content_set_type(content, "application");
 	linphone_content_set_subtype(content, "vq-rtcpxr");
 
-	append_to_buffer(&buffer, &size, &offset, "%s\r\n", report_event);
-	append_to_buffer(&buffer, &size, &offset, "CallID: %s\r\n", report->info.call_id);
-	append_to_buffer(&buffer, &size, &offset, "LocalID: %s\r\n", report->info.local_addr.id);
-	append_to_buffer(&buffer, &size, &offset, "RemoteID: %s\r\n", report->info.remote_addr.id);
-	append_to_buffer(&buffer, &size, &offset, "OrigID: %s\r\n", report->info.orig_id);
+	append_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, "%s\r\n", report_event);
+	append_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, "CallID: %s\r\n", report->info.call_id);
+	append_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, "LocalID: %s\r\n", report->info.local_addr.id);
+	append_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, "RemoteID: %s\r\n", report->info.remote_addr.id);
+	append_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, "OrigID: %s\r\n", report->info.orig_id);
 
-	APPEND_IF_NOT_NULL_STR(&buffer, &size, &offset, "LocalGroup: %s\r\n", report->info.local_addr.group);
-	APPEND_IF_NOT_NULL_STR(&buffer, &size, &offset, "RemoteGroup: %s\r\n", report->info.remote_addr.group);
-	append_to_buffer(&buffer, &size, &offset, "LocalAddr: IP=%s PORT=%d SSRC=%u\r\n", report->info.local_addr.ip, report->info.local_addr.port, report->info.local_addr.ssrc);
-	APPEND_IF_NOT_NULL_STR(&buffer, &size, &offset, "LocalMAC: %s\r\n", report->info.local_addr.mac);
-	append_to_buffer(&buffer, &size, &offset, "RemoteAddr: IP=%s PORT=%d SSRC=%u\r\n", report->info.remote_addr.ip, report->info.remote_addr.port, report->info.remote_addr.ssrc);
-	APPEND_IF_NOT_NULL_STR(&buffer, &size, &offset, "RemoteMAC: %s\r\n", report->info.remote_addr.mac);
+	APPEND_IF_NOT_NULL_STR(&aggregator->buffer, &aggregator->buffer_size, &offset, "LocalGroup: %s\r\n", report->info.local_addr.group);
+	APPEND_IF_NOT_NULL_STR(&aggregator->buffer, &aggregator->buffer_size, &offset, "RemoteGroup: %s\r\n", report->info.remote_addr.group);
+	append_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, "LocalAddr: IP=%s PORT=%d SSRC=%u\r\n", report->info.local_addr.ip, report->info.local_addr.port, report->info.local_addr.ssrc);
+	APPEND_IF_NOT_NULL_STR(&aggregator->buffer, &aggregator->buffer_size, &offset, "LocalMAC: %s\r\n", report->info.local_addr.mac);
+	append_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, "RemoteAddr: IP=%s PORT=%d SSRC=%u\r\n", report->info.remote_addr.ip, report->info.remote_addr.port, report->info.remote_addr.ssrc);
+	APPEND_IF_NOT_NULL_STR(&aggregator->buffer, &aggregator->buffer_size, &offset, "RemoteMAC: %s\r\n", report->info.remote_addr.mac);
 
-	append_to_buffer(&buffer, &size, &offset, "LocalMetrics:\r\n");
-	append_metrics_to_buffer(&buffer, &size, &offset, &report->local_metrics);
+	append_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, "LocalMetrics:\r\n");
+	append_metrics_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, &report->local_metrics);
 
 	if (are_metrics_filled(&report->remote_metrics)!=0) {
-		append_to_buffer(&buffer, &size, &offset, "RemoteMetrics:\r\n");
-		append_metrics_to_buffer(&buffer, &size, &offset, &report->remote_metrics);
+		append_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, "RemoteMetrics:\r\n");
+		append_metrics_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, &report->remote_metrics);
 	}
-	APPEND_IF_NOT_NULL_STR(&buffer, &size, &offset, "DialogID: %s\r\n", report->dialog_id);
+	APPEND_IF_NOT_NULL_STR(&aggregator->buffer, &aggregator->buffer_size, &offset, "DialogID: %s\r\n", report->dialog_id);
 
 	if (report->qos_analyzer.timestamp!=NULL){
-		append_to_buffer(&buffer, &size, &offset, "AdaptiveAlg:");
-			APPEND_IF_NOT_NULL_STR(&buffer, &size, &offset, " NAME=\"%s\"", report->qos_analyzer.name);
-			APPEND_IF_NOT_NULL_STR(&buffer, &size, &offset, " TS=\"%s\"", report->qos_analyzer.timestamp);
-			APPEND_IF_NOT_NULL_STR(&buffer, &size, &offset, " IN_LEG=\"%s\"", report->qos_analyzer.input_leg);
-			APPEND_IF_NOT_NULL_STR(&buffer, &size, &offset, " IN=\"%s\"", report->qos_analyzer.input);
-			APPEND_IF_NOT_NULL_STR(&buffer, &size, &offset, " OUT_LEG=\"%s\"", report->qos_analyzer.output_leg);
-			APPEND_IF_NOT_NULL_STR(&buffer, &size, &offset, " OUT=\"%s\"", report->qos_analyzer.output);
-		append_to_buffer(&buffer, &size, &offset, "\r\n");
+		append_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, "AdaptiveAlg:");
+			APPEND_IF_NOT_NULL_STR(&aggregator->buffer, &aggregator->buffer_size, &offset, " NAME=\"%s\"", report->qos_analyzer.name);
+			APPEND_IF_NOT_NULL_STR(&aggregator->buffer, &aggregator->buffer_size, &offset, " TS=\"%s\"", report->qos_analyzer.timestamp);
+			APPEND_IF_NOT_NULL_STR(&aggregator->buffer, &aggregator->buffer_size, &offset, " IN_LEG=\"%s\"", report->qos_analyzer.input_leg);
+			APPEND_IF_NOT_NULL_STR(&aggregator->buffer, &aggregator->buffer_size, &offset, " IN=\"%s\"", report->qos_analyzer.input);
+			APPEND_IF_NOT_NULL_STR(&aggregator->buffer, &aggregator->buffer_size, &offset, " OUT_LEG=\"%s\"", report->qos_analyzer.output_leg);
+			APPEND_IF_NOT_NULL_STR(&aggregator->buffer, &aggregator->buffer_size, &offset, " OUT=\"%s\"", report->qos_analyzer.output);
+		append_to_buffer(&aggregator->buffer, &aggregator->buffer_size, &offset, "\r\n");
 	}
 
 #if TARGET_OS_IPHONE
@@ -355,12 +573,12 @@ static int send_report(LinphoneCall* call, reporting_session_report_t * report,
 		sysctlbyname("hw.machine", NULL, &namesize, NULL, 0);
 		machine = reinterpret_cast<char *>(malloc(namesize));
 		sysctlbyname("hw.machine", machine, &namesize, NULL, 0);
-		APPEND_IF_NOT_NULL_STR(&buffer, &size, &offset, "Device: %s\r\n", machine);
+		APPEND_IF_NOT_NULL_STR(&aggregator->buffer, &aggregator->buffer_size, &offset, "Device: %s\r\n", machine);
 	}
 #endif
 
-	linphone_content_set_buffer(content, (uint8_t *)buffer, strlen(buffer));
-	ms_free(buffer);
+	linphone_content_set_buffer(content, (uint8_t *)aggregator->buffer, offset);
+	aggregator->stats.produced++;
 
 	if (linphone_call_get_log(call)->reporting.on_report_sent != NULL) {
 		SalStreamType type = report == linphone_call_get_log(call)->reporting.reports[0] ? SalAudio : report == linphone_call_get_log(call)->reporting.reports[1] ? SalVideo : SalText;
@@ -372,24 +590,20 @@ static int send_report(LinphoneCall* call, reporting_session_report_t * report,
 	if (!collector_uri){
 		collector_uri = collector_uri_allocated = ms_strdup_printf("sip:%s", linphone_proxy_config_get_domain(linphone_call_get_dest_proxy(call)));
 	}
-	request_uri = linphone_address_new(collector_uri);
-	lev = linphone_core_create_one_shot_publish(linphone_call_get_core(call), request_uri, "vq-rtcpxr");
-	/* Special exception for quality report PUBLISH: if the collector_uri has any transport related parameters
-	 * (port, transport, maddr), then it is sent directly.
-	 * Otherwise it is routed as any LinphoneEvent publish, following proxy config policy.
-	 **/
-	salAddress = L_GET_PRIVATE_FROM_C_OBJECT(request_uri)->getInternalAddress();
-	if (sal_address_has_uri_param(salAddress, "transport") ||
-		sal_address_has_uri_param(salAddress, "maddr") ||
-		linphone_address_get_port(request_uri) != 0) {
-		ms_message("Publishing report with custom route %s", collector_uri);
-		lev->op->setRoute(collector_uri);
+	if (aggregator->mode == ReportingModeFile) {
+		fwrite(aggregator->buffer, 1, offset, aggregator->file);
+		fputs("\r\n", aggregator->file);
+		aggregator->file_dirty = TRUE;
+	} else if (aggregator->mode == ReportingModeBatch && strcmp(report_event, "VQIntervalReport") == 0) {
+		// Interval reports of all calls are grouped, the session reports are sent right away.
+		reporting_aggregator_enqueue(lc, collector_uri, content);
+	} else {
+		ret = publish_report_content(lc, collector_uri, content);
+		if (ret != 0)
+			aggregator->stats.dropped++;
 	}
 
-	if (linphone_event_send_publish(lev, content) != 0){
-		lev=NULL;
-		ret=4;
-	} else {
+	if (ret == 0) {
 		reset_avg_metrics(report);
 		STR_REASSIGN(report->qos_analyzer.timestamp, NULL);
 		STR_REASSIGN(report->qos_analyzer.input_leg, NULL);
@@ -398,7 +612,6 @@ static int send_report(LinphoneCall* call, reporting_session_report_t * report,
 		STR_REASSIGN(report->qos_analyzer.output, NULL);
 	}
 
-	linphone_address_unref(request_uri);
 	linphone_content_unref(content);
 	if (collector_uri_allocated) ms_free(collector_uri_allocated);
 
@@ -144,6 +144,19 @@ typedef struct reporting_session_report {
 
 typedef void (*LinphoneQualityReportingReportSendCb)(const LinphoneCall *call, SalStreamType stream_type, const LinphoneContent *content);
 
+/**
+ * Counters of the reports handled by a core since it was started.
+ * The reporting mode is chosen with the "mode" key of the [quality_reporting] section:
+ * "publish" sends a PUBLISH per report, "batch" groups the interval reports of all calls
+ * in a multipart PUBLISH per collector, "file" appends the reports to a local file.
+**/
+typedef struct reporting_stats {
+	unsigned int produced; // reports serialized
+	unsigned int batched; // reports sent in a multipart PUBLISH
+	unsigned int dropped; // reports discarded or that could not be sent
+	unsigned int publishes; // PUBLISH requests sent
+} reporting_stats_t;
+
 reporting_session_report_t * linphone_reporting_new(void);
 void linphone_reporting_destroy(reporting_session_report_t * report);
 
@@ -209,6 +222,14 @@ void linphone_reporting_call_state_updated(LinphoneCall *call);
  */
 LINPHONE_PUBLIC void linphone_reporting_set_on_report_send(LinphoneCall *call, LinphoneQualityReportingReportSendCb cb);
 
+LINPHONE_PUBLIC reporting_stats_t linphone_reporting_get_stats(const LinphoneCore *lc);
+
+/* Sends the pending batched reports and stops sending them periodically.
+ * Called when the core stops, before its iterate hooks are freed. */
+void linphone_reporting_stop(LinphoneCore *lc);
+
+void linphone_reporting_uninit(LinphoneCore *lc);
+
 #ifdef __cplusplus
 }
 #endif
@@ -61,6 +61,7 @@ bctbx_list_t **linphone_core_get_call_logs_attribute(LinphoneCore *lc) {
 
 void linphone_core_cbs_set_auth_info_requested(LinphoneCoreCbs *cbs, LinphoneCoreAuthInfoRequestedCb cb) {
 	cbs->vtable->auth_info_requested = cb;
+	_linphone_core_cbs_vtable_changed();
 }
 
 LinphoneQualityReporting *linphone_call_log_get_quality_reporting(LinphoneCallLog *call_log) {
@@ -107,6 +108,10 @@ int linphone_friend_list_get_revision(const LinphoneFriendList *lfl) {
 	return lfl->revision;
 }
 
+const char *linphone_friend_list_get_sync_token(const LinphoneFriendList *lfl) {
+	return lfl->sync_token;
+}
+
 unsigned int _linphone_call_get_nb_audio_starts (const LinphoneCall *call) {
 	return L_GET_PRIVATE_FROM_C_OBJECT(call)->getAudioStartCount();
 }
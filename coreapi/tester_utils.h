@@ -26,6 +26,7 @@
 #include "linphone/core.h"
 #include "linphone/tunnel.h"
 #include "c-wrapper/internal/c-sal.h"
+#include "offeranswer.h"
 #include "quality_reporting.h"
 #include "vcard_private.h"
 
@@ -85,6 +86,7 @@ LINPHONE_PUBLIC void linphone_core_delete_call_history(LinphoneCore *lc);
 LINPHONE_PUBLIC int linphone_core_get_call_history_size(LinphoneCore *lc);
 
 LINPHONE_DEPRECATED LINPHONE_PUBLIC void linphone_core_cbs_set_auth_info_requested(LinphoneCoreCbs *cbs, LinphoneCoreAuthInfoRequestedCb cb);
+LINPHONE_PUBLIC void linphone_core_notify_call_stats_updated(LinphoneCore *lc, LinphoneCall *call, const LinphoneCallStats *stats);
 
 LINPHONE_PUBLIC LinphoneProxyConfigAddressComparisonResult linphone_proxy_config_is_server_config_changed(const LinphoneProxyConfig* obj);
 LINPHONE_PUBLIC LinphoneProxyConfigAddressComparisonResult linphone_proxy_config_address_equal(const LinphoneAddress *a, const LinphoneAddress *b);
@@ -136,6 +138,7 @@ LINPHONE_PUBLIC LinphoneFriendList *linphone_friend_get_friend_list(const Linpho
 LINPHONE_PUBLIC bctbx_list_t **linphone_friend_list_get_friends_attribute(LinphoneFriendList *lfl);
 LINPHONE_PUBLIC const bctbx_list_t *linphone_friend_list_get_dirty_friends_to_update(const LinphoneFriendList *lfl);
 LINPHONE_PUBLIC int linphone_friend_list_get_revision(const LinphoneFriendList *lfl);
+LINPHONE_PUBLIC const char *linphone_friend_list_get_sync_token(const LinphoneFriendList *lfl);
 
 LINPHONE_PUBLIC int linphone_remote_provisioning_load_file( LinphoneCore* lc, const char* file_path);
 
@@ -219,6 +222,21 @@ LINPHONE_PUBLIC void linphone_core_set_network_reachable_internal(LinphoneCore *
 
 LINPHONE_PUBLIC bctbx_list_t *linphone_fetch_local_addresses(void);
 
+/**
+ * Gets the attribute of an LDAP contact provider filter made of a single substring assertion, like "uid=*%s*".
+ * @param[in] filter the LDAP filter, with %s standing for the predicate
+ * @param[out] prefix_only set to TRUE when the predicate must be a prefix of the attribute value, like with "cn=%s*"
+ * @return the attribute name, to be freed with ms_free(), or NULL if searches can't be narrowed locally with this filter
+ * @donotwrap Exists for tests purposes only
+**/
+LINPHONE_PUBLIC char *linphone_ldap_parse_narrowing_filter(const char *filter, bool_t *prefix_only);
+
+/**
+ * Tells whether an attribute value matches a predicate, the way the server applies a substring assertion.
+ * @donotwrap Exists for tests purposes only
+**/
+LINPHONE_PUBLIC bool_t linphone_ldap_narrowing_value_matches(const char *value, const char *predicate, bool_t prefix_only);
+
 #ifndef __cplusplus
 LINPHONE_PUBLIC Sal *linphone_core_get_sal(const LinphoneCore *lc);
 LINPHONE_PUBLIC SalOp *linphone_proxy_config_get_sal_op(const LinphoneProxyConfig *cfg);
@@ -252,6 +270,8 @@ LINPHONE_PUBLIC const SalErrorInfo *sal_op_get_error_info(const SalOp *op);
 LINPHONE_PUBLIC bool_t sal_call_dialog_request_pending(const SalOp *op);
 LINPHONE_PUBLIC void sal_call_set_sdp_handling(SalOp *h, SalOpSDPHandling handling);
 LINPHONE_PUBLIC SalMediaDescription * sal_call_get_final_media_description(SalOp *h);
+LINPHONE_PUBLIC char *sal_media_description_to_sdp_string(const SalMediaDescription *md);
+LINPHONE_PUBLIC SalMediaDescription *sal_media_description_from_sdp_string(const char *sdp);
 LINPHONE_PUBLIC const char *sal_call_get_local_tag (SalOp *op);
 LINPHONE_PUBLIC const char *sal_call_get_remote_tag (SalOp *op);
 LINPHONE_PUBLIC void sal_call_set_replaces (SalOp *op, const char *callId, const char *fromTag, const char *toTag);
@@ -73,13 +73,81 @@ struct _LinphoneVcard {
 	char *url;
 	unsigned char md5[VCARD_MD5_HASH_SIZE];
 	bctbx_list_t *sip_addresses_cache;
+	// Text of a lazy vCard, parsed on first access to a field that isn't given by the hints.
+	char *text;
+	// Kept until the vCard is destroyed, the pointers given before the parsing stay valid.
+	char *full_name_hint;
+	bctbx_list_t *sip_addresses_hint;
+	LinphoneVcardParsedCb parsed_cb;
+	void *parsed_cb_user_data;
+	// The belcard is shared with clones, it is copied before being modified.
+	bool_t shared;
 };
 
+// -----------------------------------------------------------------------------
+
+static shared_ptr<belcard::BelCard> &getBelCard (const LinphoneVcard *vCard) {
+	LinphoneVcard *lazyVcard = const_cast<LinphoneVcard *>(vCard);
+	if (!lazyVcard->text)
+		return lazyVcard->belCard;
+
+	shared_ptr<belcard::BelCard> belCard = belcard::BelCardParser::getInstance()->parseOne(lazyVcard->text);
+	if (belCard) {
+		lazyVcard->belCard = belCard;
+	} else {
+		// Keep what was known of the vCard, like a friend created from an invalid vCard.
+		ms_error("Couldn't parse lazy vCard %s", lazyVcard->text);
+		if (lazyVcard->full_name_hint) {
+			shared_ptr<belcard::BelCardFullName> fn = belcard::BelCardGeneric::create<belcard::BelCardFullName>();
+			fn->setValue(lazyVcard->full_name_hint);
+			lazyVcard->belCard->setFullName(fn);
+		}
+		if (lazyVcard->sip_addresses_hint) {
+			shared_ptr<belcard::BelCardImpp> impp = belcard::BelCardGeneric::create<belcard::BelCardImpp>();
+			char *uri = linphone_address_as_string_uri_only((const LinphoneAddress *)bctbx_list_get_data(lazyVcard->sip_addresses_hint));
+			impp->setValue(uri);
+			lazyVcard->belCard->addImpp(impp);
+			ms_free(uri);
+		}
+	}
+	ms_free(lazyVcard->text);
+	lazyVcard->text = NULL;
+	if (lazyVcard->parsed_cb) {
+		LinphoneVcardParsedCb cb = lazyVcard->parsed_cb;
+		lazyVcard->parsed_cb = NULL;
+		cb(lazyVcard, lazyVcard->parsed_cb_user_data);
+	}
+	return lazyVcard->belCard;
+}
+
+// Gives the vCard its own copy of a belcard shared with clones, before it is modified.
+static bool_t unshareBelCard (LinphoneVcard *vCard) {
+	shared_ptr<belcard::BelCard> &belCard = getBelCard(vCard);
+	if (!vCard->shared)
+		return TRUE;
+
+	shared_ptr<belcard::BelCard> copy = belcard::BelCardParser::getInstance()->parseOne(belCard->toFoldedString());
+	if (!copy) {
+		// Modifying the belcard would modify the clones too, the vCard stays shared and unchanged.
+		ms_error("Couldn't copy the belcard shared by vCard [%p], it can't be modified", vCard);
+		return FALSE;
+	}
+	copy->setSkipFieldValidation(belCard->getSkipFieldValidation());
+	belCard = copy;
+	vCard->shared = FALSE;
+	return TRUE;
+}
+
+// -----------------------------------------------------------------------------
+
 extern "C" {
 
 static void _linphone_vcard_uninit(LinphoneVcard *vCard) {
 	if (vCard->etag) ms_free(vCard->etag);
 	if (vCard->url) ms_free(vCard->url);
+	if (vCard->text) ms_free(vCard->text);
+	if (vCard->full_name_hint) ms_free(vCard->full_name_hint);
+	if (vCard->sip_addresses_hint) bctbx_list_free_with_data(vCard->sip_addresses_hint, (void (*)(void*))linphone_address_unref);
 	linphone_vcard_clean_cache(vCard);
 	vCard->belCard.~shared_ptr<belcard::BelCard>();
 }
@@ -109,6 +177,30 @@ static LinphoneVcard* linphone_vcard_new_from_belcard(shared_ptr<belcard::BelCar
 	return vCard;
 }
 
+LinphoneVcard *linphone_vcard_new_lazy(const char *text, const char *full_name, const char *sip_address) {
+	LinphoneVcard *vCard = _linphone_vcard_new();
+	vCard->text = ms_strdup(text);
+	if (full_name) vCard->full_name_hint = ms_strdup(full_name);
+	if (sip_address) {
+		LinphoneAddress *addr = linphone_address_new(sip_address);
+		if (addr) {
+			// Addresses read from the IMPP fields have no display name.
+			linphone_address_set_display_name(addr, NULL);
+			vCard->sip_addresses_hint = bctbx_list_append(NULL, addr);
+		}
+	}
+	return vCard;
+}
+
+bool_t linphone_vcard_is_parsed(const LinphoneVcard *vCard) {
+	return !vCard->text;
+}
+
+void linphone_vcard_set_parsed_callback(LinphoneVcard *vCard, LinphoneVcardParsedCb cb, void *user_data) {
+	vCard->parsed_cb = cb;
+	vCard->parsed_cb_user_data = user_data;
+}
+
 void linphone_vcard_free(LinphoneVcard *vCard) {
 	belle_sip_object_unref((belle_sip_object_t *)vCard);
 }
@@ -124,12 +216,23 @@ void linphone_vcard_unref(LinphoneVcard *vCard) {
 LinphoneVcard *linphone_vcard_clone(const LinphoneVcard *vCard) {
 	LinphoneVcard *copy = belle_sip_object_new(LinphoneVcard);
 
-	new (&copy->belCard) shared_ptr<belcard::BelCard>(belcard::BelCardParser::getInstance()->parseOne(vCard->belCard->toFoldedString()));
+	if (vCard->text) {
+		new (&copy->belCard) shared_ptr<belcard::BelCard>(belcard::BelCardGeneric::create<belcard::BelCard>());
+		copy->text = ms_strdup(vCard->text);
+		if (vCard->full_name_hint) copy->full_name_hint = ms_strdup(vCard->full_name_hint);
+		for (const bctbx_list_t *it = vCard->sip_addresses_hint; it; it = bctbx_list_next(it))
+			copy->sip_addresses_hint = bctbx_list_append(copy->sip_addresses_hint, linphone_address_clone((const LinphoneAddress *)bctbx_list_get_data(it)));
+	} else {
+		// Share the belcard instead of serializing and parsing it again, the first vCard modified copies it.
+		new (&copy->belCard) shared_ptr<belcard::BelCard>(vCard->belCard);
+		copy->shared = TRUE;
+		const_cast<LinphoneVcard *>(vCard)->shared = TRUE;
+	}
 
 	if (vCard->url) copy->url = ms_strdup(vCard->url);
 	if (vCard->etag) copy->etag = ms_strdup(vCard->etag);
 
-	memcpy(copy->md5, vCard->md5, sizeof *vCard->md5);
+	memcpy(copy->md5, vCard->md5, sizeof vCard->md5);
 
 	return copy;
 }
@@ -182,16 +285,19 @@ LinphoneVcard* linphone_vcard_context_get_vcard_from_buffer(LinphoneVcardContext
 
 const char * linphone_vcard_as_vcard4_string(LinphoneVcard *vCard) {
 	if (!vCard) return NULL;
+	if (vCard->text) return vCard->text;
 
 	return vCard->belCard->toFoldedString().c_str();
 }
 
 void *linphone_vcard_get_belcard(LinphoneVcard *vcard) {
+	// The caller may modify it.
+	if (!unshareBelCard(vcard)) return NULL;
 	return &vcard->belCard;
 }
 
 void linphone_vcard_set_full_name(LinphoneVcard *vCard, const char *name) {
-	if (!vCard || !name) return;
+	if (!vCard || !name || !unshareBelCard(vCard)) return;
 
 	if (vCard->belCard->getFullName()) {
 		vCard->belCard->getFullName()->setValue(name);
@@ -204,13 +310,15 @@ void linphone_vcard_set_full_name(LinphoneVcard *vCard, const char *name) {
 
 const char* linphone_vcard_get_full_name(const LinphoneVcard *vCard) {
 	if (!vCard) return NULL;
+	if (vCard->text && vCard->full_name_hint) return vCard->full_name_hint;
 
-	const char *result = vCard->belCard->getFullName() ? vCard->belCard->getFullName()->getValue().c_str() : NULL;
+	const shared_ptr<belcard::BelCard> &belCard = getBelCard(vCard);
+	const char *result = belCard->getFullName() ? belCard->getFullName()->getValue().c_str() : NULL;
 	return result;
 }
 
 void linphone_vcard_set_skip_validation(LinphoneVcard *vCard, bool_t skip) {
-	if (!vCard || !vCard->belCard) return;
+	if (!vCard || !vCard->belCard || !unshareBelCard(vCard)) return;
 
 	vCard->belCard->setSkipFieldValidation((skip == TRUE) ? true : false);
 }
@@ -218,12 +326,12 @@ void linphone_vcard_set_skip_validation(LinphoneVcard *vCard, bool_t skip) {
 bool_t linphone_vcard_get_skip_validation(const LinphoneVcard *vCard) {
 	if (!vCard) return FALSE;
 
-	bool_t result = vCard->belCard->getSkipFieldValidation();
+	bool_t result = getBelCard(vCard)->getSkipFieldValidation();
 	return result;
 }
 
 void linphone_vcard_set_family_name(LinphoneVcard *vCard, const char *name) {
-	if (!vCard || !name) return;
+	if (!vCard || !name || !unshareBelCard(vCard)) return;
 
 	if (vCard->belCard->getName()) {
 		vCard->belCard->getName()->setFamilyName(name);
@@ -237,12 +345,12 @@ void linphone_vcard_set_family_name(LinphoneVcard *vCard, const char *name) {
 const char* linphone_vcard_get_family_name(const LinphoneVcard *vCard) {
 	if (!vCard) return NULL;
 
-	const char *result = vCard->belCard->getName() ? vCard->belCard->getName()->getFamilyName().c_str() : NULL;
+	const char *result = getBelCard(vCard)->getName() ? getBelCard(vCard)->getName()->getFamilyName().c_str() : NULL;
 	return result;
 }
 
 void linphone_vcard_set_given_name(LinphoneVcard *vCard, const char *name) {
-	if (!vCard || !name) return;
+	if (!vCard || !name || !unshareBelCard(vCard)) return;
 
 	if (vCard->belCard->getName()) {
 		vCard->belCard->getName()->setGivenName(name);
@@ -256,12 +364,12 @@ void linphone_vcard_set_given_name(LinphoneVcard *vCard, const char *name) {
 const char* linphone_vcard_get_given_name(const LinphoneVcard *vCard) {
 	if (!vCard) return NULL;
 
-	const char *result = vCard->belCard->getName() ? vCard->belCard->getName()->getGivenName().c_str() : NULL;
+	const char *result = getBelCard(vCard)->getName() ? getBelCard(vCard)->getName()->getGivenName().c_str() : NULL;
 	return result;
 }
 
 void linphone_vcard_add_sip_address(LinphoneVcard *vCard, const char *sip_address) {
-	if (!vCard || !sip_address) return;
+	if (!vCard || !sip_address || !unshareBelCard(vCard)) return;
 
 	shared_ptr<belcard::BelCardImpp> impp = belcard::BelCardGeneric::create<belcard::BelCardImpp>();
 	impp->setValue(sip_address);
@@ -271,7 +379,7 @@ void linphone_vcard_add_sip_address(LinphoneVcard *vCard, const char *sip_addres
 }
 
 void linphone_vcard_remove_sip_address(LinphoneVcard *vCard, const char *sip_address) {
-	if (!vCard) return;
+	if (!vCard || !unshareBelCard(vCard)) return;
 
 	for (auto &impp : vCard->belCard->getImpp()) {
 		const char *value = impp->getValue().c_str();
@@ -283,7 +391,7 @@ void linphone_vcard_remove_sip_address(LinphoneVcard *vCard, const char *sip_add
 }
 
 void linphone_vcard_edit_main_sip_address(LinphoneVcard *vCard, const char *sip_address) {
-	if (!vCard || !sip_address) return;
+	if (!vCard || !sip_address || !unshareBelCard(vCard)) return;
 
 	if (vCard->belCard->getImpp().size() > 0) {
 		const shared_ptr<belcard::BelCardImpp> impp = vCard->belCard->getImpp().front();
@@ -300,7 +408,7 @@ void linphone_vcard_edit_main_sip_address(LinphoneVcard *vCard, const char *sip_
 const bctbx_list_t* linphone_vcard_get_sip_addresses(LinphoneVcard *vCard) {
 	if (!vCard) return NULL;
 	if (!vCard->sip_addresses_cache) {
-		for (auto &impp : vCard->belCard->getImpp()) {
+		for (auto &impp : getBelCard(vCard)->getImpp()) {
 			LinphoneAddress* addr = linphone_address_new(impp->getValue().c_str());
 			if (addr) {
 				vCard->sip_addresses_cache = bctbx_list_append(vCard->sip_addresses_cache, addr);
@@ -310,8 +418,16 @@ const bctbx_list_t* linphone_vcard_get_sip_addresses(LinphoneVcard *vCard) {
 	return vCard->sip_addresses_cache;
 }
 
+const LinphoneAddress *linphone_vcard_get_main_sip_address(LinphoneVcard *vCard) {
+	if (!vCard) return NULL;
+	if (vCard->text && vCard->sip_addresses_hint) return (const LinphoneAddress *)bctbx_list_get_data(vCard->sip_addresses_hint);
+
+	const bctbx_list_t *sip_addresses = linphone_vcard_get_sip_addresses(vCard);
+	return sip_addresses ? (const LinphoneAddress *)bctbx_list_get_data(sip_addresses) : NULL;
+}
+
 void linphone_vcard_add_phone_number(LinphoneVcard *vCard, const char *phone) {
-	if (!vCard || !phone) return;
+	if (!vCard || !phone || !unshareBelCard(vCard)) return;
 
 	shared_ptr<belcard::BelCardPhoneNumber> phone_number = belcard::BelCardGeneric::create<belcard::BelCardPhoneNumber>();
 	phone_number->setValue(phone);
@@ -319,7 +435,7 @@ void linphone_vcard_add_phone_number(LinphoneVcard *vCard, const char *phone) {
 }
 
 void linphone_vcard_remove_phone_number(LinphoneVcard *vCard, const char *phone) {
-	if (!vCard) return;
+	if (!vCard || !unshareBelCard(vCard)) return;
 
 	shared_ptr<belcard::BelCardPhoneNumber> tel;
 	for (auto &phoneNumber : vCard->belCard->getPhoneNumbers()) {
@@ -335,7 +451,7 @@ bctbx_list_t* linphone_vcard_get_phone_numbers(const LinphoneVcard *vCard) {
 	bctbx_list_t *result = NULL;
 	if (!vCard) return NULL;
 
-	for (auto &phoneNumber : vCard->belCard->getPhoneNumbers()) {
+	for (auto &phoneNumber : getBelCard(vCard)->getPhoneNumbers()) {
 		const char *value = phoneNumber->getValue().c_str();
 		result = bctbx_list_append(result, (char *)value);
 	}
@@ -343,7 +459,7 @@ bctbx_list_t* linphone_vcard_get_phone_numbers(const LinphoneVcard *vCard) {
 }
 
 void linphone_vcard_set_organization(LinphoneVcard *vCard, const char *organization) {
-	if (!vCard) return;
+	if (!vCard || !unshareBelCard(vCard)) return;
 
 	if (vCard->belCard->getOrganizations().size() > 0) {
 		const shared_ptr<belcard::BelCardOrganization> org = vCard->belCard->getOrganizations().front();
@@ -356,8 +472,8 @@ void linphone_vcard_set_organization(LinphoneVcard *vCard, const char *organizat
 }
 
 const char* linphone_vcard_get_organization(const LinphoneVcard *vCard) {
-	if (vCard && vCard->belCard->getOrganizations().size() > 0) {
-		const shared_ptr<belcard::BelCardOrganization> org = vCard->belCard->getOrganizations().front();
+	if (vCard && getBelCard(vCard)->getOrganizations().size() > 0) {
+		const shared_ptr<belcard::BelCardOrganization> org = getBelCard(vCard)->getOrganizations().front();
 		return org->getValue().c_str();
 	}
 
@@ -377,7 +493,7 @@ bool_t linphone_vcard_generate_unique_id(LinphoneVcard *vCard) {
 }
 
 void linphone_vcard_set_uid(LinphoneVcard *vCard, const char *uid) {
-	if (!vCard || !uid) return;
+	if (!vCard || !uid || !unshareBelCard(vCard)) return;
 
 	shared_ptr<belcard::BelCardUniqueId> uniqueId = belcard::BelCardGeneric::create<belcard::BelCardUniqueId>();
 	uniqueId->setValue(uid);
@@ -385,8 +501,8 @@ void linphone_vcard_set_uid(LinphoneVcard *vCard, const char *uid) {
 }
 
 const char* linphone_vcard_get_uid(const LinphoneVcard *vCard) {
-	if (vCard && vCard->belCard->getUniqueId()) {
-		return vCard->belCard->getUniqueId()->getValue().c_str();
+	if (vCard && getBelCard(vCard)->getUniqueId()) {
+		return getBelCard(vCard)->getUniqueId()->getValue().c_str();
 	}
 	return NULL;
 }
@@ -426,6 +542,8 @@ const char* linphone_vcard_get_url(const LinphoneVcard *vCard) {
 void linphone_vcard_compute_md5_hash(LinphoneVcard *vCard) {
 	const char *text = NULL;
 	if (!vCard) return;
+	// Hash the serialized belcard, the text of a lazy vCard may be formatted differently.
+	getBelCard(vCard);
 	text = linphone_vcard_as_vcard4_string(vCard);
 	bctbx_md5((unsigned char *)text, strlen(text), vCard->md5);
 }
@@ -101,6 +101,39 @@ void linphone_vcard_clean_cache(LinphoneVcard *vCard);
 
 LinphoneVcard* _linphone_vcard_new(void);
 
+/**
+ * Creates a vCard that parses its text only when a field not given by the hints is accessed.
+ * @param[in] text the vCard 4.0 text
+ * @param[in] full_name the full name of the vCard, or NULL if unknown
+ * @param[in] sip_address the main SIP address of the vCard, or NULL if unknown
+ * @return a new LinphoneVcard
+ */
+LinphoneVcard* linphone_vcard_new_lazy(const char *text, const char *full_name, const char *sip_address);
+
+typedef void (*LinphoneVcardParsedCb)(LinphoneVcard *vCard, void *user_data);
+
+/**
+ * Sets the function called once the text of a lazy vCard has been parsed.
+ * @param[in] vCard the LinphoneVcard
+ * @param[in] cb the callback, or NULL to remove it
+ * @param[in] user_data the data given to the callback
+ */
+void linphone_vcard_set_parsed_callback(LinphoneVcard *vCard, LinphoneVcardParsedCb cb, void *user_data);
+
+/**
+ * Gets the first SIP address of the vCard, without parsing a lazy vCard when it was given as a hint.
+ * @param[in] vCard the LinphoneVcard
+ * @return the main SIP address of the vCard, or NULL if it has none
+ */
+const LinphoneAddress* linphone_vcard_get_main_sip_address(LinphoneVcard *vCard);
+
+/**
+ * Tells whether the text of the vCard has been parsed.
+ * @param[in] vCard the LinphoneVcard
+ * @return TRUE if the vCard isn't a lazy one or if it has already been parsed
+ */
+LINPHONE_PUBLIC bool_t linphone_vcard_is_parsed(const LinphoneVcard *vCard);
+
 #ifdef __cplusplus
 }
 #endif
@@ -58,6 +58,21 @@ LinphoneVcard* linphone_vcard_new(void) {
 	return NULL;
 }
 
+LinphoneVcard* linphone_vcard_new_lazy(const char *text, const char *full_name, const char *sip_address) {
+	return NULL;
+}
+
+bool_t linphone_vcard_is_parsed(const LinphoneVcard *vCard) {
+	return TRUE;
+}
+
+void linphone_vcard_set_parsed_callback(LinphoneVcard *vCard, LinphoneVcardParsedCb cb, void *user_data) {
+}
+
+const LinphoneAddress* linphone_vcard_get_main_sip_address(LinphoneVcard *vCard) {
+	return NULL;
+}
+
 void linphone_vcard_free(LinphoneVcard *vCard) {
 }
 
@@ -17,12 +17,20 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <vector>
+
 #include "c-wrapper/c-wrapper.h"
 #include "core/core-p.h"
 
 #include "private.h"
 #include "linphone/wrapper_utils.h"
 
+using namespace std;
+
 
 LinphoneCoreVTable *linphone_core_v_table_new() {
 	return ms_new0(LinphoneCoreVTable,1);
@@ -45,6 +53,98 @@ LinphoneCoreVTable *linphone_core_get_current_vtable(LinphoneCore *lc) {
 	else return NULL;
 }
 
+// =============================================================================
+// Callbacks are dispatched through an index holding, for each function of the vtable,
+// the references whose function is set. It is rebuilt lazily when a listener is added
+// or removed, or when a callback of any LinphoneCoreCbs is modified.
+// =============================================================================
+
+namespace {
+	constexpr size_t VTableSlotCount = sizeof(LinphoneCoreVTable) / sizeof(void *);
+
+	typedef vector<vector<VTableReference *>> VTableSlots;
+
+	atomic<unsigned int> CbsGeneration(0);
+	atomic<unsigned int> VTableReferenceOrder(0);
+}
+
+#define L_VTABLE_SLOT(function_name) (offsetof(LinphoneCoreVTable, function_name) / sizeof(void *))
+
+struct _VTableIndex {
+	shared_ptr<const VTableSlots> slots;
+	unsigned int cbsGeneration = 0;
+	bool dirty = true;
+};
+
+static void invalidate_vtable_index(LinphoneCore *lc) {
+	if (lc->vtable_index) lc->vtable_index->dirty = true;
+}
+
+static shared_ptr<const VTableSlots> get_vtable_slots(LinphoneCore *lc) {
+	if (!lc->vtable_index) lc->vtable_index = new VTableIndex;
+
+	VTableIndex *index = lc->vtable_index;
+	unsigned int cbsGeneration = CbsGeneration.load(memory_order_relaxed);
+	if (!index->dirty && index->cbsGeneration == cbsGeneration) return index->slots;
+
+	shared_ptr<VTableSlots> slots = make_shared<VTableSlots>(VTableSlotCount);
+	for (const bctbx_list_t *it = lc->vtable_refs; it != NULL; it = it->next) {
+		VTableReference *ref = (VTableReference *)it->data;
+		if (!ref->valid) continue;
+
+		/* A vtable that is not owned by its LinphoneCoreCbs belongs to the application,
+		which may change it at any time: it is registered for every callback. */
+		bool_t external = !ref->cbs->autorelease;
+		const char *vtable = reinterpret_cast<const char *>(ref->cbs->vtable);
+		for (size_t i = 0; i < VTableSlotCount; i++) {
+			void *function;
+			memcpy(&function, vtable + i * sizeof(void *), sizeof(function));
+			if (external || function) (*slots)[i].push_back(ref);
+		}
+	}
+
+	index->slots = slots;
+	index->cbsGeneration = cbsGeneration;
+	index->dirty = false;
+	return index->slots;
+}
+
+/* Listeners removed while dispatching are skipped thanks to their valid flag. References are only
+freed by cleanup_dead_vtable_refs() outside of any dispatch, so the slots snapshot stays usable.
+Listeners added while dispatching are notified too, as they were when iterating over the list. */
+template<typename Function>
+static bool_t notify_vtable_slot(LinphoneCore *lc, size_t slot, bool_t filter_internal, bool_t internal, const Function &function) {
+	bool_t has_cb = FALSE;
+	unsigned int last_order = 0;
+	shared_ptr<const VTableSlots> slots = get_vtable_slots(lc);
+
+	lc->vtable_notify_recursion++;
+	for (;;) {
+		for (VTableReference *ref : (*slots)[slot]) {
+			if (ref->order <= last_order) continue;
+			last_order = ref->order;
+			if (!ref->valid || (filter_internal && ref->internal != internal)) continue;
+			lc->current_cbs = ref->cbs;
+			if (function(ref->cbs->vtable)) has_cb = TRUE;
+		}
+
+		shared_ptr<const VTableSlots> current_slots = get_vtable_slots(lc);
+		if (current_slots == slots) break;
+		slots = current_slots;
+	}
+	lc->vtable_notify_recursion--;
+	return has_cb;
+}
+
+void _linphone_core_free_vtable_index(LinphoneCore *lc) {
+	delete lc->vtable_index;
+	lc->vtable_index = NULL;
+}
+
+void _linphone_core_cbs_vtable_changed(void) {
+	CbsGeneration.fetch_add(1, memory_order_relaxed);
+}
+
 static void cleanup_dead_vtable_refs(LinphoneCore *lc){
 	bctbx_list_t *it,*next_it;
 
@@ -56,37 +156,31 @@ static void cleanup_dead_vtable_refs(LinphoneCore *lc){
 			lc->vtable_refs=bctbx_list_erase_link(lc->vtable_refs, it);
 			belle_sip_object_unref(ref->cbs);
 			ms_free(ref);
+			invalidate_vtable_index(lc);
 		}
 		it=next_it;
 	}
 }
 
+#define NOTIFY_VTABLE_FUNCTION(function_name, ...) \
+	[&] (LinphoneCoreVTable *vtable) -> bool { \
+		if (!vtable->function_name) return false; \
+		vtable->function_name(__VA_ARGS__); \
+		return true; \
+	}
+
 #define NOTIFY_IF_EXIST(function_name, ...) \
 	if (lc->is_unreffing) return; /* This is to prevent someone from taking a ref in a callback called while the Core is being destroyed after last unref */ \
-	bctbx_list_t* iterator; \
-	VTableReference *ref; \
-	bool_t has_cb = FALSE; \
-	lc->vtable_notify_recursion++;\
-	for (iterator=lc->vtable_refs; iterator!=NULL; iterator=iterator->next){\
-		if ((ref=(VTableReference*)iterator->data)->valid && (lc->current_cbs=ref->cbs)->vtable->function_name) {\
-			lc->current_cbs->vtable->function_name(__VA_ARGS__);\
-			has_cb = TRUE;\
-		}\
-	}\
-	lc->vtable_notify_recursion--;\
-	if (has_cb) ms_message("Linphone core [%p] notified [%s]",lc,#function_name)
+	if (notify_vtable_slot(lc, L_VTABLE_SLOT(function_name), FALSE, FALSE, NOTIFY_VTABLE_FUNCTION(function_name, __VA_ARGS__))) \
+		ms_message("Linphone core [%p] notified [%s]",lc,#function_name)
+
+/* Same as NOTIFY_IF_EXIST, without the log line, for high-frequency callbacks. */
+#define NOTIFY_IF_EXIST_QUIET(function_name, ...) \
+	if (lc->is_unreffing) return; \
+	notify_vtable_slot(lc, L_VTABLE_SLOT(function_name), FALSE, FALSE, NOTIFY_VTABLE_FUNCTION(function_name, __VA_ARGS__))
 
 #define NOTIFY_IF_EXIST_INTERNAL(function_name, internal_val, ...) \
-	bctbx_list_t* iterator; \
-	VTableReference *ref; \
-	lc->vtable_notify_recursion++;\
-	bool_t internal_val_evaluation = (internal_val); \
-	for (iterator=lc->vtable_refs; iterator!=NULL; iterator=iterator->next){\
-		if ((ref=(VTableReference*)iterator->data)->valid && (lc->current_cbs=ref->cbs)->vtable->function_name && (ref->internal == internal_val_evaluation)) {\
-			lc->current_cbs->vtable->function_name(__VA_ARGS__);\
-		}\
-	}\
-	lc->vtable_notify_recursion--;
+	notify_vtable_slot(lc, L_VTABLE_SLOT(function_name), TRUE, (internal_val), NOTIFY_VTABLE_FUNCTION(function_name, __VA_ARGS__))
 
 void linphone_core_notify_global_state_changed(LinphoneCore *lc, LinphoneGlobalState gstate, const char *message) {
 	L_GET_PRIVATE_FROM_C_OBJECT(lc)->notifyGlobalStateChanged(gstate);
@@ -189,17 +283,17 @@ void linphone_core_notify_message_received_unable_decrypt(LinphoneCore *lc, Linp
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #endif
 void linphone_core_notify_file_transfer_recv(LinphoneCore *lc, LinphoneChatMessage *message, LinphoneContent* content, const char* buff, size_t size) {
-	NOTIFY_IF_EXIST(file_transfer_recv, lc,message,content,buff,size);
+	NOTIFY_IF_EXIST_QUIET(file_transfer_recv, lc,message,content,buff,size);
 	cleanup_dead_vtable_refs(lc);
 }
 
 void linphone_core_notify_file_transfer_send(LinphoneCore *lc, LinphoneChatMessage *message,  LinphoneContent* content, char* buff, size_t* size) {
-	NOTIFY_IF_EXIST(file_transfer_send, lc,message,content,buff,size);
+	NOTIFY_IF_EXIST_QUIET(file_transfer_send, lc,message,content,buff,size);
 	cleanup_dead_vtable_refs(lc);
 }
 
 void linphone_core_notify_file_transfer_progress_indication(LinphoneCore *lc, LinphoneChatMessage *message, LinphoneContent* content, size_t offset, size_t total) {
-	NOTIFY_IF_EXIST(file_transfer_progress_indication, lc,message,content,offset,total);
+	NOTIFY_IF_EXIST_QUIET(file_transfer_progress_indication, lc,message,content,offset,total);
 	cleanup_dead_vtable_refs(lc);
 }
 #if __clang__ || ((__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4)
@@ -244,7 +338,7 @@ void linphone_core_notify_transfer_state_changed(LinphoneCore *lc, LinphoneCall
 }
 
 void linphone_core_notify_call_stats_updated(LinphoneCore *lc, LinphoneCall *call, const LinphoneCallStats *stats) {
-	NOTIFY_IF_EXIST(call_stats_updated, lc,call,stats);
+	NOTIFY_IF_EXIST_QUIET(call_stats_updated, lc,call,stats);
 	cleanup_dead_vtable_refs(lc);
 }
 
@@ -290,7 +384,7 @@ void linphone_core_notify_log_collection_upload_state_changed(LinphoneCore *lc,
 }
 
 void linphone_core_notify_log_collection_upload_progress_indication(LinphoneCore *lc, size_t offset, size_t total) {
-	NOTIFY_IF_EXIST(log_collection_upload_progress_indication, lc, offset, total);
+	NOTIFY_IF_EXIST_QUIET(log_collection_upload_progress_indication, lc, offset, total);
 	cleanup_dead_vtable_refs(lc);
 }
 
@@ -353,6 +447,7 @@ static VTableReference * v_table_reference_new(LinphoneCoreCbs *cbs, bool_t inte
 	VTableReference *ref=ms_new0(VTableReference,1);
 	ref->valid=TRUE;
 	ref->internal = internal;
+	ref->order = ++VTableReferenceOrder;
 	ref->cbs=linphone_core_cbs_ref(cbs);
 	return ref;
 }
@@ -365,6 +460,7 @@ void v_table_reference_destroy(VTableReference *ref){
 void _linphone_core_add_callbacks(LinphoneCore *lc, LinphoneCoreCbs *vtable, bool_t internal) {
 	ms_message("Core callbacks [%p] registered on core [%p]", vtable, lc);
 	lc->vtable_refs=bctbx_list_append(lc->vtable_refs,v_table_reference_new(vtable, internal));
+	invalidate_vtable_index(lc);
 }
 
 void linphone_core_add_listener(LinphoneCore *lc, LinphoneCoreVTable *vtable){
@@ -385,6 +481,7 @@ void linphone_core_remove_listener(LinphoneCore *lc, const LinphoneCoreVTable *v
 		VTableReference *ref=(VTableReference*)it->data;
 		if (ref->cbs->vtable==vtable) {
 			ref->valid=FALSE;
+			invalidate_vtable_index(lc);
 		}
 	}
 }
@@ -409,6 +506,7 @@ void linphone_core_remove_callbacks(LinphoneCore *lc, const LinphoneCoreCbs *cbs
 		VTableReference *ref=(VTableReference*)it->data;
 		if (ref->cbs==cbs) {
 			ref->valid=FALSE;
+			invalidate_vtable_index(lc);
 		}
 	}
 }
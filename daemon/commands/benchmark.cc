@@ -0,0 +1,722 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <set>
+#include <vector>
+
+#include "benchmark.h"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+// -----------------------------------------------------------------------------
+
+class BenchmarkWorkload {
+public:
+	BenchmarkWorkload(Daemon *app, const string &name, const string &target, float rate, int count) :
+		mApp(app), mCore(app->getCore()), mTarget(target), mName(name), mRate(rate), mCount(count) {
+		mBegin = mEnd = Clock::now();
+	}
+	virtual ~BenchmarkWorkload() {}
+
+	const string &getName() const {
+		return mName;
+	}
+
+	bool isRunning() const {
+		return !mStopped && !isComplete();
+	}
+
+	void tick(Clock::time_point now);
+	// Cancels the pending operations and releases what the workload created.
+	void stop();
+	string report() const;
+
+	virtual void registrationStateChanged(LinphoneProxyConfig *cfg, LinphoneRegistrationState state) {}
+	virtual void callStateChanged(LinphoneCall *call, LinphoneCallState state) {}
+	virtual void chatRoomStateChanged(LinphoneChatRoom *cr, LinphoneChatRoomState state) {}
+
+protected:
+	// Starts the operation number index (from 1), returns false if it failed immediately.
+	virtual bool launch(int index) = 0;
+	virtual void onTick(Clock::time_point now) {}
+	virtual void cancel() = 0;
+	virtual size_t getPending() const = 0;
+
+	void succeeded(Clock::time_point start);
+	void failed() {
+		mFailed++;
+	}
+
+	Daemon *mApp;
+	LinphoneCore *mCore;
+	const string mTarget;
+
+private:
+	bool isComplete() const {
+		return mStarted == mCount && getPending() == 0;
+	}
+
+	unsigned int getLatency(float percentile, const vector<unsigned int> &sorted) const;
+
+	const string mName;
+	const float mRate;
+	const int mCount;
+	int mStarted = 0;
+	int mSucceeded = 0;
+	int mFailed = 0;
+	bool mStopped = false;
+	bool mFinished = false;
+	Clock::time_point mBegin;
+	Clock::time_point mEnd;
+	vector<unsigned int> mLatencies; // In microseconds.
+};
+
+void BenchmarkWorkload::tick(Clock::time_point now) {
+	if (!isRunning())
+		return;
+
+	int due = mCount;
+	if (mRate > 0) {
+		double elapsed = chrono::duration<double>(now - mBegin).count();
+		due = min(mCount, static_cast<int>(elapsed * mRate) + 1);
+	}
+	while (mStarted < due) {
+		mStarted++;
+		if (!launch(mStarted))
+			failed();
+	}
+	onTick(now);
+
+	if (isComplete()) {
+		mEnd = now;
+		mFinished = true;
+		mApp->queueEvent(new Event("benchmark-finished", report()));
+	}
+}
+
+void BenchmarkWorkload::stop() {
+	if (mStopped)
+		return;
+	cancel();
+	if (!mFinished)
+		mEnd = Clock::now();
+	mStopped = true;
+}
+
+void BenchmarkWorkload::succeeded(Clock::time_point start) {
+	mSucceeded++;
+	mLatencies.push_back(static_cast<unsigned int>(chrono::duration_cast<chrono::microseconds>(Clock::now() - start).count()));
+}
+
+unsigned int BenchmarkWorkload::getLatency(float percentile, const vector<unsigned int> &sorted) const {
+	if (sorted.empty())
+		return 0;
+	size_t rank = static_cast<size_t>(ceil(percentile / 100.f * sorted.size()));
+	return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+string BenchmarkWorkload::report() const {
+	Clock::time_point end = (mFinished || mStopped) ? mEnd : Clock::now();
+	double duration = chrono::duration<double>(end - mBegin).count();
+	vector<unsigned int> sorted(mLatencies);
+	sort(sorted.begin(), sorted.end());
+
+	ostringstream ost;
+	ost << fixed << setprecision(1);
+	ost << "Workload: " << mName << "\n";
+	ost << "Target: " << mTarget << "\n";
+	ost << "State: " << (mFinished ? "finished" : (mStopped ? "stopped" : "running")) << "\n";
+	ost << "Rate: ";
+	if (mRate > 0)
+		ost << mRate << "/s\n";
+	else
+		ost << "unlimited\n";
+	ost << "Count: " << mCount << "\n";
+	ost << "Started: " << mStarted << "\n";
+	ost << "Succeeded: " << mSucceeded << "\n";
+	ost << "Failed: " << mFailed << "\n";
+	ost << "Pending: " << (mStopped ? 0 : getPending()) << "\n";
+	ost << "Duration: " << setprecision(3) << duration << "s\n" << setprecision(1);
+	ost << "Throughput: " << (duration > 0 ? mSucceeded / duration : 0.) << "/s\n";
+	ost << "Latency:"
+		<< " p50=" << getLatency(50.f, sorted) / 1000. << "ms"
+		<< " p90=" << getLatency(90.f, sorted) / 1000. << "ms"
+		<< " p99=" << getLatency(99.f, sorted) / 1000. << "ms"
+		<< " max=" << (sorted.empty() ? 0 : sorted.back()) / 1000. << "ms\n";
+	return ost.str();
+}
+
+// -----------------------------------------------------------------------------
+
+// Registers count accounts on the proxy, the latency is the time to the RegistrationOk state.
+// The accounts stay registered until the workload is stopped.
+class RegisterWorkload: public BenchmarkWorkload {
+public:
+	RegisterWorkload(Daemon *app, const string &proxy, const string &domain, float rate, int count, const string &prefix, const string &password) :
+		BenchmarkWorkload(app, "register", proxy, rate, count), mDomain(domain), mPrefix(prefix), mPassword(password) {}
+
+	void registrationStateChanged(LinphoneProxyConfig *cfg, LinphoneRegistrationState state) override {
+		auto it = mPending.find(cfg);
+		if (it == mPending.end())
+			return;
+		if (state == LinphoneRegistrationOk)
+			succeeded(it->second);
+		else if (state == LinphoneRegistrationFailed)
+			failed();
+		else
+			return;
+		mPending.erase(it);
+	}
+
+protected:
+	bool launch(int index) override {
+		ostringstream ost;
+		ost << "sip:" << mPrefix << index << "@" << mDomain;
+		LinphoneAddress *identity = linphone_factory_create_address(linphone_factory_get(), ost.str().c_str());
+		if (!identity)
+			return false;
+		if (!mPassword.empty()) {
+			LinphoneAuthInfo *info = linphone_auth_info_new(linphone_address_get_username(identity), NULL, mPassword.c_str(), NULL, NULL, mDomain.c_str());
+			linphone_core_add_auth_info(mCore, info);
+			linphone_auth_info_unref(info);
+		}
+		LinphoneProxyConfig *cfg = linphone_core_create_proxy_config(mCore);
+		linphone_proxy_config_set_identity_address(cfg, identity);
+		linphone_address_unref(identity);
+		linphone_proxy_config_set_server_addr(cfg, mTarget.c_str());
+		linphone_proxy_config_enable_register(cfg, TRUE);
+		mProxies.push_back(cfg);
+		mPending[cfg] = Clock::now();
+		if (linphone_core_add_proxy_config(mCore, cfg) != 0) {
+			mPending.erase(cfg);
+			return false;
+		}
+		return true;
+	}
+
+	void cancel() override {
+		mPending.clear();
+		for (LinphoneProxyConfig *cfg : mProxies) {
+			const LinphoneAuthInfo *info = linphone_proxy_config_find_auth_info(cfg);
+			if (info && !mPassword.empty())
+				linphone_core_remove_auth_info(mCore, info);
+			linphone_core_remove_proxy_config(mCore, cfg);
+			linphone_proxy_config_unref(cfg);
+		}
+		mProxies.clear();
+	}
+
+	size_t getPending() const override {
+		return mPending.size();
+	}
+
+private:
+	const string mDomain;
+	const string mPrefix;
+	const string mPassword;
+	vector<LinphoneProxyConfig *> mProxies;
+	map<LinphoneProxyConfig *, Clock::time_point> mPending;
+};
+
+// -----------------------------------------------------------------------------
+
+// Places audio calls, the latency is the time to the Connected state.
+// Each call is terminated after being connected for the hold duration.
+class CallWorkload: public BenchmarkWorkload {
+public:
+	CallWorkload(Daemon *app, const string &target, float rate, int count, int holdSeconds) :
+		BenchmarkWorkload(app, "call", target, rate, count), mHold(holdSeconds) {}
+
+	void callStateChanged(LinphoneCall *call, LinphoneCallState state) override {
+		auto it = mCalling.find(call);
+		if (it != mCalling.end()) {
+			if (state == LinphoneCallConnected) {
+				succeeded(it->second);
+				mHolding[call] = Clock::now() + mHold;
+				mCalling.erase(it);
+			} else if (state == LinphoneCallError || state == LinphoneCallEnd || state == LinphoneCallReleased) {
+				failed();
+				mCalling.erase(it);
+				linphone_call_unref(call);
+			}
+			return;
+		}
+		if (state == LinphoneCallError || state == LinphoneCallEnd || state == LinphoneCallReleased) {
+			if (mHolding.erase(call) > 0 || mEnding.erase(call) > 0)
+				linphone_call_unref(call);
+		}
+	}
+
+protected:
+	bool launch(int index) override {
+		LinphoneAddress *addr = linphone_core_interpret_url(mCore, mTarget.c_str());
+		if (!addr)
+			return false;
+		LinphoneCallParams *params = linphone_core_create_call_params(mCore, NULL);
+		linphone_call_params_enable_video(params, FALSE);
+		Clock::time_point start = Clock::now();
+		LinphoneCall *call = linphone_core_invite_address_with_params(mCore, addr, params);
+		linphone_call_params_unref(params);
+		linphone_address_unref(addr);
+		if (!call)
+			return false;
+		LinphoneCallState state = linphone_call_get_state(call);
+		if (state == LinphoneCallError || state == LinphoneCallEnd || state == LinphoneCallReleased)
+			return false;
+		mCalling[linphone_call_ref(call)] = start;
+		return true;
+	}
+
+	void onTick(Clock::time_point now) override {
+		vector<LinphoneCall *> expired;
+		for (auto it = mHolding.begin(); it != mHolding.end();) {
+			if (it->second <= now) {
+				expired.push_back(it->first);
+				mEnding.insert(it->first);
+				it = mHolding.erase(it);
+			} else
+				++it;
+		}
+		for (LinphoneCall *call : expired)
+			linphone_call_terminate(call);
+	}
+
+	void cancel() override {
+		vector<LinphoneCall *> calls;
+		for (const auto &entry : mCalling)
+			calls.push_back(entry.first);
+		for (const auto &entry : mHolding)
+			calls.push_back(entry.first);
+		calls.insert(calls.end(), mEnding.begin(), mEnding.end());
+		mCalling.clear();
+		mHolding.clear();
+		mEnding.clear();
+		for (LinphoneCall *call : calls) {
+			LinphoneCallState state = linphone_call_get_state(call);
+			if (state != LinphoneCallEnd && state != LinphoneCallError && state != LinphoneCallReleased)
+				linphone_call_terminate(call);
+			linphone_call_unref(call);
+		}
+	}
+
+	size_t getPending() const override {
+		return mCalling.size() + mHolding.size() + mEnding.size();
+	}
+
+private:
+	const chrono::seconds mHold;
+	map<LinphoneCall *, Clock::time_point> mCalling; // Start of the call.
+	map<LinphoneCall *, Clock::time_point> mHolding; // End of the hold.
+	set<LinphoneCall *> mEnding;
+};
+
+// -----------------------------------------------------------------------------
+
+// Sends text messages in a basic chat room, the latency is the time to the Delivered state.
+class MessageWorkload: public BenchmarkWorkload {
+public:
+	MessageWorkload(Daemon *app, const string &target, LinphoneChatRoom *cr, float rate, int count) :
+		BenchmarkWorkload(app, "message", target, rate, count), mChatRoom(linphone_chat_room_ref(cr)) {}
+
+	~MessageWorkload() {
+		linphone_chat_room_unref(mChatRoom);
+	}
+
+protected:
+	bool launch(int index) override {
+		ostringstream text;
+		text << "Benchmark message " << index;
+		LinphoneChatMessage *msg = linphone_chat_room_create_message(mChatRoom, text.str().c_str());
+		if (!msg)
+			return false;
+		linphone_chat_message_set_user_data(msg, this);
+		linphone_chat_message_cbs_set_msg_state_changed(linphone_chat_message_get_callbacks(msg), sMsgStateChanged);
+		mPending[msg] = Clock::now();
+		linphone_chat_message_send(msg);
+		return true;
+	}
+
+	void cancel() override {
+		for (const auto &entry : mPending)
+			release(entry.first);
+		mPending.clear();
+	}
+
+	size_t getPending() const override {
+		return mPending.size();
+	}
+
+private:
+	static void sMsgStateChanged(LinphoneChatMessage *msg, LinphoneChatMessageState state) {
+		MessageWorkload *workload = static_cast<MessageWorkload *>(linphone_chat_message_get_user_data(msg));
+		if (workload)
+			workload->msgStateChanged(msg, state);
+	}
+
+	void msgStateChanged(LinphoneChatMessage *msg, LinphoneChatMessageState state) {
+		auto it = mPending.find(msg);
+		if (it == mPending.end())
+			return;
+		switch (state) {
+			case LinphoneChatMessageStateDelivered:
+			case LinphoneChatMessageStateDeliveredToUser:
+			case LinphoneChatMessageStateDisplayed:
+				succeeded(it->second);
+				break;
+			case LinphoneChatMessageStateNotDelivered:
+				failed();
+				break;
+			default:
+				return;
+		}
+		mPending.erase(it);
+		release(msg);
+	}
+
+	static void release(LinphoneChatMessage *msg) {
+		linphone_chat_message_set_user_data(msg, NULL);
+		linphone_chat_message_cbs_set_msg_state_changed(linphone_chat_message_get_callbacks(msg), NULL);
+		linphone_chat_message_unref(msg);
+	}
+
+	LinphoneChatRoom *mChatRoom;
+	map<LinphoneChatMessage *, Clock::time_point> mPending;
+};
+
+// -----------------------------------------------------------------------------
+
+// Creates group chat rooms with one participant through the conference factory of the default proxy,
+// then leaves and deletes them. The latency is the time to the Created state.
+class GroupChatWorkload: public BenchmarkWorkload {
+public:
+	GroupChatWorkload(Daemon *app, const string &target, LinphoneAddress *participant, float rate, int count) :
+		BenchmarkWorkload(app, "group-chat", target, rate, count), mParticipant(participant) {}
+
+	~GroupChatWorkload() {
+		linphone_address_unref(mParticipant);
+	}
+
+	void chatRoomStateChanged(LinphoneChatRoom *cr, LinphoneChatRoomState state) override {
+		auto it = mCreating.find(cr);
+		if (it != mCreating.end()) {
+			if (state == LinphoneChatRoomStateCreated) {
+				succeeded(it->second);
+				mCreating.erase(it);
+				mLeaving.insert(cr);
+				linphone_chat_room_leave(cr);
+			} else if (state == LinphoneChatRoomStateCreationFailed) {
+				failed();
+				mCreating.erase(it);
+				mDeleting.insert(cr);
+			}
+			return;
+		}
+		if (state == LinphoneChatRoomStateTerminated && mLeaving.erase(cr) > 0)
+			mDeleting.insert(cr);
+	}
+
+protected:
+	bool launch(int index) override {
+		LinphoneChatRoomParams *params = linphone_core_create_default_chat_room_params(mCore);
+		linphone_chat_room_params_set_backend(params, LinphoneChatRoomBackendFlexisipChat);
+		linphone_chat_room_params_enable_group(params, TRUE);
+		bctbx_list_t *participants = bctbx_list_append(NULL, mParticipant);
+		ostringstream subject;
+		subject << "Benchmark " << index;
+		Clock::time_point start = Clock::now();
+		LinphoneChatRoom *cr = linphone_core_create_chat_room_2(mCore, params, subject.str().c_str(), participants);
+		bctbx_list_free(participants);
+		linphone_chat_room_params_unref(params);
+		if (!cr)
+			return false;
+		linphone_chat_room_ref(cr);
+		if (linphone_chat_room_get_state(cr) == LinphoneChatRoomStateCreationFailed) {
+			mDeleting.insert(cr);
+			return false;
+		}
+		mCreating[cr] = start;
+		return true;
+	}
+
+	// Chat rooms are not deleted from their own state callbacks.
+	void onTick(Clock::time_point now) override {
+		set<LinphoneChatRoom *> deleting;
+		deleting.swap(mDeleting);
+		for (LinphoneChatRoom *cr : deleting) {
+			linphone_core_delete_chat_room(mCore, cr);
+			linphone_chat_room_unref(cr);
+		}
+	}
+
+	void cancel() override {
+		for (const auto &entry : mCreating)
+			mDeleting.insert(entry.first);
+		mDeleting.insert(mLeaving.begin(), mLeaving.end());
+		mCreating.clear();
+		mLeaving.clear();
+		onTick(Clock::now());
+	}
+
+	size_t getPending() const override {
+		return mCreating.size() + mLeaving.size() + mDeleting.size();
+	}
+
+private:
+	LinphoneAddress *mParticipant;
+	map<LinphoneChatRoom *, Clock::time_point> mCreating;
+	set<LinphoneChatRoom *> mLeaving;
+	set<LinphoneChatRoom *> mDeleting;
+};
+
+// -----------------------------------------------------------------------------
+
+BenchmarkCommand::BenchmarkCommand() :
+		DaemonCommand("benchmark", "benchmark register|call|message|group-chat|status|stop [<parameters>]",
+				"Generate load and measure the latency and the throughput of the core.\n"
+				"'benchmark register <proxy_address> <count> [<per_second>] [<user_prefix>] [<password>]' registers <count> accounts "
+				"sip:<user_prefix><n>@<proxy domain> (user_prefix is \"bench-\" by default), all at once unless a rate is given. "
+				"They stay registered until the benchmark is stopped.\n"
+				"'benchmark call <sip_address> <count> <per_second> [<hold_seconds>]' places audio calls, each one is terminated "
+				"after being connected for hold_seconds (1 by default).\n"
+				"'benchmark message <sip_address> <count> <per_second>' sends text messages and waits for their delivery.\n"
+				"'benchmark group-chat <participant_address> <count> <per_second>' creates group chat rooms through the conference "
+				"factory of the default proxy, then leaves and deletes them.\n"
+				"A rate of 0 starts everything at once. 'status' and 'stop' apply to all the workloads, or to the given one. "
+				"A 'benchmark-finished' event is queued with the results when a workload completes.\n"
+				"To benchmark without network, run a second daemon with --auto-answer and another sip port, "
+				"and use sip:bench@127.0.0.1:<its port> as address.") {
+	addExample(new DaemonCommandExample("benchmark message sip:bench@127.0.0.1:5072 1000 100",
+						"Status: Ok\n\n"
+						"Workload: message\n"
+						"Target: sip:bench@127.0.0.1:5072\n"
+						"State: running\n"
+						"Rate: 100.0/s\n"
+						"Count: 1000\n"
+						"Started: 1\n"
+						"Succeeded: 0\n"
+						"Failed: 0\n"
+						"Pending: 1\n"
+						"Duration: 0.000s\n"
+						"Throughput: 0.0/s\n"
+						"Latency: p50=0.0ms p90=0.0ms p99=0.0ms max=0.0ms"));
+	addExample(new DaemonCommandExample("benchmark status call",
+						"Status: Ok\n\n"
+						"Workload: call\n"
+						"Target: sip:bench@127.0.0.1:5072\n"
+						"State: finished\n"
+						"Rate: 10.0/s\n"
+						"Count: 100\n"
+						"Started: 100\n"
+						"Succeeded: 100\n"
+						"Failed: 0\n"
+						"Pending: 0\n"
+						"Duration: 11.013s\n"
+						"Throughput: 9.1/s\n"
+						"Latency: p50=14.2ms p90=21.7ms p99=38.4ms max=41.0ms"));
+	addExample(new DaemonCommandExample("benchmark stop register",
+						"Status: Error\n"
+						"Reason: No register benchmark."));
+}
+
+BenchmarkCommand::~BenchmarkCommand() {
+	for (auto &entry : mWorkloads)
+		entry.second->stop();
+	mWorkloads.clear();
+	if (mCore) {
+		linphone_core_remove_iterate_hook(mCore, iterate, this);
+		linphone_core_remove_callbacks(mCore, mCbs);
+		linphone_core_cbs_unref(mCbs);
+	}
+}
+
+BenchmarkWorkload *BenchmarkCommand::findWorkload(const string &name) const {
+	auto it = mWorkloads.find(name);
+	return it == mWorkloads.end() ? nullptr : it->second.get();
+}
+
+void BenchmarkCommand::start(Daemon *app, BenchmarkWorkload *workload) {
+	if (!mCore) {
+		mCore = app->getCore();
+		mCbs = linphone_factory_create_core_cbs(linphone_factory_get());
+		linphone_core_cbs_set_registration_state_changed(mCbs, registrationStateChanged);
+		linphone_core_cbs_set_call_state_changed(mCbs, callStateChanged);
+		linphone_core_cbs_set_chat_room_state_changed(mCbs, chatRoomStateChanged);
+		linphone_core_cbs_set_user_data(mCbs, this);
+		linphone_core_add_callbacks(mCore, mCbs);
+		linphone_core_add_iterate_hook(mCore, iterate, this);
+	}
+
+	unique_ptr<BenchmarkWorkload> &entry = mWorkloads[workload->getName()];
+	if (entry)
+		entry->stop();
+	entry.reset(workload);
+	// The first operations are started right away, the next ones by the iterate hook.
+	workload->tick(Clock::now());
+	app->sendResponse(Response(workload->report(), Response::Ok));
+}
+
+void BenchmarkCommand::exec(Daemon *app, const string& args) {
+	LinphoneCore *lc = app->getCore();
+	string param;
+	istringstream ist(args);
+	ist >> param;
+	if (ist.fail()) {
+		app->sendResponse(Response("Missing parameter.", Response::Error));
+		return;
+	}
+
+	if (param.compare("status") == 0 || param.compare("stop") == 0) {
+		string name;
+		ist >> name;
+		ostringstream ost;
+		for (const auto &entry : mWorkloads) {
+			if (!name.empty() && entry.first != name)
+				continue;
+			if (param.compare("stop") == 0)
+				entry.second->stop();
+			if (ost.tellp() > 0)
+				ost << "\n";
+			ost << entry.second->report();
+		}
+		if (ost.tellp() == 0) {
+			app->sendResponse(Response(name.empty() ? "No benchmark." : "No " + name + " benchmark.", Response::Error));
+			return;
+		}
+		app->sendResponse(Response(ost.str(), Response::Ok));
+		return;
+	}
+
+	BenchmarkWorkload *current = findWorkload(param);
+	if (current && current->isRunning()) {
+		app->sendResponse(Response("A " + param + " benchmark is already running.", Response::Error));
+		return;
+	}
+
+	string target;
+	int count;
+	float rate = 0;
+	ist >> target >> count;
+	if (ist.fail() || count <= 0) {
+		app->sendResponse(Response("Missing/Incorrect parameter(s).", Response::Error));
+		return;
+	}
+	ist >> rate;
+	if (ist.fail()) {
+		if (param.compare("register") != 0) {
+			app->sendResponse(Response("Missing/Incorrect rate.", Response::Error));
+			return;
+		}
+		ist.clear();
+		rate = 0;
+	}
+	if (rate < 0) {
+		app->sendResponse(Response("Incorrect rate.", Response::Error));
+		return;
+	}
+
+	if (param.compare("register") == 0) {
+		string prefix = "bench-";
+		string password;
+		ist >> prefix >> password;
+		LinphoneAddress *proxy = linphone_factory_create_address(linphone_factory_get(), target.c_str());
+		if (!proxy) {
+			app->sendResponse(Response("Bad proxy address.", Response::Error));
+			return;
+		}
+		string domain = linphone_address_get_domain(proxy);
+		linphone_address_unref(proxy);
+		start(app, new RegisterWorkload(app, target, domain, rate, count, prefix, password));
+	} else if (param.compare("call") == 0) {
+		int hold = 1;
+		ist >> hold;
+		if (ist.fail()) {
+			ist.clear();
+			hold = 1;
+		}
+		if (hold < 0) {
+			app->sendResponse(Response("Incorrect hold duration.", Response::Error));
+			return;
+		}
+		start(app, new CallWorkload(app, target, rate, count, hold));
+	} else if (param.compare("message") == 0) {
+		LinphoneAddress *addr = linphone_core_interpret_url(lc, target.c_str());
+		if (!addr) {
+			app->sendResponse(Response("Bad sip uri.", Response::Error));
+			return;
+		}
+		LinphoneChatRoom *cr = linphone_core_get_chat_room(lc, addr);
+		linphone_address_unref(addr);
+		if (!cr) {
+			app->sendResponse(Response("Internal error creating chat room.", Response::Error));
+			return;
+		}
+		start(app, new MessageWorkload(app, target, cr, rate, count));
+	} else if (param.compare("group-chat") == 0) {
+		LinphoneProxyConfig *cfg = linphone_core_get_default_proxy_config(lc);
+		if (!cfg || !linphone_proxy_config_get_conference_factory_uri(cfg)) {
+			app->sendResponse(Response("No conference factory uri on the default proxy.", Response::Error));
+			return;
+		}
+		LinphoneAddress *participant = linphone_core_interpret_url(lc, target.c_str());
+		if (!participant) {
+			app->sendResponse(Response("Bad participant address.", Response::Error));
+			return;
+		}
+		start(app, new GroupChatWorkload(app, target, participant, rate, count));
+	} else {
+		app->sendResponse(Response("Incorrect parameter.", Response::Error));
+	}
+}
+
+// -----------------------------------------------------------------------------
+
+bool_t BenchmarkCommand::iterate(void *data) {
+	BenchmarkCommand *command = static_cast<BenchmarkCommand *>(data);
+	Clock::time_point now = Clock::now();
+	for (auto &entry : command->mWorkloads)
+		entry.second->tick(now);
+	return TRUE;
+}
+
+void BenchmarkCommand::registrationStateChanged(LinphoneCore *lc, LinphoneProxyConfig *cfg, LinphoneRegistrationState state, const char *message) {
+	BenchmarkCommand *command = static_cast<BenchmarkCommand *>(linphone_core_cbs_get_user_data(linphone_core_get_current_callbacks(lc)));
+	BenchmarkWorkload *workload = command->findWorkload("register");
+	if (workload)
+		workload->registrationStateChanged(cfg, state);
+}
+
+void BenchmarkCommand::callStateChanged(LinphoneCore *lc, LinphoneCall *call, LinphoneCallState state, const char *message) {
+	BenchmarkCommand *command = static_cast<BenchmarkCommand *>(linphone_core_cbs_get_user_data(linphone_core_get_current_callbacks(lc)));
+	BenchmarkWorkload *workload = command->findWorkload("call");
+	if (workload)
+		workload->callStateChanged(call, state);
+}
+
+void BenchmarkCommand::chatRoomStateChanged(LinphoneCore *lc, LinphoneChatRoom *cr, LinphoneChatRoomState state) {
+	BenchmarkCommand *command = static_cast<BenchmarkCommand *>(linphone_core_cbs_get_user_data(linphone_core_get_current_callbacks(lc)));
+	BenchmarkWorkload *workload = command->findWorkload("group-chat");
+	if (workload)
+		workload->chatRoomStateChanged(cr, state);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LINPHONE_DAEMON_COMMAND_BENCHMARK_H_
+#define LINPHONE_DAEMON_COMMAND_BENCHMARK_H_
+
+#include <memory>
+
+#include "daemon.h"
+
+class BenchmarkWorkload;
+
+/*
+ * Load generator: starts registrations, calls, messages or group chat rooms at a given rate
+ * and measures how long the core takes to complete each of them.
+ * The workloads are paced from an iterate hook and run in the daemon main loop.
+ */
+class BenchmarkCommand: public DaemonCommand {
+public:
+	BenchmarkCommand();
+	~BenchmarkCommand();
+
+	void exec(Daemon *app, const std::string& args) override;
+
+private:
+	void start(Daemon *app, BenchmarkWorkload *workload);
+	BenchmarkWorkload *findWorkload(const std::string &name) const;
+
+	static bool_t iterate(void *data);
+	static void registrationStateChanged(LinphoneCore *lc, LinphoneProxyConfig *cfg, LinphoneRegistrationState state, const char *message);
+	static void callStateChanged(LinphoneCore *lc, LinphoneCall *call, LinphoneCallState state, const char *message);
+	static void chatRoomStateChanged(LinphoneCore *lc, LinphoneChatRoom *cr, LinphoneChatRoomState state);
+
+	LinphoneCore *mCore = nullptr;
+	LinphoneCoreCbs *mCbs = nullptr;
+	std::map<std::string, std::unique_ptr<BenchmarkWorkload>> mWorkloads;
+};
+
+#endif // LINPHONE_DAEMON_COMMAND_BENCHMARK_H_
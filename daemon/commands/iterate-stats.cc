@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "iterate-stats.h"
+
+using namespace std;
+
+class IterateStatsResponse : public Response {
+public:
+	IterateStatsResponse(LinphoneCore *core);
+};
+
+IterateStatsResponse::IterateStatsResponse(LinphoneCore *core) : Response() {
+	ostringstream ost;
+	LinphoneIterateStats *stats = linphone_core_get_iterate_stats(core);
+	ost << "State: " << (stats ? "enabled" : "disabled") << "\n";
+	ost << "Budget: " << linphone_core_get_iterate_budget(core) << "ms\n";
+	if (stats) {
+		ost << "OverBudget: " << linphone_iterate_stats_get_over_budget_count(stats) << "\n";
+		for (int i = 0; i < LinphoneIterateStepCount; i++) {
+			LinphoneIterateStep step = (LinphoneIterateStep)i;
+			ost << linphone_iterate_step_to_string(step) << ":"
+				<< " count=" << linphone_iterate_stats_get_count(stats, step)
+				<< " mean=" << linphone_iterate_stats_get_mean(stats, step) << "us"
+				<< " p50=" << linphone_iterate_stats_get_percentile(stats, step, 50.f) << "us"
+				<< " p99=" << linphone_iterate_stats_get_percentile(stats, step, 99.f) << "us"
+				<< " p99.9=" << linphone_iterate_stats_get_percentile(stats, step, 99.9f) << "us"
+				<< " max=" << linphone_iterate_stats_get_max(stats, step) << "us\n";
+		}
+		linphone_iterate_stats_unref(stats);
+	}
+	setBody(ost.str());
+}
+
+IterateStatsCommand::IterateStatsCommand() :
+		DaemonCommand("iterate-stats", "iterate-stats [enable|disable|reset|budget <milliseconds>]",
+				"Show the durations of the main loop steps, in microseconds.\n"
+				"'enable' and 'disable' control the recording, 'reset' clears the recorded durations, "
+				"'budget' sets the duration above which an iteration is logged as a warning (0 to disable).") {
+	addExample(new DaemonCommandExample("iterate-stats enable",
+						"Status: Ok\n\n"
+						"State: enabled\n"
+						"Budget: 0ms\n"
+						"OverBudget: 0\n"
+						"Total: count=0 mean=0us p50=0us p99=0us p99.9=0us max=0us\n"
+						"..."));
+	addExample(new DaemonCommandExample("iterate-stats budget 50",
+						"Status: Ok\n\n"
+						"State: enabled\n"
+						"Budget: 50ms\n"
+						"OverBudget: 0\n"
+						"Total: count=2110 mean=312us p50=219us p99=2303us p99.9=9727us max=11841us\n"
+						"..."));
+}
+
+void IterateStatsCommand::exec(Daemon *app, const string& args) {
+	LinphoneCore *lc = app->getCore();
+	string param;
+	istringstream ist(args);
+	ist >> param;
+	if (ist.fail()) {
+		app->sendResponse(IterateStatsResponse(lc));
+		return;
+	}
+
+	if (param.compare("enable") == 0) {
+		linphone_core_enable_iterate_stats(lc, TRUE);
+	} else if (param.compare("disable") == 0) {
+		linphone_core_enable_iterate_stats(lc, FALSE);
+	} else if (param.compare("reset") == 0) {
+		linphone_core_reset_iterate_stats(lc);
+	} else if (param.compare("budget") == 0) {
+		int budget;
+		ist >> budget;
+		if (ist.fail() || budget < 0) {
+			app->sendResponse(Response("Invalid budget.", Response::Error));
+			return;
+		}
+		linphone_core_set_iterate_budget(lc, budget);
+	} else {
+		app->sendResponse(Response("Incorrect parameter.", Response::Error));
+		return;
+	}
+	app->sendResponse(IterateStatsResponse(lc));
+}
@@ -52,6 +52,7 @@
 #include "commands/audio-stream-stop.h"
 #include "commands/audio-stream-stats.h"
 #include "commands/auth-infos-clear.h"
+#include "commands/benchmark.h"
 #include "commands/call.h"
 #include "commands/call-stats.h"
 #include "commands/call-status.h"
@@ -66,6 +67,7 @@
 #include "commands/firewall-policy.h"
 #include "commands/help.h"
 #include "commands/ipv6.h"
+#include "commands/iterate-stats.h"
 #include "commands/media-encryption.h"
 #include "commands/msfilter-add-fmtp.h"
 #include "commands/play-wav.h"
@@ -491,6 +493,8 @@ void Daemon::initCommands() {
 	mCommands.push_back(new JitterBufferCommand());
 	mCommands.push_back(new JitterBufferResetCommand());
 	mCommands.push_back(new VersionCommand());
+	mCommands.push_back(new IterateStatsCommand());
+	mCommands.push_back(new BenchmarkCommand());
 	mCommands.push_back(new QuitCommand());
 	mCommands.push_back(new HelpCommand());
 	mCommands.push_back(new ConfigGetCommand());
@@ -33,9 +33,11 @@
 #include "linphone/api/c-chat-room-cbs.h"
 #include "linphone/api/c-chat-room.h"
 #include "linphone/api/c-content.h"
+#include "linphone/api/c-core-shards.h"
 #include "linphone/api/c-dial-plan.h"
 #include "linphone/api/c-event-log.h"
 #include "linphone/api/c-magic-search.h"
+#include "linphone/api/c-object-array.h"
 #include "linphone/api/c-participant-imdn-state.h"
 #include "linphone/api/c-participant.h"
 #include "linphone/api/c-participant-device.h"
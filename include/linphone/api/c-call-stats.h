@@ -44,6 +44,19 @@
 #define LINPHONE_CALL_STATS_SENT_RTCP_UPDATE (1 << 1) /**< sent_rtcp field of LinphoneCallStats object has been updated */
 #define LINPHONE_CALL_STATS_PERIODICAL_UPDATE (1 << 2) /**< Every seconds LinphoneCallStats object has been updated */
 
+/**
+ * A sample of the statistics of a stream, recorded every [rtp] stats_history_interval ms while the stream is running.
+ */
+struct _LinphoneCallStatsSample {
+	uint64_t time; /**< Time the sample was recorded, in ms, as given by ortp_get_cur_time_ms() */
+	float receiver_interarrival_jitter; /**< Interarrival jitter reported by the remote end in its last RTCP report, in s */
+	float receiver_loss_rate; /**< Loss rate reported by the remote end in its last RTCP report, in percent */
+	float round_trip_delay; /**< Round trip delay in s, -1 if unknown */
+	float download_bandwidth; /**< Download bandwidth in kbit/s */
+	float upload_bandwidth; /**< Upload bandwidth in kbit/s */
+	float jitter_buffer_size_ms; /**< Jitter buffer size in ms */
+};
+
 /**
  * Increment refcount.
  * @param[in] stats #LinphoneCallStats object
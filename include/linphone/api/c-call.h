@@ -166,6 +166,14 @@ LINPHONE_PUBLIC LinphoneCall *linphone_call_get_replaced_call (LinphoneCall *cal
 **/
 LINPHONE_PUBLIC int linphone_call_get_duration (const LinphoneCall *call);
 
+/**
+ * Returns the time spent negotiating the codecs and streams of the call with SDP offer/answer, in microseconds.
+ * All the negotiations of the call (initial INVITE, re-INVITEs and UPDATEs) are counted.
+ * @param call #LinphoneCall object. @notnil
+ * @return the total offer/answer processing time in microseconds.
+**/
+LINPHONE_PUBLIC unsigned int linphone_call_get_offer_answer_time (const LinphoneCall *call);
+
 /**
  * Returns current parameters associated to the call.
 **/
@@ -790,6 +798,26 @@ LINPHONE_PUBLIC LinphoneCallStats *linphone_call_get_stats(LinphoneCall *call, L
 
 LINPHONE_PUBLIC LinphoneCallStats *linphone_call_get_audio_stats(LinphoneCall *call);
 
+/**
+ * Get the number of statistics samples recorded for a stream of the call.
+ * Samples are recorded every [rtp] stats_history_interval ms (0, the default, disables them),
+ * and the last [rtp] stats_history_depth samples are kept.
+ * @param call the call
+ * @param type the stream type
+ * @return the number of samples available through linphone_call_get_stats_history_sample()
+**/
+LINPHONE_PUBLIC unsigned int linphone_call_get_stats_history_size(const LinphoneCall *call, LinphoneStreamType type);
+
+/**
+ * Get a statistics sample recorded for a stream of the call, without copying it.
+ * @param call the call
+ * @param type the stream type
+ * @param index index of the sample, from 0 (the oldest) to linphone_call_get_stats_history_size() - 1
+ * @return the sample, or NULL if index is out of range. It is only valid until the next sample is recorded.
+ * @donotwrap
+**/
+LINPHONE_PUBLIC const LinphoneCallStatsSample *linphone_call_get_stats_history_sample(const LinphoneCall *call, LinphoneStreamType type, unsigned int index);
+
 LINPHONE_PUBLIC LinphoneCallStats *linphone_call_get_video_stats(LinphoneCall *call);
 
 LINPHONE_PUBLIC LinphoneCallStats *linphone_call_get_text_stats(LinphoneCall *call);
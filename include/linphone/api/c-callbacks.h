@@ -351,6 +351,13 @@ typedef void (*LinphoneChatRoomCbsParticipantRegistrationUnsubscriptionRequested
  */
 typedef void (*LinphoneChatRoomCbsShouldChatMessageBeStoredCb) (LinphoneChatRoom *cr, LinphoneChatMessage *msg);
 
+/**
+ * Task posted to a shard with linphone_core_shards_post(), run on the thread of the shard.
+ * @param[in] core The #LinphoneCore of the shard
+ * @param[in] user_data The user data given to linphone_core_shards_post()
+ */
+typedef void (*LinphoneCoreShardsTaskCb) (LinphoneCore *core, void *user_data);
+
 /**
  * @}
 **/
@@ -241,6 +241,17 @@ LINPHONE_PUBLIC bctbx_list_t *linphone_chat_room_get_history (LinphoneChatRoom *
  */
 LINPHONE_PUBLIC bctbx_list_t *linphone_chat_room_get_history_range (LinphoneChatRoom *cr, int begin, int end);
 
+/**
+ * Gets the messages in the given range, sorted from oldest to most recent, as a contiguous array.
+ * Prefer it to linphone_chat_room_get_history_range() to page through large histories: no intermediate list is built.
+ * @param[in] cr The #LinphoneChatRoom object corresponding to the conversation for which messages should be retrieved
+ * @param[in] begin The first message of the range to be retrieved. History most recent message has index 0.
+ * @param[in] end The last message of the range to be retrieved. History oldest message has index of history size - 1
+ * @return A #LinphoneObjectArray of #LinphoneChatMessage, to be released with linphone_object_array_unref().
+ * @donotwrap
+ */
+LINPHONE_PUBLIC LinphoneObjectArray *linphone_chat_room_get_history_range_array (LinphoneChatRoom *cr, int begin, int end);
+
 /**
  * Gets nb_events most recent chat message events from cr chat room, sorted from oldest to most recent.
  * @param[in] cr The #LinphoneChatRoom object corresponding to the conversation for which events should be retrieved
@@ -275,6 +286,29 @@ LINPHONE_PUBLIC bctbx_list_t *linphone_chat_room_get_history_events (LinphoneCha
  */
 LINPHONE_PUBLIC bctbx_list_t *linphone_chat_room_get_history_range_events (LinphoneChatRoom *cr, int begin, int end);
 
+/**
+ * Gets the events in the given range, sorted from oldest to most recent, as a contiguous array.
+ * @param[in] cr The #LinphoneChatRoom object corresponding to the conversation for which events should be retrieved
+ * @param[in] begin The first event of the range to be retrieved. History most recent event has index 0.
+ * @param[in] end The last event of the range to be retrieved. History oldest event has index of history size - 1
+ * @return A #LinphoneObjectArray of #LinphoneEventLog, to be released with linphone_object_array_unref().
+ * @donotwrap
+ */
+LINPHONE_PUBLIC LinphoneObjectArray *linphone_chat_room_get_history_range_events_array (LinphoneChatRoom *cr, int begin, int end);
+
+/**
+ * Searches the text messages of a chat room containing all the words of a text, in any order and ignoring case.
+ * When the database has a full-text index (sqlite built with fts5 and [storage] chat_message_search_index not
+ * set to 0), words are matched as whole words or prefixes and the best matches come first. Otherwise words are
+ * matched anywhere in the text and the most recent messages come first.
+ * @param[in] cr The #LinphoneChatRoom object corresponding to the conversation to search
+ * @param[in] text The words to look for.
+ * @param[in] begin The index of the first result to return, 0 for the best match.
+ * @param[in] end The index after the last result to return, -1 for all the results.
+ * @return \bctbx_list{LinphoneEventLog} \onTheFlyList
+ */
+LINPHONE_PUBLIC bctbx_list_t *linphone_chat_room_search_messages (LinphoneChatRoom *cr, const char *text, int begin, int end);
+
 /**
  * Gets the number of events in a chat room.
  * @param[in] cr The #LinphoneChatRoom object corresponding to the conversation for which size has to be computed
@@ -464,6 +498,14 @@ LINPHONE_PUBLIC int linphone_chat_room_get_nb_participants (const LinphoneChatRo
  */
 LINPHONE_PUBLIC bctbx_list_t * linphone_chat_room_get_participants (const LinphoneChatRoom *cr);
 
+/**
+ * Get the participants of a chat room as a contiguous array.
+ * @param[in] cr A #LinphoneChatRoom object
+ * @return A #LinphoneObjectArray of #LinphoneParticipant, to be released with linphone_object_array_unref().
+ * @donotwrap
+ */
+LINPHONE_PUBLIC LinphoneObjectArray *linphone_chat_room_get_participants_array (const LinphoneChatRoom *cr);
+
 /**
  * Get the subject of a chat room.
  * @param[in] cr A #LinphoneChatRoom object
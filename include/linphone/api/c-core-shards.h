@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_C_CORE_SHARDS_H_
+#define _L_C_CORE_SHARDS_H_
+
+#include "linphone/api/c-callbacks.h"
+#include "linphone/api/c-types.h"
+
+// =============================================================================
+
+#ifdef __cplusplus
+	extern "C" {
+#endif // ifdef __cplusplus
+
+/**
+ * @addtogroup misc
+ * @{
+ */
+
+/**
+ * Create a set of core shards, to use several CPUs in one process.
+ * Each shard runs a #LinphoneCore created, iterated and destroyed on its own thread, the cores are
+ * created by linphone_core_shards_start().
+ * The configuration files are read once, each core gets a read-only copy of them in which the sip ports
+ * are moved by the index of the shard times [misc] core_shards_port_stride (10 by default) and a sqlite
+ * [storage] uri gets a "-shard<index>" suffix. Without [storage] uri each shard uses linphone-shard<index>.db
+ * in the data directory.
+ * @param[in] factory The #LinphoneFactory singleton.
+ * @param[in] count The number of shards, at least 1.
+ * @param[in] config_path A path to a config file. If it does not exists it will be created. @maybenil
+ * @param[in] factory_config_path A path to a read-only config file that can be used to store hard-coded
+ * preferences such as proxy settings or internal preferences. @maybenil
+ * @param[in] system_context A pointer to a system object required by the core to operate. Currently it is
+ * required to pass an android Context on android, pass NULL on other platforms.
+ * @return A new #LinphoneCoreShards object.
+ */
+LINPHONE_PUBLIC LinphoneCoreShards *linphone_factory_create_core_shards (
+	const LinphoneFactory *factory,
+	int count,
+	const char *config_path,
+	const char *factory_config_path,
+	void *system_context
+);
+
+/**
+ * Acquire a reference to the #LinphoneCoreShards object.
+ * @param[in] shards #LinphoneCoreShards object.
+ * @return The same #LinphoneCoreShards object.
+ */
+LINPHONE_PUBLIC LinphoneCoreShards *linphone_core_shards_ref (LinphoneCoreShards *shards);
+
+/**
+ * Release reference to the #LinphoneCoreShards object. The shards are stopped when it is destroyed.
+ * @param[in] shards #LinphoneCoreShards object.
+ */
+LINPHONE_PUBLIC void linphone_core_shards_unref (LinphoneCoreShards *shards);
+
+/**
+ * Create and start the cores of the shards.
+ * @param[in] shards #LinphoneCoreShards object.
+ * @return 0 if all the cores are running, -1 otherwise.
+ */
+LINPHONE_PUBLIC LinphoneStatus linphone_core_shards_start (LinphoneCoreShards *shards);
+
+/**
+ * Run the tasks already posted, then stop and destroy the cores of the shards.
+ * Must not be called from a shard.
+ * @param[in] shards #LinphoneCoreShards object.
+ */
+LINPHONE_PUBLIC void linphone_core_shards_stop (LinphoneCoreShards *shards);
+
+/**
+ * Get the number of shards.
+ * @param[in] shards #LinphoneCoreShards object.
+ * @return The number of shards.
+ */
+LINPHONE_PUBLIC int linphone_core_shards_get_count (const LinphoneCoreShards *shards);
+
+/**
+ * Get the core of a shard. A #LinphoneCore is not thread safe, it must only be used from the tasks
+ * posted to its shard.
+ * @param[in] shards #LinphoneCoreShards object.
+ * @param[in] index The index of the shard.
+ * @return The #LinphoneCore of the shard, NULL if the shards are not running. @maybenil
+ */
+LINPHONE_PUBLIC LinphoneCore *linphone_core_shards_get_core (const LinphoneCoreShards *shards, int index);
+
+/**
+ * Get the shard to which the application should post the tasks of a conference or a chat room.
+ * This is only an index helper: the shards do not route incoming requests themselves. The result
+ * only depends on the addresses and on the number of shards, it is the same on every platform and run.
+ * @param[in] shards #LinphoneCoreShards object.
+ * @param[in] peer_address The address of the conference or the peer of the chat room.
+ * @param[in] local_address The local address of the chat room. @maybenil
+ * @return The index of the shard.
+ */
+LINPHONE_PUBLIC int linphone_core_shards_get_index_for_conference (
+	const LinphoneCoreShards *shards,
+	const LinphoneAddress *peer_address,
+	const LinphoneAddress *local_address
+);
+
+/**
+ * Get the index of the shard running the calling thread.
+ * @return The index of the shard, -1 if the calling thread is not the one of a shard.
+ */
+LINPHONE_PUBLIC int linphone_core_shards_get_current_index (void);
+
+/**
+ * Post a task to a shard. This function is thread safe, it can be used from any shard or from another
+ * thread. The tasks posted to a shard are run in order, between two iterations of its core.
+ * @param[in] shards #LinphoneCoreShards object.
+ * @param[in] index The index of the shard.
+ * @param[in] cb The task to run.
+ * @param[in] user_data The data given to the task.
+ * @return 0 if the task is queued, -1 if the shards are not running or the index is invalid.
+ */
+LINPHONE_PUBLIC LinphoneStatus linphone_core_shards_post (
+	LinphoneCoreShards *shards,
+	int index,
+	LinphoneCoreShardsTaskCb cb,
+	void *user_data
+);
+
+/**
+ * Retrieve the user pointer associated with the #LinphoneCoreShards object.
+ * It may be read from all the shards, it must not be changed while they are running.
+ * @param[in] shards #LinphoneCoreShards object.
+ * @return The user pointer. @maybenil
+ */
+LINPHONE_PUBLIC void *linphone_core_shards_get_user_data (const LinphoneCoreShards *shards);
+
+/**
+ * Assign a user pointer to the #LinphoneCoreShards object.
+ * @param[in] shards #LinphoneCoreShards object.
+ * @param[in] user_data The user pointer. @maybenil
+ */
+LINPHONE_PUBLIC void linphone_core_shards_set_user_data (LinphoneCoreShards *shards, void *user_data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+	}
+#endif // ifdef __cplusplus
+
+#endif // ifndef _L_C_CORE_SHARDS_H_
@@ -138,6 +138,19 @@ LINPHONE_PUBLIC bctbx_list_t *linphone_magic_search_get_contact_list_from_filter
 	const char *domain
 );
 
+/**
+ * Same as linphone_magic_search_get_contact_list_from_filter() but returns the results as a contiguous array.
+ * @param[in] filter word we search
+ * @param[in] domain domain which we want to search only
+ * @return A sorted #LinphoneObjectArray of #LinphoneSearchResult, to be released with linphone_object_array_unref().
+ * @donotwrap
+ **/
+LINPHONE_PUBLIC LinphoneObjectArray *linphone_magic_search_get_contact_array_from_filter (
+	const LinphoneMagicSearch *magic_search,
+	const char *filter,
+	const char *domain
+);
+
 /**
  * @}
  */
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_C_OBJECT_ARRAY_H_
+#define _L_C_OBJECT_ARRAY_H_
+
+#include "linphone/api/c-types.h"
+
+// =============================================================================
+
+#ifdef __cplusplus
+	extern "C" {
+#endif // ifdef __cplusplus
+
+/**
+ * @addtogroup misc
+ * @{
+ */
+
+/**
+ * Acquire a reference to the #LinphoneObjectArray object.
+ * @param[in] array #LinphoneObjectArray object.
+ * @return The same #LinphoneObjectArray object.
+ * @donotwrap
+ */
+LINPHONE_PUBLIC LinphoneObjectArray *linphone_object_array_ref (LinphoneObjectArray *array);
+
+/**
+ * Release reference to the #LinphoneObjectArray object.
+ * The references held on the contained objects are released with the array.
+ * @param[in] array #LinphoneObjectArray object.
+ * @donotwrap
+ */
+LINPHONE_PUBLIC void linphone_object_array_unref (LinphoneObjectArray *array);
+
+/**
+ * Get the number of objects contained in the array.
+ * @param[in] array #LinphoneObjectArray object.
+ * @return The number of objects.
+ * @donotwrap
+ */
+LINPHONE_PUBLIC size_t linphone_object_array_get_size (const LinphoneObjectArray *array);
+
+/**
+ * Get the object at the given position.
+ * The returned object is owned by the array, take a reference on it to keep it after the array is released.
+ * @param[in] array #LinphoneObjectArray object.
+ * @param[in] index The position of the object, must be lower than linphone_object_array_get_size().
+ * @return The object at the given position or NULL if the index is out of range.
+ * @donotwrap
+ */
+LINPHONE_PUBLIC void *linphone_object_array_get (const LinphoneObjectArray *array, size_t index);
+
+/**
+ * Get the contiguous storage of the array.
+ * It contains linphone_object_array_get_size() objects owned by the array.
+ * @param[in] array #LinphoneObjectArray object.
+ * @return The first element of the storage, NULL if the array is empty.
+ * @donotwrap
+ */
+LINPHONE_PUBLIC void * const *linphone_object_array_get_data (const LinphoneObjectArray *array);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+	}
+#endif // ifdef __cplusplus
+
+#endif // ifndef _L_C_OBJECT_ARRAY_H_
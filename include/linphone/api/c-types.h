@@ -165,12 +165,26 @@ typedef struct _LinphoneContent LinphoneContent;
  */
 typedef struct _LinphoneDialPlan LinphoneDialPlan;
 
+/**
+ * A #LinphoneCoreShards runs several #LinphoneCore, each one on its own thread.
+ * @ingroup misc
+ */
+typedef struct _LinphoneCoreShards LinphoneCoreShards;
+
 /**
  * A #LinphoneMagicSearch is used to do specifics searchs
  * @ingroup misc
  */
 typedef struct _LinphoneMagicSearch LinphoneMagicSearch;
 
+/**
+ * A #LinphoneObjectArray holds a contiguous, reference counted set of objects returned by a range or bulk getter.
+ * Its elements are untyped, so it is only available from C: the language wrappers keep using the list getters.
+ * @ingroup misc
+ * @donotwrap
+ */
+typedef struct _LinphoneObjectArray LinphoneObjectArray;
+
 /**
  * @ingroup misc
  */
@@ -51,6 +51,7 @@
 #include "linphone/im_encryption_engine.h"
 #include "linphone/im_notif_policy.h"
 #include "linphone/info_message.h"
+#include "linphone/iterate_stats.h"
 #include "linphone/logging.h"
 #include "linphone/lpconfig.h"
 #include "linphone/misc.h"
@@ -1127,6 +1128,55 @@ LINPHONE_PUBLIC void linphone_core_unref(LinphoneCore *lc);
 **/
 LINPHONE_PUBLIC void linphone_core_iterate(LinphoneCore *lc);
 
+/**
+ * Enable or disable the recording of the durations of the steps of linphone_core_iterate().
+ * The durations are accumulated in histograms that can be retrieved with linphone_core_get_iterate_stats().
+ * @param[in] lc #LinphoneCore object
+ * @param[in] enable TRUE to record iteration durations.
+ * @ingroup initializing
+**/
+LINPHONE_PUBLIC void linphone_core_enable_iterate_stats(LinphoneCore *lc, bool_t enable);
+
+/**
+ * Tells whether the durations of the steps of linphone_core_iterate() are recorded.
+ * @param[in] lc #LinphoneCore object
+ * @return TRUE if iteration durations are recorded.
+ * @ingroup initializing
+**/
+LINPHONE_PUBLIC bool_t linphone_core_iterate_stats_enabled(const LinphoneCore *lc);
+
+/**
+ * Get a snapshot of the durations of the steps of linphone_core_iterate().
+ * @param[in] lc #LinphoneCore object
+ * @return A new #LinphoneIterateStats object, or NULL if iterate stats are not enabled. @maybenil
+ * @ingroup initializing
+**/
+LINPHONE_PUBLIC LinphoneIterateStats *linphone_core_get_iterate_stats(const LinphoneCore *lc);
+
+/**
+ * Clear the durations recorded for linphone_core_iterate().
+ * @param[in] lc #LinphoneCore object
+ * @ingroup initializing
+**/
+LINPHONE_PUBLIC void linphone_core_reset_iterate_stats(LinphoneCore *lc);
+
+/**
+ * Set the maximum duration of a single linphone_core_iterate() call.
+ * A warning detailing the duration of each step is logged when an iteration exceeds it.
+ * @param[in] lc #LinphoneCore object
+ * @param[in] budget_ms The budget in milliseconds, 0 to disable the check.
+ * @ingroup initializing
+**/
+LINPHONE_PUBLIC void linphone_core_set_iterate_budget(LinphoneCore *lc, int budget_ms);
+
+/**
+ * Get the maximum duration of a single linphone_core_iterate() call.
+ * @param[in] lc #LinphoneCore object
+ * @return The budget in milliseconds, 0 if disabled.
+ * @ingroup initializing
+**/
+LINPHONE_PUBLIC int linphone_core_get_iterate_budget(const LinphoneCore *lc);
+
 /**
  * @ingroup initializing
  * add a listener to be notified of linphone core events. Once events are received, registered vtable are invoked in order.
@@ -2270,6 +2320,35 @@ LINPHONE_PUBLIC void linphone_core_remove_proxy_config(LinphoneCore *lc, Linphon
 **/
 LINPHONE_PUBLIC const bctbx_list_t *linphone_core_get_proxy_config_list(const LinphoneCore *lc);
 
+/**
+ * Gets the number of REGISTER requests waiting in the registration queue.
+ * The queue is only used when [sip] register_rate_limit, register_jitter or register_backoff is set.
+ * @param[in] lc The #LinphoneCore object
+ * @return the number of proxy configurations waiting for their REGISTER to be sent
+**/
+LINPHONE_PUBLIC unsigned int linphone_core_get_pending_registrations_count(const LinphoneCore *lc);
+
+/**
+ * Gets the number of REGISTER requests sent through the registration queue since the core was created.
+ * @param[in] lc The #LinphoneCore object
+ * @return the number of REGISTER requests that left the registration queue
+**/
+LINPHONE_PUBLIC unsigned int linphone_core_get_scheduled_registrations_count(const LinphoneCore *lc);
+
+/**
+ * Gets the average time REGISTER requests spent in the registration queue.
+ * @param[in] lc The #LinphoneCore object
+ * @return the average queueing latency in milliseconds, 0 if no REGISTER was queued
+**/
+LINPHONE_PUBLIC unsigned int linphone_core_get_registration_queue_average_latency(const LinphoneCore *lc);
+
+/**
+ * Gets the longest time a REGISTER request spent in the registration queue.
+ * @param[in] lc The #LinphoneCore object
+ * @return the maximum queueing latency in milliseconds
+**/
+LINPHONE_PUBLIC unsigned int linphone_core_get_registration_queue_max_latency(const LinphoneCore *lc);
+
 /** @deprecated Use linphone_core_set_default_proxy_config() instead. */
 #define linphone_core_set_default_proxy(lc, config) linphone_core_set_default_proxy_config(lc, config)
 
@@ -2334,6 +2413,17 @@ LINPHONE_PUBLIC LinphoneAuthInfo * linphone_core_create_auth_info(LinphoneCore *
  */
 LINPHONE_PUBLIC void linphone_core_add_auth_info(LinphoneCore *lc, const LinphoneAuthInfo *info);
 
+/**
+ * Adds several authentication informations to the #LinphoneCore at once, for example after the credentials of
+ * many accounts were changed on the server.
+ * Pending authentications are retried and the configuration is written once for all of them, instead of once per
+ * authentication information as linphone_core_add_auth_info() does.
+ * @param[in] lc The #LinphoneCore.
+ * @param[in] infos \bctbx_list{LinphoneAuthInfo} The authentication informations to add.
+ * @ingroup authentication
+ */
+LINPHONE_PUBLIC void linphone_core_add_auth_infos(LinphoneCore *lc, const bctbx_list_t *infos);
+
 /**
  * Removes an authentication information object.
  * @param[in] lc The #LinphoneCore from which the #LinphoneAuthInfo will be removed.
@@ -3478,6 +3568,17 @@ LINPHONE_PUBLIC bctbx_list_t *linphone_core_get_call_history_2(
 	const LinphoneAddress *local_addr
 );
 
+/**
+ * Get a page of call logs (past calls), most recent first, as a contiguous array.
+ * When a call logs database is used, only the requested page is read from it.
+ * @param[in] lc #LinphoneCore object.
+ * @param[in] offset Number of most recent call logs to skip.
+ * @param[in] count Maximum number of call logs to retrieve. 0 means everything after offset.
+ * @return A #LinphoneObjectArray of #LinphoneCallLog, to be released with linphone_object_array_unref().
+ * @donotwrap
+**/
+LINPHONE_PUBLIC LinphoneObjectArray *linphone_core_get_call_history_array(LinphoneCore *lc, int offset, int count);
+
 /**
  * Get the latest outgoing call log.
  * @param[in] lc #LinphoneCore object
@@ -4255,6 +4356,23 @@ LINPHONE_PUBLIC int linphone_core_get_mtu(const LinphoneCore *lc);
 **/
 LINPHONE_PUBLIC void linphone_core_set_mtu(LinphoneCore *lc, int mtu);
 
+/**
+ * Returns the number of times the local ip or the mtu to reach a call destination was found in the route cache.
+ * The route cache is cleared each time the network reachability changes.
+ * @param[in] lc #LinphoneCore object
+ * @return The number of route cache hits
+ * @ingroup media_parameters
+**/
+LINPHONE_PUBLIC unsigned int linphone_core_get_route_cache_hit_count(const LinphoneCore *lc);
+
+/**
+ * Returns the number of times the local ip or the mtu to reach a call destination had to be computed.
+ * @param[in] lc #LinphoneCore object
+ * @return The number of route cache misses
+ * @ingroup media_parameters
+**/
+LINPHONE_PUBLIC unsigned int linphone_core_get_route_cache_miss_count(const LinphoneCore *lc);
+
 /**
  * Enable or disable the UPDATE method support
  * @param[in] lc #LinphoneCore object
@@ -4488,6 +4606,16 @@ LINPHONE_PUBLIC int linphone_core_get_calls_nb(const LinphoneCore *lc);
 **/
 LINPHONE_PUBLIC const bctbx_list_t *linphone_core_get_calls(LinphoneCore *lc);
 
+/**
+ * Writes the stats history of all current calls to a CSV file, one line per sample.
+ * See linphone_call_get_stats_history_sample().
+ * @param[in] lc The #LinphoneCore object
+ * @param[in] path The path of the file to write, overwritten if it exists
+ * @return 0 if successful, -1 if the file could not be opened
+ * @ingroup call_control
+**/
+LINPHONE_PUBLIC LinphoneStatus linphone_core_dump_calls_stats_history(LinphoneCore *lc, const char *path);
+
 LINPHONE_PUBLIC LinphoneGlobalState linphone_core_get_global_state(const LinphoneCore *lc);
 
 /**
@@ -5676,6 +5804,17 @@ LINPHONE_PUBLIC LinphoneChatRoom *linphone_core_find_one_to_one_chat_room_2 (
 **/
 LINPHONE_PUBLIC void linphone_core_delete_chat_room(LinphoneCore *lc, LinphoneChatRoom *cr);
 
+/**
+ * Searches the text messages of all the chat rooms containing all the words of a text, in any order and ignoring
+ * case. The matching and the order of the results are the ones of linphone_chat_room_search_messages().
+ * @param[in] lc A #LinphoneCore object
+ * @param[in] text The words to look for.
+ * @param[in] begin The index of the first result to return, 0 for the best match.
+ * @param[in] end The index after the last result to return, -1 for all the results.
+ * @return \bctbx_list{LinphoneEventLog} \onTheFlyList
+**/
+LINPHONE_PUBLIC bctbx_list_t *linphone_core_search_chat_messages(LinphoneCore *lc, const char *text, int begin, int end);
+
 /**
  * Inconditionnaly disable incoming chat messages.
  * @param lc A #LinphoneCore object
@@ -5976,6 +6115,22 @@ LINPHONE_PUBLIC void linphone_core_set_friends_database_path(LinphoneCore *lc, c
 **/
 LINPHONE_PUBLIC const char* linphone_core_get_friends_database_path(LinphoneCore *lc);
 
+/**
+ * Gets the number of friends and friend lists rows written in the friends database since it was opened.
+ * @ingroup initializing
+ * @param lc the linphone core
+ * @return the number of rows inserted or updated
+**/
+LINPHONE_PUBLIC unsigned int linphone_core_get_friends_database_rows_written(const LinphoneCore *lc);
+
+/**
+ * Gets the time spent writing friends and friend lists in the friends database since it was opened, including the commits of the transactions.
+ * @ingroup initializing
+ * @param lc the linphone core
+ * @return the time spent writing, in milliseconds
+**/
+LINPHONE_PUBLIC unsigned int linphone_core_get_friends_database_write_time(const LinphoneCore *lc);
+
 /**
  * Create a new empty #LinphoneFriendList object.
  * @param[in] lc #LinphoneCore object.
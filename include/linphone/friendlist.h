@@ -120,6 +120,15 @@ LINPHONE_PUBLIC LinphoneFriendListStatus linphone_friend_list_add_friend(Linphon
 **/
 LINPHONE_PUBLIC LinphoneFriendListStatus linphone_friend_list_add_local_friend(LinphoneFriendList *list, LinphoneFriend *lf);
 
+/**
+ * Add several friends to a friend list, like linphone_friend_list_add_friend() does for each of them.
+ * The friends are saved in the friends database in a single transaction.
+ * @param[in] list #LinphoneFriendList object.
+ * @param[in] friends \bctbx_list{LinphoneFriend} the friends to add to the friend list.
+ * @return the amount of friends added to the friend list.
+**/
+LINPHONE_PUBLIC int linphone_friend_list_add_friends(LinphoneFriendList *list, const bctbx_list_t *friends);
+
 /**
  * Remove a friend from a friend list.
  * @param[in] list #LinphoneFriendList object.
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LINPHONE_ITERATE_STATS_H_
+#define LINPHONE_ITERATE_STATS_H_
+
+
+#include "linphone/types.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @addtogroup misc
+ * @{
+ */
+
+/**
+ * Acquire a reference to the iterate stats.
+ * @param[in] stats #LinphoneIterateStats object.
+ * @return The same #LinphoneIterateStats object.
+**/
+LINPHONE_PUBLIC LinphoneIterateStats *linphone_iterate_stats_ref(LinphoneIterateStats *stats);
+
+/**
+ * Release reference to the iterate stats.
+ * @param[in] stats #LinphoneIterateStats object.
+**/
+LINPHONE_PUBLIC void linphone_iterate_stats_unref(LinphoneIterateStats *stats);
+
+/**
+ * Get the number of durations recorded for a step.
+ * @param[in] stats #LinphoneIterateStats object.
+ * @param[in] step The #LinphoneIterateStep.
+ * @return The number of recorded durations.
+**/
+LINPHONE_PUBLIC unsigned int linphone_iterate_stats_get_count(const LinphoneIterateStats *stats, LinphoneIterateStep step);
+
+/**
+ * Get the mean duration of a step.
+ * @param[in] stats #LinphoneIterateStats object.
+ * @param[in] step The #LinphoneIterateStep.
+ * @return The mean duration in microseconds.
+**/
+LINPHONE_PUBLIC unsigned int linphone_iterate_stats_get_mean(const LinphoneIterateStats *stats, LinphoneIterateStep step);
+
+/**
+ * Get the maximum duration of a step.
+ * @param[in] stats #LinphoneIterateStats object.
+ * @param[in] step The #LinphoneIterateStep.
+ * @return The maximum duration in microseconds.
+**/
+LINPHONE_PUBLIC unsigned int linphone_iterate_stats_get_max(const LinphoneIterateStats *stats, LinphoneIterateStep step);
+
+/**
+ * Get a percentile of the durations of a step.
+ * The value is exact within the histogram precision of about 6%.
+ * @param[in] stats #LinphoneIterateStats object.
+ * @param[in] step The #LinphoneIterateStep.
+ * @param[in] percentile The percentile, between 0 and 100.
+ * @return The duration in microseconds below which the given percentage of the durations fall.
+**/
+LINPHONE_PUBLIC unsigned int linphone_iterate_stats_get_percentile(const LinphoneIterateStats *stats, LinphoneIterateStep step, float percentile);
+
+/**
+ * Get the number of iterations that exceeded the budget set with linphone_core_set_iterate_budget().
+ * @param[in] stats #LinphoneIterateStats object.
+ * @return The number of iterations over budget.
+**/
+LINPHONE_PUBLIC unsigned int linphone_iterate_stats_get_over_budget_count(const LinphoneIterateStats *stats);
+
+/**
+ * Get a printable name of a step.
+ * @param[in] step The #LinphoneIterateStep.
+ * @return The name of the step.
+**/
+LINPHONE_PUBLIC const char *linphone_iterate_step_to_string(LinphoneIterateStep step);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LINPHONE_ITERATE_STATS_H_ */
@@ -150,6 +150,25 @@ LINPHONE_PUBLIC unsigned int linphone_logging_service_get_log_level_mask(const L
  */
 LINPHONE_PUBLIC void linphone_logging_service_set_log_file(const LinphoneLoggingService *service, const char *dir, const char *filename, size_t max_size);
 
+/**
+ * @brief Enables or disables asynchronous writing of liblinphone log messages.
+ *
+ * When enabled, messages are pushed into a lock-free queue and written by a background
+ * thread, so that the calling thread does not wait for the log handlers. Messages of other
+ * domains (belle-sip, mediastreamer...) and fatal messages are still written synchronously.
+ *
+ * @param log_service The logging service singleton.
+ * @param enable TRUE to write messages from a background thread.
+ */
+LINPHONE_PUBLIC void linphone_logging_service_enable_async_sink(LinphoneLoggingService *log_service, bool_t enable);
+
+/**
+ * @brief Tells whether liblinphone log messages are written asynchronously.
+ * @param log_service The logging service singleton.
+ * @return TRUE if the asynchronous sink is enabled.
+ */
+LINPHONE_PUBLIC bool_t linphone_logging_service_async_sink_enabled(const LinphoneLoggingService *log_service);
+
 /**
  * @brief Increases the reference counter.
  */
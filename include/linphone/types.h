@@ -291,6 +291,13 @@ typedef struct _LinphoneCallParams LinphoneCallParams;
 **/
 typedef struct _LinphoneCallStats LinphoneCallStats;
 
+/**
+ * A sample of the statistics of a stream, kept in the stats history of the call.
+ * See linphone_call_get_stats_history_sample().
+ * @ingroup call_misc
+**/
+typedef struct _LinphoneCallStatsSample LinphoneCallStatsSample;
+
 /**
  * Enum representing the status of a call
  * @ingroup call_logs
@@ -1134,6 +1141,31 @@ typedef enum _LinphoneVersionUpdateCheckResult {
  */
 typedef struct _LinphoneVideoDefinition LinphoneVideoDefinition;
 
+/**
+ * The #LinphoneIterateStats object holds duration histograms of the steps of linphone_core_iterate().
+ * @ingroup misc
+ */
+typedef struct _LinphoneIterateStats LinphoneIterateStats;
+
+/**
+ * Enum describing the steps of linphone_core_iterate() measured by #LinphoneIterateStats.
+ * @ingroup misc
+ */
+typedef enum _LinphoneIterateStep {
+	LinphoneIterateStepTotal, /**< Whole iteration */
+	LinphoneIterateStepSal, /**< SIP stack iteration */
+	LinphoneIterateStepEventQueue, /**< Mediastreamer2 event queue pumping */
+	LinphoneIterateStepProxyUpdate, /**< Proxy configs update */
+	LinphoneIterateStepCalls, /**< Calls iteration */
+	LinphoneIterateStepVideoPreview, /**< Video preview handling */
+	LinphoneIterateStepHooks, /**< Iterate hooks */
+	LinphoneIterateStepPluginTasks, /**< SIP setup plugin tasks */
+	LinphoneIterateStepSubscribes, /**< Initial presence subscribes */
+	LinphoneIterateStepConfigSync, /**< Configuration file synchronization */
+	LinphoneIterateStepFriendLists, /**< Dirty friends update */
+	LinphoneIterateStepCount /**< Number of steps, not a step */
+} LinphoneIterateStep;
+
 /**
  * Structure describing policy regarding video streams establishments.
  * @ingroup media_parameters
@@ -41,6 +41,16 @@ public:
 	static void clearSipAddressesCache ();
 
 private:
+	// Values derived from the whole address, computed on first use.
+	enum CachedField {
+		CachedScheme = 1 << 0,
+		CachedUsername = 1 << 1,
+		CachedDomain = 1 << 2,
+		CachedString = 1 << 3,
+		CachedStringUriOnly = 1 << 4,
+		CachedWeakKey = 1 << 5
+	};
+
 	struct AddressCache {
 		std::string scheme;
 		std::string displayName;
@@ -49,11 +59,25 @@ private:
 		std::string methodParam;
 		std::string password;
 
+		std::string asString;
+		std::string asStringUriOnly;
+		std::string weakKey;
+		int validFields = 0;
+
 		std::unordered_map<std::string, std::string> headers;
 		std::unordered_map<std::string, std::string> params;
 		std::unordered_map<std::string, std::string> uriParams;
 	};
 
+	// Must be called by every operation modifying the internal address.
+	inline void invalidateCache () {
+		cache.validFields = 0;
+	}
+
+	const std::string &getCachedString () const;
+	const std::string &getCachedStringUriOnly () const;
+	const std::string &getWeakKey () const;
+
 	SalAddress *internalAddress = nullptr;
 	mutable AddressCache cache;
 
@@ -17,6 +17,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <mutex>
+
 #include "address-p.h"
 #include "address/identity-address.h"
 #include "c-wrapper/c-wrapper.h"
@@ -55,10 +57,13 @@ namespace {
 	private:
 		SalAddress *mSalAddress;
 	};
+	// Shared by all the cores of the process, which may run on several threads (see CoreShards).
 	LruCache<string, SalAddressWrap> addressesCache;
+	mutex addressesCacheMutex;
 }
 
 static SalAddress *getSalAddressFromCache (const string &uri) {
+	lock_guard<mutex> lock(addressesCacheMutex);
 	SalAddressWrap *wrap = addressesCache[uri];
 	if (wrap)
 		return sal_address_clone(wrap->get());
@@ -78,9 +83,45 @@ void AddressPrivate::setInternalAddress (const SalAddress *addr) {
 	if (internalAddress)
 		sal_address_unref(internalAddress);
 	internalAddress = sal_address_clone(addr);
+	invalidateCache();
+}
+
+const string &AddressPrivate::getCachedString () const {
+	if (!(cache.validFields & CachedString)) {
+		char *buf = sal_address_as_string(internalAddress);
+		cache.asString = buf;
+		ms_free(buf);
+		cache.validFields |= CachedString;
+	}
+	return cache.asString;
+}
+
+const string &AddressPrivate::getCachedStringUriOnly () const {
+	if (!(cache.validFields & CachedStringUriOnly)) {
+		char *buf = sal_address_as_string_uri_only(internalAddress);
+		cache.asStringUriOnly = buf;
+		ms_free(buf);
+		cache.validFields |= CachedStringUriOnly;
+	}
+	return cache.asStringUriOnly;
+}
+
+// Normalized form of the fields compared by Address::weakEqual().
+const string &AddressPrivate::getWeakKey () const {
+	L_Q();
+	if (!(cache.validFields & CachedWeakKey)) {
+		cache.weakKey = q->getUsername();
+		cache.weakKey += '\0';
+		cache.weakKey += q->getDomain();
+		cache.weakKey += '\0';
+		cache.weakKey += Utils::toString(q->getPort());
+		cache.validFields |= CachedWeakKey;
+	}
+	return cache.weakKey;
 }
 
 void AddressPrivate::clearSipAddressesCache () {
+	lock_guard<mutex> lock(addressesCacheMutex);
 	addressesCache.clear();
 }
 
@@ -111,8 +152,10 @@ Address::Address (const IdentityAddress &identityAddress) : ClonableObject(*new
 Address::Address (const Address &other) : ClonableObject(*new AddressPrivate) {
 	L_D();
 	SalAddress *salAddress = other.getPrivate()->internalAddress;
-	if (salAddress)
+	if (salAddress) {
 		d->internalAddress = sal_address_clone(salAddress);
+		d->cache = other.getPrivate()->cache;
+	}
 }
 
 Address::~Address () {
@@ -128,13 +171,18 @@ Address &Address::operator= (const Address &other) {
 			sal_address_unref(d->internalAddress);
 		SalAddress *salAddress = other.getPrivate()->internalAddress;
 		d->internalAddress = salAddress ? sal_address_clone(salAddress) : nullptr;
+		d->cache = other.getPrivate()->cache;
 	}
 
 	return *this;
 }
 
 bool Address::operator== (const Address &other) const {
-	return asString() == other.asString();
+	L_D();
+	const AddressPrivate *dOther = other.getPrivate();
+	if (!d->internalAddress || !dOther->internalAddress)
+		return !d->internalAddress && !dOther->internalAddress;
+	return d->getCachedString() == dOther->getCachedString();
 }
 
 bool Address::operator!= (const Address &other) const {
@@ -142,7 +190,11 @@ bool Address::operator!= (const Address &other) const {
 }
 
 bool Address::operator< (const Address &other) const {
-	return asString() < other.asString();
+	L_D();
+	const AddressPrivate *dOther = other.getPrivate();
+	if (!d->internalAddress || !dOther->internalAddress)
+		return !d->internalAddress && dOther->internalAddress;
+	return d->getCachedString() < dOther->getCachedString();
 }
 
 bool Address::isValid () const {
@@ -156,9 +208,10 @@ const string &Address::getScheme () const {
 	if (!d->internalAddress)
 		return Utils::getEmptyConstRefObject<string>();
 
-	string scheme(L_C_TO_STRING(sal_address_get_scheme(d->internalAddress)));
-	if (scheme != d->cache.scheme)
-		d->cache.scheme = scheme;
+	if (!(d->cache.validFields & AddressPrivate::CachedScheme)) {
+		d->cache.scheme = L_C_TO_STRING(sal_address_get_scheme(d->internalAddress));
+		d->cache.validFields |= AddressPrivate::CachedScheme;
+	}
 	return d->cache.scheme;
 }
 
@@ -181,6 +234,7 @@ bool Address::setDisplayName (const string &displayName) {
 		return false;
 
 	sal_address_set_display_name(d->internalAddress, L_STRING_TO_C(displayName));
+	d->invalidateCache();
 	return true;
 }
 
@@ -190,9 +244,10 @@ const string &Address::getUsername () const {
 	if (!d->internalAddress)
 		return Utils::getEmptyConstRefObject<string>();
 
-	string username(L_C_TO_STRING(sal_address_get_username(d->internalAddress)));
-	if (username != d->cache.username)
-		d->cache.username = username;
+	if (!(d->cache.validFields & AddressPrivate::CachedUsername)) {
+		d->cache.username = L_C_TO_STRING(sal_address_get_username(d->internalAddress));
+		d->cache.validFields |= AddressPrivate::CachedUsername;
+	}
 	return d->cache.username;
 }
 
@@ -203,6 +258,7 @@ bool Address::setUsername (const string &username) {
 		return false;
 
 	sal_address_set_username(d->internalAddress, L_STRING_TO_C(username));
+	d->invalidateCache();
 	return true;
 }
 
@@ -212,9 +268,10 @@ const string &Address::getDomain () const {
 	if (!d->internalAddress)
 		return Utils::getEmptyConstRefObject<string>();
 
-	string domain(L_C_TO_STRING(sal_address_get_domain(d->internalAddress)));
-	if (domain != d->cache.domain)
-		d->cache.domain = domain;
+	if (!(d->cache.validFields & AddressPrivate::CachedDomain)) {
+		d->cache.domain = L_C_TO_STRING(sal_address_get_domain(d->internalAddress));
+		d->cache.validFields |= AddressPrivate::CachedDomain;
+	}
 	return d->cache.domain;
 }
 
@@ -225,6 +282,7 @@ bool Address::setDomain (const string &domain) {
 		return false;
 
 	sal_address_set_domain(d->internalAddress, L_STRING_TO_C(domain));
+	d->invalidateCache();
 	return true;
 }
 
@@ -240,6 +298,7 @@ bool Address::setPort (int port) {
 		return false;
 
 	sal_address_set_port(d->internalAddress, port);
+	d->invalidateCache();
 	return true;
 }
 
@@ -255,6 +314,7 @@ bool Address::setTransport (Transport transport) {
 		return false;
 
 	sal_address_set_transport(d->internalAddress, static_cast<SalTransport>(transport));
+	d->invalidateCache();
 	return true;
 }
 
@@ -270,6 +330,7 @@ bool Address::setSecure (bool enabled) {
 		return false;
 
 	sal_address_set_secure(d->internalAddress, enabled);
+	d->invalidateCache();
 	return true;
 }
 
@@ -297,6 +358,7 @@ bool Address::setMethodParam (const string &methodParam) {
 		return false;
 
 	sal_address_set_method_param(d->internalAddress, L_STRING_TO_C(methodParam));
+	d->invalidateCache();
 	return true;
 }
 
@@ -319,6 +381,7 @@ bool Address::setPassword (const string &password) {
 		return false;
 
 	sal_address_set_password(d->internalAddress, L_STRING_TO_C(password));
+	d->invalidateCache();
 	return true;
 }
 
@@ -329,6 +392,7 @@ bool Address::clean () {
 		return false;
 
 	sal_address_clean(d->internalAddress);
+	d->invalidateCache();
 	return true;
 }
 
@@ -338,10 +402,7 @@ string Address::asString () const {
 	if (!d->internalAddress)
 		return "";
 
-	char *buf = sal_address_as_string(d->internalAddress);
-	string out = buf;
-	ms_free(buf);
-	return out;
+	return d->getCachedString();
 }
 
 string Address::asStringUriOnly () const {
@@ -350,16 +411,17 @@ string Address::asStringUriOnly () const {
 	if (!d->internalAddress)
 		return "";
 
-	char *buf = sal_address_as_string_uri_only(d->internalAddress);
-	string out = buf;
-	ms_free(buf);
-	return out;
+	return d->getCachedStringUriOnly();
 }
 
 bool Address::weakEqual (const Address &address) const {
-	return getUsername() == address.getUsername() &&
-				 getDomain() == address.getDomain() &&
-				 getPort() == address.getPort();
+	L_D();
+	const AddressPrivate *dOther = address.getPrivate();
+	if (!d->internalAddress || !dOther->internalAddress)
+		return getUsername() == address.getUsername() &&
+					 getDomain() == address.getDomain() &&
+					 getPort() == address.getPort();
+	return d->getWeakKey() == dOther->getWeakKey();
 }
 
 const string &Address::getHeaderValue (const string &headerName) const {
@@ -383,6 +445,7 @@ bool Address::setHeader (const string &headerName, const string &headerValue) {
 		return false;
 
 	sal_address_set_header(d->internalAddress, L_STRING_TO_C(headerName), L_STRING_TO_C(headerValue));
+	d->invalidateCache();
 	return true;
 }
 
@@ -412,6 +475,7 @@ bool Address::setParam (const string &paramName, const string &paramValue) {
 		return false;
 
 	sal_address_set_param(d->internalAddress, L_STRING_TO_C(paramName), L_STRING_TO_C(paramValue));
+	d->invalidateCache();
 	return true;
 }
 
@@ -422,6 +486,7 @@ bool Address::setParams (const string &params) {
 		return false;
 
 	sal_address_set_params(d->internalAddress, L_STRING_TO_C(params));
+	d->invalidateCache();
 	return true;
 }
 
@@ -451,6 +516,7 @@ bool Address::setUriParam (const string &uriParamName, const string &uriParamVal
 		return false;
 
 	sal_address_set_uri_param(d->internalAddress, L_STRING_TO_C(uriParamName), L_STRING_TO_C(uriParamValue));
+	d->invalidateCache();
 	return true;
 }
 
@@ -461,6 +527,7 @@ bool Address::setUriParams (const string &uriParams) {
 		return false;
 
 	sal_address_set_uri_params(d->internalAddress, L_STRING_TO_C(uriParams));
+	d->invalidateCache();
 	return true;
 }
 
@@ -471,6 +538,7 @@ bool Address::removeUriParam (const string &uriParamName) {
 		return false;
 
 	sal_address_remove_uri_param(d->internalAddress, L_STRING_TO_C(uriParamName));
+	d->invalidateCache();
 	return true;
 }
 
@@ -42,6 +42,9 @@ public:
 	std::string username;
 	std::string domain;
 	std::string gruu;
+
+	// Serialized form, empty until asString() is called and reset by setters.
+	mutable std::string asStringCache;
 };
 
 // -----------------------------------------------------------------------------
@@ -83,6 +86,7 @@ IdentityAddress::IdentityAddress (const IdentityAddress &other) : ClonableObject
 	d->username = other.getUsername();
 	d->domain = other.getDomain();
 	d->gruu = other.getGruu();
+	d->asStringCache = other.getPrivate()->asStringCache;
 }
 
 IdentityAddress::IdentityAddress () : ClonableObject(*new IdentityAddressPrivate) {
@@ -96,6 +100,7 @@ IdentityAddress &IdentityAddress::operator= (const IdentityAddress &other) {
 		d->username = other.getUsername();
 		d->domain = other.getDomain();
 		d->gruu = other.getGruu();
+		d->asStringCache = other.getPrivate()->asStringCache;
 	}
 	return *this;
 }
@@ -136,6 +141,7 @@ const string &IdentityAddress::getScheme () const {
 void IdentityAddress::setScheme (const string &scheme) {
 	L_D();
 	d->scheme = scheme;
+	d->asStringCache.clear();
 }
 
 const string &IdentityAddress::getUsername () const {
@@ -146,6 +152,7 @@ const string &IdentityAddress::getUsername () const {
 void IdentityAddress::setUsername (const string &username) {
 	L_D();
 	d->username = username;
+	d->asStringCache.clear();
 }
 
 const string &IdentityAddress::getDomain () const {
@@ -156,6 +163,7 @@ const string &IdentityAddress::getDomain () const {
 void IdentityAddress::setDomain (const string &domain) {
 	L_D();
 	d->domain = domain;
+	d->asStringCache.clear();
 }
 
 bool IdentityAddress::hasGruu () const {
@@ -171,16 +179,21 @@ const string &IdentityAddress::getGruu () const {
 void IdentityAddress::setGruu (const string &gruu) {
 	L_D();
 	d->gruu = gruu;
+	d->asStringCache.clear();
 }
 
 IdentityAddress IdentityAddress::getAddressWithoutGruu () const {
 	IdentityAddress address(*this);
-	address.setGruu("");
+	if (address.hasGruu())
+		address.setGruu("");
 	return address;
 }
 
 string IdentityAddress::asString () const {
 	L_D();
+	if (!d->asStringCache.empty())
+		return d->asStringCache;
+
 	ostringstream res;
 	res << d->scheme << ":";
 	if (!d->username.empty()){
@@ -198,7 +211,8 @@ string IdentityAddress::asString () const {
 	if (!d->gruu.empty()){
 		res << ";gr=" << d->gruu;
 	}
-	return res.str();
+	d->asStringCache = res.str();
+	return d->asStringCache;
 }
 
 LINPHONE_END_NAMESPACE
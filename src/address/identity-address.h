@@ -86,7 +86,11 @@ namespace std {
 	struct hash<LinphonePrivate::IdentityAddress> {
 		std::size_t operator() (const LinphonePrivate::IdentityAddress &identityAddress) const {
 			if (!identityAddress.isValid()) return std::size_t(-1);
-			return hash<string>()(identityAddress.asString());
+			// Scheme is ignored, as in IdentityAddress::operator==.
+			std::size_t seed = hash<string>()(identityAddress.getUsername());
+			seed ^= hash<string>()(identityAddress.getDomain()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			seed ^= hash<string>()(identityAddress.getGruu()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			return seed;
 		}
 	};
 }
@@ -37,8 +37,16 @@ AuthStack::~AuthStack(){
 	}
 }
 
+string AuthStack::getKey(const AuthInfo &ai){
+	return ai.getRealm() + '\n' + ai.getUsername() + '\n' + ai.getDomain();
+}
+
 void AuthStack::pushAuthRequested(const std::shared_ptr<AuthInfo> &ai){
 	if (mAuthBeingRequested) return;
+	if (!mAuthQueued.insert(getKey(*ai)).second){
+		lInfo() << "AuthRequested already pushed for " << ai->toString();
+		return;
+	}
 	lInfo() << "AuthRequested pushed";
 	mAuthQueue.push_back(ai);
 	if (!mTimer){
@@ -48,7 +56,7 @@ void AuthStack::pushAuthRequested(const std::shared_ptr<AuthInfo> &ai){
 
 void AuthStack::authFound(const std::shared_ptr<AuthInfo> &ai){
 	lInfo() << "AuthStack::authFound() for " << ai->toString();
-	mAuthFound.push_back(ai);
+	mAuthFound.insert(getKey(*ai));
 	if (!mTimer){
 		mTimer = mCore.getSal()->createTimer(&onTimeout, this, 0, "authentication requests");
 	}
@@ -56,29 +64,27 @@ void AuthStack::authFound(const std::shared_ptr<AuthInfo> &ai){
 
 void AuthStack::notifyAuthFailures(){
 	auto pendingAuths = mCore.getSal()->getPendingAuths();
+	if (pendingAuths.empty()) return;
+
+	/* The user pointer of a REGISTER op is its proxy config. */
+	unordered_set<const void *> proxies;
+	for (const bctbx_list_t *elem = linphone_core_get_proxy_config_list(mCore.getCCore()); elem != NULL; elem = elem->next)
+		proxies.insert(elem->data);
+
 	for (const auto &op : pendingAuths) {
-		const bctbx_list_t *elem;
 		/*proxy case*/
-		for (elem = linphone_core_get_proxy_config_list(mCore.getCCore()); elem != NULL; elem = elem->next) {
-			LinphoneProxyConfig *pcfg = (LinphoneProxyConfig*)elem->data;
-			if (pcfg == op->getUserPointer()) {
-				const SalErrorInfo *ei=op->getErrorInfo();
-				const char *details=ei->full_string;
-				linphone_proxy_config_set_state(pcfg, LinphoneRegistrationFailed, details);
-				break;
-			}
+		if (proxies.find(op->getUserPointer()) != proxies.end()) {
+			const SalErrorInfo *ei=op->getErrorInfo();
+			const char *details=ei->full_string;
+			linphone_proxy_config_set_state((LinphoneProxyConfig*)op->getUserPointer(), LinphoneRegistrationFailed, details);
 		}
 	}
 }
 
 bool AuthStack::wasFound(const std::shared_ptr<AuthInfo>& authInfo){
-	for (auto &ai : mAuthFound){
-		if (authInfo->getRealm() == ai->getRealm() &&
-			authInfo->getUsername() == ai->getUsername() &&
-			authInfo->getDomain() == ai->getDomain()){
-			lInfo() << "Authentication request not needed.";
-			return true;
-		}
+	if (mAuthFound.find(getKey(*authInfo)) != mAuthFound.end()){
+		lInfo() << "Authentication request not needed.";
+		return true;
 	}
 	return false;
 }
@@ -99,6 +105,7 @@ void AuthStack::processAuthRequested(){
 	}
 	notifyAuthFailures();
 	mAuthQueue.clear();
+	mAuthQueued.clear();
 	mAuthFound.clear();
 	if (mTimer){
 		mCore.getSal()->cancelTimer(mTimer);
@@ -19,6 +19,8 @@
 #ifndef AUTH_STACK_H
 #define AUTH_STACK_H
 
+#include <string>
+#include <unordered_set>
 
 #include "linphone/api/c-types.h"
 #include "auth-info.h"
@@ -53,10 +55,13 @@ private:
 	void notifyAuthFailures();
 	void processAuthRequested();
 	bool wasFound(const std::shared_ptr<AuthInfo>& ai);
+	static std::string getKey(const AuthInfo &ai);
 	CorePrivate &mCore;
 	belle_sip_source_t *mTimer = nullptr;
 	std::list<std::shared_ptr<AuthInfo>> mAuthQueue;
-	std::list<std::shared_ptr<AuthInfo>> mAuthFound;
+	// (realm, username, domain) keys of mAuthQueue, so that identical requests are notified once.
+	std::unordered_set<std::string> mAuthQueued;
+	std::unordered_set<std::string> mAuthFound;
 	bool mAuthBeingRequested = false;
 	static int onTimeout(void *data, unsigned int events);
 };
@@ -282,6 +282,10 @@ int linphone_call_get_duration (const LinphoneCall *call) {
 	return L_GET_CPP_PTR_FROM_C_OBJECT(call)->getDuration();
 }
 
+unsigned int linphone_call_get_offer_answer_time (const LinphoneCall *call) {
+	return L_GET_CPP_PTR_FROM_C_OBJECT(call)->getOfferAnswerTime();
+}
+
 const LinphoneCallParams *linphone_call_get_current_params (LinphoneCall *call) {
 	return L_GET_C_BACK_PTR(L_GET_CPP_PTR_FROM_C_OBJECT(call)->getCurrentParams());
 }
@@ -608,6 +612,14 @@ LinphoneCallStats *linphone_call_get_audio_stats (LinphoneCall *call) {
 	return L_GET_CPP_PTR_FROM_C_OBJECT(call)->getAudioStats();
 }
 
+unsigned int linphone_call_get_stats_history_size (const LinphoneCall *call, LinphoneStreamType type) {
+	return (unsigned int)L_GET_CPP_PTR_FROM_C_OBJECT(call)->getStatsHistorySize(type);
+}
+
+const LinphoneCallStatsSample *linphone_call_get_stats_history_sample (const LinphoneCall *call, LinphoneStreamType type, unsigned int index) {
+	return L_GET_CPP_PTR_FROM_C_OBJECT(call)->getStatsHistorySample(type, index);
+}
+
 LinphoneCallStats *linphone_call_get_video_stats (LinphoneCall *call) {
 	return L_GET_CPP_PTR_FROM_C_OBJECT(call)->getVideoStats();
 }
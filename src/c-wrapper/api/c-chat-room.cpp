@@ -265,6 +265,17 @@ bctbx_list_t *linphone_chat_room_get_history_range (LinphoneChatRoom *cr, int st
 	return L_GET_RESOLVED_C_LIST_FROM_CPP_LIST(chatMessages);
 }
 
+LinphoneObjectArray *linphone_chat_room_get_history_range_array (LinphoneChatRoom *cr, int startm, int endm) {
+	const list<shared_ptr<LinphonePrivate::EventLog>> events = L_GET_CPP_PTR_FROM_C_OBJECT(cr)->getMessageHistoryRange(startm, endm);
+	LinphoneObjectArray *result = _linphone_object_array_new(events.size());
+	for (const auto &event : events) {
+		const shared_ptr<LinphonePrivate::ChatMessage> &chatMessage =
+			static_pointer_cast<LinphonePrivate::ConferenceChatMessageEvent>(event)->getChatMessage();
+		_linphone_object_array_append(result, linphone_chat_message_ref(L_GET_C_BACK_PTR(chatMessage)));
+	}
+	return result;
+}
+
 bctbx_list_t *linphone_chat_room_get_history (LinphoneChatRoom *cr, int nb_message) {
 	return linphone_chat_room_get_history_range(cr, 0, nb_message);
 }
@@ -285,6 +296,14 @@ bctbx_list_t *linphone_chat_room_get_history_range_events (LinphoneChatRoom *cr,
 	return L_GET_RESOLVED_C_LIST_FROM_CPP_LIST(L_GET_CPP_PTR_FROM_C_OBJECT(cr)->getHistoryRange(begin, end));
 }
 
+LinphoneObjectArray *linphone_chat_room_get_history_range_events_array (LinphoneChatRoom *cr, int begin, int end) {
+	return L_GET_RESOLVED_C_ARRAY_FROM_CPP_LIST(L_GET_CPP_PTR_FROM_C_OBJECT(cr)->getHistoryRange(begin, end));
+}
+
+bctbx_list_t *linphone_chat_room_search_messages (LinphoneChatRoom *cr, const char *text, int begin, int end) {
+	return L_GET_RESOLVED_C_LIST_FROM_CPP_LIST(L_GET_CPP_PTR_FROM_C_OBJECT(cr)->searchMessages(L_C_TO_STRING(text), begin, end));
+}
+
 int linphone_chat_room_get_history_events_size(LinphoneChatRoom *cr) {
 	return L_GET_CPP_PTR_FROM_C_OBJECT(cr)->getHistorySize();
 }
@@ -369,6 +388,10 @@ bctbx_list_t *linphone_chat_room_get_participants (const LinphoneChatRoom *cr) {
 	return L_GET_RESOLVED_C_LIST_FROM_CPP_LIST(L_GET_CPP_PTR_FROM_C_OBJECT(cr)->getParticipants());
 }
 
+LinphoneObjectArray *linphone_chat_room_get_participants_array (const LinphoneChatRoom *cr) {
+	return L_GET_RESOLVED_C_ARRAY_FROM_CPP_LIST(L_GET_CPP_PTR_FROM_C_OBJECT(cr)->getParticipants());
+}
+
 const char * linphone_chat_room_get_subject (const LinphoneChatRoom *cr) {
 	return L_STRING_TO_C(L_GET_CPP_PTR_FROM_C_OBJECT(cr)->getSubject());
 }
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "linphone/api/c-core-shards.h"
+
+#include "address/identity-address.h"
+#include "c-wrapper/c-wrapper.h"
+#include "conference/conference-id.h"
+#include "core/core-shards.h"
+
+// =============================================================================
+
+using namespace std;
+
+struct _LinphoneCoreShards {
+	belle_sip_object_t base;
+	LinphonePrivate::CoreShards *shards;
+};
+
+static void _linphone_core_shards_destroy (LinphoneCoreShards *shards) {
+	delete shards->shards;
+}
+
+BELLE_SIP_DECLARE_VPTR_NO_EXPORT(LinphoneCoreShards);
+
+BELLE_SIP_DECLARE_NO_IMPLEMENTED_INTERFACES(LinphoneCoreShards);
+
+BELLE_SIP_INSTANCIATE_VPTR(LinphoneCoreShards, belle_sip_object_t,
+	_linphone_core_shards_destroy,
+	NULL, // clone
+	NULL, // marshal
+	FALSE
+);
+
+// =============================================================================
+
+LinphoneCoreShards *linphone_factory_create_core_shards (
+	const LinphoneFactory *factory,
+	int count,
+	const char *config_path,
+	const char *factory_config_path,
+	void *system_context
+) {
+	LinphoneCoreShards *shards = belle_sip_object_new(LinphoneCoreShards);
+	shards->shards = new LinphonePrivate::CoreShards(
+		const_cast<LinphoneFactory *>(factory),
+		count,
+		L_C_TO_STRING(config_path),
+		L_C_TO_STRING(factory_config_path),
+		system_context
+	);
+	return shards;
+}
+
+LinphoneCoreShards *linphone_core_shards_ref (LinphoneCoreShards *shards) {
+	belle_sip_object_ref(shards);
+	return shards;
+}
+
+void linphone_core_shards_unref (LinphoneCoreShards *shards) {
+	belle_sip_object_unref(shards);
+}
+
+LinphoneStatus linphone_core_shards_start (LinphoneCoreShards *shards) {
+	return shards->shards->start() ? 0 : -1;
+}
+
+void linphone_core_shards_stop (LinphoneCoreShards *shards) {
+	shards->shards->stop();
+}
+
+int linphone_core_shards_get_count (const LinphoneCoreShards *shards) {
+	return shards->shards->getCount();
+}
+
+LinphoneCore *linphone_core_shards_get_core (const LinphoneCoreShards *shards, int index) {
+	return shards->shards->getCore(index);
+}
+
+int linphone_core_shards_get_index_for_conference (
+	const LinphoneCoreShards *shards,
+	const LinphoneAddress *peer_address,
+	const LinphoneAddress *local_address
+) {
+	return shards->shards->getShardIndex(LinphonePrivate::ConferenceId(
+		LinphonePrivate::IdentityAddress(*L_GET_CPP_PTR_FROM_C_OBJECT(peer_address)),
+		local_address
+			? LinphonePrivate::IdentityAddress(*L_GET_CPP_PTR_FROM_C_OBJECT(local_address))
+			: LinphonePrivate::IdentityAddress()
+	));
+}
+
+int linphone_core_shards_get_current_index (void) {
+	return LinphonePrivate::CoreShards::getCurrentShardIndex();
+}
+
+LinphoneStatus linphone_core_shards_post (
+	LinphoneCoreShards *shards,
+	int index,
+	LinphoneCoreShardsTaskCb cb,
+	void *user_data
+) {
+	if (!cb)
+		return -1;
+	return shards->shards->post(index, [cb, user_data](LinphoneCore *core) {
+		cb(core, user_data);
+	}) ? 0 : -1;
+}
+
+void *linphone_core_shards_get_user_data (const LinphoneCoreShards *shards) {
+	return shards->shards->getUserData();
+}
+
+void linphone_core_shards_set_user_data (LinphoneCoreShards *shards, void *user_data) {
+	shards->shards->setUserData(user_data);
+}
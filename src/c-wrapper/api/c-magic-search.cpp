@@ -110,3 +110,13 @@ bctbx_list_t *linphone_magic_search_get_contact_list_from_filter (
 		L_C_TO_STRING(filter), L_C_TO_STRING(domain)
 	));
 }
+
+LinphoneObjectArray *linphone_magic_search_get_contact_array_from_filter (
+	const LinphoneMagicSearch *magic_search,
+	const char *filter,
+	const char *domain
+) {
+	return L_GET_RESOLVED_C_ARRAY_FROM_CPP_LIST(L_GET_CPP_PTR_FROM_C_OBJECT(magic_search)->getContactListFromFilter(
+		L_C_TO_STRING(filter), L_C_TO_STRING(domain)
+	));
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "linphone/api/c-object-array.h"
+
+#include "c-wrapper/c-wrapper.h"
+
+// =============================================================================
+
+struct _LinphoneObjectArray {
+	belle_sip_object_t base;
+	void **items;
+	size_t size;
+	size_t capacity;
+};
+
+static void _linphone_object_array_destroy (LinphoneObjectArray *array) {
+	for (size_t i = 0; i < array->size; i++)
+		belle_sip_object_unref(array->items[i]);
+	if (array->items)
+		bctbx_free(array->items);
+}
+
+BELLE_SIP_DECLARE_VPTR_NO_EXPORT(LinphoneObjectArray);
+
+BELLE_SIP_DECLARE_NO_IMPLEMENTED_INTERFACES(LinphoneObjectArray);
+
+BELLE_SIP_INSTANCIATE_VPTR(LinphoneObjectArray, belle_sip_object_t,
+	_linphone_object_array_destroy,
+	NULL, // clone
+	NULL, // marshal
+	FALSE
+);
+
+// =============================================================================
+
+LinphoneObjectArray *_linphone_object_array_new (size_t capacity) {
+	LinphoneObjectArray *array = belle_sip_object_new(LinphoneObjectArray);
+	if (capacity > 0) {
+		array->items = static_cast<void **>(bctbx_malloc(capacity * sizeof(void *)));
+		array->capacity = capacity;
+	}
+	return array;
+}
+
+void _linphone_object_array_append (LinphoneObjectArray *array, void *object) {
+	if (array->size == array->capacity) {
+		array->capacity = array->capacity ? array->capacity * 2 : 8;
+		array->items = static_cast<void **>(bctbx_realloc(array->items, array->capacity * sizeof(void *)));
+	}
+	array->items[array->size++] = object;
+}
+
+LinphoneObjectArray *linphone_object_array_ref (LinphoneObjectArray *array) {
+	belle_sip_object_ref(array);
+	return array;
+}
+
+void linphone_object_array_unref (LinphoneObjectArray *array) {
+	belle_sip_object_unref(array);
+}
+
+size_t linphone_object_array_get_size (const LinphoneObjectArray *array) {
+	return array->size;
+}
+
+void *linphone_object_array_get (const LinphoneObjectArray *array, size_t index) {
+	return index < array->size ? array->items[index] : nullptr;
+}
+
+void * const *linphone_object_array_get_data (const LinphoneObjectArray *array) {
+	return array->size ? array->items : nullptr;
+}
@@ -573,9 +573,11 @@ char * sal_media_description_print_differences(int result){
 }
 
 int sal_media_description_equals(const SalMediaDescription *md1, const SalMediaDescription *md2) {
-	int result = sal_media_description_global_equals(md1, md2);
+	int result;
 	int i;
 
+	if (md1 == md2) return SAL_MEDIA_DESCRIPTION_UNCHANGED;
+	result = sal_media_description_global_equals(md1, md2);
 	for(i = 0; i < SAL_MEDIA_DESCRIPTION_MAX_STREAMS; ++i){
 		if (!sal_stream_description_enabled(&md1->streams[i]) && !sal_stream_description_enabled(&md2->streams[i])) continue;
 		result |= sal_stream_description_equals(&md1->streams[i], &md2->streams[i]);
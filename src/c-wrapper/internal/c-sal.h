@@ -345,11 +345,13 @@ typedef struct SalMessage{
 extern "C" {
 #endif
 
-SalMediaDescription *sal_media_description_new(void);
+LINPHONE_PUBLIC SalMediaDescription *sal_media_description_new(void);
 SalMediaDescription * sal_media_description_ref(SalMediaDescription *md);
-void sal_media_description_unref(SalMediaDescription *md);
+LINPHONE_PUBLIC void sal_media_description_unref(SalMediaDescription *md);
 bool_t sal_media_description_empty(const SalMediaDescription *md);
-int sal_media_description_equals(const SalMediaDescription *md1, const SalMediaDescription *md2);
+LINPHONE_PUBLIC int sal_media_description_equals(const SalMediaDescription *md1, const SalMediaDescription *md2);
+/* Hash of the content of the description as it appears in the SDP: equal hashes mean equal SDPs. */
+LINPHONE_PUBLIC uint64_t sal_media_description_hash(const SalMediaDescription *md);
 int sal_media_description_global_equals(const SalMediaDescription *md1, const SalMediaDescription *md2);
 char * sal_media_description_print_differences(int result);
 bool_t sal_media_description_has_dir(const SalMediaDescription *md, SalStreamDir dir);
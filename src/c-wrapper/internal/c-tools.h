@@ -33,6 +33,14 @@
 // Internal.
 // =============================================================================
 
+// Array builders, implemented in c-object-array.cpp.
+extern "C" {
+	typedef struct _LinphoneObjectArray LinphoneObjectArray;
+
+	LinphoneObjectArray *_linphone_object_array_new (size_t capacity);
+	void _linphone_object_array_append (LinphoneObjectArray *array, void *object);
+}
+
 #ifdef DEBUG
 	#define L_INTERNAL_WRAPPER_CONSTEXPR
 #else
@@ -629,6 +637,34 @@ public:
 		return result;
 	}
 
+	// ---------------------------------------------------------------------------
+	// Resolved array conversions.
+	// ---------------------------------------------------------------------------
+	template<
+		typename CppType,
+		typename = typename std::enable_if<IsDefinedBaseCppObject<CppType>::value, CppType>::type
+	>
+	static inline LinphoneObjectArray *getResolvedCArrayFromCppList (const std::list<std::shared_ptr<CppType>> &cppList) {
+		LinphoneObjectArray *result = _linphone_object_array_new(cppList.size());
+		for (const auto &value : cppList)
+			_linphone_object_array_append(result, belle_sip_object_ref(getCBackPtr(value)));
+		return result;
+	}
+
+	template<
+		typename CppType,
+		typename = typename std::enable_if<IsDefinedClonableCppObject<CppType>::value, CppType>::type
+	>
+	static inline LinphoneObjectArray *getResolvedCArrayFromCppList (const std::list<CppType> &cppList) {
+		LinphoneObjectArray *result = _linphone_object_array_new(cppList.size());
+		for (const auto &value : cppList) {
+			auto cValue = getCBackPtr(new CppType(value));
+			reinterpret_cast<WrappedClonableObject<CppType> *>(cValue)->owner = WrappedObjectOwner::External;
+			_linphone_object_array_append(result, cValue);
+		}
+		return result;
+	}
+
 private:
 	Wrapper ();
 
@@ -883,4 +919,8 @@ LINPHONE_END_NAMESPACE
 #define L_GET_RESOLVED_CPP_LIST_FROM_C_LIST(C_LIST, C_TYPE) \
 	LinphonePrivate::Wrapper::getResolvedCppListFromCList<Linphone ## C_TYPE>(C_LIST)
 
+// Transforms cpp list to a contiguous c array and convert cpp object to c object.
+#define L_GET_RESOLVED_C_ARRAY_FROM_CPP_LIST(CPP_LIST) \
+	LinphonePrivate::Wrapper::getResolvedCArrayFromCppList(CPP_LIST)
+
 #endif // ifndef _L_C_TOOLS_H_
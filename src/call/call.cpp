@@ -716,6 +716,11 @@ int Call::getDuration () const {
 	return d->getActiveSession()->getDuration();
 }
 
+unsigned int Call::getOfferAnswerTime () const {
+	L_D();
+	return d->getActiveSession()->getOfferAnswerTime();
+}
+
 const LinphoneErrorInfo *Call::getErrorInfo () const {
 	L_D();
 	return d->getActiveSession()->getErrorInfo();
@@ -842,6 +847,16 @@ LinphoneCallStats *Call::getStats (LinphoneStreamType type) const {
 	return static_pointer_cast<const MediaSession>(d->getActiveSession())->getStats(type);
 }
 
+const LinphoneCallStatsSample *Call::getStatsHistorySample (LinphoneStreamType type, size_t index) const {
+	L_D();
+	return static_pointer_cast<const MediaSession>(d->getActiveSession())->getStatsHistorySample(type, index);
+}
+
+size_t Call::getStatsHistorySize (LinphoneStreamType type) const {
+	L_D();
+	return static_pointer_cast<const MediaSession>(d->getActiveSession())->getStatsHistorySize(type);
+}
+
 int Call::getStreamCount () const {
 	L_D();
 	return static_pointer_cast<MediaSession>(d->getActiveSession())->getStreamCount();
@@ -88,6 +88,7 @@ public:
 	LinphoneCallDir getDirection () const;
 	const Address &getDiversionAddress () const;
 	int getDuration () const;
+	unsigned int getOfferAnswerTime () const;
 	const LinphoneErrorInfo *getErrorInfo () const;
 	const Address &getLocalAddress () const;
 	LinphoneCallLog *getLog () const;
@@ -110,6 +111,8 @@ public:
 	float getSpeakerVolumeGain () const;
 	CallSession::State getState () const;
 	LinphoneCallStats *getStats (LinphoneStreamType type) const;
+	const LinphoneCallStatsSample *getStatsHistorySample (LinphoneStreamType type, size_t index) const;
+	size_t getStatsHistorySize (LinphoneStreamType type) const;
 	int getStreamCount () const;
 	MSFormatType getStreamType (int streamIndex) const;
 	LinphoneCallStats *getTextStats () const;
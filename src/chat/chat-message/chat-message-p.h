@@ -44,6 +44,7 @@ LINPHONE_BEGIN_NAMESPACE
 class ChatMessagePrivate : public ObjectPrivate {
 	friend class CpimChatMessageModifier;
 	friend class EncryptionChatMessageModifier;
+	friend class FileTransferChatMessageModifier;
 	friend class MultipartChatMessageModifier;
 	friend class NotificationMessagePrivate;
 
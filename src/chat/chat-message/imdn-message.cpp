@@ -63,25 +63,26 @@ ImdnMessage::ImdnMessage (const std::shared_ptr<ImdnMessage> &message) : ImdnMes
 ImdnMessage::ImdnMessage (const Context &context) : NotificationMessage(*new ImdnMessagePrivate(context)) {
 	L_D();
 
+	LinphoneCore *core = d->context.chatRoom->getCore()->getCCore();
 	for (const auto &message : d->context.deliveredMessages) {
 		Content *content = new Content();
 		content->setContentDisposition(ContentDisposition::Notification);
 		content->setContentType(ContentType::Imdn);
-		content->setBody(Imdn::createXml(message->getImdnMessageId(), message->getTime(), Imdn::Type::Delivery, LinphoneReasonNone));
+		content->setBody(Imdn::createXml(core, message->getImdnMessageId(), message->getTime(), Imdn::Type::Delivery, LinphoneReasonNone));
 		addContent(content);
 	}
 	for (const auto &message : d->context.displayedMessages) {
 		Content *content = new Content();
 		content->setContentDisposition(ContentDisposition::Notification);
 		content->setContentType(ContentType::Imdn);
-		content->setBody(Imdn::createXml(message->getImdnMessageId(), message->getTime(), Imdn::Type::Display, LinphoneReasonNone));
+		content->setBody(Imdn::createXml(core, message->getImdnMessageId(), message->getTime(), Imdn::Type::Display, LinphoneReasonNone));
 		addContent(content);
 	}
 	for (const auto &mr : d->context.nonDeliveredMessages) {
 		Content *content = new Content();
 		content->setContentDisposition(ContentDisposition::Notification);
 		content->setContentType(ContentType::Imdn);
-		content->setBody(Imdn::createXml(mr.message->getImdnMessageId(), mr.message->getTime(), Imdn::Type::Delivery, mr.reason));
+		content->setBody(Imdn::createXml(core, mr.message->getImdnMessageId(), mr.message->getTime(), Imdn::Type::Delivery, mr.reason));
 		addContent(content);
 	}
 
@@ -121,6 +121,7 @@ public:
 	virtual std::list<std::shared_ptr<EventLog>> getHistory (int nLast) const = 0;
 	virtual std::list<std::shared_ptr<EventLog>> getHistoryRange (int begin, int end) const = 0;
 	virtual int getHistorySize () const = 0;
+	virtual std::list<std::shared_ptr<EventLog>> searchMessages (const std::string &text, int begin, int end) const = 0;
 
 	virtual void deleteFromDb () = 0;
 	virtual void deleteHistory () = 0;
@@ -478,6 +478,10 @@ int ChatRoom::getHistorySize () const {
 	return getCore()->getPrivate()->mainDb->getHistorySize(getConferenceId());
 }
 
+list<shared_ptr<EventLog>> ChatRoom::searchMessages (const string &text, int begin, int end) const {
+	return getCore()->getPrivate()->mainDb->searchChatMessages(text, getConferenceId(), begin, end);
+}
+
 void ChatRoom::deleteFromDb () {
 	L_D();
 	// Keep a ref, otherwise the object might be destroyed before we can set the Deleted state
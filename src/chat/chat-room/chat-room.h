@@ -57,6 +57,7 @@ public:
 	std::list<std::shared_ptr<EventLog>> getHistory (int nLast) const override;
 	std::list<std::shared_ptr<EventLog>> getHistoryRange (int begin, int end) const override;
 	int getHistorySize () const override;
+	std::list<std::shared_ptr<EventLog>> searchMessages (const std::string &text, int begin, int end) const override;
 
 	void deleteFromDb () override;
 	void deleteHistory () override;
@@ -28,6 +28,8 @@
 
 LINPHONE_BEGIN_NAMESPACE
 
+class EncryptionEngine;
+
 class ClientGroupChatRoomPrivate : public ChatRoomPrivate {
 public:
 	ClientGroupChatRoomPrivate(void) : ChatRoomPrivate(AbstractChatRoom::CapabilitiesMask({ChatRoom::Capabilities::Conference})) {};
@@ -45,6 +47,9 @@ public:
 	void addOneToOneCapability ();
 	unsigned int getLastNotifyId () const;
 
+	// Forces the next getSecurityLevel() to recompute the level from the participant devices.
+	void invalidateSecurityLevel () { securityLevelValid = false; }
+
 	// ChatRoomListener
 	void onChatRoomInsertRequested (const std::shared_ptr<AbstractChatRoom> &chatRoom) override;
 	void onChatRoomInsertInDatabaseRequested (const std::shared_ptr<AbstractChatRoom> &chatRoom) override;
@@ -67,6 +72,12 @@ private:
 
 	bool isEphemeral = false;
 	long ephemeralLifetime = 86400;  //24 hours = 86400s
+
+	// Security level cache, valid as long as the devices and the encryption engine trust state are unchanged.
+	mutable bool securityLevelValid = false;
+	mutable ChatRoom::SecurityLevel securityLevel = ChatRoom::SecurityLevel::ClearText;
+	mutable const EncryptionEngine *securityLevelEngine = nullptr;
+	mutable unsigned int securityLevelVersion = 0;
 	
 	L_DECLARE_PUBLIC(ClientGroupChatRoom);
 };
@@ -24,6 +24,7 @@
 #include "address/address-p.h"
 #include "basic-to-client-group-chat-room.h"
 #include "c-wrapper/c-wrapper.h"
+#include "chat/encryption/encryption-engine.h"
 #include "client-group-chat-room-p.h"
 #include "conference/handlers/remote-conference-event-handler-p.h"
 #include "conference/handlers/remote-conference-list-event-handler.h"
@@ -141,8 +142,10 @@ void ClientGroupChatRoomPrivate::confirmJoining (SalCallOp *op) {
 			if (!participant) {
 				participant = make_shared<Participant>(q, addr);
 				qConference->getPrivate()->participants.push_back(participant);
+				qConference->getPrivate()->invalidateParticipantsIndex();
 			}
 		}
+		invalidateSecurityLevel();
 	}
 	acceptSession(session);
 }
@@ -272,6 +275,7 @@ RemoteConference(core, conferenceId.getLocalAddress(), nullptr) {
 	RemoteConference::setSubject(subject);
 	for (const auto &addr : Conference::parseResourceLists(content))
 		dConference->participants.push_back(make_shared<Participant>(this, addr));
+	dConference->invalidateParticipantsIndex();
 
 	//if preserve_backward_compatibility, force creation of secure room in all cases
 	if (params->isEncrypted() || linphone_config_get_bool(linphone_core_get_config(getCore()->getCCore()), "lime", "preserve_backward_compatibility",FALSE))
@@ -318,6 +322,7 @@ RemoteConference(core, me->getAddress(), nullptr) {
 	dConference->conferenceAddress = peerAddress;
 	dConference->subject = subject;
 	dConference->participants = move(participants);
+	dConference->invalidateParticipantsIndex();
 
 	getMe()->getPrivate()->setAdmin(me->isAdmin());
 	for (const auto &device : me->getPrivate()->getDevices())
@@ -380,6 +385,20 @@ ChatRoom::SecurityLevel ClientGroupChatRoom::getSecurityLevel () const {
 		return AbstractChatRoom::SecurityLevel::ClearText;
 	}
 
+	// Computing the level queries the trust of every device, only do it when a device or its trust changed.
+	const EncryptionEngine *encryptionEngine = getCore()->getEncryptionEngine();
+	unsigned int version = encryptionEngine ? encryptionEngine->getSecurityLevelVersion() : 0;
+	if (d->securityLevelValid && (d->securityLevelEngine == encryptionEngine) && (d->securityLevelVersion == version))
+		return d->securityLevel;
+
+	d->securityLevel = computeSecurityLevel();
+	d->securityLevelEngine = encryptionEngine;
+	d->securityLevelVersion = version;
+	d->securityLevelValid = true;
+	return d->securityLevel;
+}
+
+ChatRoom::SecurityLevel ClientGroupChatRoom::computeSecurityLevel () const {
 	bool isSafe = true;
 	// check other participants
 	for (const auto &participant : getParticipants()) {
@@ -770,6 +789,8 @@ void ClientGroupChatRoom::onParticipantAdded (const shared_ptr<ConferencePartici
 
 	participant = make_shared<Participant>(this, addr);
 	dConference->participants.push_back(participant);
+	dConference->invalidateParticipantsIndex();
+	d->invalidateSecurityLevel();
 
 	if (isFullState)
 		return;
@@ -794,6 +815,8 @@ void ClientGroupChatRoom::onParticipantRemoved (const shared_ptr<ConferenceParti
 	}
 
 	dConference->participants.remove(participant);
+	dConference->invalidateParticipantsIndex();
+	d->invalidateSecurityLevel();
 	d->addEvent(event);
 
 	LinphoneChatRoom *cr = d->getCChatRoom();
@@ -883,6 +906,7 @@ void ClientGroupChatRoom::onParticipantDeviceAdded (const shared_ptr<ConferenceP
 
 	ChatRoom::SecurityLevel currentSecurityLevel = getSecurityLevel();
 	shared_ptr<ParticipantDevice> device = participant->getPrivate()->addDevice(event->getDeviceAddress());
+	d->invalidateSecurityLevel();
 	const string &deviceName = event->getDeviceName();
 	if (!deviceName.empty())
 		device->setName(deviceName);
@@ -921,6 +945,7 @@ void ClientGroupChatRoom::onParticipantDeviceRemoved (const shared_ptr<Conferenc
 		return;
 	}
 	participant->getPrivate()->removeDevice(event->getDeviceAddress());
+	d->invalidateSecurityLevel();
 	d->addEvent(event);
 
 	LinphoneChatRoom *cr = d->getCChatRoom();
@@ -928,6 +953,7 @@ void ClientGroupChatRoom::onParticipantDeviceRemoved (const shared_ptr<Conferenc
 }
 
 void ClientGroupChatRoom::onParticipantsCleared () {
+	L_D();
 	L_D_T(RemoteConference, dConference);
 	//clear from db as well
 	for (const auto &participant : dConference->participants) {
@@ -936,7 +962,8 @@ void ClientGroupChatRoom::onParticipantsCleared () {
 			getCore()->getPrivate()->mainDb->deleteChatRoomParticipantDevice(getSharedFromThis(), device);
 	}
 	dConference->participants.clear();
-
+	dConference->invalidateParticipantsIndex();
+	d->invalidateSecurityLevel();
 }
 
 void ClientGroupChatRoom::enableEphemeral (bool ephem, bool updateDb) {
@@ -122,6 +122,8 @@ private:
 		bool hasBeenLeft = false
 	);
 
+	ChatRoom::SecurityLevel computeSecurityLevel () const;
+
 	// TODO: Move me in ClientGroupChatRoomPrivate.
 	// ALL METHODS AFTER THIS POINT.
 
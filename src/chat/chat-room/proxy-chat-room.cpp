@@ -130,6 +130,11 @@ int ProxyChatRoom::getHistorySize () const {
 	return d->chatRoom->getHistorySize();
 }
 
+list<shared_ptr<EventLog>> ProxyChatRoom::searchMessages (const string &text, int begin, int end) const {
+	L_D();
+	return d->chatRoom->searchMessages(text, begin, end);
+}
+
 void ProxyChatRoom::deleteFromDb () {
 	L_D();
 	d->chatRoom->deleteFromDb();
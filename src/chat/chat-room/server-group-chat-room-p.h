@@ -82,6 +82,7 @@ public:
 	void confirmRecreation (SalCallOp *op);
 	void declineSession (const std::shared_ptr<CallSession> &session, LinphoneReason reason);
 	void dispatchQueuedMessages ();
+	void dispatchQueuedMessages (const std::shared_ptr<ParticipantDevice> &device);
 
 	void subscribeReceived (LinphoneEvent *event);
 	void subscriptionStateChanged (LinphoneEvent *event, LinphoneSubscriptionState state);
@@ -121,15 +122,53 @@ private:
 		~Message () {
 			if (customHeaders)
 				sal_custom_header_free(customHeaders);
+			if (outgoingHeaders)
+				sal_custom_header_free(outgoingHeaders);
 		}
 
 		IdentityAddress fromAddr;
 		Content content;
 		std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
 		SalCustomHeader *customHeaders = nullptr;
+
+		// Headers forwarded to every device, looked up once per message.
+		std::list<std::pair<std::string, std::string>> forwardedHeaders;
+		bool forwardedHeadersPrepared = false;
+
+		// Custom headers of the MESSAGEs sent to the devices, built on the first one and shared by all of them.
+		SalCustomHeader *outgoingHeaders = nullptr;
+	};
+
+	struct QueuedMessage {
+		QueuedMessage (const std::shared_ptr<Message> &message, long long dbId) : message(message), dbId(dbId) {}
+
+		std::shared_ptr<Message> message;
+		long long dbId; // Not positive if the message is only in memory.
+	};
+
+	/*
+	 * Messages waiting for a device. Every message is written to the database, which survives restarts, and the
+	 * head of the queue is cached in memory, up to a configurable number of messages. The messages after the
+	 * first uncached one are read back from the database in order, a batch at a time.
+	 */
+	struct MessageQueue {
+		size_t size () const { return cached.size() + uncached; }
+
+		std::queue<QueuedMessage> cached;
+		size_t uncached = 0;
+		bool drainScheduled = false;
+	};
+
+	struct MessageQueueSettings {
+		size_t maxPerDevice = 10000;
+		size_t maxPerChatRoom = 100000;
+		size_t maxInMemoryPerDevice = 1000; // 0 for no limit.
+		int drainBatchSize = 100; // Messages sent to a device per main loop iteration.
+		std::chrono::seconds maxAge = std::chrono::hours(168);
 	};
 
-	static void copyMessageHeaders (const std::shared_ptr<Message> &fromMessage, const std::shared_ptr<ChatMessage> &toMessage);
+	static void prepareForwardedHeaders (const std::shared_ptr<Message> &message);
+	static SalCustomHeader *getOutgoingHeaders (const std::shared_ptr<Message> &message);
 	static bool allDevicesLeft(const std::shared_ptr<Participant> &participant);
 	void addParticipantDevice (const std::shared_ptr<Participant> &participant, const ParticipantDeviceIdentity &deviceInfo);
 	void designateAdmin ();
@@ -139,8 +178,16 @@ private:
 	void inviteDevice (const std::shared_ptr<ParticipantDevice> &device);
 	void byeDevice (const std::shared_ptr<ParticipantDevice> &device);
 	bool isAdminLeft () const;
-	void queueMessage (const std::shared_ptr<Message> &message);
+	void fanOutMessage (const std::shared_ptr<Message> &message);
 	void queueMessage (const std::shared_ptr<Message> &msg, const IdentityAddress &deviceAddress);
+	void loadQueuedMessages ();
+	bool canUseQueuedMessagesStorage () const;
+	void dropOldestQueuedMessage (MessageQueue &msgQueue, const IdentityAddress &deviceAddress);
+	void clearQueuedMessages (const IdentityAddress &deviceAddress);
+	void scheduleQueuedMessagesDrain (MessageQueue &msgQueue, const std::shared_ptr<ParticipantDevice> &device);
+	void drainQueuedMessages (const std::shared_ptr<ParticipantDevice> &device);
+	size_t loadUncachedMessages (MessageQueue &msgQueue, const IdentityAddress &deviceAddress);
+	void addAuthorizedParticipant (const std::shared_ptr<Participant> &participant);
 	void removeParticipantDevice (const std::shared_ptr<Participant> &participant, const IdentityAddress &deviceAddress);
 
 	void onParticipantDeviceLeft (const std::shared_ptr<ParticipantDevice> &device);
@@ -165,13 +212,17 @@ private:
 	
 	std::list<std::shared_ptr<Participant>> authorizedParticipants; /*list of participant authorized to send messages to the chatroom.
 					This typically excludes participants that in the process of being removed.*/
+	std::unordered_map<IdentityAddress, std::shared_ptr<Participant>> authorizedParticipantsByAddress; /*index of authorizedParticipants*/
 	std::list<IdentityAddress> invitedParticipants; // participants in the process of being added to the chatroom, while for registration information.
 	ChatRoomListener *chatRoomListener = this;
 	std::map<std::string, RegistrationSubscriptionContext> registrationSubscriptions; /*map of registrationSubscriptions for each participant*/
 	int unnotifiedRegistrationSubscriptions = 0; /*count of not-yet notified registration subscriptions*/
 	std::shared_ptr<ParticipantDevice> mInitiatorDevice; /*pointer to the ParticipantDevice that is creating the chat room*/
 	bool joiningPendingAfterCreation = false;
-	std::unordered_map<std::string, std::queue<std::shared_ptr<Message>>> queuedMessages;
+	std::unordered_map<std::string, MessageQueue> queuedMessages;
+	MessageQueueSettings queuedMessagesSettings;
+	ServerGroupChatRoom::QueuedMessagesStats queuedMessagesStats;
+	bool queuedMessagesLoaded = false;
 
 	L_DECLARE_PUBLIC(ServerGroupChatRoom);
 };
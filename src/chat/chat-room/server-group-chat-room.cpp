@@ -36,6 +36,7 @@
 #include "core/core-p.h"
 #include "event-log/events.h"
 #include "logger/logger.h"
+#include "sal/message-op.h"
 #include "sal/refer-op.h"
 #include "server-group-chat-room-p.h"
 
@@ -96,7 +97,7 @@ void ServerGroupChatRoomPrivate::setState (ChatRoom::State state) {
 
 			if (capabilities & ServerGroupChatRoom::Capabilities::OneToOne){
 				// Even if devices can BYE and get rid of their session, actually no one can leave a one to one chatroom.
-				authorizedParticipants.push_back(participant);
+				addAuthorizedParticipant(participant);
 			}else{
 				bool atLeastOneDeviceJoining = false;
 				bool atLeastOneDevicePresent = false;
@@ -122,7 +123,7 @@ void ServerGroupChatRoomPrivate::setState (ChatRoom::State state) {
 				//its devices were "BYEed" yet. This is what the line below is testing. Might be better to add a new state in the participant Class,
 				// but it's not the case yet.
 				if (atLeastOneDevicePresent || atLeastOneDeviceJoining || atLeastOneDeviceLeaving == false ){
-					authorizedParticipants.push_back(participant);
+					addAuthorizedParticipant(participant);
 				}
 			}
 		}
@@ -140,11 +141,12 @@ shared_ptr<Participant> ServerGroupChatRoomPrivate::addParticipant (const Identi
 	if (!participant) {
 		participant = make_shared<Participant>(qConference, addr);
 		qConference->getPrivate()->participants.push_back(participant);
+		qConference->getPrivate()->invalidateParticipantsIndex();
 	}
 	/* Case of participant that is still referenced in the chatroom, but no longer authorized because it has been removed
 	 * previously OR a totally new participant. */
 	if (findAuthorizedParticipant(addr) == nullptr){
-		authorizedParticipants.push_back(participant);
+		addAuthorizedParticipant(participant);
 		shared_ptr<ConferenceParticipantEvent> event = qConference->getPrivate()->eventHandler->notifyParticipantAdded(addr);
 		q->getCore()->getPrivate()->mainDb->addEvent(event);
 	}
@@ -177,10 +179,10 @@ void ServerGroupChatRoomPrivate::setParticipantDeviceState (const shared_ptr<Par
 	switch (state){
 		case ParticipantDevice::State::ScheduledForLeaving:
 		case ParticipantDevice::State::Leaving:
-			queuedMessages.erase(address);
+			clearQueuedMessages(device->getAddress());
 		break;
 		case ParticipantDevice::State::Left:
-			queuedMessages.erase(address);
+			clearQueuedMessages(device->getAddress());
 			onParticipantDeviceLeft(device);
 		break;
 		default:
@@ -368,34 +370,156 @@ void ServerGroupChatRoomPrivate::declineSession (const shared_ptr<CallSession> &
 void ServerGroupChatRoomPrivate::dispatchQueuedMessages () {
 	L_Q();
 	for (const auto &participant : q->getParticipants()) {
-		/*
-		 * Dispatch messages for each device in Present state. In a one to one chatroom, if a device
-		 * is found is Left state, it must be invited first.
-		 */
+		for (const auto &device : participant->getPrivate()->getDevices())
+			dispatchQueuedMessages(device);
+	}
+}
 
-		for (const auto &device : participant->getPrivate()->getDevices()) {
+/*
+ * Dispatch messages for a device in Present state. In a one to one chatroom, if the device
+ * is found is Left state, it must be invited first.
+ */
+void ServerGroupChatRoomPrivate::dispatchQueuedMessages (const shared_ptr<ParticipantDevice> &device) {
+	loadQueuedMessages();
+	if (queuedMessages.empty())
+		return;
 
-			string uri(device->getAddress().asString());
-			auto & msgQueue = queuedMessages[uri];
+	auto it = queuedMessages.find(device->getAddress().asString());
+	if (it == queuedMessages.end() || (it->second.size() == 0))
+		return;
 
-			if (!msgQueue.empty()){
-				if ( (capabilities & ServerGroupChatRoom::Capabilities::OneToOne) && device->getState() == ParticipantDevice::State::Left){
-					lInfo() << "There is a message to transmit to a participant in left state in a one to one chatroom, so inviting first.";
-					inviteDevice(device);
-					continue;
-				}
-				if (device->getState() != ParticipantDevice::State::Present)
-					continue;
-				size_t nbMessages = msgQueue.size();
-				lInfo() << q << ": Dispatching " << nbMessages << " queued message(s) for '" << uri << "'";
-				while (!msgQueue.empty()) {
-					shared_ptr<Message> msg = msgQueue.front();
-					sendMessage(msg, device->getAddress());
-					msgQueue.pop();
-				}
-			}
+	if ( (capabilities & ServerGroupChatRoom::Capabilities::OneToOne) && device->getState() == ParticipantDevice::State::Left){
+		lInfo() << "There is a message to transmit to a participant in left state in a one to one chatroom, so inviting first.";
+		inviteDevice(device);
+		return;
+	}
+	if (device->getState() != ParticipantDevice::State::Present)
+		return;
+
+	scheduleQueuedMessagesDrain(it->second, device);
+}
+
+/*
+ * Queued messages are sent a batch per main loop iteration, so that a device coming back after a long
+ * absence doesn't hold the server for the whole backlog.
+ */
+void ServerGroupChatRoomPrivate::scheduleQueuedMessagesDrain (MessageQueue &msgQueue, const shared_ptr<ParticipantDevice> &device) {
+	L_Q();
+	if (msgQueue.drainScheduled)
+		return;
+	msgQueue.drainScheduled = true;
+
+	weak_ptr<ChatRoom> weakChatRoom(q->getSharedFromThis());
+	weak_ptr<ParticipantDevice> weakDevice(device);
+	string uri(device->getAddress().asString());
+	q->getCore()->doLater([this, weakChatRoom, weakDevice, uri]() {
+		shared_ptr<ChatRoom> chatRoom = weakChatRoom.lock();
+		if (!chatRoom)
+			return;
+		auto it = queuedMessages.find(uri);
+		if (it == queuedMessages.end())
+			return;
+		it->second.drainScheduled = false;
+		shared_ptr<ParticipantDevice> drainedDevice = weakDevice.lock();
+		if (drainedDevice)
+			drainQueuedMessages(drainedDevice);
+	});
+}
+
+/*
+ * Send the next batch of queued messages to a device and remove them from the database, then schedule
+ * the next batch if any.
+ */
+void ServerGroupChatRoomPrivate::drainQueuedMessages (const shared_ptr<ParticipantDevice> &device) {
+	L_Q();
+	const IdentityAddress &deviceAddress = device->getAddress();
+	auto it = queuedMessages.find(deviceAddress.asString());
+	if (it == queuedMessages.end())
+		return;
+	// The drain is resumed by the next dispatch if the device is gone in the meantime.
+	if (device->getState() != ParticipantDevice::State::Present)
+		return;
+
+	MessageQueue &msgQueue = it->second;
+	if (msgQueue.cached.empty())
+		loadUncachedMessages(msgQueue, deviceAddress);
+
+	chrono::system_clock::time_point now = chrono::system_clock::now();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	size_t nbSent = 0;
+	long long lastDbId = -1;
+	for (int i = 0; (i < queuedMessagesSettings.drainBatchSize) && !msgQueue.cached.empty(); i++) {
+		const QueuedMessage &queuedMsg = msgQueue.cached.front();
+		if (queuedMsg.dbId > 0)
+			lastDbId = queuedMsg.dbId;
+		if (now - queuedMsg.message->timestamp >= queuedMessagesSettings.maxAge)
+			queuedMessagesStats.dropped++;
+		else {
+			sendMessage(queuedMsg.message, deviceAddress);
+			nbSent++;
 		}
+		msgQueue.cached.pop();
+		queuedMessagesStats.depth--;
+	}
+	if (lastDbId > 0)
+		q->getCore()->getPrivate()->mainDb->deleteServerQueuedMessages(q->getConferenceId(), deviceAddress, lastDbId);
+
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+	queuedMessagesStats.drained += nbSent;
+	queuedMessagesStats.drainSeconds += elapsed.count();
+	if (elapsed.count() > 0)
+		queuedMessagesStats.lastDrainRate = double(nbSent) / elapsed.count();
+
+	if (msgQueue.size() == 0) {
+		lInfo() << q << ": Dispatched all queued messages to '" << deviceAddress << "', "
+			<< queuedMessagesStats.depth << " message(s) still queued in the chat room";
+		queuedMessages.erase(it);
+		return;
 	}
+	lInfo() << q << ": Dispatched " << nbSent << " queued message(s) to '" << deviceAddress << "' in "
+		<< elapsed.count() << " s, " << msgQueue.size() << " remaining";
+	scheduleQueuedMessagesDrain(msgQueue, device);
+}
+
+/*
+ * Read the next uncached messages of a queue from the database, at most a drain batch.
+ * Returns the number of messages read.
+ */
+size_t ServerGroupChatRoomPrivate::loadUncachedMessages (MessageQueue &msgQueue, const IdentityAddress &deviceAddress) {
+	L_Q();
+	if (msgQueue.uncached == 0)
+		return 0;
+
+	list<MainDb::ServerQueuedMessage> dbMessages;
+	if (canUseQueuedMessagesStorage()) {
+		int limit = (int)min((size_t)queuedMessagesSettings.drainBatchSize, msgQueue.uncached);
+		dbMessages = q->getCore()->getPrivate()->mainDb->getServerQueuedMessages(q->getConferenceId(), deviceAddress, limit);
+	}
+	if (dbMessages.empty()) {
+		lWarning() << q << ": " << msgQueue.uncached << " queued message(s) for '" << deviceAddress
+			<< "' are no longer in database";
+		queuedMessagesStats.depth -= msgQueue.uncached;
+		queuedMessagesStats.uncachedDepth -= msgQueue.uncached;
+		queuedMessagesStats.dropped += msgQueue.uncached;
+		msgQueue.uncached = 0;
+		return 0;
+	}
+
+	for (const auto &dbMessage : dbMessages) {
+		shared_ptr<Message> msg = make_shared<Message>(
+			dbMessage.fromAddress.asString(),
+			ContentType(dbMessage.contentType),
+			dbMessage.body,
+			nullptr
+		);
+		msg->timestamp = chrono::system_clock::from_time_t(dbMessage.timestamp);
+		msg->forwardedHeaders = dbMessage.headers;
+		msg->forwardedHeadersPrepared = true;
+		msgQueue.cached.emplace(msg, dbMessage.dbId);
+	}
+	msgQueue.uncached -= dbMessages.size();
+	queuedMessagesStats.uncachedDepth -= dbMessages.size();
+	return dbMessages.size();
 }
 
 void ServerGroupChatRoomPrivate::removeParticipant (const shared_ptr<const Participant> &participant) {
@@ -411,15 +535,14 @@ void ServerGroupChatRoomPrivate::removeParticipant (const shared_ptr<const Parti
 		updateParticipantDeviceSession(device);
 	}
 
-	for (const auto &p : authorizedParticipants) {
-		if (participant->getAddress() == p->getAddress()) {
-			lInfo() << q <<" 'participant ' "<< p->getAddress() <<" no more authorized'";
-			authorizedParticipants.remove(p);
-			break;
-		}
+	auto it = authorizedParticipantsByAddress.find(participant->getAddress());
+	if (it != authorizedParticipantsByAddress.end()) {
+		lInfo() << q <<" 'participant ' "<< it->second->getAddress() <<" no more authorized'";
+		authorizedParticipants.remove(it->second);
+		authorizedParticipantsByAddress.erase(it);
 	}
 
-	queuedMessages.erase(participant->getAddress().asString());
+	clearQueuedMessages(participant->getAddress());
 
 	shared_ptr<ConferenceParticipantEvent> event = qConference->getPrivate()->eventHandler->notifyParticipantRemoved(participant->getAddress());
 	q->getCore()->getPrivate()->mainDb->addEvent(event);
@@ -438,13 +561,13 @@ shared_ptr<Participant> ServerGroupChatRoomPrivate::findAuthorizedParticipant (c
 }
 
 shared_ptr<Participant> ServerGroupChatRoomPrivate::findAuthorizedParticipant (const IdentityAddress &participantAddress) const {
-	IdentityAddress searchedAddr(participantAddress);
-	searchedAddr.setGruu("");
-	for (const auto &participant : authorizedParticipants) {
-		if (participant->getAddress() == searchedAddr)
-			return participant;
-	}
-	return nullptr;
+	auto it = authorizedParticipantsByAddress.find(participantAddress.getAddressWithoutGruu());
+	return it != authorizedParticipantsByAddress.end() ? it->second : nullptr;
+}
+
+void ServerGroupChatRoomPrivate::addAuthorizedParticipant (const shared_ptr<Participant> &participant) {
+	authorizedParticipants.push_back(participant);
+	authorizedParticipantsByAddress[participant->getAddress()] = participant;
 }
 
 void ServerGroupChatRoomPrivate::subscribeReceived (LinphoneEvent *event) {
@@ -556,8 +679,7 @@ LinphoneReason ServerGroupChatRoomPrivate::onSipMessageReceived (SalOp *op, cons
 		op->getRecvCustomHeaders()
 	);
 
-	queueMessage(msg);
-	dispatchQueuedMessages();
+	fanOutMessage(msg);
 	return LinphoneReasonNone;
 }
 
@@ -691,17 +813,35 @@ void ServerGroupChatRoomPrivate::setParticipantDevices(const IdentityAddress &pa
 
 // -----------------------------------------------------------------------------
 
-void ServerGroupChatRoomPrivate::copyMessageHeaders (const shared_ptr<Message> &fromMessage, const shared_ptr<ChatMessage> &toMessage) {
-	string headersToCopy[] = {
+void ServerGroupChatRoomPrivate::prepareForwardedHeaders (const shared_ptr<Message> &message) {
+	if (message->forwardedHeadersPrepared)
+		return;
+
+	static const string headersToCopy[] = {
 		"Content-Encoding",
 		"Expires",
 		"Priority"
 	};
 	for (const auto &headerName : headersToCopy) {
-		const char *headerValue = sal_custom_header_find(fromMessage->customHeaders, headerName.c_str());
+		const char *headerValue = sal_custom_header_find(message->customHeaders, headerName.c_str());
 		if (headerValue)
-			toMessage->getPrivate()->addSalCustomHeader(headerName, headerValue);
+			message->forwardedHeaders.emplace_back(headerName, headerValue);
 	}
+	message->forwardedHeadersPrepared = true;
+}
+
+SalCustomHeader *ServerGroupChatRoomPrivate::getOutgoingHeaders (const shared_ptr<Message> &message) {
+	if (message->outgoingHeaders)
+		return message->outgoingHeaders;
+
+	prepareForwardedHeaders(message);
+	SalCustomHeader *headers = nullptr;
+	for (const auto &header : message->forwardedHeaders)
+		headers = sal_custom_header_append(headers, header.first.c_str(), header.second.c_str());
+	// Special custom header to identify MESSAGE that belong to server group chatroom
+	headers = sal_custom_header_append(headers, "Session-mode", "true");
+	message->outgoingHeaders = headers;
+	return headers;
 }
 
 /*
@@ -781,17 +921,31 @@ void ServerGroupChatRoomPrivate::designateAdmin () {
 	}
 }
 
+/*
+ * The message is forwarded as is, without modifiers nor storage: no ChatMessage is needed. The body and the
+ * headers are shared by the MESSAGEs sent to all the devices, only the Request-URI changes.
+ */
 void ServerGroupChatRoomPrivate::sendMessage (const shared_ptr<Message> &message, const IdentityAddress &deviceAddr){
 	L_Q();
 
-	shared_ptr<ChatMessage> msg = q->createChatMessage();
-	copyMessageHeaders(message, msg);
-	msg->getPrivate()->addSalCustomHeader("Session-mode", "true"); // Special custom header to identify MESSAGE that belong to server group chatroom
-	msg->setInternalContent(message->content);
-	msg->getPrivate()->forceFromAddress(q->getConferenceAddress());
-	msg->getPrivate()->forceToAddress(deviceAddr);
-	msg->getPrivate()->setApplyModifiers(false);
-	msg->send();
+	LinphoneCore *cCore = q->getCore()->getCCore();
+	const string from = q->getConferenceAddress().asString();
+	const string to = deviceAddr.asString();
+	LinphoneAddress *local = linphone_address_new(from.c_str());
+	LinphoneAddress *peer = linphone_address_new(to.c_str());
+	SalMessageOp *op = new SalMessageOp(cCore->sal);
+	linphone_configure_op_2(
+		cCore, op, local, peer, getOutgoingHeaders(message),
+		!!linphone_config_get_int(linphone_core_get_config(cCore), "sip", "chat_msg_with_contact", 0)
+	);
+	linphone_address_unref(local);
+	linphone_address_unref(peer);
+	op->setFrom(from);
+	op->setTo(to);
+	if (op->sendMessage(message->content) != 0)
+		lError() << q << ": Unable to send message to '" << deviceAddr << "'";
+	// Without user pointer, the delivery reports of this op are ignored. The transaction keeps it alive.
+	op->unref();
 }
 
 void ServerGroupChatRoomPrivate::finalizeCreation () {
@@ -936,31 +1090,166 @@ bool ServerGroupChatRoomPrivate::isAdminLeft () const {
 	return false;
 }
 
-void ServerGroupChatRoomPrivate::queueMessage (const shared_ptr<Message> &msg) {
+/*
+ * Send a message to all devices except the one that sent it. Present devices without pending messages
+ * get it immediately, the others get it queued and dispatched as soon as they can receive it.
+ */
+void ServerGroupChatRoomPrivate::fanOutMessage (const shared_ptr<Message> &msg) {
 	L_Q();
+	loadQueuedMessages();
 	for (const auto &participant : q->getParticipants()) {
 		for (const auto &device : participant->getPrivate()->getDevices()) {
-			// Queue the message for all devices except the one that sent it
-			if (msg->fromAddr != device->getAddress()){
-				queueMessage(msg, device->getAddress());
+			const IdentityAddress &deviceAddress = device->getAddress();
+			if (msg->fromAddr == deviceAddress) {
+				dispatchQueuedMessages(device);
+				continue;
 			}
+			if ((device->getState() == ParticipantDevice::State::Present)
+				&& (queuedMessages.empty() || (queuedMessages.find(deviceAddress.asString()) == queuedMessages.end()))
+			) {
+				sendMessage(msg, deviceAddress);
+				continue;
+			}
+			queueMessage(msg, deviceAddress);
+			dispatchQueuedMessages(device);
 		}
 	}
 }
 
 void ServerGroupChatRoomPrivate::queueMessage (const shared_ptr<Message> &msg, const IdentityAddress &deviceAddress) {
+	L_Q();
+	const MessageQueueSettings &settings = queuedMessagesSettings;
+	if (queuedMessagesStats.depth >= settings.maxPerChatRoom) {
+		lWarning() << q << ": Too many queued messages (" << queuedMessagesStats.depth << "), message for '"
+			<< deviceAddress << "' is dropped";
+		queuedMessagesStats.dropped++;
+		return;
+	}
+
+	const unique_ptr<MainDb> &mainDb = q->getCore()->getPrivate()->mainDb;
 	chrono::system_clock::time_point timestamp = chrono::system_clock::now();
-	string uri(deviceAddress.asString());
-	// Remove queued messages older than one week
-	while (!queuedMessages[uri].empty()) {
-		shared_ptr<Message> m = queuedMessages[uri].front();
-		chrono::hours age = chrono::duration_cast<chrono::hours>(timestamp - m->timestamp);
-		chrono::hours oneWeek(168);
-		if (age < oneWeek)
-			break;
-		queuedMessages[uri].pop();
+	auto &msgQueue = queuedMessages[deviceAddress.asString()];
+	// Remove cached messages that are too old. The uncached ones are checked when drained.
+	long long lastExpiredDbId = -1;
+	while (!msgQueue.cached.empty() && (timestamp - msgQueue.cached.front().message->timestamp >= settings.maxAge)) {
+		if (msgQueue.cached.front().dbId > 0)
+			lastExpiredDbId = msgQueue.cached.front().dbId;
+		msgQueue.cached.pop();
+		queuedMessagesStats.depth--;
+		queuedMessagesStats.dropped++;
+	}
+	if (lastExpiredDbId > 0)
+		mainDb->deleteServerQueuedMessages(q->getConferenceId(), deviceAddress, lastExpiredDbId);
+	if (msgQueue.size() >= settings.maxPerDevice)
+		dropOldestQueuedMessage(msgQueue, deviceAddress);
+
+	long long dbId = -1;
+	if (canUseQueuedMessagesStorage()) {
+		prepareForwardedHeaders(msg);
+		MainDb::ServerQueuedMessage dbMessage;
+		dbMessage.fromAddress = msg->fromAddr;
+		dbMessage.contentType = msg->content.getContentType().getValueWithParams();
+		dbMessage.body = msg->content.getBodyAsString();
+		dbMessage.headers = msg->forwardedHeaders;
+		dbMessage.timestamp = chrono::system_clock::to_time_t(msg->timestamp);
+		dbId = mainDb->insertServerQueuedMessage(q->getConferenceId(), deviceAddress, dbMessage);
+	}
+
+	// Only the head of the queue is cached: once a message is left in database, the next ones are too,
+	// so that they are read back in order. A message that couldn't be stored is kept in memory.
+	if (
+		dbId <= 0 ||
+		(msgQueue.uncached == 0 && (settings.maxInMemoryPerDevice == 0 || msgQueue.cached.size() < settings.maxInMemoryPerDevice))
+	) {
+		msgQueue.cached.emplace(msg, dbId);
+	} else {
+		msgQueue.uncached++;
+		queuedMessagesStats.uncachedDepth++;
+	}
+	queuedMessagesStats.depth++;
+}
+
+void ServerGroupChatRoomPrivate::dropOldestQueuedMessage (MessageQueue &msgQueue, const IdentityAddress &deviceAddress) {
+	L_Q();
+	lWarning() << q << ": Too many queued messages for '" << deviceAddress << "', dropping the oldest one";
+	const unique_ptr<MainDb> &mainDb = q->getCore()->getPrivate()->mainDb;
+	queuedMessagesStats.dropped++;
+	if (!msgQueue.cached.empty()) {
+		long long dbId = msgQueue.cached.front().dbId;
+		msgQueue.cached.pop();
+		queuedMessagesStats.depth--;
+		if (dbId > 0)
+			mainDb->deleteServerQueuedMessages(q->getConferenceId(), deviceAddress, dbId);
+		return;
+	}
+
+	if (msgQueue.uncached == 0)
+		return;
+	list<MainDb::ServerQueuedMessage> oldest = mainDb->getServerQueuedMessages(q->getConferenceId(), deviceAddress, 1);
+	if (!oldest.empty())
+		mainDb->deleteServerQueuedMessages(q->getConferenceId(), deviceAddress, oldest.front().dbId);
+	msgQueue.uncached--;
+	queuedMessagesStats.uncachedDepth--;
+	queuedMessagesStats.depth--;
+}
+
+void ServerGroupChatRoomPrivate::clearQueuedMessages (const IdentityAddress &deviceAddress) {
+	L_Q();
+	auto it = queuedMessages.find(deviceAddress.asString());
+	if (it == queuedMessages.end())
+		return;
+
+	const MessageQueue &msgQueue = it->second;
+	if (canUseQueuedMessagesStorage())
+		q->getCore()->getPrivate()->mainDb->deleteServerQueuedMessages(q->getConferenceId(), deviceAddress);
+	queuedMessagesStats.depth -= msgQueue.size();
+	queuedMessagesStats.uncachedDepth -= msgQueue.uncached;
+	queuedMessages.erase(it);
+}
+
+bool ServerGroupChatRoomPrivate::canUseQueuedMessagesStorage () const {
+	L_Q();
+	const unique_ptr<MainDb> &mainDb = q->getCore()->getPrivate()->mainDb;
+	return mainDb && mainDb->isInitialized() && q->getConferenceId().isValid();
+}
+
+/*
+ * Read the queue settings and recover the messages queued before a restart of the server.
+ * Done once, when the first message is queued or dispatched.
+ */
+void ServerGroupChatRoomPrivate::loadQueuedMessages () {
+	L_Q();
+	if (queuedMessagesLoaded)
+		return;
+	queuedMessagesLoaded = true;
+
+	LinphoneConfig *config = linphone_core_get_config(q->getCore()->getCCore());
+	MessageQueueSettings &settings = queuedMessagesSettings;
+	settings.maxPerDevice = (size_t)max(1, linphone_config_get_int(config, "misc", "queued_messages_max_per_device", (int)settings.maxPerDevice));
+	settings.maxPerChatRoom = (size_t)max(1, linphone_config_get_int(config, "misc", "queued_messages_max_per_chat_room", (int)settings.maxPerChatRoom));
+	settings.maxInMemoryPerDevice = (size_t)max(0, linphone_config_get_int(config, "misc", "queued_messages_max_in_memory_per_device", (int)settings.maxInMemoryPerDevice));
+	settings.drainBatchSize = max(1, linphone_config_get_int(config, "misc", "queued_messages_drain_batch_size", settings.drainBatchSize));
+	settings.maxAge = chrono::seconds(linphone_config_get_int(config, "misc", "queued_messages_max_age", (int)settings.maxAge.count()));
+
+	if (!canUseQueuedMessagesStorage())
+		return;
+
+	const unique_ptr<MainDb> &mainDb = q->getCore()->getPrivate()->mainDb;
+	time_t expiredTime = chrono::system_clock::to_time_t(chrono::system_clock::now() - settings.maxAge);
+	mainDb->deleteExpiredServerQueuedMessages(q->getConferenceId(), expiredTime);
+	if (mainDb->getServerQueuedMessageCount(q->getConferenceId()) == 0)
+		return;
+
+	// Devices that are not in the chat room yet get their messages when they join.
+	for (const auto &deviceAddress : mainDb->getServerQueuedMessageDevices(q->getConferenceId())) {
+		int count = mainDb->getServerQueuedMessageCount(q->getConferenceId(), deviceAddress);
+		if (count <= 0)
+			continue;
+		queuedMessages[deviceAddress.asString()].uncached += (size_t)count;
+		queuedMessagesStats.uncachedDepth += (size_t)count;
+		queuedMessagesStats.depth += (size_t)count;
 	}
-	queuedMessages[uri].push(msg);
+	lInfo() << q << ": Recovered " << queuedMessagesStats.depth << " queued message(s) from database";
 }
 
 /* The removal of participant device is done only when such device disapears from registration database, ie when a device unregisters explicitely
@@ -1151,6 +1440,7 @@ LocalConference(getCore(), peerAddress, nullptr) {
 
 	dConference->subject = subject;
 	dConference->participants = move(participants);
+	dConference->invalidateParticipantsIndex();
 	dConference->conferenceAddress = peerAddress;
 	dConference->eventHandler->setLastNotify(lastNotifyId);
 	dConference->eventHandler->setConferenceId(d->conferenceId);
@@ -1265,6 +1555,11 @@ const list<shared_ptr<Participant>> &ServerGroupChatRoom::getParticipants () con
 	return d->authorizedParticipants;
 }
 
+const ServerGroupChatRoom::QueuedMessagesStats &ServerGroupChatRoom::getQueuedMessagesStats () const {
+	L_D();
+	return d->queuedMessagesStats;
+}
+
 const string &ServerGroupChatRoom::getSubject () const {
 	return LocalConference::getSubject();
 }
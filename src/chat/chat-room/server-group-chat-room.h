@@ -32,6 +32,16 @@ class ServerGroupChatRoomPrivate;
 
 class ServerGroupChatRoom : public ChatRoom, public LocalConference {
 public:
+	// Counters of the messages queued for the devices that can't receive them yet.
+	struct QueuedMessagesStats {
+		size_t depth = 0; // Messages waiting for a device. All of them are stored in database when it is available.
+		size_t uncachedDepth = 0; // Part of depth that is only in database.
+		unsigned long long drained = 0; // Messages delivered from the queues.
+		unsigned long long dropped = 0; // Messages discarded because of quotas or age.
+		double drainSeconds = 0; // Time spent delivering the queued messages.
+		double lastDrainRate = 0; // Messages per second of the last drained batch.
+	};
+
 	// TODO: Make me private!
 	ServerGroupChatRoom (const std::shared_ptr<Core> &core, SalCallOp *op);
 
@@ -88,6 +98,8 @@ public:
 	void join () override;
 	void leave () override;
 
+	const QueuedMessagesStats &getQueuedMessagesStats () const;
+
 	/* ConferenceListener */
 	void onFirstNotifyReceived (const IdentityAddress &addr) override;
 
@@ -86,6 +86,9 @@ public:
 		FileTransferContent *fileTransferContent
 	) { return 0; }
 
+	// True if downloadingFile() and uploadingFile() accept the same buffer as input and output.
+	virtual bool isFileTransferProcessedInPlace () const { return false; }
+
 	virtual void mutualAuthentication (
 		MSZrtpContext *zrtpContext,
 		SalMediaDescription *localMediaDescription,
@@ -121,10 +124,14 @@ public:
 	virtual AbstractChatRoom::SecurityLevel getSecurityLevel (const std::string &deviceId) const { return AbstractChatRoom::SecurityLevel::ClearText; }
 	virtual std::list<EncryptionParameter> getEncryptionParameters () { return std::list<EncryptionParameter>(); }
 
+	// Changes each time the trust status of a peer device may have changed, allowing callers to cache security levels.
+	virtual unsigned int getSecurityLevelVersion () const { return securityLevelVersion; }
+
 protected:
 	EncryptionEngine (const std::shared_ptr<Core> &core) : CoreAccessor(core) {}
 
 	EngineType engineType;
+	unsigned int securityLevelVersion = 0;
 };
 
 LINPHONE_END_NAMESPACE
@@ -130,6 +130,7 @@ LimeX3dhEncryptionEngine::LimeX3dhEncryptionEngine (
 	_dbAccess = dbAccess;
 	x3dhServerUrl = serverUrl;
 	limeManager = unique_ptr<LimeManager>(new LimeManager(dbAccess, prov, core));
+	cache = make_shared<LimeCache>();
 	lastLimeUpdate = linphone_config_get_int(cCore->config, "lime", "last_update_time", 0);
 	if (x3dhServerUrl.empty())
 		lError() << "[LIME] server URL unavailable for encryption engine";
@@ -240,8 +241,11 @@ ChatMessageModifier::Result LimeX3dhEncryptionEngine::processOutgoingMessage (
 
 	try {
 		errorCode = 0; //no need to specify error code because not used later
-		limeManager->encrypt(localDeviceId, recipientUserId, recipients, plainMessage, cipherMessage, [localDeviceId, recipients, cipherMessage, message, result] (lime::CallbackReturn returnCode, string errorMessage) {
+		shared_ptr<LimeCache> limeCache = cache;
+		limeManager->encrypt(localDeviceId, recipientUserId, recipients, plainMessage, cipherMessage, [limeCache, localDeviceId, recipients, cipherMessage, message, result] (lime::CallbackReturn returnCode, string errorMessage) {
 			if (returnCode == lime::CallbackReturn::success) {
+				for (const lime::RecipientData &recipient : *recipients)
+					limeCache->updatePeerDeviceStatus(recipient.deviceId, recipient.peerStatus);
 
 				// Ignore devices which do not have keys on the X3DH server
 				// The message will still be sent to them but they will not be able to decrypt it
@@ -374,7 +378,7 @@ ChatMessageModifier::Result LimeX3dhEncryptionEngine::processIncomingMessage (
 	}
 
 	// Discard incoming messages from unsafe peer devices
-	lime::PeerDeviceStatus peerDeviceStatus = limeManager->get_peerDeviceStatus(senderDeviceId);
+	lime::PeerDeviceStatus peerDeviceStatus = getPeerDeviceStatus(senderDeviceId);
 	if (linphone_config_get_int(linphone_core_get_config(chatRoom->getCore()->getCCore()), "lime", "allow_message_in_unsafe_chatroom", 0) == 0) {
 		if (peerDeviceStatus == lime::PeerDeviceStatus::unsafe) {
 			lWarning() << "[LIME] discard incoming message from unsafe sender device " << senderDeviceId;
@@ -417,6 +421,7 @@ ChatMessageModifier::Result LimeX3dhEncryptionEngine::processIncomingMessage (
 
 	try {
 		 peerDeviceStatus = limeManager->decrypt(localDeviceId, recipientUserId, senderDeviceId, decodedCipherHeader, decodedCipherMessage, plainMessage);
+		cache->updatePeerDeviceStatus(senderDeviceId, peerDeviceStatus);
 	} catch (const exception &e) {
 		lError() << e.what() << " while decrypting message";
 	}
@@ -560,11 +565,80 @@ EncryptionEngine::EngineType LimeX3dhEncryptionEngine::getEngineType () {
 	return engineType;
 }
 
+lime::PeerDeviceStatus LimeX3dhEncryptionEngine::getPeerDeviceStatus (const string &peerDeviceId) const {
+	auto it = cache->peerDeviceStatuses.find(peerDeviceId);
+	if (it != cache->peerDeviceStatuses.end())
+		return it->second;
+
+	lime::PeerDeviceStatus status = limeManager->get_peerDeviceStatus(peerDeviceId);
+	cache->peerDeviceStatuses[peerDeviceId] = status;
+	return status;
+}
+
+void LimeX3dhEncryptionEngine::setPeerDeviceStatus (const string &peerDeviceId, lime::PeerDeviceStatus status) {
+	// LIME may refuse the transition (e.g. untrusted on an unsafe device), so the cached value is dropped rather than updated.
+	cache->invalidatePeerDeviceStatus(peerDeviceId);
+	limeManager->set_peerDeviceStatus(peerDeviceId, status);
+}
+
+void LimeX3dhEncryptionEngine::setPeerDeviceStatus (const string &peerDeviceId, const vector<uint8_t> &Ik, lime::PeerDeviceStatus status) {
+	cache->invalidatePeerDeviceStatus(peerDeviceId);
+	limeManager->set_peerDeviceStatus(peerDeviceId, Ik, status);
+}
+
+void LimeX3dhEncryptionEngine::deletePeerDevice (const string &peerDeviceId) {
+	cache->invalidatePeerDeviceStatus(peerDeviceId);
+	limeManager->delete_peerDevice(peerDeviceId);
+}
+
+bool LimeX3dhEncryptionEngine::isLocalUser (const string &deviceId) const {
+	auto it = cache->localUsers.find(deviceId);
+	if (it != cache->localUsers.end())
+		return it->second;
+
+	bool localUser = limeManager->is_localUser(deviceId);
+	cache->localUsers[deviceId] = localUser;
+	return localUser;
+}
+
+unsigned int LimeX3dhEncryptionEngine::getSecurityLevelVersion () const {
+	return cache->version;
+}
+
+void LimeX3dhEncryptionEngine::LimeCache::invalidatePeerDeviceStatus (const string &peerDeviceId) {
+	peerDeviceStatuses.erase(peerDeviceId);
+	version++;
+}
+
+// Called with the status reported by encrypt/decrypt, which store unknown devices as untrusted on first contact.
+void LimeX3dhEncryptionEngine::LimeCache::updatePeerDeviceStatus (const string &peerDeviceId, lime::PeerDeviceStatus reportedStatus) {
+	if (reportedStatus == lime::PeerDeviceStatus::fail)
+		return;
+
+	auto it = peerDeviceStatuses.find(peerDeviceId);
+	if (it == peerDeviceStatuses.end())
+		return;
+	if (reportedStatus != lime::PeerDeviceStatus::unknown && it->second == reportedStatus)
+		return;
+	invalidatePeerDeviceStatus(peerDeviceId);
+}
+
+void LimeX3dhEncryptionEngine::LimeCache::invalidateLocalUser (const string &deviceId) {
+	localUsers.erase(deviceId);
+	version++;
+}
+
+void LimeX3dhEncryptionEngine::LimeCache::clear () {
+	peerDeviceStatuses.clear();
+	localUsers.clear();
+	version++;
+}
+
 AbstractChatRoom::SecurityLevel LimeX3dhEncryptionEngine::getSecurityLevel (const string &deviceId) const {
-	lime::PeerDeviceStatus status = limeManager->get_peerDeviceStatus(deviceId);
+	lime::PeerDeviceStatus status = getPeerDeviceStatus(deviceId);
 	switch (status) {
 		case lime::PeerDeviceStatus::unknown:
-			if (limeManager->is_localUser(deviceId)) {
+			if (isLocalUser(deviceId)) {
 				return AbstractChatRoom::SecurityLevel::Safe;
 			}
 			return AbstractChatRoom::SecurityLevel::Encrypted;
@@ -714,11 +788,11 @@ void LimeX3dhEncryptionEngine::authenticationVerified (
 	else if (ms_zrtp_getAuxiliarySharedSecretMismatch(zrtpContext) == 0 /*BZRTP_AUXSECRET_MATCH*/) {
 		try {
 			lInfo() << "[LIME] SAS verified and Ik exchange successful";
-			limeManager->set_peerDeviceStatus(peerDeviceId, remoteIk, lime::PeerDeviceStatus::trusted);
+			setPeerDeviceStatus(peerDeviceId, remoteIk, lime::PeerDeviceStatus::trusted);
 		} catch (const BctbxException &e) {
 			lInfo() << "[LIME] exception" << e.what();
 			// Ik error occured, the stored Ik is different from this Ik
-			lime::PeerDeviceStatus status = limeManager->get_peerDeviceStatus(peerDeviceId);
+			lime::PeerDeviceStatus status = getPeerDeviceStatus(peerDeviceId);
 			switch (status) {
 				case lime::PeerDeviceStatus::unsafe:
 					lWarning() << "[LIME] peer device " << peerDeviceId << " is unsafe and its identity key has changed";
@@ -738,8 +812,8 @@ void LimeX3dhEncryptionEngine::authenticationVerified (
 					break;
 			}
 			// Delete current peer device data and replace it with the new Ik and a trusted status
-			limeManager->delete_peerDevice(peerDeviceId);
-			limeManager->set_peerDeviceStatus(peerDeviceId, remoteIk, lime::PeerDeviceStatus::trusted);
+			deletePeerDevice(peerDeviceId);
+			setPeerDeviceStatus(peerDeviceId, remoteIk, lime::PeerDeviceStatus::trusted);
 		}
 		catch (const exception &e) {
 			lError() << "[LIME] exception" << e.what();
@@ -750,7 +824,7 @@ void LimeX3dhEncryptionEngine::authenticationVerified (
 	else /*BZRTP_AUXSECRET_MISMATCH*/{
 		lError() << "[LIME] SAS is verified but the auxiliary secret mismatches, removing trust";
 		ms_zrtp_sas_reset_verified(zrtpContext);
-		limeManager->set_peerDeviceStatus(peerDeviceId, lime::PeerDeviceStatus::unsafe);
+		setPeerDeviceStatus(peerDeviceId, lime::PeerDeviceStatus::unsafe);
 		addSecurityEventInChatrooms(peerDeviceAddr, ConferenceSecurityEvent::SecurityEventType::ManInTheMiddleDetected);
 	}
 }
@@ -762,7 +836,7 @@ void LimeX3dhEncryptionEngine::authenticationRejected (
 	// Warn the user that rejecting the SAS reveals a man-in-the-middle
 	const IdentityAddress peerDeviceAddr = IdentityAddress(peerDeviceId);
 
-	if (limeManager->get_peerDeviceStatus(peerDeviceId) == lime::PeerDeviceStatus::trusted) {
+	if (getPeerDeviceStatus(peerDeviceId) == lime::PeerDeviceStatus::trusted) {
 		addSecurityEventInChatrooms(peerDeviceAddr, ConferenceSecurityEvent::SecurityEventType::SecurityLevelDowngraded);
 	}
 
@@ -773,7 +847,7 @@ void LimeX3dhEncryptionEngine::authenticationRejected (
 		addSecurityEventInChatrooms(peerDeviceAddr, ConferenceSecurityEvent::SecurityEventType::ManInTheMiddleDetected);
 	}
 
-	limeManager->set_peerDeviceStatus(peerDeviceId, statusIfSASrefused);
+	setPeerDeviceStatus(peerDeviceId, statusIfSASrefused);
 }
 
 void LimeX3dhEncryptionEngine::addSecurityEventInChatrooms (
@@ -801,7 +875,7 @@ shared_ptr<ConferenceSecurityEvent> LimeX3dhEncryptionEngine::onDeviceAdded (
 	const shared_ptr<AbstractChatRoom> &chatRoom,
 	ChatRoom::SecurityLevel currentSecurityLevel
 ) {
-	lime::PeerDeviceStatus newDeviceStatus = limeManager->get_peerDeviceStatus(newDeviceAddr.asString());
+	lime::PeerDeviceStatus newDeviceStatus = getPeerDeviceStatus(newDeviceAddr.asString());
 	int maxNbDevicesPerParticipant = linphone_config_get_int(linphone_core_get_config(L_GET_C_BACK_PTR(getCore())), "lime", "max_nb_device_per_participant", INT_MAX);
 	int nbDevice = int(participant->getPrivate()->getDevices().size());
 	shared_ptr<ConferenceSecurityEvent> securityEvent = nullptr;
@@ -815,7 +889,7 @@ shared_ptr<ConferenceSecurityEvent> LimeX3dhEncryptionEngine::onDeviceAdded (
 			ConferenceSecurityEvent::SecurityEventType::ParticipantMaxDeviceCountExceeded,
 			newDeviceAddr
 		);
-		limeManager->set_peerDeviceStatus(newDeviceAddr.asString(), lime::PeerDeviceStatus::unsafe);
+		setPeerDeviceStatus(newDeviceAddr.asString(), lime::PeerDeviceStatus::unsafe);
 	}
 
 	// Otherwise if the chatroom security level was degraded a corresponding security event is created
@@ -835,6 +909,7 @@ shared_ptr<ConferenceSecurityEvent> LimeX3dhEncryptionEngine::onDeviceAdded (
 
 void LimeX3dhEncryptionEngine::cleanDb () {
 	remove(_dbAccess.c_str());
+	cache->clear();
 }
 
 std::shared_ptr<LimeManager> LimeX3dhEncryptionEngine::getLimeManager () {
@@ -881,7 +956,13 @@ void LimeX3dhEncryptionEngine::onRegistrationStateChanged (
 		if (!limeManager->is_user(localDeviceId)) {
 			// create user if not exist
 			lime::limeCallback callback = setLimeCallback("creating user " + localDeviceId);
-			limeManager->create_user(localDeviceId, x3dhServerUrl, curve, callback);
+			shared_ptr<LimeCache> limeCache = cache;
+			limeManager->create_user(localDeviceId, x3dhServerUrl, curve, [limeCache, localDeviceId, callback] (lime::CallbackReturn returnCode, string anythingToSay) {
+				// The local user is only known for sure once the X3DH server answered
+				limeCache->invalidateLocalUser(localDeviceId);
+				callback(returnCode, anythingToSay);
+			});
+			cache->invalidateLocalUser(localDeviceId);
 			lastLimeUpdate = ms_time(NULL);
 		} else {
 			limeManager->set_x3dhServerUrl(localDeviceId,x3dhServerUrl);
@@ -20,6 +20,8 @@
 #ifndef _L_LIME_X3DH_ENCRYPTION_ENGINE_H_
 #define _L_LIME_X3DH_ENCRYPTION_ENGINE_H_
 
+#include <unordered_map>
+
 #include "belle-sip/belle-sip.h"
 #include "belle-sip/http-listener.h"
 #include "carddav.h"
@@ -115,6 +117,9 @@ public:
 		FileTransferContent *fileTransferContent
 	) override;
 
+	// AES-GCM processes the file stream in place.
+	bool isFileTransferProcessedInPlace () const override { return true; }
+
 	void mutualAuthentication (
 		MSZrtpContext *zrtpContext,
 		SalMediaDescription *localMediaDescription,
@@ -146,6 +151,7 @@ public:
 
 	bool isEncryptionEnabledForFileTransfer (const std::shared_ptr<AbstractChatRoom> &ChatRoom) override;
 	AbstractChatRoom::SecurityLevel getSecurityLevel (const std::string &deviceId) const override;
+	unsigned int getSecurityLevelVersion () const override;
 	EncryptionEngine::EngineType getEngineType () override;
 	std::list<EncryptionParameter> getEncryptionParameters () override;
 	void update () override;
@@ -165,7 +171,27 @@ public:
 	) override;
 
 private:
+	// Peer device status accessors backed by an in-memory cache of the LIME database.
+	lime::PeerDeviceStatus getPeerDeviceStatus (const std::string &peerDeviceId) const;
+	void setPeerDeviceStatus (const std::string &peerDeviceId, lime::PeerDeviceStatus status);
+	void setPeerDeviceStatus (const std::string &peerDeviceId, const std::vector<uint8_t> &Ik, lime::PeerDeviceStatus status);
+	void deletePeerDevice (const std::string &peerDeviceId);
+	bool isLocalUser (const std::string &deviceId) const;
+
+	// Shared with the asynchronous LIME callbacks, which may run after the engine is destroyed.
+	struct LimeCache {
+		std::unordered_map<std::string, lime::PeerDeviceStatus> peerDeviceStatuses;
+		std::unordered_map<std::string, bool> localUsers;
+		unsigned int version = 0;
+
+		void invalidatePeerDeviceStatus (const std::string &peerDeviceId);
+		void updatePeerDeviceStatus (const std::string &peerDeviceId, lime::PeerDeviceStatus reportedStatus);
+		void invalidateLocalUser (const std::string &deviceId);
+		void clear ();
+	};
+
 	std::shared_ptr<LimeManager> limeManager;
+	std::shared_ptr<LimeCache> cache;
 	std::time_t lastLimeUpdate;
 	std::string x3dhServerUrl;
 	std::string _dbAccess;
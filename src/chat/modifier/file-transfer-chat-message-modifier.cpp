@@ -18,6 +18,7 @@
  */
 
 #include "linphone/api/c-content.h"
+#include "linphone/utils/utils.h"
 
 #include "address/address.h"
 #include "bctoolbox/crypto.h"
@@ -27,7 +28,7 @@
 #include "chat/chat-room/chat-room-p.h"
 #include "content/content-type.h"
 #include "content/content.h"
-#include "core/core.h"
+#include "core/core-p.h"
 #include "logger/logger.h"
 
 #include "file-transfer-chat-message-modifier.h"
@@ -55,6 +56,9 @@ FileTransferChatMessageModifier::~FileTransferChatMessageModifier () {
 		cancelFileTransfer(); //to avoid body handler to still refference zombie FileTransferChatMessageModifier
 	else
 		releaseHttpRequest();
+	closeResumedFile();
+	if (recvBuffer)
+		linphone_buffer_unref(recvBuffer);
 }
 
 ChatMessageModifier::Result FileTransferChatMessageModifier::encode (const shared_ptr<ChatMessage> &message, int &errorCode) {
@@ -109,6 +113,10 @@ void FileTransferChatMessageModifier::fileTransferOnProgress (
 	if (!message)
 		return;
 
+	// A resumed download reports the progress of the remaining part of the file.
+	offset += downloadResumeOffset;
+	total += downloadResumeOffset;
+
 	LinphoneChatMessage *msg = L_GET_C_BACK_PTR(message);
 	LinphoneChatMessageCbs *cbs = linphone_chat_message_get_callbacks(msg);
 	LinphoneContent *content = L_GET_C_BACK_PTR((Content *)currentFileContentToTransfer);
@@ -183,16 +191,17 @@ int FileTransferChatMessageModifier::onSendBody (
 	EncryptionEngine *imee = message->getCore()->getEncryptionEngine();
 	if (imee) {
 		size_t max_size = *size;
-		uint8_t *encrypted_buffer = (uint8_t *)ms_malloc0(max_size);
+		bool inPlace = imee->isFileTransferProcessedInPlace();
+		uint8_t *encrypted_buffer = inPlace ? buffer : getChunkBuffer(max_size);
 		retval = imee->uploadingFile(L_GET_CPP_PTR_FROM_C_OBJECT(msg), offset, buffer, size, encrypted_buffer, currentFileTransferContent);
 		if (retval == 0) {
 			if (*size > max_size) {
 				lError() << "IM encryption engine process upload file callback returned a size bigger than the size of the buffer, so it will be truncated !";
 				*size = max_size;
 			}
-			memcpy(buffer, encrypted_buffer, *size);
+			if (!inPlace)
+				memcpy(buffer, encrypted_buffer, *size);
 		}
-		ms_free(encrypted_buffer);
 	}
 
 	return retval <= 0 ? BELLE_SIP_CONTINUE : BELLE_SIP_STOP;
@@ -280,18 +289,21 @@ void FileTransferChatMessageModifier::processResponseFromPostFile (const belle_h
 				EncryptionEngine *imee = message->getCore()->getEncryptionEngine();
 				if (imee) {
 					size_t max_size = buf_size;
-					uint8_t *encrypted_buffer = (uint8_t *)ms_malloc0(max_size);
+					bool inPlace = imee->isFileTransferProcessedInPlace();
+					uint8_t *encrypted_buffer = inPlace ? buf : (uint8_t *)ms_malloc0(max_size);
 					int retval = imee->uploadingFile(message, 0, buf, &max_size, encrypted_buffer, currentFileTransferContent);
 					if (retval == 0) {
 						if (max_size > buf_size) {
 							lError() << "IM encryption engine process upload file callback returned a size bigger than the size of the buffer, so it will be truncated !";
 							max_size = buf_size;
 						}
-						memcpy(buf, encrypted_buffer, buf_size);
+						if (!inPlace)
+							memcpy(buf, encrypted_buffer, buf_size);
 						// Call it once more to compute the authentication tag
 						imee->uploadingFile(message, 0, nullptr, 0, nullptr, currentFileTransferContent);
 					}
-					ms_free(encrypted_buffer);
+					if (!inPlace)
+						ms_free(encrypted_buffer);
 				}
 
 				first_part_bh = (belle_sip_body_handler_t *)belle_sip_memory_body_handler_new_from_buffer(
@@ -520,12 +532,17 @@ int FileTransferChatMessageModifier::startHttpTransfer (const string &url, const
 		goto error;
 	}
 	if (bh) belle_sip_message_set_body_handler(BELLE_SIP_MESSAGE(httpRequest), BELLE_SIP_BODY_HANDLER(bh));
+	if (action == "GET" && downloadResumeOffset > 0) {
+		const string range = "bytes=" + Utils::toString(downloadResumeOffset) + "-";
+		belle_sip_message_add_header(BELLE_SIP_MESSAGE(httpRequest), belle_sip_header_create("Range", range.c_str()));
+	}
 	// keep a reference to the http request to be able to cancel it during upload
 	belle_sip_object_ref(httpRequest);
 
 	// give msg to listener to be able to start the actual file upload when server answer a 204 No content
 	httpListener = belle_http_request_listener_create_from_callbacks(cbs, this);
-	belle_http_provider_send_request(provider, httpRequest, httpListener);
+	transferCore = message->getCore();
+	sendHttpRequest();
 	return 0;
 
 error:
@@ -536,6 +553,50 @@ error:
 	return -1;
 }
 
+/*
+ * Send the HTTP request unless the core already runs [misc] max_concurrent_file_transfers requests (0 for no limit).
+ * In that case the request is sent as soon as another one is released.
+ */
+void FileTransferChatMessageModifier::sendHttpRequest () {
+	shared_ptr<ChatMessage> message = chatMessage.lock();
+	shared_ptr<Core> core = transferCore.lock();
+	if (!message || !core || !httpRequest)
+		return;
+
+	CorePrivate *dCore = core->getPrivate();
+	int maxTransfers = linphone_config_get_int(linphone_core_get_config(core->getCCore()), "misc", "max_concurrent_file_transfers", 0);
+	if (maxTransfers > 0 && dCore->activeFileTransfers >= maxTransfers) {
+		lInfo() << "Already " << dCore->activeFileTransfers << " file transfers in progress, delaying the one of msg [" << this << "]";
+		httpRequestPending = true;
+		dCore->pendingFileTransfers.push_back(message);
+		return;
+	}
+
+	httpRequestPending = false;
+	httpRequestSent = true;
+	dCore->activeFileTransfers++;
+	belle_http_provider_send_request(provider, httpRequest, httpListener);
+}
+
+void FileTransferChatMessageModifier::sendPendingHttpRequests (const shared_ptr<Core> &core) {
+	if (!core)
+		return;
+
+	CorePrivate *dCore = core->getPrivate();
+	int maxTransfers = linphone_config_get_int(linphone_core_get_config(core->getCCore()), "misc", "max_concurrent_file_transfers", 0);
+	while (!dCore->pendingFileTransfers.empty() && (maxTransfers <= 0 || dCore->activeFileTransfers < maxTransfers)) {
+		shared_ptr<ChatMessage> message = dCore->pendingFileTransfers.front().lock();
+		dCore->pendingFileTransfers.pop_front();
+		if (!message)
+			continue;
+
+		// The transfer may have been cancelled or restarted since it has been queued.
+		FileTransferChatMessageModifier &modifier = message->getPrivate()->fileTransferChatMessageModifier;
+		if (modifier.httpRequestPending)
+			modifier.sendHttpRequest();
+	}
+}
+
 void FileTransferChatMessageModifier::fileUploadBeginBackgroundTask () {
 	shared_ptr<ChatMessage> message = chatMessage.lock();
 	if (!message)
@@ -763,23 +824,30 @@ void FileTransferChatMessageModifier::onRecvBody (belle_sip_user_body_handler_t
 	if (!message)
 		return;
 
+	// Offset in the whole file, a resumed download starts in the middle of it.
+	offset += downloadResumeOffset;
+
 	int retval = -1;
 	EncryptionEngine *imee = message->getCore()->getEncryptionEngine();
 	if (imee) {
-		uint8_t *decrypted_buffer = (uint8_t *)ms_malloc0(size);
-		retval = imee->downloadingFile(message, offset, buffer, size, decrypted_buffer, currentFileTransferContent);
-		if (retval == 0) {
-			memcpy(buffer, decrypted_buffer, size);
+		if (imee->isFileTransferProcessedInPlace()) {
+			retval = imee->downloadingFile(message, offset, buffer, size, buffer, currentFileTransferContent);
+		} else {
+			uint8_t *decrypted_buffer = getChunkBuffer(size);
+			retval = imee->downloadingFile(message, offset, buffer, size, decrypted_buffer, currentFileTransferContent);
+			if (retval == 0) {
+				memcpy(buffer, decrypted_buffer, size);
+			}
 		}
-		ms_free(decrypted_buffer);
 	}
 
 	if (retval == 0 || retval == -1) {
+		downloadedSize = offset + size;
 		if (currentFileContentToTransfer->getFilePath().empty()) {
 			LinphoneChatMessage *msg = L_GET_C_BACK_PTR(message);
 			LinphoneChatMessageCbs *cbs = linphone_chat_message_get_callbacks(msg);
 			LinphoneContent *content = L_GET_C_BACK_PTR((Content *)currentFileContentToTransfer);
-			LinphoneBuffer *lb = linphone_buffer_new_from_data(buffer, size);
+			LinphoneBuffer *lb = getRecvBuffer(buffer, size);
 			// Deprecated: use list of callbacks now
 			if (linphone_chat_message_cbs_get_file_transfer_recv(cbs)) {
 				linphone_chat_message_cbs_get_file_transfer_recv(cbs)(msg, content, lb);
@@ -788,7 +856,9 @@ void FileTransferChatMessageModifier::onRecvBody (belle_sip_user_body_handler_t
 				linphone_core_notify_file_transfer_recv(message->getCore()->getCCore(), msg, content, (const char *)buffer, size);
 			}
 			_linphone_chat_message_notify_file_transfer_recv(msg, content, lb);
-			linphone_buffer_unref(lb);
+		} else if (resumedFile && bctbx_file_write(resumedFile, buffer, size, (off_t)offset) != (ssize_t)size) {
+			lError() << "Unable to write resumed download of msg [" << this << "] to " << currentFileContentToTransfer->getFilePath();
+			message->getPrivate()->setState(ChatMessage::State::FileTransferError);
 		}
 	} else {
 		lWarning() << "File transfer decrypt failed with code -" << hex <<(int)(-retval);
@@ -807,6 +877,7 @@ void FileTransferChatMessageModifier::onRecvEnd (belle_sip_user_body_handler_t *
 		return;
 
 	shared_ptr<Core> core = message->getCore();
+	closeResumedFile();
 
 	int retval = -1;
 	EncryptionEngine *imee = message->getCore()->getEncryptionEngine();
@@ -905,6 +976,38 @@ void FileTransferChatMessageModifier::processResponseHeadersFromGetFile (const b
 		// if not done, belle-sip will create a memory body handler, the default
 		belle_sip_message_t *response = BELLE_SIP_MESSAGE(event->response);
 
+		if (downloadResumeOffset > 0) {
+			// The received bytes have already been given to the decryption engine and the application,
+			// so the download can only go on if the server sends the remaining part of the file.
+			if (code != 206 || !currentFileContentToTransfer) {
+				lWarning() << "Unable to resume download of msg [" << this << "], server answered " << code;
+				onDownloadFailed();
+				return;
+			}
+
+			const string &filePath = currentFileContentToTransfer->getFilePath();
+			if (!filePath.empty()) {
+				resumedFile = bctbx_file_open(bctbx_vfs_get_default(), filePath.c_str(), "r+");
+				if (!resumedFile) {
+					lError() << "Unable to open " << filePath << " to resume download of msg [" << this << "]";
+					onDownloadFailed();
+					return;
+				}
+			}
+
+			belle_sip_header_content_length_t *content_length_hdr = BELLE_SIP_HEADER_CONTENT_LENGTH(belle_sip_message_get_header(response, "Content-Length"));
+			size_t remainingSize = content_length_hdr ? belle_sip_header_content_length_get_content_length(content_length_hdr) : 0;
+			lInfo() << "Resuming download of msg [" << this << "] at " << downloadResumeOffset << ", " << remainingSize << " bytes remaining";
+
+			// The file body handler can't write at an offset, the resumed part is written by onRecvBody().
+			belle_sip_body_handler_t *body_handler = (belle_sip_body_handler_t *)belle_sip_buffering_user_body_handler_new(
+				remainingSize, 16, _chat_message_file_transfer_on_progress,
+				nullptr, _chat_message_on_recv_body,
+				nullptr, _chat_message_on_recv_end, this);
+			belle_sip_message_set_body_handler((belle_sip_message_t *)event->response, body_handler);
+			return;
+		}
+
 		if (currentFileContentToTransfer) {
 			belle_sip_header_content_length_t *content_length_hdr = BELLE_SIP_HEADER_CONTENT_LENGTH(belle_sip_message_get_header(response, "Content-Length"));
 			currentFileContentToTransfer->setFileSize(belle_sip_header_content_length_get_content_length(content_length_hdr));
@@ -979,7 +1082,55 @@ static void _chat_message_process_io_error_download (void *data, const belle_sip
 
 void FileTransferChatMessageModifier::processIoErrorDownload (const belle_sip_io_error_event_t *event) {
 	lError() << "I/O Error during file download msg [" << this << "]";
-	onDownloadFailed();
+	closeResumedFile();
+	if (!scheduleDownloadResumption())
+		onDownloadFailed();
+}
+
+/*
+ * Resume an interrupted download after [misc] file_transfer_resume_delay ms, with a Range request for the bytes
+ * not received yet. At most [misc] file_transfer_resume_max_attempts attempts are made for a download.
+ */
+bool FileTransferChatMessageModifier::scheduleDownloadResumption () {
+	shared_ptr<ChatMessage> message = chatMessage.lock();
+	if (!message || !currentFileTransferContent || !currentFileContentToTransfer || downloadedSize == 0)
+		return false;
+
+	LinphoneConfig *config = linphone_core_get_config(message->getCore()->getCCore());
+	int maxAttempts = linphone_config_get_int(config, "misc", "file_transfer_resume_max_attempts", 3);
+	if (downloadResumeAttempts >= maxAttempts)
+		return false;
+
+	int delay = linphone_config_get_int(config, "misc", "file_transfer_resume_delay", 1000);
+	downloadResumeAttempts++;
+	downloadResumeOffset = downloadedSize;
+	lInfo() << "Download of msg [" << this << "] interrupted after " << downloadedSize << " bytes, resuming it in "
+		<< delay << " ms (attempt " << downloadResumeAttempts << "/" << maxAttempts << ")";
+
+	releaseHttpRequest();
+	stopDownloadResumeTimer();
+	downloadResumeTimer = message->getCore()->createTimer([this]() {
+		stopDownloadResumeTimer();
+		if (startDownload() == -1)
+			onDownloadFailed();
+		return false;
+	}, (unsigned int)max(0, delay), "File transfer download resumption");
+	return true;
+}
+
+void FileTransferChatMessageModifier::stopDownloadResumeTimer () {
+	if (downloadResumeTimer) {
+		belle_sip_source_cancel(downloadResumeTimer);
+		belle_sip_object_unref(downloadResumeTimer);
+		downloadResumeTimer = nullptr;
+	}
+}
+
+void FileTransferChatMessageModifier::closeResumedFile () {
+	if (resumedFile) {
+		bctbx_file_close(resumedFile);
+		resumedFile = nullptr;
+	}
 }
 
 static void _chat_message_process_response_from_get_file (void *data, const belle_http_response_event_t *event) {
@@ -1034,12 +1185,10 @@ bool FileTransferChatMessageModifier::downloadFile (
 
 	lInfo() << "Downloading file transfer content [" << fileTransferContent << "], removing it to keep only the file content [" << fileContent << "]";
 
-	belle_http_request_listener_callbacks_t cbs = { 0 };
-	cbs.process_response_headers = _chat_process_response_headers_from_get_file;
-	cbs.process_response = _chat_message_process_response_from_get_file;
-	cbs.process_io_error = _chat_message_process_io_error_download;
-	cbs.process_auth_requested = _chat_message_process_auth_requested_download;
-	int err = startHttpTransfer(fileTransferContent->getFileUrl(), "GET", nullptr, &cbs); // File URL has been set by createFileTransferInformationsFromVndGsmaRcsFtHttpXml
+	downloadedSize = 0;
+	downloadResumeOffset = 0;
+	downloadResumeAttempts = 0;
+	int err = startDownload();
 	if (err == -1)
 		return false;
 	// start the download, status is In Progress
@@ -1047,15 +1196,33 @@ bool FileTransferChatMessageModifier::downloadFile (
 	return true;
 }
 
+int FileTransferChatMessageModifier::startDownload () {
+	belle_http_request_listener_callbacks_t cbs = { 0 };
+	cbs.process_response_headers = _chat_process_response_headers_from_get_file;
+	cbs.process_response = _chat_message_process_response_from_get_file;
+	cbs.process_io_error = _chat_message_process_io_error_download;
+	cbs.process_auth_requested = _chat_message_process_auth_requested_download;
+	// File URL has been set by createFileTransferInformationsFromVndGsmaRcsFtHttpXml
+	return startHttpTransfer(currentFileTransferContent->getFileUrl(), "GET", nullptr, &cbs);
+}
+
 // ----------------------------------------------------------
 
 void FileTransferChatMessageModifier::cancelFileTransfer () {
+	if (downloadResumeTimer) {
+		lInfo() << "Canceling resumption of download of msg [" << this << "]";
+		stopDownloadResumeTimer();
+	}
+	closeResumedFile();
+
 	if (!httpRequest) {
 		lInfo() << "No existing file transfer - nothing to cancel";
 		return;
 	}
 
-	if (!belle_http_request_is_cancelled(httpRequest)) {
+	if (httpRequestPending) {
+		lInfo() << "Canceling file transfer of msg [" << this << "] not started yet";
+	} else if (!belle_http_request_is_cancelled(httpRequest)) {
 		shared_ptr<ChatMessage> message = chatMessage.lock();
 		if (message) {
 			lInfo() << "Canceling file transfer " << (
@@ -1073,7 +1240,7 @@ void FileTransferChatMessageModifier::cancelFileTransfer () {
 }
 
 bool FileTransferChatMessageModifier::isFileTransferInProgressAndValid () const {
-	return httpRequest && !belle_http_request_is_cancelled(httpRequest);
+	return (httpRequest && !belle_http_request_is_cancelled(httpRequest)) || downloadResumeTimer;
 }
 
 void FileTransferChatMessageModifier::releaseHttpRequest () {
@@ -1085,6 +1252,41 @@ void FileTransferChatMessageModifier::releaseHttpRequest () {
 			httpListener = nullptr;
 		}
 	}
+	httpRequestPending = false;
+
+	if (httpRequestSent) {
+		httpRequestSent = false;
+		shared_ptr<Core> core = transferCore.lock();
+		if (core) {
+			CorePrivate *dCore = core->getPrivate();
+			dCore->activeFileTransfers--;
+			// Delayed so that the next step of this transfer, if any, does not have to wait for its turn.
+			if (!dCore->pendingFileTransfers.empty()) {
+				weak_ptr<Core> weakCore = core;
+				core->doLater([weakCore]() {
+					sendPendingHttpRequests(weakCore.lock());
+				});
+			}
+		}
+	}
+}
+
+uint8_t *FileTransferChatMessageModifier::getChunkBuffer (size_t size) {
+	if (chunkBuffer.size() < size)
+		chunkBuffer.resize(size);
+	return chunkBuffer.data();
+}
+
+LinphoneBuffer *FileTransferChatMessageModifier::getRecvBuffer (const uint8_t *data, size_t size) {
+	// Do not modify a buffer the application kept a reference on.
+	if (recvBuffer && BELLE_SIP_OBJECT(recvBuffer)->ref > 1) {
+		linphone_buffer_unref(recvBuffer);
+		recvBuffer = nullptr;
+	}
+	if (!recvBuffer)
+		recvBuffer = linphone_buffer_new();
+	_linphone_buffer_reuse_content(recvBuffer, data, size);
+	return recvBuffer;
 }
 
 string FileTransferChatMessageModifier::createFakeFileTransferFromUrl (const string &url) {
@@ -20,8 +20,13 @@
 #ifndef _L_FILE_TRANSFER_CHAT_MESSAGE_MODIFIER_H_
 #define _L_FILE_TRANSFER_CHAT_MESSAGE_MODIFIER_H_
 
+#include <vector>
+
+#include <bctoolbox/vfs.h>
 #include <belle-sip/belle-sip.h>
 
+#include "linphone/types.h"
+
 #include "chat-message-modifier.h"
 #include "utils/background-task.h"
 
@@ -70,12 +75,22 @@ private:
 	int uploadFile (belle_sip_body_handler_t *bh);
 	// Body handler is optional, but if set this method takes owneship of it, even in error cases.
 	int startHttpTransfer (const std::string &url, const std::string &action, belle_sip_body_handler_t *bh, belle_http_request_listener_callbacks_t *cbs);
+	void sendHttpRequest ();
+	static void sendPendingHttpRequests (const std::shared_ptr<Core> &core);
 	void fileUploadBeginBackgroundTask ();
 	void fileUploadEndBackgroundTask ();
 
 	void onDownloadFailed ();
 	void releaseHttpRequest ();
 
+	int startDownload ();
+	bool scheduleDownloadResumption ();
+	void stopDownloadResumeTimer ();
+	void closeResumedFile ();
+
+	uint8_t *getChunkBuffer (size_t size);
+	LinphoneBuffer *getRecvBuffer (const uint8_t *data, size_t size);
+
 	std::weak_ptr<ChatMessage> chatMessage;
 	FileContent* currentFileContentToTransfer = nullptr;
 	FileTransferContent *currentFileTransferContent = nullptr;
@@ -84,6 +99,22 @@ private:
 	belle_http_request_listener_t *httpListener = nullptr;
 	belle_http_provider_t *provider  = nullptr;
 
+	// Used to limit the number of concurrent HTTP requests of a core.
+	std::weak_ptr<Core> transferCore;
+	bool httpRequestSent = false;
+	bool httpRequestPending = false;
+
+	// Resumption of interrupted downloads with HTTP Range requests.
+	size_t downloadedSize = 0;
+	size_t downloadResumeOffset = 0;
+	int downloadResumeAttempts = 0;
+	belle_sip_source_t *downloadResumeTimer = nullptr;
+	bctbx_vfs_file_t *resumedFile = nullptr;
+
+	// Reused from one chunk to the next one instead of being allocated for each chunk.
+	std::vector<uint8_t> chunkBuffer;
+	LinphoneBuffer *recvBuffer = nullptr;
+
 	BackgroundTask bgTask;
 };
 
@@ -25,8 +25,7 @@
 #include "logger/logger.h"
 
 #ifdef HAVE_ADVANCED_IM
-#include "xml/imdn.h"
-#include "xml/linphone-imdn.h"
+#include "xml/notification-documents.h"
 #endif
 
 #include "imdn.h"
@@ -135,42 +134,29 @@ void Imdn::onNetworkReachable (bool sipNetworkReachable, bool mediaNetworkReacha
 
 // -----------------------------------------------------------------------------
 
-string Imdn::createXml (const string &id, time_t timestamp, Imdn::Type imdnType, LinphoneReason reason) {
+string Imdn::createXml (LinphoneCore *core, const string &id, time_t timestamp, Imdn::Type imdnType, LinphoneReason reason) {
 #ifdef HAVE_ADVANCED_IM
+	ImdnDocument imdn;
 	char *datetime = linphone_timestamp_to_rfc3339_string(timestamp);
-	Xsd::Imdn::Imdn imdn(id, datetime);
+	imdn.messageId = id;
+	imdn.datetime = datetime;
 	ms_free(datetime);
-	bool needLinphoneImdnNamespace = false;
 	if (imdnType == Imdn::Type::Delivery) {
-		Xsd::Imdn::Status status;
+		imdn.notification = ImdnDocument::Notification::Delivery;
 		if (reason == LinphoneReasonNone) {
-			auto delivered = Xsd::Imdn::Delivered();
-			status.setDelivered(delivered);
+			imdn.status = ImdnDocument::Status::Delivered;
 		} else {
-			auto failed = Xsd::Imdn::Failed();
-			status.setFailed(failed);
-			Xsd::LinphoneImdn::ImdnReason imdnReason(linphone_reason_to_string(reason));
-			imdnReason.setCode(linphone_reason_to_error_code(reason));
-			status.setReason(imdnReason);
-			needLinphoneImdnNamespace = true;
+			imdn.status = ImdnDocument::Status::Failed;
+			imdn.hasReason = true;
+			imdn.reason = linphone_reason_to_string(reason);
+			imdn.reasonCode = linphone_reason_to_error_code(reason);
 		}
-		Xsd::Imdn::DeliveryNotification deliveryNotification(status);
-		imdn.setDeliveryNotification(deliveryNotification);
 	} else if (imdnType == Imdn::Type::Display) {
-		Xsd::Imdn::Status1 status;
-		auto displayed = Xsd::Imdn::Displayed();
-		status.setDisplayed(displayed);
-		Xsd::Imdn::DisplayNotification displayNotification(status);
-		imdn.setDisplayNotification(displayNotification);
+		imdn.notification = ImdnDocument::Notification::Display;
+		imdn.status = ImdnDocument::Status::Displayed;
 	}
 
-	stringstream ss;
-	Xsd::XmlSchema::NamespaceInfomap map;
-	map[""].name = "urn:ietf:params:xml:ns:imdn";
-	if (needLinphoneImdnNamespace)
-		map["imdn"].name = "http://www.linphone.org/xsds/imdn.xsd";
-	Xsd::Imdn::serializeImdn(ss, imdn, map, "UTF-8", Xsd::XmlSchema::Flags::dont_pretty_print);
-	return ss.str();
+	return NotificationDocuments::createImdn(imdn, NotificationDocuments::getBackend(core));
 #else
 	lWarning() << "Advanced IM such as group chat is disabled!";
 	return "";
@@ -180,37 +166,28 @@ string Imdn::createXml (const string &id, time_t timestamp, Imdn::Type imdnType,
 void Imdn::parse (const shared_ptr<ChatMessage> &chatMessage) {
 #ifdef HAVE_ADVANCED_IM
 	shared_ptr<AbstractChatRoom> cr = chatMessage->getChatRoom();
+	NotificationDocuments::Backend backend = NotificationDocuments::getBackend(cr->getCore()->getCCore());
 	for (const auto &content : chatMessage->getPrivate()->getContents()) {
-		istringstream data(content->getBodyAsString());
-		unique_ptr<Xsd::Imdn::Imdn> imdn;
-		try {
-			imdn = Xsd::Imdn::parseImdn(data, Xsd::XmlSchema::Flags::dont_validate);
-		} catch (const exception &e) {
-			lError() << "IMDN parsing exception: " << e.what();
-		}
-		if (!imdn)
+		ImdnDocument imdn;
+		if (!NotificationDocuments::parseImdn(content->getBodyAsString(), imdn, backend))
 			continue;
 		
-		shared_ptr<ChatMessage> cm = cr->findChatMessage(imdn->getMessageId());
+		shared_ptr<ChatMessage> cm = cr->findChatMessage(imdn.messageId);
 		if (!cm) {
-			lWarning() << "Received IMDN for unknown message " << imdn->getMessageId();
+			lWarning() << "Received IMDN for unknown message " << imdn.messageId;
 		} else {
 			auto policy = linphone_core_get_im_notif_policy(cr->getCore()->getCCore());
 			time_t imdnTime = chatMessage->getTime();
 			const IdentityAddress &participantAddress = chatMessage->getFromAddress().getAddressWithoutGruu();
-			auto &deliveryNotification = imdn->getDeliveryNotification();
-			auto &displayNotification = imdn->getDisplayNotification();
-			if (deliveryNotification.present()) {
-				auto &status = deliveryNotification.get().getStatus();
-				if (status.getDelivered().present() && linphone_im_notif_policy_get_recv_imdn_delivered(policy))
+			if (imdn.notification == ImdnDocument::Notification::Delivery) {
+				if (imdn.status == ImdnDocument::Status::Delivered && linphone_im_notif_policy_get_recv_imdn_delivered(policy))
 					cm->getPrivate()->setParticipantState(participantAddress, ChatMessage::State::DeliveredToUser, imdnTime);
-				else if ((status.getFailed().present() || status.getError().present())
+				else if ((imdn.status == ImdnDocument::Status::Failed || imdn.status == ImdnDocument::Status::Error)
 					&& linphone_im_notif_policy_get_recv_imdn_delivered(policy)
 				)
 					cm->getPrivate()->setParticipantState(participantAddress, ChatMessage::State::NotDelivered, imdnTime);
-			} else if (displayNotification.present()) {
-				auto &status = displayNotification.get().getStatus();
-				if (status.getDisplayed().present() && linphone_im_notif_policy_get_recv_imdn_displayed(policy))
+			} else if (imdn.notification == ImdnDocument::Notification::Display) {
+				if (imdn.status == ImdnDocument::Status::Displayed && linphone_im_notif_policy_get_recv_imdn_displayed(policy))
 					cm->getPrivate()->setParticipantState(participantAddress, ChatMessage::State::Displayed, imdnTime);
 			}
 		}
@@ -222,26 +199,19 @@ void Imdn::parse (const shared_ptr<ChatMessage> &chatMessage) {
 
 bool Imdn::isError (const shared_ptr<ChatMessage> &chatMessage) {
 #ifdef HAVE_ADVANCED_IM
+	NotificationDocuments::Backend backend = NotificationDocuments::getBackend(chatMessage->getCore()->getCCore());
 	for (const auto &content : chatMessage->getPrivate()->getContents()) {
 		if (content->getContentType() != ContentType::Imdn)
 			continue;
 		
-		istringstream data(content->getBodyAsString());
-		unique_ptr<Xsd::Imdn::Imdn> imdn;
-		try {
-			imdn = Xsd::Imdn::parseImdn(data, Xsd::XmlSchema::Flags::dont_validate);
-		} catch (const exception &e) {
-			lError() << "IMDN parsing exception: " << e.what();
-		}
-		if (!imdn)
+		ImdnDocument imdn;
+		if (!NotificationDocuments::parseImdn(content->getBodyAsString(), imdn, backend))
 			continue;
 		
-		auto &deliveryNotification = imdn->getDeliveryNotification();
-		if (deliveryNotification.present()) {
-			auto &status = deliveryNotification.get().getStatus();
-			if (status.getFailed().present() || status.getError().present())
-				return true;
-		}
+		if ((imdn.notification == ImdnDocument::Notification::Delivery)
+			&& (imdn.status == ImdnDocument::Status::Failed || imdn.status == ImdnDocument::Status::Error)
+		)
+			return true;
 	}
 	return false;
 #else
@@ -69,7 +69,7 @@ public:
 	void onRegistrationStateChanged(LinphoneProxyConfig *cfg, LinphoneRegistrationState state, const std::string &message) override;
 	bool aggregationEnabled () const;
 
-	static std::string createXml (const std::string &id, time_t time, Imdn::Type imdnType, LinphoneReason reason);
+	static std::string createXml (LinphoneCore *core, const std::string &id, time_t time, Imdn::Type imdnType, LinphoneReason reason);
 	static void parse (const std::shared_ptr<ChatMessage> &chatMessage);
 	static bool isError (const std::shared_ptr<ChatMessage> &chatMessage);
 
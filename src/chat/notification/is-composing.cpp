@@ -26,7 +26,7 @@
 #include "logger/logger.h"
 
 #ifdef HAVE_ADVANCED_IM
-#include "xml/is-composing.h"
+#include "xml/notification-documents.h"
 #endif
 
 
@@ -57,15 +57,11 @@ IsComposing::~IsComposing () {
 
 string IsComposing::createXml (bool isComposing) {
 #ifdef HAVE_ADVANCED_IM
-	Xsd::IsComposing::IsComposing node(isComposing ? "active" : "idle");
+	IsComposingDocument node;
+	node.state = isComposing ? "active" : "idle";
 	if (isComposing)
-		node.setRefresh(static_cast<unsigned long long>(lp_config_get_int(core->config, "sip", "composing_refresh_timeout", defaultRefreshTimeout)));
-
-	stringstream ss;
-	Xsd::XmlSchema::NamespaceInfomap map;
-	map[""].name = "urn:ietf:params:xml:ns:im-iscomposing";
-	Xsd::IsComposing::serializeIsComposing(ss, node, map, "UTF-8", Xsd::XmlSchema::Flags::dont_pretty_print);
-	return ss.str();
+		node.refresh = static_cast<unsigned long long>(lp_config_get_int(core->config, "sip", "composing_refresh_timeout", defaultRefreshTimeout));
+	return NotificationDocuments::createIsComposing(node, NotificationDocuments::getBackend(core));
 #else
 	lWarning() << "Advanced IM such as group chat is disabled!";
 	return "";
@@ -74,18 +70,14 @@ string IsComposing::createXml (bool isComposing) {
 
 void IsComposing::parse (const Address &remoteAddr, const string &text) {
 #ifdef HAVE_ADVANCED_IM
-	istringstream data(text);
-	unique_ptr<Xsd::IsComposing::IsComposing> node(Xsd::IsComposing::parseIsComposing(data, Xsd::XmlSchema::Flags::dont_validate));
-	if (!node)
+	IsComposingDocument node;
+	if (!NotificationDocuments::parseIsComposing(text, node, NotificationDocuments::getBackend(core)))
 		return;
 
-	if (node->getState() == "active") {
-		unsigned long long refresh = 0;
-		if (node->getRefresh().present())
-			refresh = node->getRefresh().get();
-		startRemoteRefreshTimer(remoteAddr.asStringUriOnly(), refresh);
+	if (node.state == "active") {
+		startRemoteRefreshTimer(remoteAddr.asStringUriOnly(), node.refresh);
 		listener->onIsRemoteComposingStateChanged(remoteAddr, true);
-	} else if (node->getState() == "idle") {
+	} else if (node.state == "idle") {
 		stopRemoteRefreshTimer(remoteAddr.asStringUriOnly());
 		listener->onIsRemoteComposingStateChanged(remoteAddr, false);
 	}
@@ -20,6 +20,8 @@
 #ifndef _L_CONFERENCE_P_H_
 #define _L_CONFERENCE_P_H_
 
+#include <unordered_map>
+
 #include "address/identity-address.h"
 #include "conference.h"
 
@@ -34,6 +36,11 @@ class ConferencePrivate {
 public:
 	virtual ~ConferencePrivate () = default;
 
+	// Must be called after each change of participants.
+	void invalidateParticipantsIndex () {
+		participantsIndexValid = false;
+	}
+
 	IdentityAddress conferenceAddress;
 	std::list<std::shared_ptr<Participant>> participants;
 	std::string subject;
@@ -47,6 +54,10 @@ protected:
 	Conference *mPublic = nullptr;
 
 private:
+	// Index of participants by address, rebuilt by the first lookup after a change.
+	mutable std::unordered_map<IdentityAddress, std::shared_ptr<Participant>> participantsByAddress;
+	mutable bool participantsIndexValid = false;
+
 	L_DECLARE_PUBLIC(Conference);
 };
 
@@ -135,14 +135,18 @@ void Conference::setSubject (const string &subject) {
 shared_ptr<Participant> Conference::findParticipant (const IdentityAddress &addr) const {
 	L_D();
 
-	IdentityAddress searchedAddr(addr);
-	searchedAddr.setGruu("");
-	for (const auto &participant : d->participants) {
-		if (participant->getAddress() == searchedAddr)
-			return participant;
+	if (!d->participantsIndexValid) {
+		d->participantsByAddress.clear();
+		// emplace() keeps the first participant of an address, like a scan of the list would.
+		for (const auto &participant : d->participants)
+			d->participantsByAddress.emplace(participant->getAddress(), participant);
+		d->participantsIndexValid = true;
 	}
 
-	return nullptr;
+	IdentityAddress searchedAddr(addr);
+	searchedAddr.setGruu("");
+	auto it = d->participantsByAddress.find(searchedAddr);
+	return it == d->participantsByAddress.end() ? nullptr : it->second;
 }
 
 shared_ptr<Participant> Conference::findParticipant (const shared_ptr<const CallSession> &session) const {
@@ -29,7 +29,7 @@
 #include "core/core-p.h"
 #include "logger/logger.h"
 #include "remote-conference-event-handler-p.h"
-#include "xml/conference-info.h"
+#include "xml/notification-documents.h"
 
 // TODO: Remove me later.
 #include "private.h"
@@ -40,86 +40,66 @@ using namespace std;
 
 LINPHONE_BEGIN_NAMESPACE
 
-using namespace Xsd::ConferenceInfo;
-
 // -----------------------------------------------------------------------------
 
 void RemoteConferenceEventHandlerPrivate::simpleNotifyReceived (const string &xmlBody) {
-	istringstream data(xmlBody);
-	unique_ptr<ConferenceType> confInfo;
-	try {
-		confInfo = parseConferenceInfo(data, Xsd::XmlSchema::Flags::dont_validate);
-	} catch (const exception &) {
+	ConferenceInfoDocument confInfo;
+	if (!NotificationDocuments::parseConferenceInfo(xmlBody, confInfo, NotificationDocuments::getBackend(conf->getCore()->getCCore()))) {
 		lError() << "Error while parsing conference notify for: " << conferenceId;
 		return;
 	}
 
-	IdentityAddress entityAddress(confInfo->getEntity().c_str());
+	IdentityAddress entityAddress(confInfo.entity.c_str());
 	if (entityAddress != conferenceId.getPeerAddress())
 		return;
 
-	auto &confDescription = confInfo->getConferenceDescription();
-
 	// 1. Compute event time.
 	time_t creationTime = time(nullptr);
-	{
-		auto &freeText = confDescription->getFreeText();
-		if (freeText.present())
-			creationTime = static_cast<time_t>(Utils::stoll(freeText.get()));
-	}
+	if (confInfo.hasFreeText)
+		creationTime = static_cast<time_t>(Utils::stoll(confInfo.freeText));
 
 	// 2. Update last notify.
-	{
-		auto &version = confInfo->getVersion();
-		if (version.present()) {
-			unsigned int notifyVersion = version.get();
-			if (lastNotify >= notifyVersion) {
-				lWarning() << "Ignoring conference notify for: " << conferenceId << ", notify version received is: "
-					<< notifyVersion << ", should be stricly more than last notify id of chat-room: " << lastNotify;
-				return;
-			}
-			lastNotify = version.get();
+	if (confInfo.hasVersion) {
+		unsigned int notifyVersion = confInfo.version;
+		if (lastNotify >= notifyVersion) {
+			lWarning() << "Ignoring conference notify for: " << conferenceId << ", notify version received is: "
+				<< notifyVersion << ", should be stricly more than last notify id of chat-room: " << lastNotify;
+			return;
 		}
+		lastNotify = confInfo.version;
 	}
 
-	bool isFullState = confInfo->getState() == StateType::full;
+	bool isFullState = confInfo.state == ConferenceInfoDocument::State::Full;
 	ConferenceListener *confListener = static_cast<ConferenceListener *>(conf);
 
 	// 3. Notify subject and keywords.
-	if (confDescription.present()) {
-		auto &subject = confDescription.get().getSubject();
-		if (subject.present() && !subject.get().empty())
+	if (confInfo.hasDescription) {
+		if (confInfo.hasSubject && !confInfo.subject.empty())
 			confListener->onSubjectChanged(
 				make_shared<ConferenceSubjectEvent>(
 					creationTime,
 					conferenceId,
 					lastNotify,
-					subject.get()
+					confInfo.subject
 				),
 				isFullState
 			);
 
-		auto &keywords = confDescription.get().getKeywords();
-		if (keywords.present() && !keywords.get().empty()) {
-			KeywordsType xmlKeywords = keywords.get();
-			confListener->onConferenceKeywordsChanged(
-				vector<string>(xmlKeywords.begin(), xmlKeywords.end())
-			);
-		}
+		if (!confInfo.keywords.empty())
+			confListener->onConferenceKeywordsChanged(confInfo.keywords);
 	}
 
 	if (isFullState)
 		confListener->onParticipantsCleared();
 
-	auto &users = confInfo->getUsers();
-	if (!users.present()) return;
+	if (!confInfo.hasUsers) return;
 
 	// 4. Notify changes on users.
-	for (auto &user : users->getUser()) {
-		Address address(conf->getCore()->interpretUrl(user.getEntity().get()));
-		StateType state = user.getState();
+	for (const auto &user : confInfo.users) {
+		Address address(conf->getCore()->interpretUrl(user.entity));
+		ConferenceInfoDocument::State state = user.state;
 
-		if (state == StateType::deleted) {
+		if (state == ConferenceInfoDocument::State::Deleted) {
 			confListener->onParticipantRemoved(
 				make_shared<ConferenceParticipantEvent>(
 					EventLog::Type::ConferenceParticipantRemoved,
@@ -134,7 +114,7 @@ void RemoteConferenceEventHandlerPrivate::simpleNotifyReceived (const string &xm
 			continue;
 		}
 
-		if (state == StateType::full)
+		if (state == ConferenceInfoDocument::State::Full)
 			confListener->onParticipantAdded(
 				make_shared<ConferenceParticipantEvent>(
 					EventLog::Type::ConferenceParticipantAdded,
@@ -146,12 +126,10 @@ void RemoteConferenceEventHandlerPrivate::simpleNotifyReceived (const string &xm
 				isFullState
 			);
 
-		auto &roles = user.getRoles();
-		if (roles) {
-			auto &entry = roles->getEntry();
+		if (user.hasRoles) {
 			confListener->onParticipantSetAdmin(
 				make_shared<ConferenceParticipantEvent>(
-					find(entry, "admin") != entry.end()
+					find(user.roles, "admin") != user.roles.end()
 						? EventLog::Type::ConferenceParticipantSetAdmin
 						: EventLog::Type::ConferenceParticipantUnsetAdmin,
 					creationTime,
@@ -163,14 +141,14 @@ void RemoteConferenceEventHandlerPrivate::simpleNotifyReceived (const string &xm
 			);
 		}
 
-		for (const auto &endpoint : user.getEndpoint()) {
-			if (!endpoint.getEntity().present())
+		for (const auto &endpoint : user.endpoints) {
+			if (!endpoint.hasEntity)
 				continue;
 
-			Address gruu(endpoint.getEntity().get());
-			StateType state = endpoint.getState();
+			Address gruu(endpoint.entity);
+			ConferenceInfoDocument::State state = endpoint.state;
 
-			if (state == StateType::deleted) {
+			if (state == ConferenceInfoDocument::State::Deleted) {
 				confListener->onParticipantDeviceRemoved(
 					make_shared<ConferenceParticipantDeviceEvent>(
 						EventLog::Type::ConferenceParticipantDeviceRemoved,
@@ -182,8 +160,8 @@ void RemoteConferenceEventHandlerPrivate::simpleNotifyReceived (const string &xm
 					),
 					isFullState
 				);
-			} else if (state == StateType::full) {
-				const string &name = endpoint.getDisplayText().present() ? endpoint.getDisplayText().get() : "";
+			} else if (state == ConferenceInfoDocument::State::Full) {
+				const string &name = endpoint.hasDisplayText ? endpoint.displayText : "";
 				confListener->onParticipantDeviceAdded(
 					make_shared<ConferenceParticipantDeviceEvent>(
 						EventLog::Type::ConferenceParticipantDeviceAdded,
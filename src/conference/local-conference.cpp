@@ -61,6 +61,7 @@ bool LocalConference::addParticipant (const IdentityAddress &addr, const CallSes
 	participant = make_shared<Participant>(this, addr);
 	participant->getPrivate()->createSession(*this, params, hasMedia, d->listener);
 	d->participants.push_back(participant);
+	d->invalidateParticipantsIndex();
 	if (!d->activeParticipant)
 		d->activeParticipant = participant;
 	return true;
@@ -71,6 +72,7 @@ bool LocalConference::removeParticipant (const shared_ptr<Participant> &particip
 	for (const auto &p : d->participants) {
 		if (participant->getAddress() == p->getAddress()) {
 			d->participants.remove(p);
+			d->invalidateParticipantsIndex();
 			return true;
 		}
 	}
@@ -20,6 +20,8 @@
 #ifndef _L_PARTICIPANT_P_H_
 #define _L_PARTICIPANT_P_H_
 
+#include <unordered_map>
+
 #include "object/object-p.h"
 
 #include "conference/participant.h"
@@ -57,6 +59,7 @@ private:
 	bool isAdmin = false;
 	std::shared_ptr<CallSession> session;
 	std::list<std::shared_ptr<ParticipantDevice>> devices;
+	std::unordered_map<IdentityAddress, std::shared_ptr<ParticipantDevice>> devicesByGruu;
 
 	L_DECLARE_PUBLIC(Participant);
 };
@@ -53,19 +53,18 @@ shared_ptr<ParticipantDevice> ParticipantPrivate::addDevice (const IdentityAddre
 		return device;
 	device = make_shared<ParticipantDevice>(q, gruu, name);
 	devices.push_back(device);
+	devicesByGruu[gruu] = device;
 	return device;
 }
 
 void ParticipantPrivate::clearDevices () {
 	devices.clear();
+	devicesByGruu.clear();
 }
 
 shared_ptr<ParticipantDevice> ParticipantPrivate::findDevice (const IdentityAddress &gruu) const {
-	for (const auto &device : devices) {
-		if (device->getAddress() == gruu)
-			return device;
-	}
-	return nullptr;
+	auto it = devicesByGruu.find(gruu);
+	return it != devicesByGruu.end() ? it->second : nullptr;
 }
 
 shared_ptr<ParticipantDevice> ParticipantPrivate::findDevice (const shared_ptr<const CallSession> &session) {
@@ -84,6 +83,7 @@ void ParticipantPrivate::removeDevice (const IdentityAddress &gruu) {
 	for (auto it = devices.begin(); it != devices.end(); it++) {
 		if ((*it)->getAddress() == gruu) {
 			devices.erase(it);
+			devicesByGruu.erase(gruu);
 			return;
 		}
 	}
@@ -62,6 +62,7 @@ bool RemoteConference::addParticipant (const IdentityAddress &addr, const CallSe
 	participant = make_shared<Participant>(this, addr);
 	participant->getPrivate()->createSession(*this, params, hasMedia, d->listener);
 	d->participants.push_back(participant);
+	d->invalidateParticipantsIndex();
 	if (!d->activeParticipant)
 		d->activeParticipant = participant;
 	return true;
@@ -72,6 +73,7 @@ bool RemoteConference::removeParticipant (const shared_ptr<Participant> &partici
 	for (const auto &p : d->participants) {
 		if (participant->getAddress() == p->getAddress()) {
 			d->participants.remove(p);
+			d->invalidateParticipantsIndex();
 			return true;
 		}
 	}
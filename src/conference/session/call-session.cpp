@@ -1257,6 +1257,11 @@ int CallSession::getDuration () const {
 	}
 }
 
+unsigned int CallSession::getOfferAnswerTime () const {
+	L_D();
+	return d->op ? d->op->getOfferAnswerTime() : 0;
+}
+
 const LinphoneErrorInfo * CallSession::getErrorInfo () const {
 	L_D();
 	if (!d->nonOpError)
@@ -109,6 +109,7 @@ public:
 	LinphoneCallDir getDirection () const;
 	const Address &getDiversionAddress () const;
 	int getDuration () const;
+	unsigned int getOfferAnswerTime () const;
 	const LinphoneErrorInfo * getErrorInfo () const;
 	const Address &getLocalAddress () const;
 	LinphoneCallLog *getLog () const;
@@ -850,8 +850,8 @@ unsigned int MediaSessionPrivate::getTextStartCount () const {
 void MediaSessionPrivate::discoverMtu (const Address &remoteAddr) {
 	L_Q();
 	if (q->getCore()->getCCore()->net_conf.mtu == 0) {
-		/* Attempt to discover mtu */
-		int mtu = ms_discover_mtu(remoteAddr.getDomain().c_str());
+		/* Attempt to discover mtu, the discovery runs in background and applies the mtu itself when not known yet */
+		int mtu = q->getCore()->getPrivate()->getRouteCache().getMtu(af, remoteAddr.getDomain());
 		if (mtu > 0) {
 			ms_factory_set_mtu(q->getCore()->getCCore()->factory, mtu);
 			lInfo() << "Discovered mtu is " << mtu << ", RTP payload max size is " << ms_factory_get_payload_max_size(q->getCore()->getCCore()->factory);
@@ -911,9 +911,7 @@ void MediaSessionPrivate::getLocalIp (const Address &remoteAddr) {
 	}
 
 	if (mediaLocalIp.empty() || needLocalIpRefresh) {
-		char tmp[LINPHONE_IPADDR_SIZE];
-		linphone_core_get_local_ip(q->getCore()->getCCore(), af, dest.c_str(), tmp);
-		mediaLocalIp.assign(tmp);
+		mediaLocalIp = q->getCore()->getPrivate()->getRouteCache().getLocalIp(af, dest, needLocalIpRefresh);
 		needLocalIpRefresh = false;
 		lInfo() << "Media local ip to reach " << (dest.empty() ? "default route" : dest) << " is :" << mediaLocalIp;
 	}
@@ -2782,6 +2780,18 @@ LinphoneCallStats * MediaSession::getStats (LinphoneStreamType type) const {
 	return statsCopy;
 }
 
+const LinphoneCallStatsSample *MediaSession::getStatsHistorySample (LinphoneStreamType type, size_t index) const {
+	L_D();
+	Stream *s = d->getStream(type);
+	return s ? s->getStatsHistorySample(index) : nullptr;
+}
+
+size_t MediaSession::getStatsHistorySize (LinphoneStreamType type) const {
+	L_D();
+	Stream *s = d->getStream(type);
+	return s ? s->getStatsHistorySize() : 0;
+}
+
 int MediaSession::getStreamCount () const {
 	L_D();
 	return (int)d->getStreamsGroup().size();
@@ -99,6 +99,8 @@ public:
 	const MediaSessionParams *getRemoteParams ();
 	float getSpeakerVolumeGain () const;
 	LinphoneCallStats * getStats (LinphoneStreamType type) const;
+	const LinphoneCallStatsSample *getStatsHistorySample (LinphoneStreamType type, size_t index) const;
+	size_t getStatsHistorySize (LinphoneStreamType type) const;
 	int getStreamCount () const;
 	MSFormatType getStreamType (int streamIndex) const;
 	LinphoneCallStats * getTextStats () const;
@@ -213,4 +213,35 @@ const string & Stream::getPublicIp() const{
 void Stream::finish(){
 }
 
+void Stream::recordStatsSample(){
+	if (mState != Running) return;
+	LinphoneCallStats *stats = getStats();
+	if (!stats) return;
+
+	if (mStatsHistory.empty()){
+		int depth = linphone_config_get_int(linphone_core_get_config(getCCore()), "rtp", "stats_history_depth", 60);
+		if (depth <= 0) return;
+		mStatsHistory.resize((size_t)depth);
+	}
+	LinphoneCallStatsSample &sample = mStatsHistory[mStatsHistoryNext];
+	sample.time = ortp_get_cur_time_ms();
+	/* Receiver values come from the last RTCP report, they are unknown until one is received. */
+	bool rtcpReceived = !!_linphone_call_stats_has_received_rtcp(stats);
+	sample.receiver_interarrival_jitter = rtcpReceived ? linphone_call_stats_get_receiver_interarrival_jitter(stats) : 0.f;
+	sample.receiver_loss_rate = rtcpReceived ? linphone_call_stats_get_receiver_loss_rate(stats) : 0.f;
+	sample.round_trip_delay = linphone_call_stats_get_round_trip_delay(stats);
+	sample.download_bandwidth = linphone_call_stats_get_download_bandwidth(stats);
+	sample.upload_bandwidth = linphone_call_stats_get_upload_bandwidth(stats);
+	sample.jitter_buffer_size_ms = linphone_call_stats_get_jitter_buffer_size_ms(stats);
+	mStatsHistoryNext = (mStatsHistoryNext + 1) % mStatsHistory.size();
+	if (mStatsHistoryCount < mStatsHistory.size()) mStatsHistoryCount++;
+}
+
+const LinphoneCallStatsSample *Stream::getStatsHistorySample(size_t index)const{
+	if (index >= mStatsHistoryCount) return nullptr;
+	/* When the buffer is full, the oldest sample is the one that will be overwritten next. */
+	size_t oldest = (mStatsHistoryCount < mStatsHistory.size()) ? 0 : mStatsHistoryNext;
+	return &mStatsHistory[(oldest + index) % mStatsHistory.size()];
+}
+
 LINPHONE_END_NAMESPACE
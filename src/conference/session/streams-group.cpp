@@ -185,6 +185,11 @@ void StreamsGroup::render(const OfferAnswerContext &constParams, CallSession::St
 	if (!mBandwidthReportTimer){
 		mBandwidthReportTimer = getCore().createTimer([this](){ this->computeAndReportBandwidth(); return true; }, 1000 , "StreamsGroup timer");
 	}
+	if (!mStatsHistoryTimer){
+		int interval = linphone_config_get_int(linphone_core_get_config(getCCore()), "rtp", "stats_history_interval", 0);
+		if (interval > 0)
+			mStatsHistoryTimer = getCore().createTimer([this](){ this->recordStatsSamples(); return true; }, (unsigned int)interval, "StreamsGroup stats history timer");
+	}
 	
 	for(auto &hook : mPostRenderHooks){
 		hook();
@@ -218,6 +223,10 @@ void StreamsGroup::stop(){
 		getCore().destroyTimer(mBandwidthReportTimer);
 		mBandwidthReportTimer = nullptr;
 	}
+	if (mStatsHistoryTimer){
+		getCore().destroyTimer(mStatsHistoryTimer);
+		mStatsHistoryTimer = nullptr;
+	}
 	for(auto &stream : mStreams){
 		if (stream && stream->getState() != Stream::Stopped)
 			stream->stop();
@@ -451,6 +460,10 @@ void StreamsGroup::refreshSockets(){
 	forEach<Stream>(mem_fun(&Stream::refreshSockets));
 }
 
+void StreamsGroup::recordStatsSamples(){
+	forEach<Stream>(mem_fun(&Stream::recordStatsSample));
+}
+
 void StreamsGroup::computeAndReportBandwidth(){
 	forEach<Stream>(mem_fun(&Stream::updateBandwidthReports));
 	
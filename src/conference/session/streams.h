@@ -82,6 +82,17 @@ public:
 	virtual LinphoneCallStats *getStats(){
 		return nullptr;
 	}
+	/**
+	 * Appends a sample of the current statistics to the stream's stats history, a ring buffer of
+	 * [rtp] stats_history_depth samples. The oldest sample is overwritten when the buffer is full.
+	 */
+	void recordStatsSample();
+	size_t getStatsHistorySize()const{ return mStatsHistoryCount; }
+	/**
+	 * Returns the sample at the given index of the stats history, 0 being the oldest one.
+	 * The pointer remains valid until the next sample is recorded.
+	 */
+	const LinphoneCallStatsSample *getStatsHistorySample(size_t index)const;
 	/**
 	 * Called by the IceService to setup the check list to run with the stream.
 	 */
@@ -148,6 +159,9 @@ private:
 	const SalStreamType mStreamType;
 	const size_t mIndex;
 	State mState = Stopped;
+	std::vector<LinphoneCallStatsSample> mStatsHistory;
+	size_t mStatsHistoryNext = 0;
+	size_t mStatsHistoryCount = 0;
 	bool mIsMain = false;
 };
 
@@ -368,11 +382,13 @@ private:
 	std::unique_ptr<IceService> mIceService;
 	std::vector<std::unique_ptr<Stream>> mStreams;
 	void computeAndReportBandwidth();
+	void recordStatsSamples();
 	// Upload bandwidth used by audio.
 	int mAudioBandwidth = 0;
 	// Zrtp auth token
 	std::string mAuthToken;
 	belle_sip_source_t *mBandwidthReportTimer = nullptr;
+	belle_sip_source_t *mStatsHistoryTimer = nullptr;
 	std::list<std::function<void()>> mPostRenderHooks;
 	OfferAnswerContext mCurrentOfferAnswerState;
 	bool mAuthTokenVerified = false;
@@ -656,4 +656,9 @@ void Core::deleteChatRoom (const shared_ptr<const AbstractChatRoom> &chatRoom) {
 	}
 }
 
+list<shared_ptr<EventLog>> Core::searchChatMessages (const string &text, int begin, int end) const {
+	L_D();
+	return d->mainDb->searchChatMessages(text, ConferenceId(), begin, end);
+}
+
 LINPHONE_END_NAMESPACE
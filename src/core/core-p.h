@@ -28,6 +28,7 @@
 #include "object/object-p.h"
 #include "sal/call-op.h"
 #include "auth-info/auth-stack.h"
+#include "core/route-cache.h"
 #include "conference/session/tone-manager.h"
 #include "utils/background-task.h"
 
@@ -132,12 +133,22 @@ public:
 	AuthStack &getAuthStack(){
 		return authStack;
 	}
+	RouteCache &getRouteCache(){
+		return routeCache;
+	}
+	const RouteCache &getRouteCache() const{
+		return routeCache;
+	}
 	Sal * getSal();
 	LinphoneCore *getCCore();
 
 	void startEphemeralMessageTimer (time_t expireTime);
 	void stopEphemeralMessageTimer ();
 
+	// HTTP file transfers currently sent and the ones waiting for one of them to end, see [misc] max_concurrent_file_transfers.
+	int activeFileTransfers = 0;
+	std::list<std::weak_ptr<ChatMessage>> pendingFileTransfers;
+
 private:
 	bool isInBackground = false;
 	bool isFriendListSubscriptionEnabled = false;
@@ -160,6 +171,7 @@ private:
 	// Otherwise the chatRoom will be freed() before it is inserted
 	std::unordered_map<const AbstractChatRoom *, std::shared_ptr<const AbstractChatRoom>> noCreatedClientGroupChatRooms;
 	AuthStack authStack;
+	RouteCache routeCache;
 
 	std::list<std::shared_ptr<ChatMessage>> ephemeralMessages;
 	belle_sip_source_t *timer = nullptr;
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstring>
+
+#include "linphone/core.h"
+#include "linphone/factory.h"
+#include "linphone/lpconfig.h"
+#include "linphone/utils/utils.h"
+
+#include "c-wrapper/c-wrapper.h"
+#include "conference/conference-id.h"
+#include "core-shards.h"
+#include "core.h"
+#include "logger/logger.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+namespace {
+	thread_local int currentShardIndex = -1;
+}
+
+static void moveConfigPort (LinphoneConfig *config, const char *section, const char *key, int offset) {
+	const char *value = linphone_config_get_string(config, section, key, nullptr);
+	// Random (-1), disabled (0) and port ranges are kept as is.
+	if (!value || strchr(value, '-'))
+		return;
+	int port = Utils::stoi(value);
+	if (port > 0)
+		linphone_config_set_int(config, section, key, port + offset);
+}
+
+static string makeShardConfig (const char *buffer, int index, int portStride) {
+	LinphoneConfig *config = linphone_config_new_from_buffer(buffer);
+	int offset = index * portStride;
+	for (const char *key : { "sip_port", "sip_tcp_port", "sip_tls_port" })
+		moveConfigPort(config, "sip", key, offset);
+	for (const char *key : { "audio_rtp_port", "video_rtp_port", "text_rtp_port" })
+		moveConfigPort(config, "rtp", key, offset);
+
+	string backend = linphone_config_get_string(config, "storage", "backend", "sqlite3");
+	string uri = linphone_config_get_string(config, "storage", "uri", "");
+	// Without uri each core opens the default database of the data directory, see setDefaultShardDatabase().
+	if (!uri.empty() && backend == "sqlite3" && uri != "null") {
+		size_t extension = uri.find_last_of('.');
+		size_t separator = uri.find_last_of("/\\");
+		if (extension == string::npos || (separator != string::npos && extension < separator))
+			extension = uri.size();
+		uri.insert(extension, "-shard" + Utils::toString(index));
+		linphone_config_set_string(config, "storage", "uri", uri.c_str());
+	}
+
+	char *dump = linphone_config_dump(config);
+	string result(dump);
+	bctbx_free(dump);
+	linphone_config_unref(config);
+	return result;
+}
+
+// The data directory is only known once the core exists, so the default database is named before starting it.
+static void setDefaultShardDatabase (LinphoneCore *core, int index) {
+	LinphoneConfig *config = linphone_core_get_config(core);
+	const char *uri = linphone_config_get_string(config, "storage", "uri", nullptr);
+	if (uri && uri[0] != '\0')
+		return;
+	string path = L_GET_CPP_PTR_FROM_C_OBJECT(core)->getDataPath() + "linphone-shard" + Utils::toString(index) + ".db";
+	linphone_config_set_string(config, "storage", "backend", "sqlite3");
+	linphone_config_set_string(config, "storage", "uri", path.c_str());
+}
+
+// -----------------------------------------------------------------------------
+
+CoreShards::CoreShards (
+	LinphoneFactory *factory,
+	int count,
+	const string &configPath,
+	const string &factoryConfigPath,
+	void *systemContext
+) : mFactory(factory), mSystemContext(systemContext) {
+	// The configuration files are read once for all the shards.
+	LinphoneConfig *config = linphone_config_new_with_factory(
+		configPath.empty() ? nullptr : configPath.c_str(),
+		factoryConfigPath.empty() ? nullptr : factoryConfigPath.c_str()
+	);
+	mIterateInterval = linphone_config_get_int(config, "misc", "core_shards_iterate_interval_ms", mIterateInterval);
+	int portStride = linphone_config_get_int(config, "misc", "core_shards_port_stride", 10);
+	char *dump = linphone_config_dump(config);
+	linphone_config_unref(config);
+
+	if (count < 1)
+		count = 1;
+	for (int i = 0; i < count; i++) {
+		unique_ptr<Shard> shard(new Shard());
+		shard->index = i;
+		shard->config = makeShardConfig(dump, i, portStride);
+		mShards.push_back(move(shard));
+	}
+	bctbx_free(dump);
+}
+
+CoreShards::~CoreShards () {
+	stop();
+}
+
+bool CoreShards::start () {
+	if (mRunning)
+		return true;
+
+	lInfo() << "Starting " << mShards.size() << " core shards";
+	mRunning = true;
+	for (auto &shard : mShards) {
+		shard->stopping = false;
+		shard->started = false;
+		shard->thread = thread(&CoreShards::run, this, ref(*shard));
+
+		// Core creation initializes process wide state, the shards are created one after the other.
+		unique_lock<mutex> lock(shard->mutex);
+		shard->condition.wait(lock, [&shard]() { return shard->started; });
+		if (!shard->core) {
+			lError() << "Unable to create the core of shard " << shard->index;
+			lock.unlock();
+			stop();
+			return false;
+		}
+	}
+	return true;
+}
+
+void CoreShards::stop () {
+	if (!mRunning)
+		return;
+
+	for (auto &shard : mShards) {
+		{
+			lock_guard<mutex> lock(shard->mutex);
+			shard->stopping = true;
+		}
+		shard->condition.notify_all();
+	}
+	for (auto &shard : mShards) {
+		if (shard->thread.joinable())
+			shard->thread.join();
+	}
+	mRunning = false;
+	lInfo() << "Core shards stopped";
+}
+
+LinphoneCore *CoreShards::getCore (int index) const {
+	if (index < 0 || index >= getCount())
+		return nullptr;
+	Shard &shard = *mShards[size_t(index)];
+	lock_guard<mutex> lock(shard.mutex);
+	return shard.core;
+}
+
+int CoreShards::getShardIndex (const ConferenceId &conferenceId) const {
+	// FNV-1a, unlike std::hash it gives the same result on every platform and run.
+	uint64_t hash = 14695981039346656037ULL;
+	auto add = [&hash](const string &value) {
+		for (const char &c : value) {
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ULL;
+		}
+		hash ^= '\n';
+		hash *= 1099511628211ULL;
+	};
+	add(conferenceId.getPeerAddress().asString());
+	add(conferenceId.getLocalAddress().asString());
+	return static_cast<int>(hash % mShards.size());
+}
+
+int CoreShards::getCurrentShardIndex () {
+	return currentShardIndex;
+}
+
+bool CoreShards::post (int index, Task task) {
+	if (index < 0 || index >= getCount() || !task)
+		return false;
+
+	Shard &shard = *mShards[size_t(index)];
+	{
+		lock_guard<mutex> lock(shard.mutex);
+		if (!shard.core || shard.stopping)
+			return false;
+		shard.tasks.push_back(move(task));
+	}
+	shard.condition.notify_one();
+	return true;
+}
+
+bool CoreShards::post (const ConferenceId &conferenceId, Task task) {
+	return post(getShardIndex(conferenceId), move(task));
+}
+
+// -----------------------------------------------------------------------------
+
+void CoreShards::run (Shard &shard) {
+	currentShardIndex = shard.index;
+
+	LinphoneCore *core;
+	{
+		lock_guard<mutex> lifecycleLock(mLifecycleMutex);
+		LinphoneConfig *config = linphone_config_new_from_buffer(shard.config.c_str());
+		core = linphone_factory_create_core_with_config_3(mFactory, config, mSystemContext);
+		linphone_config_unref(config);
+		if (core)
+			setDefaultShardDatabase(core, shard.index);
+		if (core && linphone_core_start(core) != 0) {
+			linphone_core_unref(core);
+			core = nullptr;
+		}
+	}
+
+	{
+		lock_guard<mutex> lock(shard.mutex);
+		shard.core = core;
+		shard.started = true;
+	}
+	shard.condition.notify_all();
+	if (!core)
+		return;
+
+	lInfo() << "Core shard " << shard.index << " running";
+	const chrono::milliseconds interval(mIterateInterval);
+	for (;;) {
+		deque<Task> tasks;
+		bool stopping;
+		{
+			unique_lock<mutex> lock(shard.mutex);
+			shard.condition.wait_for(lock, interval, [&shard]() { return shard.stopping || !shard.tasks.empty(); });
+			tasks.swap(shard.tasks);
+			stopping = shard.stopping;
+		}
+
+		for (auto &task : tasks)
+			task(core);
+		if (stopping)
+			break;
+		linphone_core_iterate(core);
+	}
+
+	{
+		lock_guard<mutex> lock(shard.mutex);
+		shard.core = nullptr;
+	}
+	{
+		// The other shards may still be running while this one is destroyed.
+		lock_guard<mutex> lifecycleLock(mLifecycleMutex);
+		linphone_core_stop(core);
+		linphone_core_unref(core);
+	}
+	currentShardIndex = -1;
+}
+
+LINPHONE_END_NAMESPACE
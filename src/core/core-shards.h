@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_CORE_SHARDS_H_
+#define _L_CORE_SHARDS_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "linphone/types.h"
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+class ConferenceId;
+
+/*
+ * Runs N cores, each one created, iterated and destroyed on its own thread.
+ *
+ * A core is not thread safe: it must only be used from its shard, i.e. from the tasks posted to it.
+ * getShardIndex() gives a stable hash of a ConferenceId, so that the application can always post the work
+ * of a given conference to the same shard, with the same database, across restarts. Incoming SIP traffic
+ * is not routed: each core only receives what is sent to its own ports.
+ *
+ * The configuration is read once and each shard gets a read-only copy of it, with these changes:
+ * - the sip ports which are set are moved by index * [misc] core_shards_port_stride (10 by default),
+ * - a sqlite [storage] uri gets a "-shard<index>" suffix before its extension, without uri each shard
+ *   uses linphone-shard<index>.db in the data directory.
+ * Nothing is written back to the configuration files.
+ */
+class LINPHONE_PUBLIC CoreShards {
+public:
+	using Task = std::function<void (LinphoneCore *core)>;
+
+	CoreShards (
+		LinphoneFactory *factory,
+		int count,
+		const std::string &configPath,
+		const std::string &factoryConfigPath,
+		void *systemContext
+	);
+	CoreShards (const CoreShards &other) = delete;
+	~CoreShards ();
+
+	// Creates the cores one after the other, returns false if one of them could not be created.
+	bool start ();
+
+	// Runs the tasks already posted, then stops and destroys the cores.
+	void stop ();
+
+	bool isRunning () const {
+		return mRunning;
+	}
+
+	int getCount () const {
+		return static_cast<int>(mShards.size());
+	}
+
+	// The core of a shard, nullptr if not running. To be used only from the tasks of this shard.
+	LinphoneCore *getCore (int index) const;
+
+	int getShardIndex (const ConferenceId &conferenceId) const;
+
+	// Index of the shard running the calling thread, -1 if it is not a shard thread.
+	static int getCurrentShardIndex ();
+
+	// Thread safe. Tasks posted to a shard run in order, between two iterations of its core.
+	bool post (int index, Task task);
+	bool post (const ConferenceId &conferenceId, Task task);
+
+	void *getUserData () const {
+		return mUserData;
+	}
+
+	void setUserData (void *userData) {
+		mUserData = userData;
+	}
+
+private:
+	struct Shard {
+		int index = 0;
+		std::string config;
+		std::thread thread;
+
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<Task> tasks;
+		LinphoneCore *core = nullptr;
+		bool started = false;
+		bool stopping = false;
+	};
+
+	void run (Shard &shard);
+
+	LinphoneFactory *mFactory;
+	void *mSystemContext;
+	int mIterateInterval = 20;
+	std::vector<std::unique_ptr<Shard>> mShards;
+	// Held while a core is created or destroyed: both touch process wide state.
+	std::mutex mLifecycleMutex;
+	bool mRunning = false;
+	void *mUserData = nullptr;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_CORE_SHARDS_H_
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <mutex>
 
 #include <mediastreamer2/mscommon.h>
 
@@ -180,6 +181,7 @@ void CorePrivate::uninit () {
 #endif
 
 	AddressPrivate::clearSipAddressesCache();
+	routeCache.clear();
 	if (mainDb != nullptr) {
 		mainDb->disconnect();
 	}
@@ -194,6 +196,8 @@ void CorePrivate::notifyGlobalStateChanged (LinphoneGlobalState state) {
 }
 
 void CorePrivate::notifyNetworkReachable (bool sipNetworkReachable, bool mediaNetworkReachable) {
+	// Local ips and mtus may not be the same on the new network.
+	routeCache.invalidate();
 	auto listenersCopy = listeners; // Allow removal of a listener in its own call
 	for (const auto &listener : listenersCopy)
 		listener->onNetworkReachable(sipNetworkReachable, mediaNetworkReachable);
@@ -273,7 +277,7 @@ bool CorePrivate::basicToFlexisipChatroomMigrationEnabled()const{
 	return linphone_config_get_bool(linphone_core_get_config(q->getCCore()), "misc", "enable_basic_to_client_group_chat_room_migration", FALSE);
 }
 
-CorePrivate::CorePrivate() : authStack(*this){
+CorePrivate::CorePrivate() : authStack(*this), routeCache(*this){
 }
 
 std::shared_ptr<ToneManager> CorePrivate::getToneManager() {
@@ -314,10 +318,19 @@ void CorePrivate::stopEphemeralMessageTimer () {
 
 // =============================================================================
 
+#ifdef HAVE_ADVANCED_IM
+namespace {
+	// Xerces counts Initialize() and Terminate() calls, but does not protect its counter.
+	// Cores may be created and destroyed concurrently on several threads (see CoreShards).
+	mutex xercesMutex;
+}
+#endif
+
 Core::Core () : Object(*new CorePrivate) {
 	L_D();
 	d->imee.reset();
 #ifdef HAVE_ADVANCED_IM
+	lock_guard<mutex> lock(xercesMutex);
 	xercesc::XMLPlatformUtils::Initialize();
 #endif
 }
@@ -325,6 +338,7 @@ Core::Core () : Object(*new CorePrivate) {
 Core::~Core () {
 	lInfo() << "Destroying core: " << this;
 #ifdef HAVE_ADVANCED_IM
+	lock_guard<mutex> lock(xercesMutex);
 	xercesc::XMLPlatformUtils::Terminate();
 #endif
 }
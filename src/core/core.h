@@ -42,6 +42,7 @@ class ConferenceId;
 class CorePrivate;
 class IdentityAddress;
 class EncryptionEngine;
+class EventLog;
 
 class LINPHONE_PUBLIC Core : public Object {
 	friend class BasicToClientGroupChatRoom;
@@ -141,6 +142,9 @@ public:
 
 	static void deleteChatRoom (const std::shared_ptr<const AbstractChatRoom> &chatRoom);
 
+	// Chat message events of every chat room with a text containing all the words of text, best matches first.
+	std::list<std::shared_ptr<EventLog>> searchChatMessages (const std::string &text, int begin, int end) const;
+
 	// ---------------------------------------------------------------------------
 	// Paths.
 	// ---------------------------------------------------------------------------
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <thread>
+
+#include "core/core-p.h"
+#include "logger/logger.h"
+#include "private.h"
+#include "route-cache.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+RouteCache::RouteCache (CorePrivate &core) : mCore(core), mDiscoveries(make_shared<MtuDiscoveries>()) {}
+
+RouteCache::~RouteCache () {
+	clear();
+}
+
+string RouteCache::getLocalIp (int af, const string &dest, bool refresh) {
+	Entry &entry = mEntries[make_pair(af, dest)];
+	if (!refresh && !entry.localIp.empty()) {
+		mHits++;
+		return entry.localIp;
+	}
+
+	mMisses++;
+	char tmp[LINPHONE_IPADDR_SIZE];
+	linphone_core_get_local_ip(mCore.getCCore(), af, dest.c_str(), tmp);
+	entry.localIp = tmp;
+	return entry.localIp;
+}
+
+int RouteCache::getMtu (int af, const string &host) {
+	collectMtuDiscoveries();
+	Entry &entry = mEntries[make_pair(af, host)];
+	if (entry.mtu > 0) {
+		mHits++;
+		return entry.mtu;
+	}
+
+	mMisses++;
+	if (!entry.mtuDiscoveryStarted) {
+		entry.mtuDiscoveryStarted = true;
+		startMtuDiscovery(af, host);
+	}
+	return 0;
+}
+
+void RouteCache::invalidate () {
+	if (!mEntries.empty())
+		lInfo() << "Network reachability changed, clearing the route cache of " << mEntries.size() << " entries";
+	mEntries.clear();
+
+	// Results of discoveries still running are about the previous network.
+	lock_guard<mutex> lock(mDiscoveries->mutex);
+	mDiscoveries->results.clear();
+	mDiscoveries->generation++;
+}
+
+void RouteCache::clear () {
+	invalidate();
+	if (mTimer) {
+		mCore.getSal()->cancelTimer(mTimer);
+		belle_sip_object_unref(mTimer);
+		mTimer = nullptr;
+	}
+}
+
+void RouteCache::startMtuDiscovery (int af, const string &host) {
+	shared_ptr<MtuDiscoveries> discoveries = mDiscoveries;
+	unsigned int generation;
+	{
+		lock_guard<mutex> lock(discoveries->mutex);
+		generation = discoveries->generation;
+		discoveries->pending++;
+	}
+
+	lInfo() << "Starting mtu discovery to " << host;
+	thread([discoveries, generation, af, host]() {
+		int mtu = ms_discover_mtu(host.c_str());
+		lock_guard<mutex> lock(discoveries->mutex);
+		discoveries->pending--;
+		if (generation == discoveries->generation)
+			discoveries->results[make_pair(af, host)] = mtu;
+	}).detach();
+
+	if (!mTimer) {
+		mTimer = mCore.getSal()->createTimer([this]() {
+			if (collectMtuDiscoveries())
+				return true;
+			// Returning false removes the timer from the main loop, only our reference is left.
+			belle_sip_object_unref(mTimer);
+			mTimer = nullptr;
+			return false;
+		}, 200, "Route cache mtu discoveries");
+	}
+}
+
+// Moves the results of the finished discoveries to the cache, returns whether some are still running.
+bool RouteCache::collectMtuDiscoveries () {
+	map<pair<int, string>, int> results;
+	bool pending;
+	{
+		lock_guard<mutex> lock(mDiscoveries->mutex);
+		results.swap(mDiscoveries->results);
+		pending = (mDiscoveries->pending > 0);
+	}
+
+	LinphoneCore *lc = mCore.getCCore();
+	for (const auto &result : results) {
+		if (result.second <= 0) {
+			lWarning() << "Unable to discover mtu to " << result.first.second;
+			continue;
+		}
+		mEntries[result.first].mtu = result.second;
+		if (lc->net_conf.mtu == 0) {
+			ms_factory_set_mtu(lc->factory, result.second);
+			lInfo() << "Discovered mtu to " << result.first.second << " is " << result.second
+				<< ", RTP payload max size is " << ms_factory_get_payload_max_size(lc->factory);
+		}
+	}
+	return pending;
+}
+
+LINPHONE_END_NAMESPACE
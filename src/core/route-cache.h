@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_ROUTE_CACHE_H_
+#define _L_ROUTE_CACHE_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "linphone/utils/general.h"
+
+typedef struct belle_sip_source belle_sip_source_t;
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+class CorePrivate;
+
+/*
+ * Per destination and address family cache of what call setup needs to know about the route to a peer:
+ * the local ip to advertise in the SDP and the path MTU.
+ * The MTU is discovered in a background thread, so that the call setup never waits for the network probe.
+ * The cache is cleared when the network reachability changes.
+ */
+class RouteCache {
+public:
+	RouteCache (CorePrivate &core);
+	RouteCache (const RouteCache &other) = delete;
+	~RouteCache ();
+
+	// Local ip routing to dest (default route if empty), computed with linphone_core_get_local_ip() on a miss.
+	std::string getLocalIp (int af, const std::string &dest, bool refresh = false);
+
+	// Path MTU to host, or 0 when not known yet. On a miss a discovery is started, its result is applied
+	// to the media factory as soon as it is available.
+	int getMtu (int af, const std::string &host);
+
+	void invalidate ();
+	void clear ();
+
+	unsigned int getHitCount () const { return mHits; }
+	unsigned int getMissCount () const { return mMisses; }
+
+private:
+	struct Entry {
+		std::string localIp;
+		int mtu = 0;
+		bool mtuDiscoveryStarted = false;
+	};
+
+	// Written by the discovery threads, shared with them so that they can outlive the cache.
+	struct MtuDiscoveries {
+		std::mutex mutex;
+		std::map<std::pair<int, std::string>, int> results;
+		unsigned int generation = 0;
+		unsigned int pending = 0;
+	};
+
+	void startMtuDiscovery (int af, const std::string &host);
+	bool collectMtuDiscoveries ();
+
+	CorePrivate &mCore;
+	std::map<std::pair<int, std::string>, Entry> mEntries;
+	std::shared_ptr<MtuDiscoveries> mDiscoveries;
+	belle_sip_source_t *mTimer = nullptr;
+	unsigned int mHits = 0;
+	unsigned int mMisses = 0;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_ROUTE_CACHE_H_
@@ -196,6 +196,12 @@ private:
 	void updateModuleVersion (const std::string &name, unsigned int version);
 	void updateSchema ();
 
+	// ---------------------------------------------------------------------------
+	// Chat message search.
+	// ---------------------------------------------------------------------------
+
+	void initChatMessageSearch ();
+
 	// ---------------------------------------------------------------------------
 	// Import.
 	// ---------------------------------------------------------------------------
@@ -209,6 +215,9 @@ private:
 
 	mutable LruCache<ConferenceId, int> unreadChatMessageCountCache;
 
+	// True if the FTS5 index of the text contents is available, searches fall back to LIKE otherwise.
+	bool chatMessageSearchIndexed = false;
+
 	L_DECLARE_PUBLIC(MainDb);
 };
 
@@ -18,6 +18,7 @@
  */
 
 #include <ctime>
+#include <sstream>
 
 #include "linphone/utils/algorithm.h"
 #include "linphone/utils/static-string.h"
@@ -56,10 +57,11 @@ LINPHONE_BEGIN_NAMESPACE
 
 #ifdef HAVE_DB_STORAGE
 namespace {
-	constexpr unsigned int ModuleVersionEvents = makeVersion(1, 0, 12);
+	constexpr unsigned int ModuleVersionEvents = makeVersion(1, 0, 13);
 	constexpr unsigned int ModuleVersionFriends = makeVersion(1, 0, 0);
 	constexpr unsigned int ModuleVersionLegacyFriendsImport = makeVersion(1, 0, 0);
 	constexpr unsigned int ModuleVersionLegacyHistoryImport = makeVersion(1, 0, 0);
+	constexpr unsigned int ModuleVersionChatMessageSearch = makeVersion(1, 0, 0);
 
 	constexpr int LegacyFriendListColId = 0;
 	constexpr int LegacyFriendListColName = 1;
@@ -254,6 +256,43 @@ static string buildSqlEventFilter (
 
 	return sql;
 }
+
+// -----------------------------------------------------------------------------
+
+// Each word becomes an FTS5 string so that the user text cannot be interpreted as query syntax.
+static string buildFullTextSearchPattern (const string &text) {
+	string pattern;
+	istringstream stream(text);
+	string word;
+	while (stream >> word) {
+		if (!pattern.empty())
+			pattern += " ";
+		pattern += '"';
+		for (const char &c : word) {
+			if (c == '"')
+				pattern += '"';
+			pattern += c;
+		}
+		pattern += '"';
+	}
+	return pattern;
+}
+
+static vector<string> buildLikeSearchPatterns (const string &text) {
+	vector<string> patterns;
+	istringstream stream(text);
+	string word;
+	while (stream >> word) {
+		string pattern = "%";
+		for (const char &c : word) {
+			if (c == '!' || c == '%' || c == '_')
+				pattern += '!';
+			pattern += c;
+		}
+		patterns.push_back(pattern + "%");
+	}
+	return patterns;
+}
 #endif
 
 // -----------------------------------------------------------------------------
@@ -1486,6 +1525,80 @@ void MainDbPrivate::updateSchema () {
 		"  LEFT JOIN chat_message_ephemeral_event ON chat_message_ephemeral_event.event_id = event.id"
 		"  LEFT JOIN conference_ephemeral_message_event ON conference_ephemeral_message_event.event_id = event.id";
 	}
+
+	if (version < makeVersion(1, 0, 13))
+		*session << "CREATE INDEX server_queued_message_device_index ON server_queued_message (chat_room_id, device_sip_address_id)";
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Chat message search.
+// -----------------------------------------------------------------------------
+
+void MainDbPrivate::initChatMessageSearch () {
+#ifdef HAVE_DB_STORAGE
+	L_Q();
+
+	chatMessageSearchIndexed = false;
+	if (q->getBackend() != MainDb::Backend::Sqlite3)
+		return;
+
+	soci::session *session = dbSession.getBackendSession();
+
+	// The triggers of a previous run would make every insertion fail (or keep an index nobody reads) and the
+	// index must be rebuilt if it comes back.
+	auto dropIndexTriggers = [session] () {
+		*session << "DROP TRIGGER IF EXISTS chat_message_content_fts_inserter";
+		*session << "DROP TRIGGER IF EXISTS chat_message_content_fts_deleter";
+		*session << "DELETE FROM db_module_version WHERE name = 'chat-message-search'";
+	};
+
+	if (!linphone_config_get_bool(linphone_core_get_config(q->getCore()->getCCore()), "storage", "chat_message_search_index", TRUE)) {
+		lInfo() << "Chat message search is not indexed, disabled by [storage] chat_message_search_index.";
+		dropIndexTriggers();
+		return;
+	}
+
+	// External content table: only the index is stored, the bodies are read from chat_message_content.
+	try {
+		*session <<
+			"CREATE VIRTUAL TABLE IF NOT EXISTS chat_message_content_fts"
+			"  USING fts5(body, content='chat_message_content', content_rowid='id')";
+	} catch (const soci::soci_error &e) {
+		lWarning() << "Chat message search is not indexed, sqlite is built without fts5: " << e.what();
+		dropIndexTriggers();
+		return;
+	}
+
+	// Only the text/plain contents are indexed. Deleting a row which is not in the index would corrupt it,
+	// so the deleter uses the same condition.
+	*session <<
+		"CREATE TRIGGER IF NOT EXISTS chat_message_content_fts_inserter"
+		"  AFTER INSERT ON chat_message_content"
+		"  WHEN new.content_type_id = (SELECT id FROM content_type WHERE value = 'text/plain')"
+		"  BEGIN"
+		"    INSERT INTO chat_message_content_fts (rowid, body) VALUES (new.id, new.body);"
+		"  END";
+	*session <<
+		"CREATE TRIGGER IF NOT EXISTS chat_message_content_fts_deleter"
+		"  AFTER DELETE ON chat_message_content"
+		"  WHEN old.content_type_id = (SELECT id FROM content_type WHERE value = 'text/plain')"
+		"  BEGIN"
+		"    INSERT INTO chat_message_content_fts (chat_message_content_fts, rowid, body)"
+		"      VALUES ('delete', old.id, old.body);"
+		"  END";
+
+	if (getModuleVersion("chat-message-search") < makeVersion(1, 0, 0)) {
+		lInfo() << "Indexing the text of the chat messages for search.";
+		*session << "INSERT INTO chat_message_content_fts (chat_message_content_fts) VALUES ('delete-all')";
+		*session <<
+			"INSERT INTO chat_message_content_fts (rowid, body)"
+			"  SELECT id, body FROM chat_message_content"
+			"  WHERE content_type_id = (SELECT id FROM content_type WHERE value = 'text/plain')";
+	}
+	updateModuleVersion("chat-message-search", ModuleVersionChatMessageSearch);
+
+	chatMessageSearchIndexed = true;
 #endif
 }
 
@@ -2130,10 +2243,38 @@ void MainDb::init () {
 		"    ON DELETE CASCADE"
 		") " + charset;
 
+	*session <<
+		"CREATE TABLE IF NOT EXISTS server_queued_message ("
+		"  id" + primaryKeyStr("BIGINT UNSIGNED") + ","
+
+		"  chat_room_id" + primaryKeyRefStr("BIGINT UNSIGNED") + " NOT NULL,"
+		"  device_sip_address_id" + primaryKeyRefStr("BIGINT UNSIGNED") + " NOT NULL,"
+		"  from_sip_address_id" + primaryKeyRefStr("BIGINT UNSIGNED") + " NOT NULL,"
+		"  content_type_id" + primaryKeyRefStr("SMALLINT UNSIGNED") + " NOT NULL,"
+		"  body TEXT NOT NULL,"
+		"  headers TEXT NOT NULL,"
+		"  time" + timestampType() + " NOT NULL,"
+
+		"  FOREIGN KEY (chat_room_id)"
+		"    REFERENCES chat_room(id)"
+		"    ON DELETE CASCADE,"
+		"  FOREIGN KEY (device_sip_address_id)"
+		"    REFERENCES sip_address(id)"
+		"    ON DELETE CASCADE,"
+		"  FOREIGN KEY (from_sip_address_id)"
+		"    REFERENCES sip_address(id)"
+		"    ON DELETE CASCADE,"
+		"  FOREIGN KEY (content_type_id)"
+		"    REFERENCES content_type(id)"
+		"    ON DELETE CASCADE"
+		") " + charset;
+
 	d->updateSchema();
 
 	d->updateModuleVersion("events", ModuleVersionEvents);
 	d->updateModuleVersion("friends", ModuleVersionFriends);
+
+	d->initChatMessageSearch();
 #endif
 }
 
@@ -2892,6 +3033,139 @@ list<shared_ptr<ChatMessage>> MainDb::findChatMessagesToBeNotifiedAsDelivered ()
 #endif
 }
 
+list<shared_ptr<EventLog>> MainDb::searchChatMessages (
+	const string &text,
+	const ConferenceId &conferenceId,
+	int begin,
+	int end,
+	SearchOrder order
+) const {
+#ifdef HAVE_DB_STORAGE
+	L_D();
+
+	if (begin < 0)
+		begin = 0;
+
+	list<shared_ptr<EventLog>> events;
+	if (end > 0 && begin > end) {
+		lWarning() << "Unable to search chat messages. Invalid range.";
+		return events;
+	}
+
+	const string trimmedText = Utils::trim(text);
+	if (trimmedText.empty())
+		return events;
+
+	const bool indexed = d->chatMessageSearchIndexed;
+	const vector<string> patterns = indexed
+		? vector<string>{ buildFullTextSearchPattern(trimmedText) }
+		: buildLikeSearchPatterns(trimmedText);
+
+	string query = "SELECT conference_event_view.id AS event_id, type, creation_time, from_sip_address.value, to_sip_address.value, time, imdn_message_id, state, direction, is_secured, notify_id, device_sip_address.value, participant_sip_address.value, subject, delivery_notification_required, display_notification_required, security_alert, faulty_device, marked_as_read, forward_info, ephemeral_lifetime, expired_time, lifetime, chat_room_id"
+		" FROM conference_event_view";
+	if (indexed)
+		// The rank of an event is the one of its best content.
+		query += " JOIN ("
+			"  SELECT event_id AS match_event_id, MIN(match_rank) AS match_rank"
+			"  FROM ("
+			"    SELECT rowid AS match_content_id, rank AS match_rank FROM chat_message_content_fts"
+			"    WHERE chat_message_content_fts MATCH :pattern"
+			"  )"
+			"  JOIN chat_message_content ON chat_message_content.id = match_content_id"
+			"  GROUP BY event_id"
+			" ) AS matches ON matches.match_event_id = conference_event_view.id";
+	query += " LEFT JOIN sip_address AS from_sip_address ON from_sip_address.id = from_sip_address_id"
+		" LEFT JOIN sip_address AS to_sip_address ON to_sip_address.id = to_sip_address_id"
+		" LEFT JOIN sip_address AS device_sip_address ON device_sip_address.id = device_sip_address_id"
+		" LEFT JOIN sip_address AS participant_sip_address ON participant_sip_address.id = participant_sip_address_id";
+	if (!indexed) {
+		// Without index, each word is looked for in the text contents. Ranking is not possible.
+		query += " WHERE conference_event_view.id IN ("
+			"  SELECT event_id FROM chat_message_content"
+			"  WHERE content_type_id = (SELECT id FROM content_type WHERE value = 'text/plain')";
+		for (size_t i = 0; i < patterns.size(); ++i)
+			query += "  AND body LIKE :pattern" + Utils::toString(i) + " ESCAPE '!'";
+		query += ")";
+	}
+	if (conferenceId.isValid())
+		query += string(indexed ? " WHERE" : " AND") + " chat_room_id = :chatRoomId";
+
+	if (indexed && order == SearchOrder::Rank)
+		query += " ORDER BY match_rank, event_id DESC";
+	else
+		query += " ORDER BY event_id DESC";
+
+	if (end > 0)
+		query += " LIMIT " + Utils::toString(end - begin);
+	else
+		query += " LIMIT " + d->dbSession.noLimitValue();
+
+	if (begin > 0)
+		query += " OFFSET " + Utils::toString(begin);
+
+	DurationLogger durationLogger(
+		"Search chat messages: (indexed=" + Utils::toString(indexed) +
+		", begin=" + Utils::toString(begin) + ", end=" + Utils::toString(end) + ")."
+	);
+
+	return L_DB_TRANSACTION {
+		L_D();
+
+		unordered_map<long long, shared_ptr<AbstractChatRoom>> chatRooms;
+		auto addEvents = [&](soci::rowset<soci::row> &rows) {
+			for (const auto &row : rows) {
+				// chat_room_id is the last element of row
+				const long long &dbChatRoomId = d->dbSession.resolveId(row, (int)row.size()-1);
+				auto it = chatRooms.find(dbChatRoomId);
+				if (it == chatRooms.end()) {
+					ConferenceId chatRoomConferenceId = d->getConferenceIdFromCache(dbChatRoomId);
+					if (!chatRoomConferenceId.isValid())
+						chatRoomConferenceId = d->selectConferenceId(dbChatRoomId);
+					shared_ptr<AbstractChatRoom> chatRoom;
+					if (chatRoomConferenceId.isValid())
+						chatRoom = d->findChatRoom(chatRoomConferenceId);
+					it = chatRooms.emplace(dbChatRoomId, chatRoom).first;
+				}
+				if (!it->second)
+					continue;
+
+				shared_ptr<EventLog> event = d->selectGenericConferenceEvent(it->second, row);
+				if (event)
+					events.push_back(event);
+			}
+		};
+
+		// The amount of patterns depends on the searched text, they are bound one by one.
+		long long dbChatRoomId = -1;
+		if (conferenceId.isValid()) {
+			dbChatRoomId = d->selectChatRoomId(conferenceId);
+			if (dbChatRoomId < 0)
+				return events;
+		}
+		soci::details::prepare_temp_type statement = (d->dbSession.getBackendSession()->prepare << query);
+		for (const string &pattern : patterns)
+			statement, soci::use(pattern);
+		if (conferenceId.isValid())
+			statement, soci::use(dbChatRoomId);
+		soci::rowset<soci::row> rows(statement);
+		addEvents(rows);
+
+		return events;
+	};
+#else
+	return list<shared_ptr<EventLog>>();
+#endif
+}
+
+bool MainDb::isChatMessageSearchIndexed () const {
+#ifdef HAVE_DB_STORAGE
+	L_D();
+	return d->chatMessageSearchIndexed;
+#else
+	return false;
+#endif
+}
+
 list<shared_ptr<EventLog>> MainDb::getHistory (const ConferenceId &conferenceId, int nLast, FilterMask mask) const {
 #ifdef HAVE_DB_STORAGE
 	return getHistoryRange(conferenceId, 0, nLast, mask);
@@ -3540,6 +3814,225 @@ void MainDb::deleteChatRoomParticipantDevice (
 	d->deleteChatRoomParticipantDevice(participantId, participantSipAddressId);
 #endif
 }
+
+// -----------------------------------------------------------------------------
+
+#ifdef HAVE_DB_STORAGE
+// Forwarded headers are stored as "Name: value" lines.
+static string serializeServerQueuedMessageHeaders (const list<pair<string, string>> &headers) {
+	string serialized;
+	for (const auto &header : headers)
+		serialized += header.first + ": " + header.second + "\r\n";
+	return serialized;
+}
+
+static list<pair<string, string>> parseServerQueuedMessageHeaders (const string &serialized) {
+	list<pair<string, string>> headers;
+	size_t start = 0;
+	while (start < serialized.size()) {
+		size_t end = serialized.find("\r\n", start);
+		if (end == string::npos)
+			end = serialized.size();
+		size_t separator = serialized.find(": ", start);
+		if (separator != string::npos && separator < end)
+			headers.emplace_back(serialized.substr(start, separator - start), serialized.substr(separator + 2, end - separator - 2));
+		start = end + 2;
+	}
+	return headers;
+}
+#endif
+
+long long MainDb::insertServerQueuedMessage (
+	const ConferenceId &conferenceId,
+	const IdentityAddress &deviceAddress,
+	const ServerQueuedMessage &message
+) {
+#ifdef HAVE_DB_STORAGE
+	static const string query = "INSERT INTO server_queued_message ("
+		"  chat_room_id, device_sip_address_id, from_sip_address_id, content_type_id, body, headers, time"
+		") VALUES ("
+		"  :chatRoomId, :deviceSipAddressId, :fromSipAddressId, :contentTypeId, :body, :headers, :time"
+		")";
+
+	return L_DB_TRANSACTION {
+		L_D();
+
+		const long long &dbChatRoomId = d->selectChatRoomId(conferenceId);
+		if (dbChatRoomId < 0) {
+			lWarning() << "Unable to queue message of unknown chat room: " << conferenceId << ".";
+			return -1LL;
+		}
+
+		const long long &deviceSipAddressId = d->insertSipAddress(deviceAddress.asString());
+		const long long &fromSipAddressId = d->insertSipAddress(message.fromAddress.asString());
+		const long long &contentTypeId = d->insertContentType(message.contentType);
+		const string &headers = serializeServerQueuedMessageHeaders(message.headers);
+		const tm &messageTime = Utils::getTimeTAsTm(message.timestamp);
+
+		*d->dbSession.getBackendSession() << query, soci::use(dbChatRoomId), soci::use(deviceSipAddressId),
+			soci::use(fromSipAddressId), soci::use(contentTypeId), soci::use(message.body), soci::use(headers),
+			soci::use(messageTime);
+		const long long dbId = d->dbSession.getLastInsertId();
+
+		tr.commit();
+
+		return dbId;
+	};
+#else
+	return -1;
+#endif
+}
+
+list<MainDb::ServerQueuedMessage> MainDb::getServerQueuedMessages (
+	const ConferenceId &conferenceId,
+	const IdentityAddress &deviceAddress,
+	int limit
+) const {
+#ifdef HAVE_DB_STORAGE
+	static const string query = "SELECT server_queued_message.id, from_sip_address.value, content_type.value, body, headers, time"
+		"  FROM server_queued_message"
+		"  JOIN sip_address AS from_sip_address ON from_sip_address.id = from_sip_address_id"
+		"  JOIN content_type ON content_type.id = content_type_id"
+		"  WHERE chat_room_id = :chatRoomId AND device_sip_address_id = :deviceSipAddressId"
+		"  ORDER BY server_queued_message.id ASC"
+		"  LIMIT :limit";
+
+	return L_DB_TRANSACTION {
+		L_D();
+
+		list<ServerQueuedMessage> messages;
+		const long long &dbChatRoomId = d->selectChatRoomId(conferenceId);
+		const long long &deviceSipAddressId = d->selectSipAddressId(deviceAddress.asString());
+		if (dbChatRoomId < 0 || deviceSipAddressId < 0)
+			return messages;
+
+		soci::rowset<soci::row> rows = (d->dbSession.getBackendSession()->prepare << query,
+			soci::use(dbChatRoomId), soci::use(deviceSipAddressId), soci::use(limit));
+		for (const auto &row : rows) {
+			ServerQueuedMessage message;
+			message.dbId = d->dbSession.resolveId(row, 0);
+			message.fromAddress = IdentityAddress(row.get<string>(1));
+			message.contentType = row.get<string>(2);
+			message.body = row.get<string>(3);
+			message.headers = parseServerQueuedMessageHeaders(row.get<string>(4));
+			message.timestamp = d->dbSession.getTime(row, 5);
+			messages.push_back(move(message));
+		}
+
+		return messages;
+	};
+#else
+	return list<ServerQueuedMessage>();
+#endif
+}
+
+list<IdentityAddress> MainDb::getServerQueuedMessageDevices (const ConferenceId &conferenceId) const {
+#ifdef HAVE_DB_STORAGE
+	static const string query = "SELECT DISTINCT sip_address.value"
+		"  FROM server_queued_message"
+		"  JOIN sip_address ON sip_address.id = device_sip_address_id"
+		"  WHERE chat_room_id = :chatRoomId";
+
+	return L_DB_TRANSACTION {
+		L_D();
+
+		list<IdentityAddress> devices;
+		const long long &dbChatRoomId = d->selectChatRoomId(conferenceId);
+		if (dbChatRoomId < 0)
+			return devices;
+
+		soci::rowset<soci::row> rows = (d->dbSession.getBackendSession()->prepare << query, soci::use(dbChatRoomId));
+		for (const auto &row : rows)
+			devices.push_back(IdentityAddress(row.get<string>(0)));
+
+		return devices;
+	};
+#else
+	return list<IdentityAddress>();
+#endif
+}
+
+int MainDb::getServerQueuedMessageCount (const ConferenceId &conferenceId, const IdentityAddress &deviceAddress) const {
+#ifdef HAVE_DB_STORAGE
+	return L_DB_TRANSACTION {
+		L_D();
+
+		int count = 0;
+
+		const long long &dbChatRoomId = d->selectChatRoomId(conferenceId);
+		if (dbChatRoomId < 0)
+			return count;
+
+		soci::session *session = d->dbSession.getBackendSession();
+
+		string query = "SELECT COUNT(*) FROM server_queued_message WHERE chat_room_id = :chatRoomId";
+		if (!deviceAddress.isValid())
+			*session << query, soci::use(dbChatRoomId), soci::into(count);
+		else {
+			const long long &deviceSipAddressId = d->selectSipAddressId(deviceAddress.asString());
+			if (deviceSipAddressId < 0)
+				return count;
+
+			query += " AND device_sip_address_id = :deviceSipAddressId";
+			*session << query, soci::use(dbChatRoomId), soci::use(deviceSipAddressId), soci::into(count);
+		}
+
+		return count;
+	};
+#else
+	return 0;
+#endif
+}
+
+void MainDb::deleteServerQueuedMessages (
+	const ConferenceId &conferenceId,
+	const IdentityAddress &deviceAddress,
+	long long lastDbId
+) {
+#ifdef HAVE_DB_STORAGE
+	L_DB_TRANSACTION {
+		L_D();
+
+		const long long &dbChatRoomId = d->selectChatRoomId(conferenceId);
+		const long long &deviceSipAddressId = d->selectSipAddressId(deviceAddress.asString());
+		if (dbChatRoomId < 0 || deviceSipAddressId < 0)
+			return;
+
+		soci::session *session = d->dbSession.getBackendSession();
+
+		string query = "DELETE FROM server_queued_message"
+			"  WHERE chat_room_id = :chatRoomId AND device_sip_address_id = :deviceSipAddressId";
+		if (lastDbId < 0)
+			*session << query, soci::use(dbChatRoomId), soci::use(deviceSipAddressId);
+		else {
+			query += " AND id <= :lastDbId";
+			*session << query, soci::use(dbChatRoomId), soci::use(deviceSipAddressId), soci::use(lastDbId);
+		}
+
+		tr.commit();
+	};
+#endif
+}
+
+void MainDb::deleteExpiredServerQueuedMessages (const ConferenceId &conferenceId, time_t expiredTime) {
+#ifdef HAVE_DB_STORAGE
+	static const string query = "DELETE FROM server_queued_message"
+		"  WHERE chat_room_id = :chatRoomId AND time < :expiredTime";
+
+	L_DB_TRANSACTION {
+		L_D();
+
+		const long long &dbChatRoomId = d->selectChatRoomId(conferenceId);
+		if (dbChatRoomId < 0)
+			return;
+
+		const tm &expiredTm = Utils::getTimeTAsTm(expiredTime);
+		*d->dbSession.getBackendSession() << query, soci::use(dbChatRoomId), soci::use(expiredTm);
+
+		tr.commit();
+	};
+#endif
+}
 	
 // -----------------------------------------------------------------------------
 
@@ -60,6 +60,11 @@ public:
 
 	typedef EnumMask<Filter> FilterMask;
 
+	enum class SearchOrder {
+		Rank,
+		Time
+	};
+
 	struct ParticipantState {
 		ParticipantState (const IdentityAddress &address, ChatMessage::State state, time_t timestamp)
 			: address(address), state(state), timestamp(timestamp) {}
@@ -69,6 +74,16 @@ public:
 		time_t timestamp = 0;
 	};
 
+	// Message waiting in a server group chat room for a device to come back online.
+	struct ServerQueuedMessage {
+		long long dbId = -1;
+		IdentityAddress fromAddress;
+		std::string contentType;
+		std::string body;
+		std::list<std::pair<std::string, std::string>> headers;
+		time_t timestamp = 0;
+	};
+
 	MainDb (const std::shared_ptr<Core> &core);
 
 	// ---------------------------------------------------------------------------
@@ -134,6 +149,17 @@ public:
 
 	std::list<std::shared_ptr<ChatMessage>> findChatMessagesToBeNotifiedAsDelivered () const;
 
+	// Chat message events with a text content containing all the words of text, in any order, in every chat room
+	// if conferenceId is not valid. Results are paginated like getHistoryRange, best matches or most recent first.
+	std::list<std::shared_ptr<EventLog>> searchChatMessages (
+		const std::string &text,
+		const ConferenceId &conferenceId = ConferenceId(),
+		int begin = 0,
+		int end = -1,
+		SearchOrder order = SearchOrder::Rank
+	) const;
+	bool isChatMessageSearchIndexed () const;
+
 	// ---------------------------------------------------------------------------
 	// Conference events.
 	// ---------------------------------------------------------------------------
@@ -203,6 +229,42 @@ public:
 		const std::shared_ptr<ParticipantDevice> &device
 	);
 
+	// ---------------------------------------------------------------------------
+	// Server group chat room queued messages.
+	// ---------------------------------------------------------------------------
+
+	// Returns the id of the stored message, not positive on failure.
+	long long insertServerQueuedMessage (
+		const ConferenceId &conferenceId,
+		const IdentityAddress &deviceAddress,
+		const ServerQueuedMessage &message
+	);
+
+	// Oldest messages first.
+	std::list<ServerQueuedMessage> getServerQueuedMessages (
+		const ConferenceId &conferenceId,
+		const IdentityAddress &deviceAddress,
+		int limit
+	) const;
+
+	// Devices that have at least one queued message.
+	std::list<IdentityAddress> getServerQueuedMessageDevices (const ConferenceId &conferenceId) const;
+
+	// Count the messages of the whole chat room if deviceAddress is not valid.
+	int getServerQueuedMessageCount (
+		const ConferenceId &conferenceId,
+		const IdentityAddress &deviceAddress = IdentityAddress()
+	) const;
+
+	// Delete all the messages of a device, or only the ones up to lastDbId (included) if it is positive.
+	void deleteServerQueuedMessages (
+		const ConferenceId &conferenceId,
+		const IdentityAddress &deviceAddress,
+		long long lastDbId = -1
+	);
+
+	void deleteExpiredServerQueuedMessages (const ConferenceId &conferenceId, time_t expiredTime);
+
 	// ---------------------------------------------------------------------------
 	// Other.
 	// ---------------------------------------------------------------------------
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstring>
+
+#include <bctoolbox/logging.h>
+
+#include "async-log-sink.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+namespace {
+	size_t roundUpToPowerOfTwo (size_t value) {
+		size_t result = 2;
+		while (result < value)
+			result <<= 1;
+		return result;
+	}
+}
+
+// -----------------------------------------------------------------------------
+
+AsyncLogSink::AsyncLogSink (size_t capacity) :
+	mSlots(roundUpToPowerOfTwo(capacity)),
+	mMask(mSlots.size() - 1),
+	mEnqueuePos(0),
+	mRunning(false),
+	mSleeping(false),
+	mFallbackCount(0) {
+	for (size_t i = 0; i < mSlots.size(); ++i)
+		mSlots[i].sequence.store(i, memory_order_relaxed);
+}
+
+AsyncLogSink::~AsyncLogSink () {
+	stop();
+}
+
+// -----------------------------------------------------------------------------
+
+void AsyncLogSink::start () {
+	if (mRunning.exchange(true))
+		return;
+	mThread = thread(&AsyncLogSink::run, this);
+}
+
+void AsyncLogSink::stop () {
+	if (!mRunning.exchange(false))
+		return;
+	mWakeUp.notify_one();
+	mThread.join();
+	flush();
+}
+
+// -----------------------------------------------------------------------------
+
+bool AsyncLogSink::push (Logger::Level level, const char *message, size_t length) {
+	if (length >= SlotSize) {
+		mFallbackCount.fetch_add(1, memory_order_relaxed);
+		return false;
+	}
+
+	Slot *slot;
+	size_t pos = mEnqueuePos.load(memory_order_relaxed);
+	for (;;) {
+		slot = &mSlots[pos & mMask];
+		size_t sequence = slot->sequence.load(memory_order_acquire);
+		intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+		if (diff == 0) {
+			if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			// Queue is full.
+			mFallbackCount.fetch_add(1, memory_order_relaxed);
+			return false;
+		} else
+			pos = mEnqueuePos.load(memory_order_relaxed);
+	}
+
+	slot->level = level;
+	slot->length = length;
+	memcpy(slot->data, message, length);
+	slot->data[length] = '\0';
+	slot->sequence.store(pos + 1, memory_order_release);
+
+	if (!mRunning.load(memory_order_acquire))
+		// Stopped while pushing: nobody else will write this line.
+		flush();
+	else if (mSleeping.load(memory_order_relaxed))
+		mWakeUp.notify_one();
+	return true;
+}
+
+void AsyncLogSink::flush () {
+	lock_guard<mutex> lock(mConsumerMutex);
+	while (pop());
+}
+
+void AsyncLogSink::write (Logger::Level level, const char *message) {
+	switch (level) {
+		case Logger::Debug:
+			#if DEBUG_LOGS
+				bctbx_debug("%s", message);
+			#endif // if DEBUG_LOGS
+			break;
+		case Logger::Info:
+			bctbx_message("%s", message);
+			break;
+		case Logger::Warning:
+			bctbx_warning("%s", message);
+			break;
+		case Logger::Error:
+			bctbx_error("%s", message);
+			break;
+		case Logger::Fatal:
+			bctbx_fatal("%s", message);
+			break;
+	}
+}
+
+// -----------------------------------------------------------------------------
+
+// Must be called with mConsumerMutex held: only one consumer at a time.
+bool AsyncLogSink::pop () {
+	Slot &slot = mSlots[mDequeuePos & mMask];
+	size_t sequence = slot.sequence.load(memory_order_acquire);
+	if (intptr_t(sequence) - intptr_t(mDequeuePos + 1) < 0)
+		return false;
+
+	write(slot.level, slot.data);
+	slot.sequence.store(mDequeuePos + mMask + 1, memory_order_release);
+	++mDequeuePos;
+	return true;
+}
+
+void AsyncLogSink::run () {
+	unique_lock<mutex> lock(mConsumerMutex);
+	while (mRunning.load(memory_order_acquire)) {
+		if (pop())
+			continue;
+
+		// Producers do not take the lock to notify, so a wake-up can be missed:
+		// the timeout bounds the latency in this case.
+		mSleeping.store(true, memory_order_relaxed);
+		mWakeUp.wait_for(lock, chrono::milliseconds(10));
+		mSleeping.store(false, memory_order_relaxed);
+	}
+}
+
+LINPHONE_END_NAMESPACE
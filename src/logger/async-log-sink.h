@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_ASYNC_LOG_SINK_H_
+#define _L_ASYNC_LOG_SINK_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "logger.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+// Bounded multi-producer/single-consumer queue of log lines. Producers never lock,
+// the consumer is a background thread writing lines to bctoolbox.
+class AsyncLogSink {
+public:
+	static constexpr size_t SlotSize = 1024;
+
+	explicit AsyncLogSink (size_t capacity = 4096);
+	~AsyncLogSink ();
+
+	// Starts or stops the background thread. Stopping writes the remaining queued lines.
+	void start ();
+	void stop ();
+	bool isRunning () const { return mRunning.load(std::memory_order_relaxed); }
+
+	// Returns false if the line cannot be queued (queue full or line too long).
+	// The caller must then write it synchronously.
+	bool push (Logger::Level level, const char *message, size_t length);
+
+	// Writes all queued lines from the calling thread. Used before fatal logs and on stop.
+	void flush ();
+
+	unsigned long getFallbackCount () const { return mFallbackCount.load(std::memory_order_relaxed); }
+
+	static void write (Logger::Level level, const char *message);
+
+private:
+	struct Slot {
+		std::atomic<size_t> sequence;
+		Logger::Level level;
+		size_t length;
+		char data[SlotSize];
+	};
+
+	bool pop ();
+	void run ();
+
+	std::vector<Slot> mSlots;
+	const size_t mMask;
+
+	std::atomic<size_t> mEnqueuePos;
+	size_t mDequeuePos = 0;
+
+	std::atomic<bool> mRunning;
+	std::atomic<bool> mSleeping;
+	std::atomic<unsigned long> mFallbackCount;
+
+	std::mutex mConsumerMutex;
+	std::condition_variable mWakeUp;
+	std::thread mThread;
+
+	L_DISABLE_COPY(AsyncLogSink);
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_ASYNC_LOG_SINK_H_
@@ -18,11 +18,14 @@
  */
 
 #include <chrono>
+#include <cstring>
+#include <mutex>
 
 #include <bctoolbox/logging.h>
 
 #include "object/base-object-p.h"
 
+#include "async-log-sink.h"
 #include "logger.h"
 
 // =============================================================================
@@ -31,50 +34,121 @@ using namespace std;
 
 LINPHONE_BEGIN_NAMESPACE
 
-// -----------------------------------------------------------------------------
+namespace {
+	// Created on first use and kept until exit so that producers never have to lock to access it.
+	AsyncLogSink &getAsyncSink () {
+		static AsyncLogSink sink;
+		return sink;
+	}
 
-class LoggerPrivate : public BaseObjectPrivate {
-public:
-	Logger::Level level;
-	ostringstream os;
-};
+	mutex AsyncSinkMutex;
+	atomic<bool> AsyncSinkEnabled(false);
+
+	BctbxLogLevel toBctbxLogLevel (Logger::Level level) {
+		switch (level) {
+			case Logger::Debug:
+				return BCTBX_LOG_DEBUG;
+			case Logger::Info:
+				return BCTBX_LOG_MESSAGE;
+			case Logger::Warning:
+				return BCTBX_LOG_WARNING;
+			case Logger::Error:
+				return BCTBX_LOG_ERROR;
+			case Logger::Fatal:
+				break;
+		}
+		return BCTBX_LOG_FATAL;
+	}
+}
 
 // -----------------------------------------------------------------------------
 
-Logger::Logger (Level level) : BaseObject(*new LoggerPrivate) {
-	L_D();
-	d->level = level;
+Logger::Buffer::Buffer () {
+	// Keep one byte for the final null character.
+	setp(mInline, mInline + InlineSize - 1);
 }
 
+const char *Logger::Buffer::getData (size_t &length) {
+	*pptr() = '\0';
+	if (mOverflow.empty()) {
+		length = size_t(pptr() - pbase());
+		return mInline;
+	}
+
+	mOverflow.append(pbase(), size_t(pptr() - pbase()));
+	setp(mInline, mInline + InlineSize - 1);
+	length = mOverflow.length();
+	return mOverflow.c_str();
+}
+
+Logger::Buffer::int_type Logger::Buffer::overflow (int_type c) {
+	mOverflow.append(pbase(), size_t(pptr() - pbase()));
+	setp(mInline, mInline + InlineSize - 1);
+	if (!traits_type::eq_int_type(c, traits_type::eof()))
+		mOverflow.push_back(traits_type::to_char_type(c));
+	return traits_type::not_eof(c);
+}
+
+streamsize Logger::Buffer::xsputn (const char *s, streamsize n) {
+	const size_t count = size_t(n);
+	if (count <= size_t(epptr() - pptr())) {
+		memcpy(pptr(), s, count);
+		pbump(int(n));
+		return n;
+	}
+
+	mOverflow.append(pbase(), size_t(pptr() - pbase()));
+	mOverflow.append(s, count);
+	setp(mInline, mInline + InlineSize - 1);
+	return n;
+}
+
+// -----------------------------------------------------------------------------
+
+Logger::Logger (Level level) : mLevel(level), mOutput(&mBuffer) {}
+
 Logger::~Logger () {
-	L_D();
+	size_t length;
+	const char *str = mBuffer.getData(length);
+
+	if (AsyncSinkEnabled.load(memory_order_relaxed)) {
+		AsyncLogSink &sink = getAsyncSink();
+		if (mLevel != Fatal) {
+			if (sink.push(mLevel, str, length))
+				return;
+		} else
+			// Keep queued lines before the fatal one.
+			sink.flush();
+	}
 
-	const string str = d->os.str();
-
-	switch (d->level) {
-		case Debug:
-			#if DEBUG_LOGS
-				bctbx_debug("%s", str.c_str());
-			#endif // if DEBUG_LOGS
-			break;
-		case Info:
-			bctbx_message("%s", str.c_str());
-			break;
-		case Warning:
-			bctbx_warning("%s", str.c_str());
-			break;
-		case Error:
-			bctbx_error("%s", str.c_str());
-			break;
-		case Fatal:
-			bctbx_fatal("%s", str.c_str());
-			break;
+	AsyncLogSink::write(mLevel, str);
+}
+
+ostream &Logger::getOutput () {
+	return mOutput;
+}
+
+bool Logger::isEnabled (Level level) {
+	#if !DEBUG_LOGS
+		if (level == Debug)
+			return false;
+	#endif // if !DEBUG_LOGS
+	return level == Fatal || bctbx_log_level_enabled(BCTBX_LOG_DOMAIN, toBctbxLogLevel(level));
+}
+
+void Logger::enableAsyncSink (bool enable) {
+	lock_guard<mutex> lock(AsyncSinkMutex);
+	if (enable) {
+		getAsyncSink().start();
+		AsyncSinkEnabled.store(true, memory_order_relaxed);
+	} else if (AsyncSinkEnabled.load(memory_order_relaxed)) {
+		AsyncSinkEnabled.store(false, memory_order_relaxed);
+		getAsyncSink().stop();
 	}
 }
 
-ostringstream &Logger::getOutput () {
-	L_D();
-	return d->os;
+bool Logger::asyncSinkEnabled () {
+	return AsyncSinkEnabled.load(memory_order_relaxed);
 }
 
 // -----------------------------------------------------------------------------
@@ -21,6 +21,8 @@
 #define _L_LOGGER_H_
 
 #include <sstream>
+#include <streambuf>
+#include <string>
 
 #include "object/base-object.h"
 
@@ -28,9 +30,7 @@
 
 LINPHONE_BEGIN_NAMESPACE
 
-class LoggerPrivate;
-
-class LINPHONE_PUBLIC Logger : public BaseObject {
+class LINPHONE_PUBLIC Logger {
 public:
 	enum Level {
 		Debug,
@@ -43,13 +43,49 @@ public:
 	explicit Logger (Level level);
 	~Logger ();
 
-	std::ostringstream &getOutput ();
+	std::ostream &getOutput ();
+
+	// Must be called before building a log line. Disabled levels are never formatted.
+	static bool isEnabled (Level level);
+
+	// When enabled, log lines are pushed to a lock-free queue drained by a background thread.
+	static void enableAsyncSink (bool enable);
+	static bool asyncSinkEnabled ();
 
 private:
-	L_DECLARE_PRIVATE(Logger);
+	// Stream buffer using an inline storage. The heap is only used for lines larger than the inline buffer.
+	class Buffer : public std::streambuf {
+	public:
+		Buffer ();
+
+		const char *getData (size_t &length);
+
+	protected:
+		int_type overflow (int_type c) override;
+		std::streamsize xsputn (const char *s, std::streamsize n) override;
+
+	private:
+		static constexpr size_t InlineSize = 512;
+
+		char mInline[InlineSize];
+		std::string mOverflow;
+
+		L_DISABLE_COPY(Buffer);
+	};
+
+	Level mLevel;
+	Buffer mBuffer;
+	std::ostream mOutput;
+
 	L_DISABLE_COPY(Logger);
 };
 
+// Swallows the stream expression of a disabled log line. Used by the lXxx() macros.
+class LogVoidify {
+public:
+	void operator& (std::ostream &) {}
+};
+
 class DurationLoggerPrivate;
 
 class DurationLogger : public BaseObject {
@@ -64,11 +100,18 @@ private:
 
 LINPHONE_END_NAMESPACE
 
-#define lDebug() LinphonePrivate::Logger(LinphonePrivate::Logger::Debug).getOutput()
-#define lInfo() LinphonePrivate::Logger(LinphonePrivate::Logger::Info).getOutput()
-#define lWarning() LinphonePrivate::Logger(LinphonePrivate::Logger::Warning).getOutput()
-#define lError() LinphonePrivate::Logger(LinphonePrivate::Logger::Error).getOutput()
-#define lFatal() LinphonePrivate::Logger(LinphonePrivate::Logger::Fatal).getOutput()
+// The level is checked before evaluating the streamed arguments: `lInfo() << a << b` costs nothing
+// if the info level is disabled.
+#define L_LOG(LEVEL) \
+	!LinphonePrivate::Logger::isEnabled(LEVEL) \
+		? (void)0 \
+		: LinphonePrivate::LogVoidify() & LinphonePrivate::Logger(LEVEL).getOutput()
+
+#define lDebug() L_LOG(LinphonePrivate::Logger::Debug)
+#define lInfo() L_LOG(LinphonePrivate::Logger::Info)
+#define lWarning() L_LOG(LinphonePrivate::Logger::Warning)
+#define lError() L_LOG(LinphonePrivate::Logger::Error)
+#define lFatal() L_LOG(LinphonePrivate::Logger::Fatal)
 
 #define L_BEGIN_LOG_EXCEPTION try {
 
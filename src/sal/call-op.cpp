@@ -22,6 +22,8 @@
 #include "sal/call-op.h"
 #include "content/content-manager.h"
 
+#include <chrono>
+
 #include <bctoolbox/defs.h>
 #include <belle-sip/provider.h>
 
@@ -45,13 +47,11 @@ SalCallOp::~SalCallOp () {
 
 int SalCallOp::setLocalMediaDescription (SalMediaDescription *desc) {
 	if (desc) {
-		sal_media_description_ref(desc);
 		belle_sip_error_code error;
-		belle_sdp_session_description_t *sdp = media_description_to_sdp(desc);
-		vector<char> buffer = marshalMediaDescription(sdp, error);
-		belle_sip_object_unref(sdp);
+		vector<char> buffer = marshalMediaDescription(desc, error);
 		if (error != BELLE_SIP_OK)
 			return -1;
+		sal_media_description_ref(desc);
 
 		mLocalBody.setContentType(ContentType::Sdp);
 		mLocalBody.setBody(move(buffer));
@@ -147,6 +147,25 @@ std::vector<char> SalCallOp::marshalMediaDescription (belle_sdp_session_descript
 	return buffer;
 }
 
+// Session refreshes and answers to re-INVITEs usually send the same SDP again, it is then taken from mLocalSdp.
+vector<char> SalCallOp::marshalMediaDescription (const SalMediaDescription *desc, belle_sip_error_code &error) {
+	uint64_t hash = sal_media_description_hash(desc);
+	if (!mLocalSdp.empty() && (hash == mLocalSdpHash)) {
+		media_description_enable_rtcp_fb_payloads(desc);
+		error = BELLE_SIP_OK;
+		return mLocalSdp;
+	}
+
+	belle_sdp_session_description_t *sdp = media_description_to_sdp(desc);
+	vector<char> buffer = marshalMediaDescription(sdp, error);
+	belle_sip_object_unref(sdp);
+	if (error == BELLE_SIP_OK) {
+		mLocalSdp = buffer;
+		mLocalSdpHash = hash;
+	}
+	return buffer;
+}
+
 int SalCallOp::setSdp (belle_sip_message_t *msg, belle_sdp_session_description_t *sessionDesc) {
 	if (!sessionDesc)
 		return -1;
@@ -164,10 +183,16 @@ int SalCallOp::setSdp (belle_sip_message_t *msg, belle_sdp_session_description_t
 }
 
 int SalCallOp::setSdpFromDesc (belle_sip_message_t *msg, const SalMediaDescription *desc) {
-	auto sdp = media_description_to_sdp(desc);
-	int err = setSdp(msg, sdp);
-	belle_sip_object_unref(sdp);
-	return err;
+	belle_sip_error_code error;
+	vector<char> buffer = marshalMediaDescription(desc, error);
+	if (error != BELLE_SIP_OK)
+		return -1;
+
+	Content body;
+	body.setContentType(ContentType::Sdp);
+	body.setBody(move(buffer));
+	setCustomBody(msg, body);
+	return 0;
 }
 
 void SalCallOp::fillInvite (belle_sip_request_t *invite) {
@@ -347,12 +372,15 @@ void SalCallOp::sdpProcess () {
 		return;
 
 	mResult = sal_media_description_new();
+	auto offerAnswerStart = chrono::steady_clock::now();
 	if (mSdpOffering) {
 		offer_answer_initiate_outgoing(mRoot->mFactory, mLocalMedia, mRemoteMedia, mResult);
+		mOfferAnswerTime += (unsigned int)chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - offerAnswerStart).count();
 	} else {
 		if (mSdpAnswer)
 			belle_sip_object_unref(mSdpAnswer);
 		offer_answer_initiate_incoming(mRoot->mFactory, mLocalMedia, mRemoteMedia, mResult, mRoot->mOneMatchingCodec);
+		mOfferAnswerTime += (unsigned int)chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - offerAnswerStart).count();
 		// For backward compatibility purpose
 		if (mCnxIpTo0000IfSendOnlyEnabled && sal_media_description_has_dir(mResult,SalStreamSendOnly)) {
 			setAddrTo0000(mResult->addr, sizeof(mResult->addr));
@@ -40,6 +40,8 @@ public:
 	SalMediaDescription *getRemoteMediaDescription () { return mRemoteMedia; }
 	const Content &getRemoteBody () const { return mRemoteBody; }
 	SalMediaDescription *getFinalMediaDescription ();
+	// Total time spent in SDP offer/answer computations, in microseconds
+	unsigned int getOfferAnswerTime () const { return mOfferAnswerTime; }
 
 	int call (const std::string &from, const std::string &to, const std::string &subject);
 	int notifyRinging (bool earlyMedia);
@@ -110,10 +112,11 @@ private:
 	static belle_sip_header_reason_t *makeReasonHeader (const SalErrorInfo *info);
 	static belle_sip_header_allow_t *createAllow (bool enableUpdate);
 	static std::vector<char> marshalMediaDescription (belle_sdp_session_description_t *sessionDesc, belle_sip_error_code &error);
+	std::vector<char> marshalMediaDescription (const SalMediaDescription *desc, belle_sip_error_code &error);
 
 	// belle_sip_message handlers
 	static int setSdp (belle_sip_message_t *message, belle_sdp_session_description_t *sessionDesc);
-	static int setSdpFromDesc (belle_sip_message_t *message, const SalMediaDescription *desc);
+	int setSdpFromDesc (belle_sip_message_t *message, const SalMediaDescription *desc);
 	static void processIoErrorCb (void *userCtx, const belle_sip_io_error_event_t *event);
 	static Content extractBody (belle_sip_message_t *message);
 
@@ -134,6 +137,10 @@ private:
 	SalMediaDescription *mRemoteMedia = nullptr;
 	Content mLocalBody;
 	Content mRemoteBody;
+	// Last SDP generated from a media description, and the hash of this description
+	std::vector<char> mLocalSdp;
+	uint64_t mLocalSdpHash = 0;
+	unsigned int mOfferAnswerTime = 0;
 	std::list<Content> mAdditionalLocalBodies;
 	std::list<Content> mAdditionalRemoteBodies;
 };
@@ -34,6 +34,12 @@ public:
 	}
 	int unregister() { return refreshRegister(0); }
 
+	// Delay in ms before the refresher retries after a failure.
+	void setRetryAfter (int delay) {
+		if (mRefresher)
+			belle_sip_refresher_set_retry_after(mRefresher, delay);
+	}
+
 	void authenticate (const SalAuthInfo *info) override {
 		mRoot->removePendingAuth(this);
 		refreshRegister(-1);
@@ -0,0 +1,644 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <sstream>
+
+#include <libxml/xmlwriter.h>
+
+#include "linphone/core.h"
+#include "linphone/utils/utils.h"
+
+#include "logger/logger.h"
+#include "notification-documents.h"
+#include "xml/conference-info.h"
+#include "xml/imdn.h"
+#include "xml/is-composing.h"
+#include "xml/linphone-imdn.h"
+#include "xml/xml-pull-parser.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+namespace {
+	constexpr char ImdnNamespace[] = "urn:ietf:params:xml:ns:imdn";
+	constexpr char LinphoneImdnNamespace[] = "http://www.linphone.org/xsds/imdn.xsd";
+	constexpr char IsComposingNamespace[] = "urn:ietf:params:xml:ns:im-iscomposing";
+	constexpr char ConferenceInfoNamespace[] = "urn:ietf:params:xml:ns:conference-info";
+}
+
+// -----------------------------------------------------------------------------
+
+NotificationDocuments::Backend NotificationDocuments::getBackend (LinphoneCore *core) {
+	const char *parser = linphone_config_get_string(linphone_core_get_config(core), "misc", "xml_parser", "stream");
+	return (strcmp(parser, "xsd") == 0) ? Backend::Xsd : Backend::Stream;
+}
+
+// -----------------------------------------------------------------------------
+// Streaming backend.
+// -----------------------------------------------------------------------------
+
+static void logParsingError (const char *documentName, const XmlPullParser &parser) {
+	lError() << documentName << " parsing error: " << Utils::trim(parser.getErrorMessage());
+}
+
+static ImdnDocument::Status imdnStatusFromName (const XmlPullParser &parser) {
+	if (parser.isElement("delivered"))
+		return ImdnDocument::Status::Delivered;
+	if (parser.isElement("failed"))
+		return ImdnDocument::Status::Failed;
+	if (parser.isElement("displayed"))
+		return ImdnDocument::Status::Displayed;
+	if (parser.isElement("processed"))
+		return ImdnDocument::Status::Processed;
+	if (parser.isElement("stored"))
+		return ImdnDocument::Status::Stored;
+	if (parser.isElement("forbidden"))
+		return ImdnDocument::Status::Forbidden;
+	if (parser.isElement("error"))
+		return ImdnDocument::Status::Error;
+	return ImdnDocument::Status::None;
+}
+
+static void parseImdnStatus (XmlPullParser &parser, ImdnDocument &document) {
+	int depth = parser.getDepth();
+	while (parser.nextChild(depth)) {
+		if (parser.isElement("reason", LinphoneImdnNamespace)) {
+			string code;
+			document.hasReason = true;
+			if (parser.getAttribute("code", code))
+				document.reasonCode = Utils::stoi(code);
+			document.reason = parser.readText();
+		} else if (document.status == ImdnDocument::Status::None) {
+			document.status = imdnStatusFromName(parser);
+		}
+	}
+}
+
+static bool streamParseImdn (const string &xml, ImdnDocument &document) {
+	XmlPullParser parser(xml);
+	if (!parser.nextRoot() || !parser.isElement("imdn", ImdnNamespace)) {
+		if (parser.hasError())
+			logParsingError("IMDN", parser);
+		return false;
+	}
+
+	bool hasMessageId = false;
+	bool hasDatetime = false;
+	int depth = parser.getDepth();
+	while (parser.nextChild(depth)) {
+		ImdnDocument::Notification notification = ImdnDocument::Notification::None;
+		if (parser.isElement("message-id")) {
+			document.messageId = Utils::trim(parser.readText());
+			hasMessageId = true;
+		} else if (parser.isElement("datetime")) {
+			document.datetime = parser.readText();
+			hasDatetime = true;
+		} else if (parser.isElement("delivery-notification")) {
+			notification = ImdnDocument::Notification::Delivery;
+		} else if (parser.isElement("display-notification")) {
+			notification = ImdnDocument::Notification::Display;
+		} else if (parser.isElement("processing-notification")) {
+			notification = ImdnDocument::Notification::Processing;
+		}
+
+		if (notification == ImdnDocument::Notification::None)
+			continue;
+		document.notification = notification;
+		int notificationDepth = parser.getDepth();
+		while (parser.nextChild(notificationDepth)) {
+			if (parser.isElement("status"))
+				parseImdnStatus(parser, document);
+		}
+	}
+
+	if (parser.hasError()) {
+		logParsingError("IMDN", parser);
+		return false;
+	}
+	return hasMessageId && hasDatetime;
+}
+
+static bool streamParseIsComposing (const string &xml, IsComposingDocument &document) {
+	XmlPullParser parser(xml);
+	if (!parser.nextRoot() || !parser.isElement("isComposing", IsComposingNamespace)) {
+		if (parser.hasError())
+			logParsingError("Is-composing", parser);
+		return false;
+	}
+
+	bool hasState = false;
+	int depth = parser.getDepth();
+	while (parser.nextChild(depth)) {
+		if (parser.isElement("state")) {
+			document.state = parser.readText();
+			hasState = true;
+		} else if (parser.isElement("refresh")) {
+			document.refresh = Utils::stoull(Utils::trim(parser.readText()));
+		}
+	}
+
+	if (parser.hasError()) {
+		logParsingError("Is-composing", parser);
+		return false;
+	}
+	return hasState;
+}
+
+static bool conferenceInfoStateFromString (const string &value, ConferenceInfoDocument::State &state) {
+	string trimmed = Utils::trim(value);
+	if (trimmed == "full")
+		state = ConferenceInfoDocument::State::Full;
+	else if (trimmed == "partial")
+		state = ConferenceInfoDocument::State::Partial;
+	else if (trimmed == "deleted")
+		state = ConferenceInfoDocument::State::Deleted;
+	else
+		return false;
+	return true;
+}
+
+static bool readConferenceInfoState (const XmlPullParser &parser, ConferenceInfoDocument::State &state) {
+	string value;
+	if (!parser.getAttribute("state", value))
+		return true; // Defaults to full.
+	if (conferenceInfoStateFromString(value, state))
+		return true;
+	lError() << "Conference-info parsing error: invalid state [" << value << "]";
+	return false;
+}
+
+static void parseConferenceDescription (XmlPullParser &parser, ConferenceInfoDocument &document) {
+	document.hasDescription = true;
+	int depth = parser.getDepth();
+	while (parser.nextChild(depth)) {
+		if (parser.isElement("subject")) {
+			document.hasSubject = true;
+			document.subject = parser.readText();
+		} else if (parser.isElement("free-text")) {
+			document.hasFreeText = true;
+			document.freeText = parser.readText();
+		} else if (parser.isElement("keywords")) {
+			istringstream keywords(parser.readText());
+			string keyword;
+			while (keywords >> keyword)
+				document.keywords.push_back(keyword);
+		}
+	}
+}
+
+static bool parseConferenceUser (XmlPullParser &parser, ConferenceInfoDocument::User &user) {
+	parser.getAttribute("entity", user.entity);
+	if (!readConferenceInfoState(parser, user.state))
+		return false;
+
+	int depth = parser.getDepth();
+	while (parser.nextChild(depth)) {
+		if (parser.isElement("roles")) {
+			user.hasRoles = true;
+			int rolesDepth = parser.getDepth();
+			while (parser.nextChild(rolesDepth)) {
+				if (parser.isElement("entry"))
+					user.roles.push_back(Utils::trim(parser.readText()));
+			}
+		} else if (parser.isElement("endpoint")) {
+			ConferenceInfoDocument::Endpoint endpoint;
+			endpoint.hasEntity = parser.getAttribute("entity", endpoint.entity);
+			if (!readConferenceInfoState(parser, endpoint.state))
+				return false;
+			int endpointDepth = parser.getDepth();
+			while (parser.nextChild(endpointDepth)) {
+				if (parser.isElement("display-text")) {
+					endpoint.hasDisplayText = true;
+					endpoint.displayText = parser.readText();
+				}
+			}
+			user.endpoints.push_back(move(endpoint));
+		}
+	}
+	return true;
+}
+
+static bool streamParseConferenceInfo (const string &xml, ConferenceInfoDocument &document) {
+	XmlPullParser parser(xml);
+	if (!parser.nextRoot() || !parser.isElement("conference-info", ConferenceInfoNamespace)) {
+		if (parser.hasError())
+			logParsingError("Conference-info", parser);
+		return false;
+	}
+
+	if (!parser.getAttribute("entity", document.entity) || !readConferenceInfoState(parser, document.state))
+		return false;
+	string version;
+	if (parser.getAttribute("version", version)) {
+		document.hasVersion = true;
+		document.version = static_cast<unsigned int>(Utils::stoull(version));
+	}
+
+	int depth = parser.getDepth();
+	while (parser.nextChild(depth)) {
+		if (parser.isElement("conference-description")) {
+			parseConferenceDescription(parser, document);
+		} else if (parser.isElement("users")) {
+			document.hasUsers = true;
+			int usersDepth = parser.getDepth();
+			while (parser.nextChild(usersDepth)) {
+				if (!parser.isElement("user"))
+					continue;
+				ConferenceInfoDocument::User user;
+				if (!parseConferenceUser(parser, user))
+					return false;
+				document.users.push_back(move(user));
+			}
+		}
+	}
+
+	if (parser.hasError()) {
+		logParsingError("Conference-info", parser);
+		return false;
+	}
+	return true;
+}
+
+// Writes a document in memory, the result is empty if one of the writes failed.
+class XmlStreamWriter {
+public:
+	XmlStreamWriter () {
+		mBuffer = xmlBufferCreate();
+		mWriter = xmlNewTextWriterMemory(mBuffer, 0);
+		check(xmlTextWriterStartDocument(mWriter, "1.0", "UTF-8", nullptr));
+	}
+
+	~XmlStreamWriter () {
+		if (mWriter)
+			xmlFreeTextWriter(mWriter);
+		xmlBufferFree(mBuffer);
+	}
+
+	void startElement (const char *name, const char *namespaceUri = nullptr) {
+		check(namespaceUri
+			? xmlTextWriterStartElementNS(mWriter, nullptr, reinterpret_cast<const xmlChar *>(name), reinterpret_cast<const xmlChar *>(namespaceUri))
+			: xmlTextWriterStartElement(mWriter, reinterpret_cast<const xmlChar *>(name))
+		);
+	}
+
+	void writeNamespace (const char *prefix, const char *namespaceUri) {
+		check(xmlTextWriterWriteAttributeNS(mWriter, reinterpret_cast<const xmlChar *>("xmlns"),
+			reinterpret_cast<const xmlChar *>(prefix), nullptr, reinterpret_cast<const xmlChar *>(namespaceUri)));
+	}
+
+	void writeAttribute (const char *name, const string &value) {
+		check(xmlTextWriterWriteAttribute(mWriter, reinterpret_cast<const xmlChar *>(name), reinterpret_cast<const xmlChar *>(value.c_str())));
+	}
+
+	void writeText (const string &text) {
+		check(xmlTextWriterWriteString(mWriter, reinterpret_cast<const xmlChar *>(text.c_str())));
+	}
+
+	void writeElement (const char *name, const string &text) {
+		check(xmlTextWriterWriteElement(mWriter, reinterpret_cast<const xmlChar *>(name), reinterpret_cast<const xmlChar *>(text.c_str())));
+	}
+
+	void writeEmptyElement (const char *name) {
+		startElement(name);
+		endElement();
+	}
+
+	void endElement () {
+		check(xmlTextWriterEndElement(mWriter));
+	}
+
+	string getResult () {
+		check(xmlTextWriterEndDocument(mWriter));
+		// Freeing the writer flushes it to the buffer.
+		xmlFreeTextWriter(mWriter);
+		mWriter = nullptr;
+		if (mError)
+			return string();
+		return string(reinterpret_cast<const char *>(xmlBufferContent(mBuffer)), static_cast<size_t>(xmlBufferLength(mBuffer)));
+	}
+
+private:
+	void check (int result) {
+		if (result < 0)
+			mError = true;
+	}
+
+	xmlBufferPtr mBuffer = nullptr;
+	xmlTextWriterPtr mWriter = nullptr;
+	bool mError = false;
+};
+
+static string streamCreateImdn (const ImdnDocument &document) {
+	XmlStreamWriter writer;
+	writer.startElement("imdn", ImdnNamespace);
+	if (document.hasReason)
+		writer.writeNamespace("imdn", LinphoneImdnNamespace);
+	writer.writeElement("message-id", document.messageId);
+	writer.writeElement("datetime", document.datetime);
+
+	switch (document.notification) {
+		case ImdnDocument::Notification::Delivery:
+			writer.startElement("delivery-notification");
+			break;
+		case ImdnDocument::Notification::Display:
+			writer.startElement("display-notification");
+			break;
+		case ImdnDocument::Notification::Processing:
+			writer.startElement("processing-notification");
+			break;
+		case ImdnDocument::Notification::None:
+			break;
+	}
+	if (document.notification != ImdnDocument::Notification::None) {
+		writer.startElement("status");
+		switch (document.status) {
+			case ImdnDocument::Status::Delivered:
+				writer.writeEmptyElement("delivered");
+				break;
+			case ImdnDocument::Status::Failed:
+				writer.writeEmptyElement("failed");
+				break;
+			case ImdnDocument::Status::Displayed:
+				writer.writeEmptyElement("displayed");
+				break;
+			case ImdnDocument::Status::Processed:
+				writer.writeEmptyElement("processed");
+				break;
+			case ImdnDocument::Status::Stored:
+				writer.writeEmptyElement("stored");
+				break;
+			case ImdnDocument::Status::Forbidden:
+				writer.writeEmptyElement("forbidden");
+				break;
+			case ImdnDocument::Status::Error:
+				writer.writeEmptyElement("error");
+				break;
+			case ImdnDocument::Status::None:
+				break;
+		}
+		if (document.hasReason) {
+			writer.startElement("imdn:reason");
+			writer.writeAttribute("code", Utils::toString(document.reasonCode));
+			writer.writeText(document.reason);
+			writer.endElement();
+		}
+		writer.endElement();
+		writer.endElement();
+	}
+
+	writer.endElement();
+	return writer.getResult();
+}
+
+static string streamCreateIsComposing (const IsComposingDocument &document) {
+	XmlStreamWriter writer;
+	writer.startElement("isComposing", IsComposingNamespace);
+	writer.writeElement("state", document.state);
+	if (document.refresh > 0)
+		writer.writeElement("refresh", Utils::toString(document.refresh));
+	writer.endElement();
+	return writer.getResult();
+}
+
+// -----------------------------------------------------------------------------
+// XSD backend.
+// -----------------------------------------------------------------------------
+
+static bool xsdParseImdn (const string &xml, ImdnDocument &document) {
+	istringstream data(xml);
+	unique_ptr<Xsd::Imdn::Imdn> imdn;
+	try {
+		imdn = Xsd::Imdn::parseImdn(data, Xsd::XmlSchema::Flags::dont_validate);
+	} catch (const exception &e) {
+		lError() << "IMDN parsing exception: " << e.what();
+	}
+	if (!imdn)
+		return false;
+
+	document.messageId = imdn->getMessageId();
+	document.datetime = imdn->getDatetime();
+	auto &deliveryNotification = imdn->getDeliveryNotification();
+	auto &displayNotification = imdn->getDisplayNotification();
+	auto &processingNotification = imdn->getProcessingNotification();
+	if (deliveryNotification.present()) {
+		auto &status = deliveryNotification.get().getStatus();
+		document.notification = ImdnDocument::Notification::Delivery;
+		if (status.getDelivered().present())
+			document.status = ImdnDocument::Status::Delivered;
+		else if (status.getFailed().present())
+			document.status = ImdnDocument::Status::Failed;
+		else if (status.getForbidden().present())
+			document.status = ImdnDocument::Status::Forbidden;
+		else if (status.getError().present())
+			document.status = ImdnDocument::Status::Error;
+		if (status.getReason().present()) {
+			document.hasReason = true;
+			document.reason = status.getReason().get();
+			document.reasonCode = status.getReason().get().getCode();
+		}
+	} else if (displayNotification.present()) {
+		auto &status = displayNotification.get().getStatus();
+		document.notification = ImdnDocument::Notification::Display;
+		if (status.getDisplayed().present())
+			document.status = ImdnDocument::Status::Displayed;
+		else if (status.getForbidden().present())
+			document.status = ImdnDocument::Status::Forbidden;
+		else if (status.getError().present())
+			document.status = ImdnDocument::Status::Error;
+	} else if (processingNotification.present()) {
+		auto &status = processingNotification.get().getStatus();
+		document.notification = ImdnDocument::Notification::Processing;
+		if (status.getProcessed().present())
+			document.status = ImdnDocument::Status::Processed;
+		else if (status.getStored().present())
+			document.status = ImdnDocument::Status::Stored;
+		else if (status.getForbidden().present())
+			document.status = ImdnDocument::Status::Forbidden;
+		else if (status.getError().present())
+			document.status = ImdnDocument::Status::Error;
+	}
+	return true;
+}
+
+static string xsdCreateImdn (const ImdnDocument &document) {
+	Xsd::Imdn::Imdn imdn(document.messageId, document.datetime);
+	if (document.notification == ImdnDocument::Notification::Delivery) {
+		Xsd::Imdn::Status status;
+		if (document.status == ImdnDocument::Status::Delivered) {
+			auto delivered = Xsd::Imdn::Delivered();
+			status.setDelivered(delivered);
+		} else {
+			auto failed = Xsd::Imdn::Failed();
+			status.setFailed(failed);
+		}
+		if (document.hasReason) {
+			Xsd::LinphoneImdn::ImdnReason imdnReason(document.reason);
+			imdnReason.setCode(document.reasonCode);
+			status.setReason(imdnReason);
+		}
+		Xsd::Imdn::DeliveryNotification deliveryNotification(status);
+		imdn.setDeliveryNotification(deliveryNotification);
+	} else if (document.notification == ImdnDocument::Notification::Display) {
+		Xsd::Imdn::Status1 status;
+		auto displayed = Xsd::Imdn::Displayed();
+		status.setDisplayed(displayed);
+		Xsd::Imdn::DisplayNotification displayNotification(status);
+		imdn.setDisplayNotification(displayNotification);
+	}
+
+	stringstream ss;
+	Xsd::XmlSchema::NamespaceInfomap map;
+	map[""].name = ImdnNamespace;
+	if (document.hasReason)
+		map["imdn"].name = LinphoneImdnNamespace;
+	Xsd::Imdn::serializeImdn(ss, imdn, map, "UTF-8", Xsd::XmlSchema::Flags::dont_pretty_print);
+	return ss.str();
+}
+
+static bool xsdParseIsComposing (const string &xml, IsComposingDocument &document) {
+	istringstream data(xml);
+	unique_ptr<Xsd::IsComposing::IsComposing> node;
+	try {
+		node = Xsd::IsComposing::parseIsComposing(data, Xsd::XmlSchema::Flags::dont_validate);
+	} catch (const exception &e) {
+		lError() << "Is-composing parsing exception: " << e.what();
+	}
+	if (!node)
+		return false;
+
+	document.state = node->getState();
+	if (node->getRefresh().present())
+		document.refresh = node->getRefresh().get();
+	return true;
+}
+
+static string xsdCreateIsComposing (const IsComposingDocument &document) {
+	Xsd::IsComposing::IsComposing node(document.state);
+	if (document.refresh > 0)
+		node.setRefresh(document.refresh);
+
+	stringstream ss;
+	Xsd::XmlSchema::NamespaceInfomap map;
+	map[""].name = IsComposingNamespace;
+	Xsd::IsComposing::serializeIsComposing(ss, node, map, "UTF-8", Xsd::XmlSchema::Flags::dont_pretty_print);
+	return ss.str();
+}
+
+static ConferenceInfoDocument::State conferenceInfoStateFromXsd (const Xsd::ConferenceInfo::StateType &state) {
+	if (state == Xsd::ConferenceInfo::StateType::partial)
+		return ConferenceInfoDocument::State::Partial;
+	if (state == Xsd::ConferenceInfo::StateType::deleted)
+		return ConferenceInfoDocument::State::Deleted;
+	return ConferenceInfoDocument::State::Full;
+}
+
+static bool xsdParseConferenceInfo (const string &xml, ConferenceInfoDocument &document) {
+	istringstream data(xml);
+	unique_ptr<Xsd::ConferenceInfo::ConferenceType> confInfo;
+	try {
+		confInfo = Xsd::ConferenceInfo::parseConferenceInfo(data, Xsd::XmlSchema::Flags::dont_validate);
+	} catch (const exception &e) {
+		lError() << "Conference-info parsing exception: " << e.what();
+	}
+	if (!confInfo)
+		return false;
+
+	document.entity = confInfo->getEntity();
+	document.state = conferenceInfoStateFromXsd(confInfo->getState());
+	if (confInfo->getVersion().present()) {
+		document.hasVersion = true;
+		document.version = confInfo->getVersion().get();
+	}
+
+	auto &confDescription = confInfo->getConferenceDescription();
+	if (confDescription.present()) {
+		document.hasDescription = true;
+		auto &subject = confDescription.get().getSubject();
+		if (subject.present()) {
+			document.hasSubject = true;
+			document.subject = subject.get();
+		}
+		auto &freeText = confDescription.get().getFreeText();
+		if (freeText.present()) {
+			document.hasFreeText = true;
+			document.freeText = freeText.get();
+		}
+		auto &keywords = confDescription.get().getKeywords();
+		if (keywords.present())
+			document.keywords.assign(keywords.get().begin(), keywords.get().end());
+	}
+
+	auto &users = confInfo->getUsers();
+	if (!users.present())
+		return true;
+
+	document.hasUsers = true;
+	for (const auto &xsdUser : users->getUser()) {
+		ConferenceInfoDocument::User user;
+		if (xsdUser.getEntity().present())
+			user.entity = xsdUser.getEntity().get();
+		user.state = conferenceInfoStateFromXsd(xsdUser.getState());
+		auto &roles = xsdUser.getRoles();
+		if (roles) {
+			user.hasRoles = true;
+			user.roles.assign(roles->getEntry().begin(), roles->getEntry().end());
+		}
+		for (const auto &xsdEndpoint : xsdUser.getEndpoint()) {
+			ConferenceInfoDocument::Endpoint endpoint;
+			endpoint.hasEntity = xsdEndpoint.getEntity().present();
+			if (endpoint.hasEntity)
+				endpoint.entity = xsdEndpoint.getEntity().get();
+			endpoint.state = conferenceInfoStateFromXsd(xsdEndpoint.getState());
+			endpoint.hasDisplayText = xsdEndpoint.getDisplayText().present();
+			if (endpoint.hasDisplayText)
+				endpoint.displayText = xsdEndpoint.getDisplayText().get();
+			user.endpoints.push_back(move(endpoint));
+		}
+		document.users.push_back(move(user));
+	}
+	return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool NotificationDocuments::parseImdn (const string &xml, ImdnDocument &document, Backend backend) {
+	return (backend == Backend::Xsd) ? xsdParseImdn(xml, document) : streamParseImdn(xml, document);
+}
+
+string NotificationDocuments::createImdn (const ImdnDocument &document, Backend backend) {
+	return (backend == Backend::Xsd) ? xsdCreateImdn(document) : streamCreateImdn(document);
+}
+
+bool NotificationDocuments::parseIsComposing (const string &xml, IsComposingDocument &document, Backend backend) {
+	return (backend == Backend::Xsd) ? xsdParseIsComposing(xml, document) : streamParseIsComposing(xml, document);
+}
+
+string NotificationDocuments::createIsComposing (const IsComposingDocument &document, Backend backend) {
+	return (backend == Backend::Xsd) ? xsdCreateIsComposing(document) : streamCreateIsComposing(document);
+}
+
+bool NotificationDocuments::parseConferenceInfo (const string &xml, ConferenceInfoDocument &document, Backend backend) {
+	return (backend == Backend::Xsd) ? xsdParseConferenceInfo(xml, document) : streamParseConferenceInfo(xml, document);
+}
+
+LINPHONE_END_NAMESPACE
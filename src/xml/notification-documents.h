@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_NOTIFICATION_DOCUMENTS_H_
+#define _L_NOTIFICATION_DOCUMENTS_H_
+
+#include <string>
+#include <vector>
+
+#include "linphone/types.h"
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+// What is used of an IMDN (RFC 5438) body.
+struct ImdnDocument {
+	enum class Notification {
+		None,
+		Delivery,
+		Display,
+		Processing
+	};
+
+	enum class Status {
+		None,
+		Delivered,
+		Failed,
+		Displayed,
+		Processed,
+		Stored,
+		Forbidden,
+		Error
+	};
+
+	std::string messageId;
+	std::string datetime;
+	Notification notification = Notification::None;
+	Status status = Status::None;
+
+	// Linphone extension giving the reason of a failed delivery.
+	bool hasReason = false;
+	std::string reason;
+	int reasonCode = 200;
+};
+
+// What is used of an is-composing (RFC 3994) body.
+struct IsComposingDocument {
+	std::string state;
+	unsigned long long refresh = 0; // 0 if absent.
+};
+
+// What is used of a conference-info (RFC 4575) body.
+struct ConferenceInfoDocument {
+	enum class State {
+		Full,
+		Partial,
+		Deleted
+	};
+
+	struct Endpoint {
+		bool hasEntity = false;
+		std::string entity;
+		State state = State::Full;
+		bool hasDisplayText = false;
+		std::string displayText;
+	};
+
+	struct User {
+		std::string entity;
+		State state = State::Full;
+		bool hasRoles = false;
+		std::vector<std::string> roles;
+		std::vector<Endpoint> endpoints;
+	};
+
+	std::string entity;
+	State state = State::Full;
+	bool hasVersion = false;
+	unsigned int version = 0;
+
+	bool hasDescription = false;
+	bool hasSubject = false;
+	std::string subject;
+	bool hasFreeText = false;
+	std::string freeText;
+	std::vector<std::string> keywords;
+
+	bool hasUsers = false;
+	std::vector<User> users;
+};
+
+/*
+ * Parsing and serialization of the IMDN, is-composing and conference-info bodies.
+ * The streaming backend reads and writes them in one pass with libxml2, the XSD backend goes through the
+ * generated CodeSynthesis object model. The backend is chosen with [misc] xml_parser ("stream" or "xsd").
+ * Parse functions return false if the body is malformed or is not a document of the expected kind.
+ */
+namespace NotificationDocuments {
+	enum class Backend {
+		Stream,
+		Xsd
+	};
+
+	LINPHONE_PUBLIC Backend getBackend (LinphoneCore *core);
+
+	LINPHONE_PUBLIC bool parseImdn (const std::string &xml, ImdnDocument &document, Backend backend = Backend::Stream);
+	LINPHONE_PUBLIC std::string createImdn (const ImdnDocument &document, Backend backend = Backend::Stream);
+
+	LINPHONE_PUBLIC bool parseIsComposing (const std::string &xml, IsComposingDocument &document, Backend backend = Backend::Stream);
+	LINPHONE_PUBLIC std::string createIsComposing (const IsComposingDocument &document, Backend backend = Backend::Stream);
+
+	LINPHONE_PUBLIC bool parseConferenceInfo (const std::string &xml, ConferenceInfoDocument &document, Backend backend = Backend::Stream);
+}
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_NOTIFICATION_DOCUMENTS_H_
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include <libxml/xmlreader.h>
+
+#include "xml-pull-parser.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+static void onXmlReaderError (void *userData, const char *msg, xmlParserSeverities severity, xmlTextReaderLocatorPtr locator) {
+	string *errorMessage = static_cast<string *>(userData);
+	if (errorMessage->empty() && msg)
+		*errorMessage = msg;
+}
+
+XmlPullParser::XmlPullParser (const string &xml) {
+	mReader = xmlReaderForMemory(xml.c_str(), static_cast<int>(xml.size()), nullptr, "UTF-8", XML_PARSE_NONET);
+	if (!mReader) {
+		mError = true;
+		mErrorMessage = "Unable to create xml reader";
+		return;
+	}
+	// Keep libxml2 from printing on stderr, the caller logs the error if needed.
+	xmlTextReaderSetErrorHandler(mReader, onXmlReaderError, &mErrorMessage);
+}
+
+XmlPullParser::~XmlPullParser () {
+	if (mReader)
+		xmlFreeTextReader(mReader);
+}
+
+// -----------------------------------------------------------------------------
+
+bool XmlPullParser::nextRoot () {
+	while (next()) {
+		if (xmlTextReaderNodeType(mReader) == XML_READER_TYPE_ELEMENT)
+			return true;
+	}
+	return false;
+}
+
+bool XmlPullParser::nextChild (int parentDepth) {
+	while (next()) {
+		int type = xmlTextReaderNodeType(mReader);
+		int depth = xmlTextReaderDepth(mReader);
+		if (depth <= parentDepth) {
+			if ((type == XML_READER_TYPE_END_ELEMENT) && (depth == parentDepth))
+				return false;
+			// The parent was an empty element, this node follows it: keep it for the caller.
+			mPending = true;
+			return false;
+		}
+		if ((type == XML_READER_TYPE_ELEMENT) && (depth == parentDepth + 1))
+			return true;
+	}
+	return false;
+}
+
+int XmlPullParser::getDepth () const {
+	return xmlTextReaderDepth(mReader);
+}
+
+bool XmlPullParser::isElement (const char *localName) const {
+	const xmlChar *name = xmlTextReaderConstLocalName(mReader);
+	return name && (strcmp(reinterpret_cast<const char *>(name), localName) == 0);
+}
+
+bool XmlPullParser::isElement (const char *localName, const char *namespaceUri) const {
+	if (!isElement(localName))
+		return false;
+	const xmlChar *uri = xmlTextReaderConstNamespaceUri(mReader);
+	return uri && (strcmp(reinterpret_cast<const char *>(uri), namespaceUri) == 0);
+}
+
+bool XmlPullParser::getAttribute (const char *name, string &value) const {
+	xmlChar *attribute = xmlTextReaderGetAttribute(mReader, reinterpret_cast<const xmlChar *>(name));
+	if (!attribute)
+		return false;
+	value = reinterpret_cast<const char *>(attribute);
+	xmlFree(attribute);
+	return true;
+}
+
+string XmlPullParser::readText () const {
+	xmlChar *text = xmlTextReaderReadString(mReader);
+	if (!text)
+		return string();
+	string result(reinterpret_cast<const char *>(text));
+	xmlFree(text);
+	return result;
+}
+
+// -----------------------------------------------------------------------------
+
+bool XmlPullParser::next () {
+	if (mPending) {
+		mPending = false;
+		return true;
+	}
+	if (!mReader || mError)
+		return false;
+
+	int result = xmlTextReaderRead(mReader);
+	if (result < 0) {
+		mError = true;
+		if (mErrorMessage.empty())
+			mErrorMessage = "Malformed xml document";
+	}
+	return result == 1;
+}
+
+LINPHONE_END_NAMESPACE
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_XML_PULL_PARSER_H_
+#define _L_XML_PULL_PARSER_H_
+
+#include <string>
+
+#include "linphone/utils/general.h"
+
+typedef struct _xmlTextReader xmlTextReader;
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+/*
+ * Thin wrapper of the libxml2 text reader, to parse small documents in one pass without building a tree.
+ *
+ * Typical use, with the reader positioned on an element of depth d:
+ *
+ *	int depth = parser.getDepth();
+ *	while (parser.nextChild(depth)) {
+ *		if (parser.isElement("subject"))
+ *			subject = parser.readText();
+ *	}
+ *
+ * Children not looked at are skipped with their whole subtree.
+ */
+class XmlPullParser {
+public:
+	// The document is not copied, it must outlive the parser.
+	XmlPullParser (const std::string &xml);
+	XmlPullParser (const XmlPullParser &other) = delete;
+	~XmlPullParser ();
+
+	// Moves to the root element, returns false if the document does not have one.
+	bool nextRoot ();
+
+	// Moves to the next child element of the element of the given depth.
+	// Returns false when there is none, the reader is then after the end of this element.
+	bool nextChild (int parentDepth);
+
+	int getDepth () const;
+	bool isElement (const char *localName) const;
+	bool isElement (const char *localName, const char *namespaceUri) const;
+
+	bool getAttribute (const char *name, std::string &value) const;
+
+	// Text content of the current element, its children included.
+	std::string readText () const;
+
+	// True if the document was malformed, the parsing of the current document must then be aborted.
+	bool hasError () const {
+		return mError;
+	}
+
+	const std::string &getErrorMessage () const {
+		return mErrorMessage;
+	}
+
+private:
+	bool next ();
+
+	xmlTextReader *mReader = nullptr;
+	bool mPending = false;
+	bool mError = false;
+	std::string mErrorMessage;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_XML_PULL_PARSER_H_
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+#include "address/address.h"
+#include "address/identity-address.h"
+#include "linphone/utils/utils.h"
+
+#include "liblinphone_tester.h"
+#include "tester_utils.h"
+
+// =============================================================================
+
+using namespace std;
+
+using namespace LinphonePrivate;
+
+namespace {
+	const int ParticipantCount = 10000;
+	const int LookupCount = 200;
+
+	string participantUri (int index) {
+		return "sip:participant-" + Utils::toString(index) + "@sip.example.org";
+	}
+
+	long long elapsedUs (const chrono::steady_clock::time_point &start) {
+		return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+	}
+}
+
+static void string_forms_follow_mutations () {
+	Address address("\"Alice\" <sip:alice@sip.example.org:5060;transport=tcp>");
+	BC_ASSERT_TRUE(address.isValid());
+	const string initial = address.asString();
+	const string initialUriOnly = address.asStringUriOnly();
+
+	Address copy(address);
+	BC_ASSERT_TRUE(copy == address);
+	BC_ASSERT_TRUE(copy.weakEqual(address));
+
+	BC_ASSERT_TRUE(address.setUsername("bob"));
+	BC_ASSERT_STRING_EQUAL(address.getUsername().c_str(), "bob");
+	BC_ASSERT_STRING_NOT_EQUAL(address.asString().c_str(), initial.c_str());
+	BC_ASSERT_TRUE(address.asStringUriOnly().find("bob@") != string::npos);
+	BC_ASSERT_FALSE(copy == address);
+	BC_ASSERT_FALSE(copy.weakEqual(address));
+
+	// The copy keeps its own state.
+	BC_ASSERT_STRING_EQUAL(copy.asString().c_str(), initial.c_str());
+	BC_ASSERT_STRING_EQUAL(copy.asStringUriOnly().c_str(), initialUriOnly.c_str());
+
+	copy.setPort(5070);
+	BC_ASSERT_EQUAL(copy.getPort(), 5070, int, "%d");
+	BC_ASSERT_TRUE(copy.asString().find("5070") != string::npos);
+
+	copy = address;
+	BC_ASSERT_TRUE(copy == address);
+	BC_ASSERT_STRING_EQUAL(copy.asString().c_str(), address.asString().c_str());
+
+	BC_ASSERT_TRUE(address.setUriParam("gr", "urn:uuid:1234"));
+	BC_ASSERT_TRUE(address.asString().find("gr=urn:uuid:1234") != string::npos);
+	BC_ASSERT_TRUE(copy.weakEqual(address));
+
+	BC_ASSERT_TRUE(Address() == Address());
+	BC_ASSERT_FALSE(Address() == address);
+}
+
+static void identity_string_follows_mutations () {
+	IdentityAddress identity("sip:alice@sip.example.org;gr=urn:uuid:1234");
+	BC_ASSERT_STRING_EQUAL(identity.asString().c_str(), "sip:alice@sip.example.org;gr=urn:uuid:1234");
+	BC_ASSERT_STRING_EQUAL(identity.getAddressWithoutGruu().asString().c_str(), "sip:alice@sip.example.org");
+
+	identity.setDomain("sip.linphone.org");
+	BC_ASSERT_STRING_EQUAL(identity.asString().c_str(), "sip:alice@sip.linphone.org;gr=urn:uuid:1234");
+	identity.setGruu("");
+	BC_ASSERT_STRING_EQUAL(identity.asString().c_str(), "sip:alice@sip.linphone.org");
+
+	IdentityAddress copy(identity);
+	copy.setUsername("bob");
+	BC_ASSERT_STRING_EQUAL(copy.asString().c_str(), "sip:bob@sip.linphone.org");
+	BC_ASSERT_STRING_EQUAL(identity.asString().c_str(), "sip:alice@sip.linphone.org");
+}
+
+static void participant_lookup_benchmark () {
+	vector<Address> participants;
+	unordered_map<IdentityAddress, int> participantIndexes;
+	participants.reserve(ParticipantCount);
+	for (int i = 0; i < ParticipantCount; ++i) {
+		participants.emplace_back(participantUri(i));
+		participantIndexes[IdentityAddress(participants.back())] = i;
+	}
+
+	vector<Address> searched;
+	for (int i = 0; i < LookupCount; ++i)
+		searched.emplace_back(participantUri((i * 7919) % ParticipantCount));
+
+	long long durations[2];
+	int found = 0;
+	for (int pass = 0; pass < 2; ++pass) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for (const auto &address : searched) {
+			for (const auto &participant : participants) {
+				if (participant.weakEqual(address) && participant == address) {
+					found++;
+					break;
+				}
+			}
+		}
+		durations[pass] = elapsedUs(start);
+	}
+	BC_ASSERT_EQUAL(found, 2 * LookupCount, int, "%d");
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	int hashed = 0;
+	for (int i = 0; i < 10; ++i) {
+		for (const auto &address : searched) {
+			auto it = participantIndexes.find(IdentityAddress(address));
+			if (it != participantIndexes.end() && participants[size_t(it->second)] == address)
+				hashed++;
+		}
+	}
+	long long hashDuration = elapsedUs(start);
+	BC_ASSERT_EQUAL(hashed, 10 * LookupCount, int, "%d");
+
+	ms_message(
+		"Address lookup benchmark (%d participants, %d lookups): first linear pass=%lldus, cached linear pass=%lldus, "
+		"10 hashed passes=%lldus",
+		ParticipantCount, LookupCount, durations[0], durations[1], hashDuration
+	);
+}
+
+test_t address_tests[] = {
+	TEST_NO_TAG("String forms follow mutations", string_forms_follow_mutations),
+	TEST_NO_TAG("Identity string follows mutations", identity_string_follows_mutations),
+	TEST_ONE_TAG("Participant lookup benchmark", participant_lookup_benchmark, "Benchmark")
+};
+
+test_suite_t address_test_suite = {
+	"Address", NULL, NULL, liblinphone_tester_before_each, liblinphone_tester_after_each,
+	sizeof(address_tests) / sizeof(address_tests[0]), address_tests
+};
@@ -421,6 +421,48 @@ static void direct_call_over_ipv6(void){
 	}else ms_warning("Test skipped, no ipv6 available");
 }
 
+static void direct_call_route_cache(void){
+	LinphoneCoreManager* marie = linphone_core_manager_new("marie_rc");
+	LinphoneCoreManager* pauline = linphone_core_manager_new(transport_supported(LinphoneTransportTls) ? "pauline_rc" : "pauline_tcp_rc");
+	LinphoneSipTransports pauline_transports;
+	LinphoneAddress* pauline_dest = linphone_address_new("sip:127.0.0.1;transport=tcp");
+	unsigned int hits, misses;
+	int i;
+
+	linphone_core_set_default_proxy_config(marie->lc, NULL);
+	linphone_core_set_default_proxy_config(pauline->lc, NULL);
+	linphone_core_get_sip_transports_used(pauline->lc, &pauline_transports);
+	linphone_address_set_port(pauline_dest, pauline_transports.tcp_port);
+
+	for (i = 0; i < 3; i++) {
+		hits = linphone_core_get_route_cache_hit_count(marie->lc);
+		misses = linphone_core_get_route_cache_miss_count(marie->lc);
+		if (i == 2) {
+			/* The cache is cleared when the network changes. */
+			linphone_core_set_network_reachable(marie->lc, FALSE);
+			linphone_core_set_network_reachable(marie->lc, TRUE);
+		}
+
+		linphone_core_invite_address(marie->lc, pauline_dest);
+		BC_ASSERT_TRUE(wait_for(marie->lc, pauline->lc, &pauline->stat.number_of_LinphoneCallIncomingReceived, i + 1));
+		linphone_call_accept(linphone_core_get_current_call(pauline->lc));
+		BC_ASSERT_TRUE(wait_for(marie->lc, pauline->lc, &marie->stat.number_of_LinphoneCallStreamsRunning, i + 1));
+		BC_ASSERT_TRUE(wait_for(marie->lc, pauline->lc, &pauline->stat.number_of_LinphoneCallStreamsRunning, i + 1));
+
+		if (i == 1) {
+			/* Same destination as the first call: the local ip is taken from the cache. */
+			BC_ASSERT_GREATER(linphone_core_get_route_cache_hit_count(marie->lc), hits + 1, unsigned int, "%u");
+		} else {
+			BC_ASSERT_GREATER(linphone_core_get_route_cache_miss_count(marie->lc), misses + 1, unsigned int, "%u");
+		}
+		end_call(marie, pauline);
+	}
+
+	linphone_core_manager_destroy(marie);
+	linphone_core_manager_destroy(pauline);
+	linphone_address_unref(pauline_dest);
+}
+
 //Testing the well known port config from linphonerc in call
 static void _direct_call_well_known_port(int iptype){
 	LinphoneCoreManager* marie = NULL;
@@ -4798,6 +4840,22 @@ static void call_logs_sqlite_storage(void) {
 	end_call(marie, pauline);
 	BC_ASSERT_TRUE(linphone_core_get_call_history_size(marie->lc) == 2);
 
+	{
+		LinphoneObjectArray *page = linphone_core_get_call_history_array(marie->lc, 0, 1);
+		LinphoneObjectArray *all = linphone_core_get_call_history_array(marie->lc, 0, 0);
+		BC_ASSERT_EQUAL((int)linphone_object_array_get_size(page), 1, int, "%d");
+		BC_ASSERT_EQUAL((int)linphone_object_array_get_size(all), 2, int, "%d");
+		/* Pages are most recent first and share the call logs cached by the core. */
+		BC_ASSERT_PTR_EQUAL(linphone_object_array_get(page, 0), linphone_object_array_get(all, 0));
+		BC_ASSERT_PTR_NULL(linphone_object_array_get(all, 2));
+		linphone_object_array_unref(page);
+		page = linphone_core_get_call_history_array(marie->lc, 1, 10);
+		if (BC_ASSERT_TRUE(linphone_object_array_get_size(page) == 1))
+			BC_ASSERT_PTR_EQUAL(linphone_object_array_get_data(page)[0], linphone_object_array_get(all, 1));
+		linphone_object_array_unref(page);
+		linphone_object_array_unref(all);
+	}
+
 	linphone_core_delete_call_history(marie->lc);
 	BC_ASSERT_TRUE(linphone_core_get_call_history_size(marie->lc) == 0);
 
@@ -4920,6 +4978,53 @@ static void call_with_rtcp_mux_not_accepted(void){
 	_call_with_rtcp_mux(TRUE, FALSE, FALSE,TRUE);
 }
 
+static void call_with_stats_history(void){
+	const int depth = 5;
+	LinphoneCoreManager* marie = linphone_core_manager_new("marie_rc");
+	LinphoneCoreManager* pauline = linphone_core_manager_new(transport_supported(LinphoneTransportTls) ? "pauline_rc" : "pauline_tcp_rc");
+	char *dump_path = bc_tester_file("calls-stats-history.csv");
+
+	lp_config_set_int(linphone_core_get_config(marie->lc), "rtp", "stats_history_interval", 200);
+	lp_config_set_int(linphone_core_get_config(marie->lc), "rtp", "stats_history_depth", depth);
+
+	if (BC_ASSERT_TRUE(call(marie,pauline))){
+		LinphoneCall *call = linphone_core_get_current_call(marie->lc);
+		unsigned int i;
+		FILE *f;
+
+		/* more samples than the depth are recorded, only the last ones are kept */
+		wait_for_until(marie->lc, pauline->lc, NULL, 0, 2000);
+		BC_ASSERT_EQUAL(linphone_call_get_stats_history_size(call, LinphoneStreamTypeAudio), depth, unsigned int, "%u");
+		BC_ASSERT_EQUAL(linphone_call_get_stats_history_size(call, LinphoneStreamTypeVideo), 0, unsigned int, "%u");
+		BC_ASSERT_PTR_NULL(linphone_call_get_stats_history_sample(call, LinphoneStreamTypeAudio, depth));
+		for (i = 1; i < (unsigned int)depth; i++) {
+			const LinphoneCallStatsSample *previous = linphone_call_get_stats_history_sample(call, LinphoneStreamTypeAudio, i - 1);
+			const LinphoneCallStatsSample *sample = linphone_call_get_stats_history_sample(call, LinphoneStreamTypeAudio, i);
+			if (BC_ASSERT_PTR_NOT_NULL(previous) && BC_ASSERT_PTR_NOT_NULL(sample))
+				BC_ASSERT_GREATER((long long)sample->time, (long long)previous->time + 1, long long, "%lld");
+		}
+		BC_ASSERT_GREATER(linphone_call_get_stats_history_sample(call, LinphoneStreamTypeAudio, depth - 1)->download_bandwidth, 1.f, float, "%f");
+		/* pauline did not enable the stats history */
+		BC_ASSERT_EQUAL(linphone_call_get_stats_history_size(linphone_core_get_current_call(pauline->lc), LinphoneStreamTypeAudio), 0, unsigned int, "%u");
+
+		BC_ASSERT_EQUAL(linphone_core_dump_calls_stats_history(marie->lc, dump_path), 0, int, "%d");
+		f = fopen(dump_path, "r");
+		if (BC_ASSERT_PTR_NOT_NULL(f)) {
+			char line[512];
+			int lines = 0;
+			while (fgets(line, sizeof(line), f)) lines++;
+			/* header and one line per audio sample */
+			BC_ASSERT_EQUAL(lines, depth + 1, int, "%d");
+			fclose(f);
+		}
+		remove(dump_path);
+		end_call(marie,pauline);
+	}
+	bc_free(dump_path);
+	linphone_core_manager_destroy(marie);
+	linphone_core_manager_destroy(pauline);
+}
+
 static void v6_to_v4_call_without_relay(void){
 	LinphoneCoreManager* marie;
 	LinphoneCoreManager* pauline;
@@ -5176,6 +5281,7 @@ test_t call_tests[] = {
 	TEST_NO_TAG("Call with http proxy", call_with_http_proxy),
 	TEST_NO_TAG("Call with timed-out bye", call_with_timed_out_bye),
 	TEST_NO_TAG("Direct call over IPv6", direct_call_over_ipv6),
+	TEST_NO_TAG("Direct call with route cache", direct_call_route_cache),
 	TEST_NO_TAG("Direct call well known port", direct_call_well_known_port_ipv4),
 	TEST_NO_TAG("Direct call well known port ipv6", direct_call_well_known_port_ipv6),
 	TEST_NO_TAG("Call IPv6 to IPv4 without relay", v6_to_v4_call_without_relay),
@@ -5252,6 +5358,7 @@ test_t call_tests[] = {
 	TEST_NO_TAG("Call record with custom RTP Modifier", call_record_with_custom_rtp_modifier),
 	TEST_NO_TAG("Call with rtcp-mux", call_with_rtcp_mux),
 	TEST_NO_TAG("Call with rtcp-mux not accepted", call_with_rtcp_mux_not_accepted),
+	TEST_NO_TAG("Call with stats history", call_with_stats_history),
 	TEST_NO_TAG("Call with network reachable down in callback", call_with_network_reachable_down_in_callback),
 	TEST_NO_TAG("Call terminated with reason", terminate_call_with_error),
 	TEST_NO_TAG("Call cancelled with reason", cancel_call_with_error),
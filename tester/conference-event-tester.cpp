@@ -17,10 +17,15 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <map>
 #include <string>
 
 #include "address/identity-address.h"
+#include "chat/chat-room/client-group-chat-room.h"
+#include "chat/chat-room/server-group-chat-room-p.h"
+#include "chat/encryption/encryption-engine.h"
 #include "conference/conference-listener.h"
 #include "conference/handlers/local-conference-event-handler-p.h"
 #include "conference/handlers/remote-conference-event-handler-p.h"
@@ -28,12 +33,18 @@
 #include "conference/local-conference.h"
 #include "conference/participant-p.h"
 #include "conference/remote-conference.h"
+#include "content/content-disposition.h"
+#include "content/content-type.h"
+#include "core/core-p.h"
+#include "db/main-db.h"
 #include "liblinphone_tester.h"
 #include "linphone/core.h"
 #include "private.h"
+#include "sal/message-op.h"
 #include "tester_utils.h"
 #include "tools/private-access.h"
 #include "tools/tester.h"
+#include "xml/notification-documents.h"
 
 using namespace LinphonePrivate;
 using namespace std;
@@ -1336,6 +1347,455 @@ void one_to_one_keyword () {
 	linphone_core_manager_destroy(pauline);
 }
 
+static const char *imdn_failed_notification = \
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"\
+"<imdn xmlns=\"urn:ietf:params:xml:ns:imdn\" xmlns:imdn=\"http://www.linphone.org/xsds/imdn.xsd\">"\
+"	<message-id>3jf5g8ZeEd</message-id>"\
+"	<datetime>2020-02-03T10:12:42Z</datetime>"\
+"	<delivery-notification>"\
+"		<status><failed/><imdn:reason code=\"488\">Not acceptable here</imdn:reason></status>"\
+"	</delivery-notification>"\
+"</imdn>";
+
+static const char *is_composing_active = \
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"\
+"<isComposing xmlns=\"urn:ietf:params:xml:ns:im-iscomposing\">"\
+"	<state>active</state>"\
+"	<refresh>60</refresh>"\
+"</isComposing>";
+
+static void check_conference_info_documents (const ConferenceInfoDocument &doc1, const ConferenceInfoDocument &doc2) {
+	BC_ASSERT_STRING_EQUAL(doc1.entity.c_str(), doc2.entity.c_str());
+	BC_ASSERT_TRUE(doc1.state == doc2.state);
+	BC_ASSERT_EQUAL(doc1.hasVersion, doc2.hasVersion, bool, "%d");
+	BC_ASSERT_EQUAL(doc1.version, doc2.version, unsigned int, "%u");
+	BC_ASSERT_EQUAL(doc1.hasSubject, doc2.hasSubject, bool, "%d");
+	BC_ASSERT_STRING_EQUAL(doc1.subject.c_str(), doc2.subject.c_str());
+	BC_ASSERT_TRUE(doc1.keywords == doc2.keywords);
+	if (!BC_ASSERT_TRUE(doc1.users.size() == doc2.users.size()))
+		return;
+	for (size_t i = 0; i < doc1.users.size(); i++) {
+		const auto &user1 = doc1.users[i];
+		const auto &user2 = doc2.users[i];
+		BC_ASSERT_STRING_EQUAL(user1.entity.c_str(), user2.entity.c_str());
+		BC_ASSERT_TRUE(user1.state == user2.state);
+		BC_ASSERT_EQUAL(user1.hasRoles, user2.hasRoles, bool, "%d");
+		BC_ASSERT_TRUE(user1.roles == user2.roles);
+		if (!BC_ASSERT_TRUE(user1.endpoints.size() == user2.endpoints.size()))
+			continue;
+		for (size_t j = 0; j < user1.endpoints.size(); j++) {
+			BC_ASSERT_STRING_EQUAL(user1.endpoints[j].entity.c_str(), user2.endpoints[j].entity.c_str());
+			BC_ASSERT_TRUE(user1.endpoints[j].state == user2.endpoints[j].state);
+			BC_ASSERT_STRING_EQUAL(user1.endpoints[j].displayText.c_str(), user2.endpoints[j].displayText.c_str());
+		}
+	}
+}
+
+static string format_notify (const char *notify) {
+	size_t size = strlen(notify) + strlen(confUri);
+	char *buffer = new char[size];
+	snprintf(buffer, size, notify, confUri);
+	string result(buffer);
+	delete[] buffer;
+	return result;
+}
+
+void notification_documents_backends () {
+	using Backend = NotificationDocuments::Backend;
+
+	// Both backends must give the same documents.
+	for (const char *notify : { first_notify, participant_added_notify, participant_deleted_notify }) {
+		string xml = format_notify(notify);
+		ConferenceInfoDocument streamDocument, xsdDocument;
+		BC_ASSERT_TRUE(NotificationDocuments::parseConferenceInfo(xml, streamDocument, Backend::Stream));
+		BC_ASSERT_TRUE(NotificationDocuments::parseConferenceInfo(xml, xsdDocument, Backend::Xsd));
+		check_conference_info_documents(streamDocument, xsdDocument);
+	}
+
+	ConferenceInfoDocument confInfo;
+	NotificationDocuments::parseConferenceInfo(format_notify(first_notify), confInfo);
+	BC_ASSERT_STRING_EQUAL(confInfo.subject.c_str(), "Agenda: This month's goals");
+	if (BC_ASSERT_TRUE(confInfo.users.size() == 2)) {
+		BC_ASSERT_EQUAL(confInfo.users[0].endpoints.size(), 1, size_t, "%zu");
+		BC_ASSERT_STRING_EQUAL(confInfo.users[0].endpoints[0].displayText.c_str(), "Bob's Laptop");
+		BC_ASSERT_TRUE(confInfo.users[1].roles == vector<string>({ "admin", "participant" }));
+		BC_ASSERT_EQUAL(confInfo.users[1].endpoints.size(), 2, size_t, "%zu");
+	}
+
+	for (Backend backend : { Backend::Stream, Backend::Xsd }) {
+		ImdnDocument imdn;
+		BC_ASSERT_TRUE(NotificationDocuments::parseImdn(imdn_failed_notification, imdn, backend));
+		BC_ASSERT_STRING_EQUAL(imdn.messageId.c_str(), "3jf5g8ZeEd");
+		BC_ASSERT_TRUE(imdn.notification == ImdnDocument::Notification::Delivery);
+		BC_ASSERT_TRUE(imdn.status == ImdnDocument::Status::Failed);
+		BC_ASSERT_TRUE(imdn.hasReason);
+		BC_ASSERT_EQUAL(imdn.reasonCode, 488, int, "%d");
+		BC_ASSERT_STRING_EQUAL(imdn.reason.c_str(), "Not acceptable here");
+
+		// What is written by a backend is read the same way by the other one.
+		Backend other = (backend == Backend::Stream) ? Backend::Xsd : Backend::Stream;
+		ImdnDocument copy;
+		BC_ASSERT_TRUE(NotificationDocuments::parseImdn(NotificationDocuments::createImdn(imdn, backend), copy, other));
+		BC_ASSERT_STRING_EQUAL(copy.messageId.c_str(), imdn.messageId.c_str());
+		BC_ASSERT_STRING_EQUAL(copy.datetime.c_str(), imdn.datetime.c_str());
+		BC_ASSERT_TRUE(copy.status == imdn.status);
+		BC_ASSERT_EQUAL(copy.reasonCode, imdn.reasonCode, int, "%d");
+		BC_ASSERT_STRING_EQUAL(copy.reason.c_str(), imdn.reason.c_str());
+
+		IsComposingDocument isComposing;
+		BC_ASSERT_TRUE(NotificationDocuments::parseIsComposing(is_composing_active, isComposing, backend));
+		BC_ASSERT_STRING_EQUAL(isComposing.state.c_str(), "active");
+		BC_ASSERT_EQUAL(isComposing.refresh, 60, unsigned long long, "%llu");
+		IsComposingDocument isComposingCopy;
+		BC_ASSERT_TRUE(NotificationDocuments::parseIsComposing(NotificationDocuments::createIsComposing(isComposing, backend), isComposingCopy, other));
+		BC_ASSERT_STRING_EQUAL(isComposingCopy.state.c_str(), "active");
+		BC_ASSERT_EQUAL(isComposingCopy.refresh, 60, unsigned long long, "%llu");
+
+		// Malformed or unexpected bodies are rejected.
+		BC_ASSERT_FALSE(NotificationDocuments::parseImdn("<imdn xmlns=\"urn:ietf:params:xml:ns:imdn\"><message-id>", imdn, backend));
+		BC_ASSERT_FALSE(NotificationDocuments::parseImdn(is_composing_active, imdn, backend));
+		BC_ASSERT_FALSE(NotificationDocuments::parseIsComposing("hello", isComposing, backend));
+	}
+}
+
+template<typename Document>
+static double parsingMicroseconds (
+	bool (*parse)(const string &, Document &, NotificationDocuments::Backend),
+	const string &xml,
+	NotificationDocuments::Backend backend,
+	int count
+) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int i = 0; i < count; i++) {
+		Document document;
+		BC_ASSERT_TRUE(parse(xml, document, backend));
+	}
+	return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / count;
+}
+
+void notification_documents_parsing_benchmark () {
+	using Backend = NotificationDocuments::Backend;
+	const int count = 2000;
+	string confInfo = format_notify(first_notify);
+
+	for (Backend backend : { Backend::Xsd, Backend::Stream }) {
+		const char *name = (backend == Backend::Xsd) ? "xsd" : "stream";
+		ms_message("Notification documents parsing with %s backend: IMDN %.1f us, is-composing %.1f us, conference-info %.1f us per document",
+			name,
+			parsingMicroseconds<ImdnDocument>(NotificationDocuments::parseImdn, imdn_failed_notification, backend, count),
+			parsingMicroseconds<IsComposingDocument>(NotificationDocuments::parseIsComposing, is_composing_active, backend, count),
+			parsingMicroseconds<ConferenceInfoDocument>(NotificationDocuments::parseConferenceInfo, confInfo, backend, count)
+		);
+	}
+}
+
+static double fanOutMessagesPerSecond (const shared_ptr<Core> &core, int deviceCount, int messageCount) {
+	const int devicesPerParticipant = 2;
+	const string domain = "127.0.0.1";
+	IdentityAddress conferenceAddress("sip:fan-out-" + Utils::toString(deviceCount) + "@" + domain);
+
+	list<shared_ptr<Participant>> participants;
+	for (int i = 0; i < deviceCount / devicesPerParticipant; i++) {
+		shared_ptr<Participant> participant = make_shared<Participant>(
+			nullptr, IdentityAddress("sip:member-" + Utils::toString(i) + "@" + domain)
+		);
+		for (int j = 0; j < devicesPerParticipant; j++) {
+			IdentityAddress gruu(participant->getAddress());
+			gruu.setGruu("urn:uuid:" + Utils::toString(i) + "-" + Utils::toString(j));
+			L_GET_PRIVATE(participant)->addDevice(gruu)->setState(ParticipantDevice::State::Present);
+		}
+		participants.push_back(participant);
+	}
+
+	shared_ptr<ServerGroupChatRoom> chatRoom = make_shared<ServerGroupChatRoom>(
+		core,
+		conferenceAddress,
+		ChatRoom::CapabilitiesMask({ ChatRoom::Capabilities::Conference }),
+		ChatRoomParams::getDefaults(core),
+		"Fan-out benchmark",
+		move(participants),
+		0
+	);
+	L_GET_PRIVATE(chatRoom)->setState(ChatRoom::State::Instantiated);
+	L_GET_PRIVATE(chatRoom)->setState(ChatRoom::State::Created);
+	for (const auto &participant : chatRoom->getParticipants())
+		L_GET_PRIVATE(participant)->setConference(chatRoom.get());
+
+	const string sender = chatRoom->getParticipants().front()->getAddress().asString() + ";gr=urn:uuid:0-0";
+	SalMessage message;
+	message.from = sender.c_str();
+	message.text = "Fan-out benchmark message";
+	message.url = nullptr;
+	message.message_id = nullptr;
+	message.content_type = "text/plain";
+	message.time = ms_time(nullptr);
+
+	int accepted = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int i = 0; i < messageCount; i++) {
+		SalMessageOp *op = new SalMessageOp(core->getCCore()->sal);
+		op->setFrom(sender);
+		if (L_GET_PRIVATE(chatRoom)->onSipMessageReceived(op, &message) == LinphoneReasonNone)
+			accepted++;
+		op->release();
+	}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	BC_ASSERT_EQUAL(accepted, messageCount, int, "%d");
+
+	chatRoom = nullptr;
+	return seconds > 0 ? messageCount / seconds : 0;
+}
+
+void server_group_chat_room_fan_out_benchmark () {
+	LinphoneCoreManager *pauline = linphone_core_manager_new("pauline_tcp_rc");
+	linphone_core_enable_conference_server(pauline->lc, TRUE);
+
+	string report;
+	for (int deviceCount : { 10, 100, 1000 }) {
+		int messageCount = max(5, 10000 / deviceCount);
+		double messagesPerSecond = fanOutMessagesPerSecond(pauline->lc->cppPtr, deviceCount, messageCount);
+		BC_ASSERT_TRUE(messagesPerSecond > 0);
+		ms_message(
+			"Server group chat room fan-out: %d devices, %d messages, %.1f messages/s, %.0f deliveries/s",
+			deviceCount, messageCount, messagesPerSecond, messagesPerSecond * (deviceCount - 1)
+		);
+		char line[128];
+		snprintf(line, sizeof(line), "\t%4d devices: %10.1f messages/s\n", deviceCount, messagesPerSecond);
+		report += line;
+		wait_for_until(pauline->lc, NULL, NULL, 0, 100);
+	}
+	bc_tester_printf(ORTP_MESSAGE, "Server group chat room fan-out:\n%s", report.c_str());
+
+	linphone_core_manager_destroy(pauline);
+}
+
+static shared_ptr<ServerGroupChatRoom> createQueueingChatRoom (
+	const shared_ptr<Core> &core,
+	const IdentityAddress &conferenceAddress,
+	const list<string> &receiverDevices
+) {
+	const string domain = "127.0.0.1";
+	list<shared_ptr<Participant>> participants;
+
+	shared_ptr<Participant> sender = make_shared<Participant>(nullptr, IdentityAddress("sip:sender@" + domain));
+	IdentityAddress senderDevice(sender->getAddress());
+	senderDevice.setGruu("urn:uuid:sender");
+	L_GET_PRIVATE(sender)->addDevice(senderDevice)->setState(ParticipantDevice::State::Present);
+	participants.push_back(sender);
+
+	// The devices of the receiver are not Present, the messages sent to them are queued.
+	shared_ptr<Participant> receiver = make_shared<Participant>(nullptr, IdentityAddress("sip:receiver@" + domain));
+	for (const auto &uuid : receiverDevices) {
+		IdentityAddress gruu(receiver->getAddress());
+		gruu.setGruu("urn:uuid:" + uuid);
+		L_GET_PRIVATE(receiver)->addDevice(gruu)->setState(ParticipantDevice::State::Joining);
+	}
+	participants.push_back(receiver);
+
+	shared_ptr<ServerGroupChatRoom> chatRoom = make_shared<ServerGroupChatRoom>(
+		core,
+		conferenceAddress,
+		ChatRoom::CapabilitiesMask({ ChatRoom::Capabilities::Conference }),
+		ChatRoomParams::getDefaults(core),
+		"Queue test",
+		move(participants),
+		0
+	);
+	L_GET_PRIVATE(chatRoom)->setState(ChatRoom::State::Instantiated);
+	L_GET_PRIVATE(chatRoom)->setState(ChatRoom::State::Created);
+	for (const auto &participant : chatRoom->getParticipants())
+		L_GET_PRIVATE(participant)->setConference(chatRoom.get());
+	return chatRoom;
+}
+
+static void sendQueueingChatRoomMessages (const shared_ptr<Core> &core, const shared_ptr<ServerGroupChatRoom> &chatRoom, int count) {
+	const string sender = "sip:sender@127.0.0.1;gr=urn:uuid:sender";
+	SalMessage message;
+	message.from = sender.c_str();
+	message.url = nullptr;
+	message.message_id = nullptr;
+	message.content_type = "text/plain";
+	message.time = ms_time(nullptr);
+
+	for (int i = 0; i < count; i++) {
+		const string text = "Queued message " + Utils::toString(i);
+		message.text = text.c_str();
+		SalMessageOp *op = new SalMessageOp(core->getCCore()->sal);
+		op->setFrom(sender);
+		BC_ASSERT_EQUAL(L_GET_PRIVATE(chatRoom)->onSipMessageReceived(op, &message), LinphoneReasonNone, int, "%d");
+		op->release();
+	}
+}
+
+static IdentityAddress receiverDevice (const string &uuid) {
+	IdentityAddress gruu("sip:receiver@127.0.0.1");
+	gruu.setGruu("urn:uuid:" + uuid);
+	return gruu;
+}
+
+void server_group_chat_room_queue_quotas () {
+	LinphoneCoreManager *pauline = linphone_core_manager_new("pauline_tcp_rc");
+	linphone_core_enable_conference_server(pauline->lc, TRUE);
+	LinphoneConfig *config = linphone_core_get_config(pauline->lc);
+	linphone_config_set_int(config, "misc", "queued_messages_max_per_device", 8);
+	linphone_config_set_int(config, "misc", "queued_messages_max_in_memory_per_device", 3);
+	shared_ptr<Core> core = pauline->lc->cppPtr;
+	const unique_ptr<MainDb> &mainDb = L_GET_PRIVATE(core)->mainDb;
+
+	// The oldest messages of a device are dropped beyond its quota. All the queued messages are in database,
+	// only the first ones of each device are also in memory.
+	shared_ptr<ServerGroupChatRoom> chatRoom = createQueueingChatRoom(core, IdentityAddress("sip:queue-device-quota@127.0.0.1"), { "a", "b" });
+	mainDb->insertChatRoom(chatRoom);
+	sendQueueingChatRoomMessages(core, chatRoom, 10);
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().depth, 16, int, "%d");
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().uncachedDepth, 14, int, "%d");
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().dropped, 4, int, "%d");
+	BC_ASSERT_EQUAL(mainDb->getServerQueuedMessageCount(chatRoom->getConferenceId(), receiverDevice("a")), 8, int, "%d");
+	BC_ASSERT_EQUAL(mainDb->getServerQueuedMessageCount(chatRoom->getConferenceId(), receiverDevice("b")), 8, int, "%d");
+	list<MainDb::ServerQueuedMessage> oldest = mainDb->getServerQueuedMessages(chatRoom->getConferenceId(), receiverDevice("a"), 1);
+	if (BC_ASSERT_TRUE(oldest.size() == 1))
+		BC_ASSERT_STRING_EQUAL(oldest.front().body.c_str(), "Queued message 2");
+	chatRoom = nullptr;
+
+	// The chat room quota applies to the messages of all the devices.
+	linphone_config_set_int(config, "misc", "queued_messages_max_per_chat_room", 5);
+	chatRoom = createQueueingChatRoom(core, IdentityAddress("sip:queue-chat-room-quota@127.0.0.1"), { "a", "b" });
+	mainDb->insertChatRoom(chatRoom);
+	sendQueueingChatRoomMessages(core, chatRoom, 10);
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().depth, 5, int, "%d");
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().dropped, 15, int, "%d");
+	BC_ASSERT_EQUAL(mainDb->getServerQueuedMessageCount(chatRoom->getConferenceId()), 5, int, "%d");
+	chatRoom = nullptr;
+
+	linphone_core_manager_destroy(pauline);
+}
+
+void server_group_chat_room_queue_restart_and_drain () {
+	LinphoneCoreManager *pauline = linphone_core_manager_new("pauline_tcp_rc");
+	linphone_core_enable_conference_server(pauline->lc, TRUE);
+	LinphoneConfig *config = linphone_core_get_config(pauline->lc);
+	linphone_config_set_int(config, "misc", "queued_messages_max_in_memory_per_device", 3);
+	linphone_config_set_int(config, "misc", "queued_messages_drain_batch_size", 2);
+	shared_ptr<Core> core = pauline->lc->cppPtr;
+	const unique_ptr<MainDb> &mainDb = L_GET_PRIVATE(core)->mainDb;
+	const IdentityAddress conferenceAddress("sip:queue-restart@127.0.0.1");
+
+	shared_ptr<ServerGroupChatRoom> chatRoom = createQueueingChatRoom(core, conferenceAddress, { "a", "b" });
+	mainDb->insertChatRoom(chatRoom);
+	sendQueueingChatRoomMessages(core, chatRoom, 10);
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().depth, 20, int, "%d");
+
+	// Restart: the cached messages are lost, the database has them all. Device "b" is not known
+	// by the chat room yet, its messages are recovered anyway.
+	chatRoom = nullptr;
+	chatRoom = createQueueingChatRoom(core, conferenceAddress, { "a" });
+	L_GET_PRIVATE(chatRoom)->dispatchQueuedMessages();
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().depth, 20, int, "%d");
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().uncachedDepth, 20, int, "%d");
+
+	shared_ptr<Participant> receiver = chatRoom->findParticipant(IdentityAddress("sip:receiver@127.0.0.1"));
+	if (BC_ASSERT_PTR_NOT_NULL(receiver.get())) {
+		L_GET_PRIVATE(receiver)->addDevice(receiverDevice("b"));
+		for (const auto &device : L_GET_PRIVATE(receiver)->getDevices())
+			device->setState(ParticipantDevice::State::Present);
+	}
+
+	// The drain is asynchronous, a batch per device and per iteration.
+	L_GET_PRIVATE(chatRoom)->dispatchQueuedMessages();
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().drained, 0, int, "%d");
+	linphone_core_iterate(pauline->lc);
+	BC_ASSERT_TRUE(chatRoom->getQueuedMessagesStats().drained > 0);
+	BC_ASSERT_TRUE(chatRoom->getQueuedMessagesStats().drained < 20);
+	for (int i = 0; (i < 100) && (chatRoom->getQueuedMessagesStats().depth > 0); i++)
+		linphone_core_iterate(pauline->lc);
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().depth, 0, int, "%d");
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().uncachedDepth, 0, int, "%d");
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().drained, 20, int, "%d");
+	BC_ASSERT_EQUAL(mainDb->getServerQueuedMessageCount(chatRoom->getConferenceId()), 0, int, "%d");
+
+	// Once drained, a Present device gets the messages without queue.
+	sendQueueingChatRoomMessages(core, chatRoom, 2);
+	BC_ASSERT_EQUAL((int)chatRoom->getQueuedMessagesStats().depth, 0, int, "%d");
+	chatRoom = nullptr;
+
+	linphone_core_manager_destroy(pauline);
+}
+
+static double securityLevelMicroseconds (const shared_ptr<AbstractChatRoom> &chatRoom, int count, AbstractChatRoom::SecurityLevel &level) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int i = 0; i < count; i++)
+		level = chatRoom->getSecurityLevel();
+	return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / count;
+}
+
+void client_group_chat_room_security_level_benchmark () {
+	const int participantCount = 100;
+	const int devicesPerParticipant = 3;
+	const string domain = "127.0.0.1";
+	LinphoneCoreManager *marie = linphone_core_manager_new("marie_lime_x3dh_rc");
+	shared_ptr<Core> core = marie->lc->cppPtr;
+
+	EncryptionEngine *encryptionEngine = core->getEncryptionEngine();
+	if (!encryptionEngine) {
+		ms_warning("LIME X3DH is not available, skipping client group chat room security level benchmark");
+		linphone_core_manager_destroy(marie);
+		return;
+	}
+
+	string resourceLists = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><resource-lists xmlns=\"urn:ietf:params:xml:ns:resource-lists\"><list>";
+	for (int i = 0; i < participantCount; i++)
+		resourceLists += "<entry uri=\"sip:member-" + Utils::toString(i) + "@" + domain + "\"/>";
+	resourceLists += "</list></resource-lists>";
+	Content content;
+	content.setBody(resourceLists);
+	content.setContentType(ContentType::ResourceLists);
+	content.setContentDisposition(ContentDisposition::RecipientList);
+
+	char *identity = linphone_address_as_string_uri_only(marie->identity);
+	ConferenceId conferenceId(IdentityAddress("sip:security-level@" + domain), IdentityAddress(identity));
+	bctbx_free(identity);
+	shared_ptr<AbstractChatRoom> chatRoom = L_GET_PRIVATE(core)->createClientGroupChatRoom("Security level benchmark", conferenceId, content, true);
+	if (!BC_ASSERT_PTR_NOT_NULL(chatRoom.get())) {
+		linphone_core_manager_destroy(marie);
+		return;
+	}
+	BC_ASSERT_EQUAL((int)chatRoom->getParticipants().size(), participantCount, int, "%d");
+
+	string firstDevice;
+	for (const auto &participant : chatRoom->getParticipants()) {
+		for (int j = 0; j < devicesPerParticipant; j++) {
+			IdentityAddress gruu(participant->getAddress());
+			gruu.setGruu("urn:uuid:" + Utils::toString(j));
+			L_GET_PRIVATE(participant)->addDevice(gruu);
+			if (firstDevice.empty())
+				firstDevice = gruu.asString();
+		}
+	}
+
+	// The first computation goes to the LIME database for every device, the following ones are served from the caches.
+	AbstractChatRoom::SecurityLevel level = AbstractChatRoom::SecurityLevel::ClearText;
+	double firstComputation = securityLevelMicroseconds(chatRoom, 1, level);
+	BC_ASSERT_TRUE(level == AbstractChatRoom::SecurityLevel::Encrypted);
+	double cachedComputation = securityLevelMicroseconds(chatRoom, 1000, level);
+	BC_ASSERT_TRUE(level == AbstractChatRoom::SecurityLevel::Encrypted);
+
+	// A trust change on a single device must be reflected at once.
+	unsigned int version = encryptionEngine->getSecurityLevelVersion();
+	linphone_config_set_int(linphone_core_get_config(marie->lc), "lime", "unsafe_if_sas_refused", 1);
+	encryptionEngine->authenticationRejected(firstDevice.c_str());
+	BC_ASSERT_NOT_EQUAL(encryptionEngine->getSecurityLevelVersion(), version, unsigned int, "%u");
+	double afterTrustChange = securityLevelMicroseconds(chatRoom, 1, level);
+	BC_ASSERT_TRUE(level == AbstractChatRoom::SecurityLevel::Unsafe);
+
+	ms_message(
+		"Client group chat room security level with %d devices: first %.1f us, cached %.3f us, after trust change %.1f us",
+		participantCount * devicesPerParticipant, firstComputation, cachedComputation, afterTrustChange
+	);
+
+	chatRoom = nullptr;
+	linphone_core_manager_destroy(marie);
+}
+
 test_t conference_event_tests[] = {
 	TEST_NO_TAG("First notify parsing", first_notify_parsing),
 	TEST_NO_TAG("First notify parsing wrong conf", first_notify_parsing_wrong_conf),
@@ -1352,7 +1812,13 @@ test_t conference_event_tests[] = {
 	TEST_NO_TAG("Send subject changed notify", send_subject_changed_notify),
 	TEST_NO_TAG("Send device added notify", send_device_added_notify),
 	TEST_NO_TAG("Send device removed notify", send_device_removed_notify),
-	TEST_NO_TAG("one-to-one keyword", one_to_one_keyword)
+	TEST_NO_TAG("one-to-one keyword", one_to_one_keyword),
+	TEST_NO_TAG("Notification documents backends", notification_documents_backends),
+	TEST_ONE_TAG("Notification documents parsing benchmark", notification_documents_parsing_benchmark, "Benchmark"),
+	TEST_NO_TAG("Server group chat room queue quotas", server_group_chat_room_queue_quotas),
+	TEST_NO_TAG("Server group chat room queue restart and drain", server_group_chat_room_queue_restart_and_drain),
+	TEST_ONE_TAG("Server group chat room fan-out benchmark", server_group_chat_room_fan_out_benchmark, "Benchmark"),
+	TEST_ONE_TAG("Client group chat room security level benchmark", client_group_chat_room_security_level_benchmark, "Benchmark")
 };
 
 test_suite_t conference_event_test_suite = {
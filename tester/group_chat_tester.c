@@ -438,6 +438,9 @@ LinphoneChatRoom * create_chat_room_client_side_with_expected_number_of_particip
 	BC_ASSERT_TRUE(wait_for_list(lcs, &lcm->stat.number_of_LinphoneChatRoomConferenceJoined, initialStats->number_of_LinphoneChatRoomConferenceJoined + 1, 5000));
 	BC_ASSERT_EQUAL(linphone_chat_room_get_nb_participants(chatRoom),
 		(expectedParticipantSize >= 0) ? expectedParticipantSize : participantsAddressesSize, int, "%d");
+	LinphoneObjectArray *participants = linphone_chat_room_get_participants_array(chatRoom);
+	BC_ASSERT_EQUAL((int)linphone_object_array_get_size(participants), linphone_chat_room_get_nb_participants(chatRoom), int, "%d");
+	linphone_object_array_unref(participants);
 	LinphoneParticipant *participant = linphone_chat_room_get_me(chatRoom);
 	BC_ASSERT_PTR_NOT_NULL(participant);
 	if (participant)
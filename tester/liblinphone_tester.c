@@ -351,11 +351,13 @@ void liblinphone_tester_add_suites() {
 	bc_tester_add_suite(&remote_provisioning_test_suite);
 	bc_tester_add_suite(&quality_reporting_test_suite);
 	bc_tester_add_suite(&log_collection_test_suite);
+	bc_tester_add_suite(&logger_test_suite);
 	bc_tester_add_suite(&player_test_suite);
 	bc_tester_add_suite(&dtmf_test_suite);
 	bc_tester_add_suite(&cpim_test_suite);
 	bc_tester_add_suite(&multipart_test_suite);
 	bc_tester_add_suite(&clonable_object_test_suite);
+	bc_tester_add_suite(&address_test_suite);
 #ifdef HAVE_DB_STORAGE
 	bc_tester_add_suite(&main_db_test_suite);
 #endif
@@ -47,6 +47,7 @@ extern void *system_context;
 #endif
 
 extern test_suite_t account_creator_test_suite;
+extern test_suite_t address_test_suite;
 extern test_suite_t call_test_suite;
 
 #if VIDEO_ENABLED
@@ -66,6 +67,7 @@ extern test_suite_t flexisip_test_suite;
 extern test_suite_t group_chat_test_suite;
 extern test_suite_t secure_group_chat_test_suite;
 extern test_suite_t log_collection_test_suite;
+extern test_suite_t logger_test_suite;
 extern test_suite_t message_test_suite;
 extern test_suite_t session_timers_test_suite;
 extern test_suite_t multi_call_test_suite;
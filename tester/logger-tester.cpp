@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2010-2019 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include <bctoolbox/logging.h>
+
+#include "logger/logger.h"
+
+#include "liblinphone_tester.h"
+#include "tester_utils.h"
+
+// =============================================================================
+
+using namespace std;
+
+using namespace LinphonePrivate;
+
+namespace {
+	int EvaluationCount = 0;
+
+	int countEvaluation () {
+		return ++EvaluationCount;
+	}
+
+	class LogLevelMaskRestorer {
+	public:
+		LogLevelMaskRestorer (unsigned int mask) {
+			mMask = linphone_logging_service_get_log_level_mask(linphone_logging_service_get());
+			linphone_logging_service_set_log_level_mask(linphone_logging_service_get(), mask);
+		}
+
+		~LogLevelMaskRestorer () {
+			linphone_logging_service_set_log_level_mask(linphone_logging_service_get(), mMask);
+		}
+
+	private:
+		unsigned int mMask;
+	};
+
+	// Collects the lines that reach bctoolbox and contain a given marker. The async sink writes from its own
+	// thread, hence the lock.
+	class LogCapture {
+	public:
+		LogCapture (const string &marker) : mMarker(marker) {
+			mHandler = bctbx_create_log_handler(onLogMessage, onDestroy, this);
+			bctbx_add_log_handler(mHandler);
+		}
+
+		~LogCapture () {
+			bctbx_remove_log_handler(mHandler);
+		}
+
+		vector<string> getLines () {
+			lock_guard<mutex> lock(mMutex);
+			return mLines;
+		}
+
+	private:
+		static void onLogMessage (void *info, const char *, BctbxLogLevel, const char *fmt, va_list args) {
+			LogCapture *capture = static_cast<LogCapture *>(info);
+			char *message = bctbx_strdup_vprintf(fmt, args);
+			string line(message);
+			bctbx_free(message);
+			if (line.find(capture->mMarker) == string::npos)
+				return;
+			lock_guard<mutex> lock(capture->mMutex);
+			capture->mLines.push_back(line);
+		}
+
+		static void onDestroy (bctbx_log_handler_t *handler) {
+			bctbx_free(handler);
+		}
+
+		const string mMarker;
+		bctbx_log_handler_t *mHandler;
+		mutex mMutex;
+		vector<string> mLines;
+	};
+
+	long long logLines (int count) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for (int i = 0; i < count; ++i)
+			lInfo() << "Logger benchmark line " << i << " with a pointer " << &count << " and a string " << "abcdefghijklmnopqrstuvwxyz";
+		return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+	}
+}
+
+static void disabled_level_is_not_formatted () {
+	LogLevelMaskRestorer restorer(LinphoneLogLevelError | LinphoneLogLevelFatal);
+	EvaluationCount = 0;
+
+	BC_ASSERT_FALSE(Logger::isEnabled(Logger::Info));
+	lInfo() << "Never formatted: " << countEvaluation();
+	BC_ASSERT_EQUAL(EvaluationCount, 0, int, "%d");
+
+	BC_ASSERT_TRUE(Logger::isEnabled(Logger::Error));
+	lError() << "Formatted: " << countEvaluation();
+	BC_ASSERT_EQUAL(EvaluationCount, 1, int, "%d");
+}
+
+static void log_line_larger_than_inline_buffer () {
+	LogLevelMaskRestorer restorer(LinphoneLogLevelMessage | LinphoneLogLevelWarning | LinphoneLogLevelError | LinphoneLogLevelFatal);
+	const string longString(5000, 'x');
+	vector<string> lines;
+	{
+		LogCapture capture("Long line: ");
+		{
+			Logger logger(Logger::Info);
+			logger.getOutput() << "Long line: " << longString;
+		}
+		lInfo() << "Long line: " << longString << "|" << longString;
+		lines = capture.getLines();
+	}
+
+	if (BC_ASSERT_EQUAL((int)lines.size(), 2, int, "%d")) {
+		BC_ASSERT_STRING_EQUAL(lines[0].c_str(), ("Long line: " + longString).c_str());
+		BC_ASSERT_STRING_EQUAL(lines[1].c_str(), ("Long line: " + longString + "|" + longString).c_str());
+	}
+}
+
+static void async_sink () {
+	LogLevelMaskRestorer restorer(LinphoneLogLevelMessage | LinphoneLogLevelWarning | LinphoneLogLevelError | LinphoneLogLevelFatal);
+	const int count = 100;
+	vector<string> lines;
+	{
+		LogCapture capture("Async line ");
+		BC_ASSERT_FALSE(Logger::asyncSinkEnabled());
+		linphone_logging_service_enable_async_sink(linphone_logging_service_get(), TRUE);
+		BC_ASSERT_TRUE(Logger::asyncSinkEnabled());
+		for (int i = 0; i < count; ++i)
+			lInfo() << "Async line " << i;
+		// Disabling the sink flushes the lines still queued.
+		linphone_logging_service_enable_async_sink(linphone_logging_service_get(), FALSE);
+		BC_ASSERT_FALSE(Logger::asyncSinkEnabled());
+		lInfo() << "Async line " << count << " written synchronously";
+		lines = capture.getLines();
+	}
+
+	if (BC_ASSERT_EQUAL((int)lines.size(), count + 1, int, "%d")) {
+		for (int i = 0; i < count; ++i)
+			BC_ASSERT_STRING_EQUAL(lines[size_t(i)].c_str(), ("Async line " + to_string(i)).c_str());
+		BC_ASSERT_STRING_EQUAL(lines[size_t(count)].c_str(), ("Async line " + to_string(count) + " written synchronously").c_str());
+	}
+}
+
+static void sync_and_async_sink_benchmark () {
+	const int count = 20000;
+	LogLevelMaskRestorer restorer(
+		LinphoneLogLevelMessage | LinphoneLogLevelWarning | LinphoneLogLevelError | LinphoneLogLevelFatal
+	);
+
+	long long syncDuration = logLines(count);
+
+	linphone_logging_service_enable_async_sink(linphone_logging_service_get(), TRUE);
+	long long asyncDuration = logLines(count);
+	linphone_logging_service_enable_async_sink(linphone_logging_service_get(), FALSE);
+
+	long long disabledDuration;
+	{
+		LogLevelMaskRestorer errorsOnly(LinphoneLogLevelError | LinphoneLogLevelFatal);
+		disabledDuration = logLines(count);
+	}
+
+	ms_message(
+		"Logger benchmark (%d lines): sync=%lldus, async=%lldus, disabled level=%lldus",
+		count, syncDuration, asyncDuration, disabledDuration
+	);
+	BC_ASSERT_LOWER(disabledDuration, syncDuration, long long, "%lld");
+}
+
+test_t logger_tests[] = {
+	TEST_NO_TAG("Disabled level is not formatted", disabled_level_is_not_formatted),
+	TEST_NO_TAG("Log line larger than inline buffer", log_line_larger_than_inline_buffer),
+	TEST_NO_TAG("Async sink", async_sink),
+	TEST_ONE_TAG("Sync and async sink benchmark", sync_and_async_sink_benchmark, "Benchmark")
+};
+
+test_suite_t logger_test_suite = {
+	"Logger", NULL, NULL, liblinphone_tester_before_each, liblinphone_tester_after_each,
+	sizeof(logger_tests) / sizeof(logger_tests[0]), logger_tests
+};
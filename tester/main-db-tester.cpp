@@ -18,9 +18,12 @@
  */
 
 #include "address/address.h"
+#include "chat/chat-room/abstract-chat-room.h"
+#include "content/content.h"
 #include "core/core-p.h"
 #include "db/main-db.h"
 #include "event-log/events.h"
+#include "linphone/utils/utils.h"
 
 // TODO: Remove me. <3
 #include "private.h"
@@ -59,6 +62,14 @@ public:
 		return *L_GET_PRIVATE(mCoreManager->lc->cppPtr)->mainDb;
 	}
 
+	MainDb &getWritableMainDb () {
+		return *L_GET_PRIVATE(mCoreManager->lc->cppPtr)->mainDb;
+	}
+
+	shared_ptr<Core> getCore () {
+		return mCoreManager->lc->cppPtr;
+	}
+
 private:
 	LinphoneCoreManager *mCoreManager;
 };
@@ -261,6 +272,164 @@ static void get_chat_rooms() {
 	}
 }
 
+static void server_queued_messages (void) {
+	MainDbProvider provider;
+	MainDb &mainDb = provider.getWritableMainDb();
+	ConferenceId conferenceId(IdentityAddress("sip:test-3@sip.linphone.org"), IdentityAddress("sip:test-1@sip.linphone.org"));
+	IdentityAddress deviceA("sip:test-5@sip.linphone.org;gr=urn:uuid:aaaa");
+	IdentityAddress deviceB("sip:test-6@sip.linphone.org;gr=urn:uuid:bbbb");
+
+	BC_ASSERT_EQUAL(mainDb.getServerQueuedMessageCount(conferenceId), 0, int, "%d");
+
+	time_t now = time(nullptr);
+	long long lastDbId = 0;
+	for (int i = 0; i < 10; i++) {
+		MainDb::ServerQueuedMessage message;
+		message.fromAddress = IdentityAddress("sip:test-4@sip.linphone.org");
+		message.contentType = "text/plain;charset=utf-8";
+		message.body = "Message " + Utils::toString(i);
+		message.headers.emplace_back("Priority", "urgent");
+		message.headers.emplace_back("Expires", "0");
+		message.timestamp = (i == 9) ? now - 3600 : now;
+		long long dbId = mainDb.insertServerQueuedMessage(conferenceId, (i % 2) ? deviceB : deviceA, message);
+		BC_ASSERT_TRUE(dbId > lastDbId);
+		lastDbId = dbId;
+	}
+	BC_ASSERT_EQUAL(mainDb.getServerQueuedMessageCount(conferenceId), 10, int, "%d");
+	BC_ASSERT_EQUAL((int)mainDb.getServerQueuedMessageDevices(conferenceId).size(), 2, int, "%d");
+	BC_ASSERT_EQUAL(mainDb.getServerQueuedMessageCount(conferenceId, deviceA), 5, int, "%d");
+
+	// Batches are returned oldest first and removed once delivered.
+	list<MainDb::ServerQueuedMessage> batch = mainDb.getServerQueuedMessages(conferenceId, deviceA, 3);
+	if (BC_ASSERT_TRUE(batch.size() == 3)) {
+		const MainDb::ServerQueuedMessage &first = batch.front();
+		BC_ASSERT_STRING_EQUAL(first.body.c_str(), "Message 0");
+		BC_ASSERT_STRING_EQUAL(first.contentType.c_str(), "text/plain;charset=utf-8");
+		BC_ASSERT_TRUE(first.fromAddress == IdentityAddress("sip:test-4@sip.linphone.org"));
+		BC_ASSERT_EQUAL((int)first.headers.size(), 2, int, "%d");
+		BC_ASSERT_STRING_EQUAL(first.headers.front().first.c_str(), "Priority");
+		BC_ASSERT_STRING_EQUAL(first.headers.front().second.c_str(), "urgent");
+		BC_ASSERT_STRING_EQUAL(batch.back().body.c_str(), "Message 4");
+		mainDb.deleteServerQueuedMessages(conferenceId, deviceA, batch.back().dbId);
+	}
+	BC_ASSERT_EQUAL(mainDb.getServerQueuedMessageCount(conferenceId, deviceA), 2, int, "%d");
+
+	mainDb.deleteExpiredServerQueuedMessages(conferenceId, now - 60);
+	BC_ASSERT_EQUAL(mainDb.getServerQueuedMessageCount(conferenceId), 6, int, "%d");
+
+	mainDb.deleteServerQueuedMessages(conferenceId, deviceB);
+	BC_ASSERT_EQUAL(mainDb.getServerQueuedMessageCount(conferenceId, deviceB), 0, int, "%d");
+	BC_ASSERT_EQUAL(mainDb.getServerQueuedMessageCount(conferenceId), 2, int, "%d");
+	list<IdentityAddress> devices = mainDb.getServerQueuedMessageDevices(conferenceId);
+	if (BC_ASSERT_TRUE(devices.size() == 1))
+		BC_ASSERT_TRUE(devices.front() == deviceA);
+}
+
+static shared_ptr<EventLog> add_text_message (MainDb &mainDb, const shared_ptr<AbstractChatRoom> &chatRoom, const string &text) {
+	shared_ptr<EventLog> event = make_shared<ConferenceChatMessageEvent>(time(nullptr), chatRoom->createChatMessage(text));
+	BC_ASSERT_TRUE(mainDb.addEvent(event));
+	return event;
+}
+
+static void search_chat_messages (void) {
+	MainDbProvider provider;
+	MainDb &mainDb = provider.getWritableMainDb();
+	shared_ptr<Core> core = provider.getCore();
+	shared_ptr<AbstractChatRoom> roomA = core->getOrCreateBasicChatRoomFromUri("sip:search-a@sip.linphone.org");
+	shared_ptr<AbstractChatRoom> roomB = core->getOrCreateBasicChatRoomFromUri("sip:search-b@sip.linphone.org");
+	if (!BC_ASSERT_TRUE(roomA && roomB))
+		return;
+	const ConferenceId &conferenceIdA = roomA->getConferenceId();
+
+	shared_ptr<EventLog> repeated = add_text_message(mainDb, roomA, "zanzibar zanzibar zanzibar");
+	shared_ptr<EventLog> meeting = add_text_message(mainDb, roomA, "Meet me in Zanzibar tomorrow");
+	add_text_message(mainDb, roomA, "Nothing to see here");
+	shared_ptr<EventLog> flights = add_text_message(mainDb, roomB, "Flights to ZANZIBAR are cheap");
+	add_text_message(mainDb, roomB, "Blue sky");
+
+	BC_ASSERT_EQUAL((int)mainDb.searchChatMessages("zanzibar").size(), 3, int, "%d");
+	BC_ASSERT_EQUAL((int)mainDb.searchChatMessages("zanzibar", conferenceIdA).size(), 2, int, "%d");
+	BC_ASSERT_EQUAL((int)mainDb.searchChatMessages("  ").size(), 0, int, "%d");
+
+	// Words are matched in any order, with or without index.
+	BC_ASSERT_EQUAL((int)mainDb.searchChatMessages("tomorrow ZANZIBAR").size(), 1, int, "%d");
+	BC_ASSERT_EQUAL((int)mainDb.searchChatMessages("zanzibar blue").size(), 0, int, "%d");
+
+	// Most recent first.
+	list<shared_ptr<EventLog>> events = mainDb.searchChatMessages("zanzibar", ConferenceId(), 0, -1, MainDb::SearchOrder::Time);
+	if (BC_ASSERT_TRUE(events.size() == 3)) {
+		BC_ASSERT_TRUE(events.front() == flights);
+		BC_ASSERT_TRUE(events.back() == repeated);
+	}
+
+	// Pagination.
+	events = mainDb.searchChatMessages("zanzibar", ConferenceId(), 1, 2, MainDb::SearchOrder::Time);
+	if (BC_ASSERT_TRUE(events.size() == 1))
+		BC_ASSERT_TRUE(events.front() == meeting);
+	BC_ASSERT_EQUAL((int)mainDb.searchChatMessages("zanzibar", ConferenceId(), 2).size(), 1, int, "%d");
+
+	if (mainDb.isChatMessageSearchIndexed()) {
+		events = mainDb.searchChatMessages("zanzibar", conferenceIdA, 0, -1, MainDb::SearchOrder::Rank);
+		if (BC_ASSERT_TRUE(events.size() == 2))
+			BC_ASSERT_TRUE(events.front() == repeated);
+
+		// The text is never taken as query syntax.
+		BC_ASSERT_EQUAL((int)mainDb.searchChatMessages("zanzibar OR blue").size(), 0, int, "%d");
+		BC_ASSERT_EQUAL((int)mainDb.searchChatMessages("\"zanzibar* AND").size(), 0, int, "%d");
+	}
+
+	// Deleted messages are removed from the index.
+	MainDb::deleteEvent(repeated);
+	BC_ASSERT_EQUAL((int)mainDb.searchChatMessages("zanzibar", conferenceIdA).size(), 1, int, "%d");
+	roomB->deleteHistory();
+	BC_ASSERT_EQUAL((int)mainDb.searchChatMessages("zanzibar").size(), 1, int, "%d");
+}
+
+static void search_chat_messages_benchmark (void) {
+	const int messageCount = 10000;
+	const char *words[] = { "hello", "world", "meeting", "tomorrow", "coffee", "call", "later", "thanks", "see", "you" };
+	const int wordCount = sizeof(words) / sizeof(words[0]);
+
+	MainDbProvider provider;
+	MainDb &mainDb = provider.getWritableMainDb();
+	shared_ptr<AbstractChatRoom> chatRoom = provider.getCore()->getOrCreateBasicChatRoomFromUri("sip:search-benchmark@sip.linphone.org");
+	if (!BC_ASSERT_TRUE(chatRoom != nullptr))
+		return;
+
+	// One message out of 100 contains the searched word.
+	for (int i = 0; i < messageCount; i++) {
+		string text;
+		for (int j = 0; j < 8; j++)
+			text += string(words[(i * 7 + j * 3) % wordCount]) + " ";
+		if (i % 100 == 0)
+			text += "needle";
+		add_text_message(mainDb, chatRoom, text);
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	list<shared_ptr<EventLog>> found = mainDb.searchChatMessages("needle", chatRoom->getConferenceId(), 0, -1, MainDb::SearchOrder::Time);
+	long searchMs = (long)chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+	BC_ASSERT_EQUAL((int)found.size(), messageCount / 100, int, "%d");
+	found.clear();
+
+	// What an application has to do without the search API.
+	start = chrono::steady_clock::now();
+	int scanned = 0;
+	for (const auto &event : mainDb.getHistoryRange(chatRoom->getConferenceId(), 0, -1, MainDb::ConferenceChatMessageFilter)) {
+		for (const auto &content : static_pointer_cast<ConferenceChatMessageEvent>(event)->getChatMessage()->getContents()) {
+			if (content->getBodyAsString().find("needle") != string::npos) {
+				scanned++;
+				break;
+			}
+		}
+	}
+	long scanMs = (long)chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+	BC_ASSERT_EQUAL(scanned, messageCount / 100, int, "%d");
+
+	ms_message("Search in %d messages (%s): %ld ms, history scan: %ld ms",
+		messageCount, mainDb.isChatMessageSearchIndexed() ? "fts5 index" : "no index", searchMs, scanMs);
+}
+
 static void load_a_lot_of_chatrooms(void) {
 	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
 	MainDbProvider provider("db/chatrooms.db");
@@ -280,6 +449,9 @@ test_t main_db_tests[] = {
 	TEST_NO_TAG("Get history", get_history),
 	TEST_NO_TAG("Get conference events", get_conference_notified_events),
 	TEST_NO_TAG("Get chat rooms", get_chat_rooms),
+	TEST_NO_TAG("Server queued messages", server_queued_messages),
+	TEST_NO_TAG("Search chat messages", search_chat_messages),
+	TEST_ONE_TAG("Search chat messages benchmark", search_chat_messages_benchmark, "Benchmark"),
 	TEST_NO_TAG("Load a lot of chatrooms", load_a_lot_of_chatrooms)
 };
 
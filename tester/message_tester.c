@@ -625,6 +625,10 @@ void transfer_message_base2(LinphoneCoreManager* marie, LinphoneCoreManager* pau
 				if (use_file_body_handler_in_download) {
 					linphone_chat_message_set_file_transfer_filepath(recv_msg, receive_filepath);
 				}
+				if (download_error) {
+					/* the download must fail instead of being resumed */
+					linphone_config_set_int(linphone_core_get_config(marie->lc), "misc", "file_transfer_resume_max_attempts", 0);
+				}
 				linphone_chat_message_download_file(recv_msg);
 				BC_ASSERT_EQUAL(marie->stat.number_of_LinphoneMessageFileTransferInProgress, 1, int, "%d");
 
@@ -754,6 +758,62 @@ static void transfer_message_with_download_io_error(void) {
 	transfer_message_base(FALSE, TRUE, FALSE, FALSE, FALSE, TRUE, -1, FALSE);
 }
 
+static void transfer_message_with_download_io_error_resumed(void) {
+	if (!linphone_factory_is_database_storage_available(linphone_factory_get())) {
+		ms_warning("Test skipped, database storage is not available");
+		return;
+	}
+
+	char *send_filepath = bc_tester_res("sounds/sintel_trailer_opus_h264.mkv");
+	char *receive_filepath = bc_tester_file("receive_file.dump");
+	LinphoneChatRoom* chat_room;
+	LinphoneChatMessage* msg;
+	LinphoneCoreManager* marie = linphone_core_manager_new( "marie_rc");
+	LinphoneCoreManager* pauline = linphone_core_manager_new( "pauline_tcp_rc");
+
+	remove(receive_filepath);
+	/* leave some time to restore the network before the download is resumed */
+	linphone_config_set_int(linphone_core_get_config(marie->lc), "misc", "file_transfer_resume_delay", 3000);
+
+	/* Globally configure an http file transfer server. */
+	linphone_core_set_file_transfer_server(pauline->lc, file_transfer_url);
+
+	/* create a chatroom on pauline's side */
+	chat_room = linphone_core_get_chat_room(pauline->lc,marie->identity);
+	msg = create_message_from_sintel_trailer(chat_room);
+	linphone_chat_message_send(msg);
+
+	/* wait for marie to receive pauline's msg */
+	BC_ASSERT_TRUE(wait_for_until(pauline->lc,marie->lc,&marie->stat.number_of_LinphoneMessageReceivedWithFile,1, 60000));
+
+	if (marie->stat.last_received_chat_message ) { /* get last msg and use it to download file */
+		LinphoneChatMessageCbs *cbs = linphone_chat_message_get_callbacks(marie->stat.last_received_chat_message);
+		linphone_chat_message_cbs_set_msg_state_changed(cbs, liblinphone_tester_chat_message_msg_state_changed);
+		linphone_chat_message_cbs_set_file_transfer_recv(cbs, file_transfer_received);
+		linphone_chat_message_cbs_set_file_transfer_progress_indication(cbs, file_transfer_progress_indication);
+		linphone_chat_message_download_file(marie->stat.last_received_chat_message);
+		/* wait for file to be 50% downloaded */
+		BC_ASSERT_TRUE(wait_for(pauline->lc,marie->lc,&marie->stat.progress_of_LinphoneFileTransfer, 50));
+		/* and simulate a network error shorter than the resume delay */
+		belle_http_provider_set_recv_error(linphone_core_get_http_provider(marie->lc), -1);
+		wait_for_until(pauline->lc, marie->lc, NULL, 0, 1000);
+		belle_http_provider_set_recv_error(linphone_core_get_http_provider(marie->lc), 0);
+
+		if (BC_ASSERT_TRUE(wait_for_until(pauline->lc,marie->lc,&marie->stat.number_of_LinphoneFileTransferDownloadSuccessful,1,55000))) {
+			compare_files(send_filepath, receive_filepath);
+		}
+	}
+
+	BC_ASSERT_EQUAL(marie->stat.number_of_LinphoneMessageNotDelivered, 0, int, "%d");
+
+	linphone_chat_message_unref(msg);
+	linphone_core_manager_destroy(marie);
+	linphone_core_manager_destroy(pauline);
+	remove(receive_filepath);
+	bc_free(send_filepath);
+	bc_free(receive_filepath);
+}
+
 static void transfer_message_upload_cancelled(void) {
 	if (transport_supported(LinphoneTransportTls)) {
 		LinphoneCoreManager* marie = linphone_core_manager_new( "marie_rc");
@@ -1822,6 +1882,9 @@ void history_message_count_helper(LinphoneChatRoom* chatroom, int x, int y, unsi
 	bctbx_list_t* messages = linphone_chat_room_get_history_range(chatroom, x, y);
 	BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(messages), expected, unsigned int, "%u");
 	bctbx_list_free_with_data(messages, (void (*)(void *))linphone_chat_message_unref);
+	LinphoneObjectArray *array = linphone_chat_room_get_history_range_array(chatroom, x, y);
+	BC_ASSERT_EQUAL((unsigned int)linphone_object_array_get_size(array), expected, unsigned int, "%u");
+	linphone_object_array_unref(array);
 }
 
 void crash_during_file_transfer(void) {
@@ -2899,6 +2962,84 @@ void unread_message_count_callback(void) {
 	linphone_core_manager_destroy(pauline);
 }
 
+/* Search through the public API, with the full-text index or with the fallback which scans the texts. */
+static void search_messages_base(bool_t indexed) {
+	if (!linphone_factory_is_database_storage_available(linphone_factory_get())) {
+		ms_warning("Test skipped, database storage is not available");
+		return;
+	}
+
+	const char *texts[] = { "zanzibar zanzibar zanzibar", "Nothing to see here", "Meet me in Zanzibar tomorrow" };
+	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
+	LinphoneCoreManager *pauline = linphone_core_manager_create("pauline_tcp_rc");
+	LinphoneChatRoom *marie_room;
+	LinphoneChatRoom *pauline_room;
+	LinphoneChatRoom *other_room;
+	LinphoneChatMessage *msg;
+	bctbx_list_t *events;
+	size_t i;
+
+	linphone_config_set_int(linphone_core_get_config(pauline->lc), "storage", "chat_message_search_index", indexed);
+	linphone_core_manager_start(pauline, TRUE);
+
+	marie_room = linphone_core_get_chat_room(marie->lc, pauline->identity);
+	for (i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+		msg = linphone_chat_room_create_message(marie_room, texts[i]);
+		linphone_chat_message_send(msg);
+		linphone_chat_message_unref(msg);
+		BC_ASSERT_TRUE(wait_for(pauline->lc, marie->lc, &pauline->stat.number_of_LinphoneMessageReceived, (int)i + 1));
+	}
+	pauline_room = linphone_core_get_chat_room(pauline->lc, marie->identity);
+
+	/* A message of another chat room, only found by the core-wide search. */
+	other_room = linphone_core_get_chat_room_from_uri(pauline->lc, "sip:nobody@sip.example.org");
+	msg = linphone_chat_room_create_message(other_room, "Flights to ZANZIBAR are cheap");
+	linphone_chat_message_send(msg);
+	linphone_chat_message_unref(msg);
+
+	events = linphone_chat_room_search_messages(pauline_room, "zanzibar", 0, -1);
+	if (BC_ASSERT_TRUE(bctbx_list_size(events) == 2) && !indexed) {
+		/* Without index, the most recent messages come first. */
+		LinphoneChatMessage *first = linphone_event_log_get_chat_message((LinphoneEventLog *)bctbx_list_get_data(events));
+		BC_ASSERT_STRING_EQUAL(linphone_chat_message_get_text_content(first), texts[2]);
+	}
+	bctbx_list_free_with_data(events, (bctbx_list_free_func)linphone_event_log_unref);
+
+	/* Every word must be found, in any order. */
+	events = linphone_chat_room_search_messages(pauline_room, "TOMORROW zanzibar", 0, -1);
+	if (BC_ASSERT_TRUE(bctbx_list_size(events) == 1)) {
+		LinphoneChatMessage *found = linphone_event_log_get_chat_message((LinphoneEventLog *)bctbx_list_get_data(events));
+		BC_ASSERT_STRING_EQUAL(linphone_chat_message_get_text_content(found), texts[2]);
+	}
+	bctbx_list_free_with_data(events, (bctbx_list_free_func)linphone_event_log_unref);
+	events = linphone_chat_room_search_messages(pauline_room, "zanzibar cheap", 0, -1);
+	BC_ASSERT_EQUAL((int)bctbx_list_size(events), 0, int, "%d");
+	bctbx_list_free_with_data(events, (bctbx_list_free_func)linphone_event_log_unref);
+
+	/* Pagination. */
+	events = linphone_chat_room_search_messages(pauline_room, "zanzibar", 1, -1);
+	BC_ASSERT_EQUAL((int)bctbx_list_size(events), 1, int, "%d");
+	bctbx_list_free_with_data(events, (bctbx_list_free_func)linphone_event_log_unref);
+
+	events = linphone_core_search_chat_messages(pauline->lc, "zanzibar", 0, -1);
+	BC_ASSERT_EQUAL((int)bctbx_list_size(events), 3, int, "%d");
+	bctbx_list_free_with_data(events, (bctbx_list_free_func)linphone_event_log_unref);
+	events = linphone_core_search_chat_messages(pauline->lc, "zanzibar cheap", 0, 1);
+	BC_ASSERT_EQUAL((int)bctbx_list_size(events), 1, int, "%d");
+	bctbx_list_free_with_data(events, (bctbx_list_free_func)linphone_event_log_unref);
+
+	linphone_core_manager_destroy(marie);
+	linphone_core_manager_destroy(pauline);
+}
+
+static void search_messages(void) {
+	search_messages_base(TRUE);
+}
+
+static void search_messages_without_index(void) {
+	search_messages_base(FALSE);
+}
+
 static void migration_from_messages_db (void) {
 	if (!linphone_factory_is_database_storage_available(linphone_factory_get())) {
 		ms_warning("Test skipped, database storage is not available");
@@ -2947,6 +3088,7 @@ test_t message_tests[] = {
 	TEST_NO_TAG("Transfer message with http proxy", file_transfer_with_http_proxy),
 	TEST_NO_TAG("Transfer message with upload io error", transfer_message_with_upload_io_error),
 	TEST_NO_TAG("Transfer message with download io error", transfer_message_with_download_io_error),
+	TEST_NO_TAG("Transfer message with download io error resumed", transfer_message_with_download_io_error_resumed),
 	TEST_NO_TAG("Transfer message upload cancelled", transfer_message_upload_cancelled),
 	TEST_NO_TAG("Transfer message download cancelled", transfer_message_download_cancelled),
 	TEST_NO_TAG("Transfer 2 messages simultaneously", file_transfer_2_messages_simultaneously),
@@ -3013,7 +3155,9 @@ test_t message_tests[] = {
 	TEST_NO_TAG("Crash during file transfer", crash_during_file_transfer),
 	TEST_NO_TAG("Text status after destroying chat room", text_status_after_destroying_chat_room),
 	TEST_NO_TAG("Transfer success after destroying chatroom", file_transfer_success_after_destroying_chatroom),
-	TEST_NO_TAG("Migration from messages db", migration_from_messages_db)
+	TEST_NO_TAG("Migration from messages db", migration_from_messages_db),
+	TEST_NO_TAG("Search messages", search_messages),
+	TEST_NO_TAG("Search messages without index", search_messages_without_index)
 };
 
 static int message_tester_before_suite(void) {
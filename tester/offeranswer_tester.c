@@ -88,6 +88,8 @@ static void simple_call_with_different_codec_mappings(void) {
 	BC_ASSERT_PTR_NOT_NULL(pauline_call);
 	if (pauline_call){
 		LinphoneCallParams *params;
+		unsigned int offer_answer_time = linphone_call_get_offer_answer_time(pauline_call);
+		BC_ASSERT_GREATER(offer_answer_time, 1, unsigned int, "%u");
 		check_payload_type_numbers(linphone_core_get_current_call(marie->lc), pauline_call, 104);
 		/*make a reinvite in the other direction*/
 		linphone_call_update(pauline_call,
@@ -99,6 +101,8 @@ static void simple_call_with_different_codec_mappings(void) {
 		BC_ASSERT_TRUE(wait_for(pauline->lc,marie->lc,&marie->stat.number_of_LinphoneCallStreamsRunning,2));
 		/*payload type numbers shall remain the same*/
 		check_payload_type_numbers(linphone_core_get_current_call(marie->lc), pauline_call, 104);
+		/*the negotiation of the reinvite is added to the one of the call*/
+		BC_ASSERT_GREATER(linphone_call_get_offer_answer_time(pauline_call), offer_answer_time, unsigned int, "%u");
 	}
 
 	end_call(marie,pauline);
@@ -784,6 +788,264 @@ end:
 }
 #endif
 
+static PayloadType *create_sdp_payload_type(const char *mime_type, int clock_rate, int number, const char *fmtp) {
+	PayloadType *pt = payload_type_new();
+	pt->mime_type = ms_strdup(mime_type);
+	pt->clock_rate = clock_rate;
+	payload_type_set_number(pt, number);
+	if (fmtp) payload_type_set_recv_fmtp(pt, fmtp);
+	return pt;
+}
+
+static SalMediaDescription *create_sdp_media_description(int nb_streams) {
+	SalMediaDescription *md = sal_media_description_new();
+	int i, j;
+
+	strcpy(md->addr, "192.168.1.10");
+	strcpy(md->username, "marie");
+	md->session_id = 1234;
+	md->session_ver = 1;
+	strcpy(md->ice_ufrag, "f1b2c3d4");
+	strcpy(md->ice_pwd, "0123456789abcdef01234567");
+	md->nb_streams = nb_streams;
+	for (i = 0; i < nb_streams; i++) {
+		SalStreamDescription *sd = &md->streams[i];
+		sd->type = (i % 2 == 0) ? SalAudio : SalVideo;
+		sd->proto = SalProtoRtpAvpf;
+		sd->dir = SalStreamSendRecv;
+		strcpy(sd->rtp_addr, md->addr);
+		strcpy(sd->rtcp_addr, md->addr);
+		sd->rtp_port = 7078 + 2 * i;
+		sd->rtcp_port = sd->rtp_port + 1;
+		sd->rtcp_mux = TRUE;
+		snprintf(sd->mid, sizeof(sd->mid), "m%d", i);
+		if (sd->type == SalAudio) {
+			sd->payloads = bctbx_list_append(sd->payloads, create_sdp_payload_type("opus", 48000, 96, "useinbandfec=1"));
+			sd->payloads = bctbx_list_append(sd->payloads, create_sdp_payload_type("PCMU", 8000, 0, NULL));
+			sd->payloads = bctbx_list_append(sd->payloads, create_sdp_payload_type("telephone-event", 8000, 101, NULL));
+			sd->ptime = 20;
+		} else {
+			sd->payloads = bctbx_list_append(sd->payloads, create_sdp_payload_type("VP8", 90000, 97, NULL));
+			sd->payloads = bctbx_list_append(sd->payloads, create_sdp_payload_type("H264", 90000, 98, "profile-level-id=42801F;packetization-mode=1"));
+		}
+		for (j = 0; j < 4; j++) {
+			SalIceCandidate *candidate = &sd->ice_candidates[j];
+			snprintf(candidate->addr, sizeof(candidate->addr), "192.168.1.%d", 10 + j);
+			snprintf(candidate->foundation, sizeof(candidate->foundation), "%d", j + 1);
+			strcpy(candidate->type, "host");
+			candidate->componentID = 1;
+			candidate->priority = 2130706431 - (unsigned int)j;
+			candidate->port = sd->rtp_port;
+		}
+	}
+	return md;
+}
+
+static void sdp_media_description_hash(void) {
+	SalMediaDescription *md = create_sdp_media_description(3);
+	SalMediaDescription *same_md = create_sdp_media_description(3);
+	SalMediaDescription *parsed_md;
+	char *sdp = sal_media_description_to_sdp_string(md);
+
+	BC_ASSERT_TRUE(sal_media_description_hash(md) == sal_media_description_hash(same_md));
+	BC_ASSERT_EQUAL(sal_media_description_equals(md, same_md), SAL_MEDIA_DESCRIPTION_UNCHANGED, int, "%d");
+	BC_ASSERT_EQUAL(sal_media_description_equals(md, md), SAL_MEDIA_DESCRIPTION_UNCHANGED, int, "%d");
+
+	/* Bytes left after the end of a string are not part of the SDP. */
+	strcpy(same_md->streams[1].ice_pwd, "ignoredpassword");
+	same_md->streams[1].ice_pwd[0] = '\0';
+	BC_ASSERT_TRUE(sal_media_description_hash(md) == sal_media_description_hash(same_md));
+
+	parsed_md = sal_media_description_from_sdp_string(sdp);
+	if (BC_ASSERT_PTR_NOT_NULL(parsed_md)) {
+		BC_ASSERT_EQUAL(parsed_md->nb_streams, 3, int, "%d");
+		BC_ASSERT_EQUAL(parsed_md->streams[2].rtp_port, md->streams[2].rtp_port, int, "%d");
+		BC_ASSERT_EQUAL((int)bctbx_list_size(parsed_md->streams[0].payloads), 3, int, "%d");
+		sal_media_description_unref(parsed_md);
+	}
+
+	same_md->streams[2].rtp_port++;
+	BC_ASSERT_FALSE(sal_media_description_hash(md) == sal_media_description_hash(same_md));
+	same_md->streams[2].rtp_port--;
+	payload_type_set_recv_fmtp((PayloadType *)same_md->streams[0].payloads->data, "useinbandfec=0");
+	BC_ASSERT_FALSE(sal_media_description_hash(md) == sal_media_description_hash(same_md));
+	payload_type_set_recv_fmtp((PayloadType *)same_md->streams[0].payloads->data, "useinbandfec=1");
+	payload_type_set_flag((PayloadType *)same_md->streams[1].payloads->data, PAYLOAD_TYPE_RTCP_FEEDBACK_ENABLED);
+	BC_ASSERT_FALSE(sal_media_description_hash(md) == sal_media_description_hash(same_md));
+	payload_type_unset_flag((PayloadType *)same_md->streams[1].payloads->data, PAYLOAD_TYPE_RTCP_FEEDBACK_ENABLED);
+	BC_ASSERT_TRUE(sal_media_description_hash(md) == sal_media_description_hash(same_md));
+	same_md->session_ver++;
+	BC_ASSERT_FALSE(sal_media_description_hash(md) == sal_media_description_hash(same_md));
+
+	bctbx_free(sdp);
+	sal_media_description_unref(same_md);
+	sal_media_description_unref(md);
+}
+
+static PayloadType *create_oa_payload_type(const char *mime_type, int clock_rate, int channels, int number, const char *fmtp) {
+	PayloadType *pt = create_sdp_payload_type(mime_type, clock_rate, number, fmtp);
+	pt->channels = channels;
+	return pt;
+}
+
+static SalMediaDescription *create_oa_media_description(bctbx_list_t *payloads) {
+	SalMediaDescription *md = sal_media_description_new();
+	SalStreamDescription *sd = &md->streams[0];
+
+	strcpy(md->addr, "127.0.0.1");
+	md->nb_streams = 1;
+	sd->type = SalAudio;
+	sd->proto = SalProtoRtpAvp;
+	sd->dir = SalStreamSendRecv;
+	strcpy(sd->rtp_addr, md->addr);
+	strcpy(sd->rtcp_addr, md->addr);
+	sd->rtp_port = 7078;
+	sd->rtcp_port = 7079;
+	sd->payloads = payloads;
+	return md;
+}
+
+static void check_oa_payload_type(const bctbx_list_t *payloads, int position, const char *mime_type, int clock_rate, int channels, int number, int flags) {
+	const PayloadType *pt = (const PayloadType *)bctbx_list_nth_data(payloads, position);
+	if (!BC_ASSERT_PTR_NOT_NULL(pt)) return;
+	BC_ASSERT_STRING_EQUAL(pt->mime_type, mime_type);
+	BC_ASSERT_EQUAL(pt->clock_rate, clock_rate, int, "%d");
+	BC_ASSERT_EQUAL(pt->channels, channels, int, "%d");
+	BC_ASSERT_EQUAL(payload_type_get_number(pt), number, int, "%d");
+	BC_ASSERT_EQUAL(payload_type_get_flags(pt) & (PAYLOAD_TYPE_FLAG_CAN_SEND | PAYLOAD_TYPE_FLAG_CAN_RECV), flags, int, "%d");
+}
+
+/* Checks the payload types negotiated by the offer/answer functions themselves, independently of any call. */
+static void offer_answer_payload_matching(void) {
+	LinphoneCoreManager *mgr = linphone_core_manager_new2("empty_rc", FALSE);
+	MSFactory *factory = linphone_core_get_ms_factory(mgr->lc);
+	const int send_recv = PAYLOAD_TYPE_FLAG_CAN_SEND | PAYLOAD_TYPE_FLAG_CAN_RECV;
+	SalMediaDescription *local, *remote, *result;
+	const bctbx_list_t *payloads;
+
+	/* Answering: mime types are compared case insensitively, clock rate and channels must be equal, the first local
+	 * payload type wins and the answer uses the numbers of the offer. */
+	local = create_oa_media_description(NULL);
+	local->streams[0].payloads = bctbx_list_append(local->streams[0].payloads, create_oa_payload_type("PCMU", 8000, 1, 0, NULL));
+	local->streams[0].payloads = bctbx_list_append(local->streams[0].payloads, create_oa_payload_type("L16", 44100, 1, 110, "mono"));
+	local->streams[0].payloads = bctbx_list_append(local->streams[0].payloads, create_oa_payload_type("L16", 44100, 2, 111, "first"));
+	local->streams[0].payloads = bctbx_list_append(local->streams[0].payloads, create_oa_payload_type("L16", 44100, 2, 112, "second"));
+	local->streams[0].payloads = bctbx_list_append(local->streams[0].payloads, create_oa_payload_type("telephone-event", 8000, 1, 101, NULL));
+	remote = create_oa_media_description(NULL);
+	remote->streams[0].payloads = bctbx_list_append(remote->streams[0].payloads, create_oa_payload_type("speex", 16000, 1, 97, NULL));
+	remote->streams[0].payloads = bctbx_list_append(remote->streams[0].payloads, create_oa_payload_type("pcmu", 8000, 1, 0, NULL));
+	remote->streams[0].payloads = bctbx_list_append(remote->streams[0].payloads, create_oa_payload_type("L16", 22050, 2, 99, NULL));
+	remote->streams[0].payloads = bctbx_list_append(remote->streams[0].payloads, create_oa_payload_type("L16", 44100, 2, 100, NULL));
+	remote->streams[0].payloads = bctbx_list_append(remote->streams[0].payloads, create_oa_payload_type("telephone-event", 8000, 1, 102, NULL));
+
+	result = sal_media_description_new();
+	offer_answer_initiate_incoming(factory, local, remote, result, FALSE);
+	payloads = result->streams[0].payloads;
+	BC_ASSERT_EQUAL((int)bctbx_list_size(payloads), 3, int, "%d");
+	check_oa_payload_type(payloads, 0, "PCMU", 8000, 1, 0, send_recv);
+	check_oa_payload_type(payloads, 1, "L16", 44100, 2, 100, send_recv);
+	if (bctbx_list_size(payloads) > 1)
+		BC_ASSERT_STRING_EQUAL(((const PayloadType *)bctbx_list_nth_data(payloads, 1))->recv_fmtp, "first");
+	check_oa_payload_type(payloads, 2, "telephone-event", 8000, 1, 102, send_recv);
+	BC_ASSERT_GREATER(result->streams[0].rtp_port, 0, int, "%d");
+	sal_media_description_unref(result);
+
+	/* Only the first real codec is kept, telephone-event still is. */
+	result = sal_media_description_new();
+	offer_answer_initiate_incoming(factory, local, remote, result, TRUE);
+	payloads = result->streams[0].payloads;
+	BC_ASSERT_EQUAL((int)bctbx_list_size(payloads), 2, int, "%d");
+	check_oa_payload_type(payloads, 0, "PCMU", 8000, 1, 0, send_recv);
+	check_oa_payload_type(payloads, 1, "telephone-event", 8000, 1, 102, send_recv);
+	sal_media_description_unref(result);
+	sal_media_description_unref(remote);
+	sal_media_description_unref(local);
+
+	/* Reading an answer: a payload type answered with another number is also kept with the local number to receive
+	 * it, and the local payload types that aren't used are added for compatibility, once per number. Unnumbered
+	 * payload types share the -1 number, so only the first one is added. */
+	local = create_oa_media_description(NULL);
+	local->streams[0].payloads = bctbx_list_append(local->streams[0].payloads, create_oa_payload_type("PCMU", 8000, 1, 0, NULL));
+	local->streams[0].payloads = bctbx_list_append(local->streams[0].payloads, create_oa_payload_type("PCMA", 8000, 1, 8, NULL));
+	local->streams[0].payloads = bctbx_list_append(local->streams[0].payloads, create_oa_payload_type("G722", 8000, 1, -1, NULL));
+	local->streams[0].payloads = bctbx_list_append(local->streams[0].payloads, create_oa_payload_type("GSM", 8000, 1, -1, NULL));
+	local->streams[0].payloads = bctbx_list_append(local->streams[0].payloads, create_oa_payload_type("telephone-event", 8000, 1, 101, NULL));
+	remote = create_oa_media_description(NULL);
+	remote->streams[0].payloads = bctbx_list_append(remote->streams[0].payloads, create_oa_payload_type("PCMU", 8000, 1, 0, NULL));
+	remote->streams[0].payloads = bctbx_list_append(remote->streams[0].payloads, create_oa_payload_type("telephone-event", 8000, 1, 110, NULL));
+
+	result = sal_media_description_new();
+	offer_answer_initiate_outgoing(factory, local, remote, result);
+	payloads = result->streams[0].payloads;
+	BC_ASSERT_EQUAL((int)bctbx_list_size(payloads), 5, int, "%d");
+	check_oa_payload_type(payloads, 0, "PCMU", 8000, 1, 0, send_recv);
+	check_oa_payload_type(payloads, 1, "telephone-event", 8000, 1, 110, send_recv);
+	check_oa_payload_type(payloads, 2, "telephone-event", 8000, 1, 101, send_recv);
+	check_oa_payload_type(payloads, 3, "PCMA", 8000, 1, 8, PAYLOAD_TYPE_FLAG_CAN_RECV);
+	check_oa_payload_type(payloads, 4, "G722", 8000, 1, -1, PAYLOAD_TYPE_FLAG_CAN_RECV);
+	sal_media_description_unref(result);
+	sal_media_description_unref(remote);
+	sal_media_description_unref(local);
+
+	linphone_core_manager_destroy(mgr);
+}
+
+static long long sdp_benchmark_elapsed_us(const MSTimeSpec *start) {
+	MSTimeSpec end;
+	ms_get_cur_time(&end);
+	return ((end.tv_sec - start->tv_sec) * 1000000LL) + ((end.tv_nsec - start->tv_nsec) / 1000LL);
+}
+
+static void sdp_generation_and_parsing_benchmark(void) {
+	const int nb_streams[] = { 2, 4, 8 };
+	const int nb_iterations = 2000;
+	size_t k;
+	int i;
+
+	for (k = 0; k < sizeof(nb_streams) / sizeof(nb_streams[0]); k++) {
+		SalMediaDescription *md = create_sdp_media_description(nb_streams[k]);
+		SalMediaDescription *other_md = create_sdp_media_description(nb_streams[k]);
+		char *sdp = sal_media_description_to_sdp_string(md);
+		long long generation_us, parsing_us, hash_us, equals_us;
+		uint64_t hash = 0;
+		int diff = 0;
+		MSTimeSpec start;
+
+		liblinphone_tester_clock_start(&start);
+		for (i = 0; i < nb_iterations; i++)
+			bctbx_free(sal_media_description_to_sdp_string(md));
+		generation_us = sdp_benchmark_elapsed_us(&start);
+
+		liblinphone_tester_clock_start(&start);
+		for (i = 0; i < nb_iterations; i++) {
+			SalMediaDescription *parsed_md = sal_media_description_from_sdp_string(sdp);
+			if (parsed_md) sal_media_description_unref(parsed_md);
+		}
+		parsing_us = sdp_benchmark_elapsed_us(&start);
+
+		/* What a session refresh costs when its SDP is taken from the cache. */
+		liblinphone_tester_clock_start(&start);
+		for (i = 0; i < nb_iterations; i++)
+			hash ^= sal_media_description_hash(md);
+		hash_us = sdp_benchmark_elapsed_us(&start);
+
+		liblinphone_tester_clock_start(&start);
+		for (i = 0; i < nb_iterations; i++)
+			diff |= sal_media_description_equals(md, other_md);
+		equals_us = sdp_benchmark_elapsed_us(&start);
+
+		BC_ASSERT_EQUAL(diff, SAL_MEDIA_DESCRIPTION_UNCHANGED, int, "%d");
+		ms_message("SDP with %d streams (%d bytes, hash %llx), per operation: generation=%lldns, parsing=%lldns, hash=%lldns, equals=%lldns",
+			nb_streams[k], (int)strlen(sdp), (unsigned long long)hash,
+			generation_us * 1000LL / nb_iterations, parsing_us * 1000LL / nb_iterations,
+			hash_us * 1000LL / nb_iterations, equals_us * 1000LL / nb_iterations);
+
+		bctbx_free(sdp);
+		sal_media_description_unref(other_md);
+		sal_media_description_unref(md);
+	}
+}
+
 static test_t offeranswer_tests[] = {
 	TEST_NO_TAG("Start with no config", start_with_no_config),
 	TEST_NO_TAG("Call failed because of codecs", call_failed_because_of_codecs),
@@ -838,7 +1100,10 @@ static test_t offeranswer_tests[] = {
 	TEST_NO_TAG("H264 packetization-mode set to 1 on sender", h264_call_with_fmtps),
 	TEST_NO_TAG("H264 on sender, but not on receiver", h264_call_receiver_with_no_h264_support),
 	TEST_NO_TAG("H264 packetization-mode not set", h264_call_without_packetization_mode),
-	TEST_NO_TAG("Mixed AVP+AVPF video call", avp_avpf_video_call)
+	TEST_NO_TAG("Mixed AVP+AVPF video call", avp_avpf_video_call),
+	TEST_NO_TAG("SDP media description hash", sdp_media_description_hash),
+	TEST_NO_TAG("Offer answer payload matching", offer_answer_payload_matching),
+	TEST_ONE_TAG("SDP generation and parsing benchmark", sdp_generation_and_parsing_benchmark, "Benchmark")
 #endif
 };
 
@@ -297,6 +297,76 @@ static void quality_reporting_interval_report (void) {
 	linphone_core_manager_destroy(pauline);
 }
 
+static void quality_reporting_interval_report_batched (void) {
+	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc_rtcp_xr");
+	LinphoneCoreManager *pauline = linphone_core_manager_new("pauline_rc_rtcp_xr");
+	LinphoneCall *call_marie = NULL;
+	LinphoneCall *call_pauline = NULL;
+	reporting_stats_t stats;
+
+	lp_config_set_string(linphone_core_get_config(marie->lc), "quality_reporting", "mode", "batch");
+	lp_config_set_int(linphone_core_get_config(marie->lc), "quality_reporting", "batch_max_reports", 2);
+	lp_config_set_int(linphone_core_get_config(marie->lc), "quality_reporting", "batch_delay", 60);
+
+	if (create_call_for_quality_reporting_tests(marie, pauline, &call_marie, &call_pauline, NULL, NULL)) {
+		linphone_reporting_set_on_report_send(call_marie, on_report_send_mandatory);
+		linphone_proxy_config_set_quality_reporting_interval(linphone_call_get_dest_proxy(call_marie), 1);
+
+		// Two interval reports are sent in a single PUBLISH
+		BC_ASSERT_TRUE(wait_for_until(marie->lc, pauline->lc, &marie->stat.number_of_LinphonePublishOk, 1, 60000));
+		stats = linphone_reporting_get_stats(marie->lc);
+		BC_ASSERT_EQUAL(stats.batched, 2, unsigned int, "%u");
+		BC_ASSERT_EQUAL(stats.publishes, 1, unsigned int, "%u");
+		BC_ASSERT_GREATER(stats.produced, 2, unsigned int, "%u");
+		BC_ASSERT_EQUAL(stats.dropped, 0, unsigned int, "%u");
+		end_call(marie, pauline);
+	}
+
+	linphone_core_manager_destroy(marie);
+	linphone_core_manager_destroy(pauline);
+}
+
+static void quality_reporting_interval_report_to_file (void) {
+	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc_rtcp_xr");
+	LinphoneCoreManager *pauline = linphone_core_manager_new("pauline_rc_rtcp_xr");
+	LinphoneCall *call_marie = NULL;
+	LinphoneCall *call_pauline = NULL;
+	char *report_file = bc_tester_file("quality_reports.txt");
+	reporting_stats_t stats;
+
+	unlink(report_file);
+	lp_config_set_string(linphone_core_get_config(marie->lc), "quality_reporting", "mode", "file");
+	lp_config_set_string(linphone_core_get_config(marie->lc), "quality_reporting", "file", report_file);
+
+	if (create_call_for_quality_reporting_tests(marie, pauline, &call_marie, &call_pauline, NULL, NULL)) {
+		FILE *f;
+		char content[4096] = { 0 };
+
+		linphone_reporting_set_on_report_send(call_marie, on_report_send_mandatory);
+		linphone_proxy_config_set_quality_reporting_interval(linphone_call_get_dest_proxy(call_marie), 1);
+		wait_for_until(marie->lc, pauline->lc, NULL, 0, 3000);
+
+		// Reports are written locally, nothing is published
+		stats = linphone_reporting_get_stats(marie->lc);
+		BC_ASSERT_GREATER(stats.produced, 1, unsigned int, "%u");
+		BC_ASSERT_EQUAL(stats.publishes, 0, unsigned int, "%u");
+		BC_ASSERT_EQUAL(marie->stat.number_of_LinphonePublishProgress, 0, int, "%d");
+
+		f = fopen(report_file, "r");
+		if (BC_ASSERT_PTR_NOT_NULL(f)) {
+			BC_ASSERT_GREATER(fread(content, 1, sizeof(content) - 1, f), 0, size_t, "%zu");
+			BC_ASSERT_PTR_NOT_NULL(strstr(content, "VQIntervalReport\r\n"));
+			fclose(f);
+		}
+		end_call(marie, pauline);
+	}
+
+	linphone_core_manager_destroy(marie);
+	linphone_core_manager_destroy(pauline);
+	unlink(report_file);
+	bc_free(report_file);
+}
+
 #ifdef VIDEO_ENABLED
 static void quality_reporting_session_report_if_video_stopped (void) {
 	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc_rtcp_xr");
@@ -497,6 +567,8 @@ test_t quality_reporting_tests[] = {
 	TEST_NO_TAG("Call term session report invalid if missing mandatory fields", quality_reporting_invalid_report),
 	TEST_NO_TAG("Call term session report sent if call ended normally", quality_reporting_at_call_termination),
 	TEST_NO_TAG("Interval report if interval is configured", quality_reporting_interval_report),
+	TEST_NO_TAG("Interval reports batched in a single PUBLISH", quality_reporting_interval_report_batched),
+	TEST_NO_TAG("Interval reports written to a file", quality_reporting_interval_report_to_file),
 	#ifdef VIDEO_ENABLED
 		TEST_NO_TAG("Interval report if interval is configured with video and realtime text", quality_reporting_interval_report_video_and_rtt),
 		TEST_NO_TAG("Session report sent if video stopped during call", quality_reporting_session_report_if_video_stopped),
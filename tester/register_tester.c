@@ -21,6 +21,7 @@
 #include "linphone/core.h"
 #include "liblinphone_tester.h"
 #include "tester_utils.h"
+#include "belle-sip/belle-sip.h"
 
 
 static void authentication_requested(LinphoneCore *lc, LinphoneAuthInfo *auth_info, LinphoneAuthMethod method) {
@@ -1478,6 +1479,409 @@ static void register_with_specific_client_port(void){
 #endif
 }
 
+/* Minimal registrar challenging then accepting every REGISTER, used as a local stand-in for a SIP server.
+ * It listens on the stack of the core under test, so that iterating the core also serves the registrar. */
+typedef struct _LocalRegistrar {
+	belle_sip_provider_t *provider;
+	belle_sip_listener_t *listener;
+	belle_sip_listening_point_t *listening_point;
+	int port;
+	int challenged;
+	int registered;
+	/* when set, that many challenges are held back then sent together */
+	int grouped_challenges;
+	bctbx_list_t *held_challenges;
+	/* REGISTERs of this user are answered 503, the time they were received is recorded */
+	const char *unavailable_user;
+	uint64_t unavailable_times[8];
+	int unavailable_count;
+	int min_expires;
+} LocalRegistrar;
+
+static bool_t local_registrar_is_from_user(belle_sip_request_t *request, const char *user) {
+	belle_sip_header_from_t *from = belle_sip_message_get_header_by_type(request, belle_sip_header_from_t);
+	const char *from_user = from ? belle_sip_uri_get_user(belle_sip_header_address_get_uri(BELLE_SIP_HEADER_ADDRESS(from))) : NULL;
+	return from_user && strcmp(from_user, user) == 0;
+}
+
+static void local_registrar_process_request_event(void *user_ctx, const belle_sip_request_event_t *event) {
+	LocalRegistrar *registrar = (LocalRegistrar *)user_ctx;
+	belle_sip_request_t *request = belle_sip_request_event_get_request(event);
+	belle_sip_response_t *response;
+
+	if (strcmp(belle_sip_request_get_method(request), "REGISTER") != 0) {
+		response = belle_sip_response_create_from_request(request, 405);
+	} else if (registrar->unavailable_user && local_registrar_is_from_user(request, registrar->unavailable_user)) {
+		response = belle_sip_response_create_from_request(request, 503);
+		if (registrar->unavailable_count < (int)(sizeof(registrar->unavailable_times) / sizeof(registrar->unavailable_times[0])))
+			registrar->unavailable_times[registrar->unavailable_count] = ortp_get_cur_time_ms();
+		registrar->unavailable_count++;
+	} else if (!belle_sip_message_get_header(BELLE_SIP_MESSAGE(request), "Authorization")) {
+		response = belle_sip_response_create_from_request(request, 401);
+		belle_sip_message_add_header(BELLE_SIP_MESSAGE(response), BELLE_SIP_HEADER(belle_sip_header_www_authenticate_parse(
+			"WWW-Authenticate: Digest realm=\"bench.example.org\", nonce=\"bench\", algorithm=MD5"
+		)));
+		registrar->challenged++;
+		if (registrar->grouped_challenges > 0) {
+			registrar->held_challenges = bctbx_list_append(registrar->held_challenges, belle_sip_object_ref(response));
+			if ((int)bctbx_list_size(registrar->held_challenges) < registrar->grouped_challenges) return;
+			for (const bctbx_list_t *it = registrar->held_challenges; it != NULL; it = bctbx_list_next(it))
+				belle_sip_provider_send_response(registrar->provider, (belle_sip_response_t *)bctbx_list_get_data(it));
+			registrar->held_challenges = bctbx_list_free_with_data(registrar->held_challenges, belle_sip_object_unref);
+			return;
+		}
+	} else {
+		belle_sip_header_contact_t *contact = belle_sip_message_get_header_by_type(request, belle_sip_header_contact_t);
+		belle_sip_header_expires_t *expires = belle_sip_message_get_header_by_type(request, belle_sip_header_expires_t);
+		response = belle_sip_response_create_from_request(request, 200);
+		if (contact)
+			belle_sip_message_add_header(BELLE_SIP_MESSAGE(response), BELLE_SIP_HEADER(belle_sip_object_clone(BELLE_SIP_OBJECT(contact))));
+		if (expires) {
+			belle_sip_message_add_header(BELLE_SIP_MESSAGE(response), BELLE_SIP_HEADER(belle_sip_object_clone(BELLE_SIP_OBJECT(expires))));
+			if (belle_sip_header_expires_get_expires(expires) > 0) {
+				registrar->registered++;
+				if (registrar->min_expires == 0 || belle_sip_header_expires_get_expires(expires) < registrar->min_expires)
+					registrar->min_expires = belle_sip_header_expires_get_expires(expires);
+			}
+		}
+	}
+	belle_sip_provider_send_response(registrar->provider, response);
+}
+
+static LocalRegistrar *local_registrar_new(LinphoneCore *lc) {
+	belle_sip_stack_t *stack = (belle_sip_stack_t *)sal_get_stack_impl(linphone_core_get_sal(lc));
+	belle_sip_listener_callbacks_t cbs;
+	LocalRegistrar *registrar = ms_new0(LocalRegistrar, 1);
+
+	memset(&cbs, 0, sizeof(cbs));
+	cbs.process_request_event = local_registrar_process_request_event;
+	registrar->listening_point = belle_sip_stack_create_listening_point(stack, "127.0.0.1", BELLE_SIP_LISTENING_POINT_RANDOM_PORT, "UDP");
+	registrar->port = belle_sip_listening_point_get_port(registrar->listening_point);
+	registrar->provider = belle_sip_stack_create_provider(stack, registrar->listening_point);
+	registrar->listener = belle_sip_listener_create_from_callbacks(&cbs, registrar);
+	belle_sip_provider_add_sip_listener(registrar->provider, registrar->listener);
+	return registrar;
+}
+
+static void local_registrar_destroy(LocalRegistrar *registrar) {
+	belle_sip_provider_remove_sip_listener(registrar->provider, registrar->listener);
+	/* the provider owns the listening point, removing it closes the registrar's socket */
+	belle_sip_provider_remove_listening_point(registrar->provider, registrar->listening_point);
+	belle_sip_object_unref(registrar->listener);
+	belle_sip_object_unref(registrar->provider);
+	bctbx_list_free_with_data(registrar->held_challenges, belle_sip_object_unref);
+	ms_free(registrar);
+}
+
+static void auth_info_index_follows_changes(void) {
+	const char *domain = "sip.example.org";
+	LinphoneCoreManager *mgr = linphone_core_manager_new2("empty_rc", FALSE);
+	LinphoneCore *lc = mgr->lc;
+	LinphoneAuthInfo *ai;
+	const LinphoneAuthInfo *found;
+	int i;
+
+	for (i = 0; i < 10; i++) {
+		char *username = bctbx_strdup_printf("user-%i", i);
+		ai = linphone_auth_info_new(username, NULL, "secret", NULL, NULL, domain);
+		linphone_core_add_auth_info(lc, ai);
+		linphone_auth_info_unref(ai);
+		bctbx_free(username);
+	}
+	found = linphone_core_find_auth_info(lc, NULL, "user-4", domain);
+	if (BC_ASSERT_PTR_NOT_NULL(found))
+		BC_ASSERT_STRING_EQUAL(linphone_auth_info_get_username(found), "user-4");
+	BC_ASSERT_PTR_NULL(linphone_core_find_auth_info(lc, NULL, "user-10", domain));
+
+	/* an auth info renamed after it was added is found under its new username only */
+	linphone_auth_info_set_username((LinphoneAuthInfo *)found, "renamed");
+	BC_ASSERT_PTR_NULL(linphone_core_find_auth_info(lc, NULL, "user-4", domain));
+	BC_ASSERT_PTR_EQUAL(linphone_core_find_auth_info(lc, NULL, "renamed", domain), found);
+
+	/* and can be removed afterwards */
+	linphone_auth_info_set_username((LinphoneAuthInfo *)found, "renamed-again");
+	linphone_core_remove_auth_info(lc, found);
+	BC_ASSERT_PTR_NULL(linphone_core_find_auth_info(lc, NULL, "renamed", domain));
+	BC_ASSERT_PTR_NULL(linphone_core_find_auth_info(lc, NULL, "renamed-again", domain));
+	BC_ASSERT_EQUAL((int)bctbx_list_size(linphone_core_get_auth_info_list(lc)), 9, int, "%i");
+
+	/* the other ones are still indexed */
+	for (i = 0; i < 10; i++) {
+		char *username = bctbx_strdup_printf("user-%i", i);
+		if (i != 4) BC_ASSERT_PTR_NOT_NULL(linphone_core_find_auth_info(lc, NULL, username, domain));
+		bctbx_free(username);
+	}
+	found = linphone_core_find_auth_info(lc, NULL, "user-7", domain);
+	linphone_core_remove_auth_info(lc, found);
+	BC_ASSERT_PTR_NULL(linphone_core_find_auth_info(lc, NULL, "user-7", domain));
+	BC_ASSERT_PTR_NOT_NULL(linphone_core_find_auth_info(lc, NULL, "user-8", domain));
+
+	linphone_core_manager_destroy(mgr);
+}
+
+static void register_many_accounts_benchmark(void) {
+	const int account_count = 5000;
+	const char *domain = "bench.example.org";
+	LinphoneCoreManager *mgr = linphone_core_manager_new2("empty_rc", FALSE);
+	LinphoneCore *lc = mgr->lc;
+	LocalRegistrar *registrar = local_registrar_new(lc);
+	char *server = bctbx_strdup_printf("sip:127.0.0.1:%i;transport=udp", registrar->port);
+	uint64_t start;
+	uint64_t add_time, register_time, lookup_time;
+	int i;
+
+	start = ms_get_cur_time_ms();
+	for (i = 0; i < account_count; i++) {
+		char *username = bctbx_strdup_printf("bench-%i", i);
+		char *identity = bctbx_strdup_printf("sip:%s@%s", username, domain);
+		LinphoneAddress *identity_address = linphone_address_new(identity);
+		LinphoneProxyConfig *cfg = linphone_core_create_proxy_config(lc);
+		LinphoneAuthInfo *ai = linphone_auth_info_new(username, NULL, "secret", NULL, NULL, domain);
+
+		linphone_proxy_config_set_identity_address(cfg, identity_address);
+		linphone_proxy_config_set_server_addr(cfg, server);
+		linphone_proxy_config_set_expires(cfg, 3600);
+		linphone_proxy_config_enable_register(cfg, TRUE);
+		linphone_core_add_auth_info(lc, ai);
+		linphone_core_add_proxy_config(lc, cfg);
+
+		linphone_auth_info_unref(ai);
+		linphone_proxy_config_unref(cfg);
+		linphone_address_unref(identity_address);
+		bctbx_free(identity);
+		bctbx_free(username);
+	}
+	add_time = ms_get_cur_time_ms() - start;
+
+	start = ms_get_cur_time_ms();
+	BC_ASSERT_TRUE(wait_for_until(lc, NULL, &mgr->stat.number_of_LinphoneRegistrationOk, account_count, 120000));
+	register_time = ms_get_cur_time_ms() - start;
+	BC_ASSERT_GREATER(registrar->challenged, account_count, int, "%i");
+	BC_ASSERT_EQUAL(registrar->registered, account_count, int, "%i");
+
+	start = ms_get_cur_time_ms();
+	for (i = 0; i < account_count; i++) {
+		char *username = bctbx_strdup_printf("bench-%i", i);
+		BC_ASSERT_PTR_NOT_NULL(linphone_core_find_auth_info(lc, domain, username, domain));
+		bctbx_free(username);
+	}
+	lookup_time = ms_get_cur_time_ms() - start;
+
+	ms_message("Registered %i accounts: added in %llu ms, registered in %llu ms, %i auth info lookups in %llu ms",
+		account_count, (unsigned long long)add_time, (unsigned long long)register_time, account_count, (unsigned long long)lookup_time);
+
+	/* do not send the 5000 unREGISTERs while the core is destroyed */
+	linphone_core_set_network_reachable(lc, FALSE);
+	local_registrar_destroy(registrar);
+	bctbx_free(server);
+	linphone_core_manager_destroy(mgr);
+}
+
+static void register_many_accounts_with_rate_limit(void) {
+	const int account_count = 30;
+	const int rate_limit = 10;
+	const int burst = 2;
+	const char *domain = "bench.example.org";
+	LinphoneCoreManager *mgr = linphone_core_manager_create("empty_rc");
+	LinphoneCore *lc = mgr->lc;
+	LocalRegistrar *registrar;
+	char *server;
+	int i;
+
+	linphone_config_set_int(linphone_core_get_config(lc), "sip", "register_rate_limit", rate_limit);
+	linphone_config_set_int(linphone_core_get_config(lc), "sip", "register_burst", burst);
+	linphone_config_set_int(linphone_core_get_config(lc), "sip", "register_jitter", 100);
+	linphone_core_manager_start(mgr, FALSE);
+	registrar = local_registrar_new(lc);
+	server = bctbx_strdup_printf("sip:127.0.0.1:%i;transport=udp", registrar->port);
+
+	for (i = 0; i < account_count; i++) {
+		char *username = bctbx_strdup_printf("bench-%i", i);
+		char *identity = bctbx_strdup_printf("sip:%s@%s", username, domain);
+		LinphoneAddress *identity_address = linphone_address_new(identity);
+		LinphoneProxyConfig *cfg = linphone_core_create_proxy_config(lc);
+		LinphoneAuthInfo *ai = linphone_auth_info_new(username, NULL, "secret", NULL, NULL, domain);
+
+		linphone_proxy_config_set_identity_address(cfg, identity_address);
+		linphone_proxy_config_set_server_addr(cfg, server);
+		linphone_proxy_config_set_expires(cfg, 3600);
+		linphone_proxy_config_enable_register(cfg, TRUE);
+		linphone_core_add_auth_info(lc, ai);
+		linphone_core_add_proxy_config(lc, cfg);
+
+		linphone_auth_info_unref(ai);
+		linphone_proxy_config_unref(cfg);
+		linphone_address_unref(identity_address);
+		bctbx_free(identity);
+		bctbx_free(username);
+	}
+	linphone_core_iterate(lc);
+	/* at most the burst can leave the queue right away */
+	BC_ASSERT_GREATER((int)linphone_core_get_pending_registrations_count(lc), account_count - burst, int, "%i");
+
+	BC_ASSERT_TRUE(wait_for_until(lc, NULL, &mgr->stat.number_of_LinphoneRegistrationOk, account_count, 20000));
+	BC_ASSERT_EQUAL(registrar->registered, account_count, int, "%i");
+	BC_ASSERT_EQUAL((int)linphone_core_get_pending_registrations_count(lc), 0, int, "%i");
+	BC_ASSERT_EQUAL((int)linphone_core_get_scheduled_registrations_count(lc), account_count, int, "%i");
+	/* the last REGISTERs waited for the rate limit */
+	BC_ASSERT_GREATER((int)linphone_core_get_registration_queue_max_latency(lc), (account_count - burst) * 1000 / rate_limit - 500, int, "%i");
+	BC_ASSERT_LOWER((int)linphone_core_get_registration_queue_average_latency(lc), (int)linphone_core_get_registration_queue_max_latency(lc), int, "%i");
+	/* the requested expiry is shortened by up to the jitter, rounded up to the second */
+	BC_ASSERT_GREATER(registrar->min_expires, 3599, int, "%i");
+	BC_ASSERT_LOWER(registrar->min_expires, 3600, int, "%i");
+
+	linphone_core_set_network_reachable(lc, FALSE);
+	local_registrar_destroy(registrar);
+	bctbx_free(server);
+	linphone_core_manager_destroy(mgr);
+}
+
+static void register_backoff_per_account(void) {
+	const int retry_after = 100;
+	const int backoff = 400;
+	const int backoff_max = 800;
+	const char *domain = "bench.example.org";
+	LinphoneCoreManager *mgr = linphone_core_manager_create("empty_rc");
+	LinphoneCore *lc = mgr->lc;
+	LocalRegistrar *registrar;
+	char *server;
+	int i;
+
+	linphone_config_set_int(linphone_core_get_config(lc), "sip", "refresher_retry_after", retry_after);
+	linphone_config_set_int(linphone_core_get_config(lc), "sip", "register_backoff", backoff);
+	linphone_config_set_int(linphone_core_get_config(lc), "sip", "register_backoff_max", backoff_max);
+	linphone_core_manager_start(mgr, FALSE);
+	registrar = local_registrar_new(lc);
+	registrar->unavailable_user = "unavailable";
+	server = bctbx_strdup_printf("sip:127.0.0.1:%i;transport=udp", registrar->port);
+
+	for (i = 0; i < 2; i++) {
+		const char *username = i == 0 ? "available" : "unavailable";
+		char *identity = bctbx_strdup_printf("sip:%s@%s", username, domain);
+		LinphoneAddress *identity_address = linphone_address_new(identity);
+		LinphoneProxyConfig *cfg = linphone_core_create_proxy_config(lc);
+		LinphoneAuthInfo *ai = linphone_auth_info_new(username, NULL, "secret", NULL, NULL, domain);
+
+		linphone_proxy_config_set_identity_address(cfg, identity_address);
+		linphone_proxy_config_set_server_addr(cfg, server);
+		linphone_proxy_config_set_expires(cfg, 3600);
+		linphone_proxy_config_enable_register(cfg, TRUE);
+		linphone_core_add_auth_info(lc, ai);
+		linphone_core_add_proxy_config(lc, cfg);
+
+		linphone_auth_info_unref(ai);
+		linphone_proxy_config_unref(cfg);
+		linphone_address_unref(identity_address);
+		bctbx_free(identity);
+	}
+
+	/* the refresher retries the refused account, each time after a longer backoff, up to the max */
+	if (BC_ASSERT_TRUE(wait_for_until(lc, NULL, &registrar->unavailable_count, 4, 10000))) {
+		BC_ASSERT_GREATER((int)(registrar->unavailable_times[1] - registrar->unavailable_times[0]), retry_after + backoff, int, "%i");
+		BC_ASSERT_GREATER((int)(registrar->unavailable_times[3] - registrar->unavailable_times[2]), retry_after + backoff_max, int, "%i");
+		BC_ASSERT_LOWER((int)(registrar->unavailable_times[3] - registrar->unavailable_times[2]), retry_after + backoff_max + 1000, int, "%i");
+	}
+
+	/* the other account is not delayed by these failures */
+	BC_ASSERT_EQUAL(mgr->stat.number_of_LinphoneRegistrationOk, 1, int, "%i");
+	BC_ASSERT_EQUAL(registrar->registered, 1, int, "%i");
+	BC_ASSERT_LOWER((int)linphone_core_get_registration_queue_max_latency(lc), backoff, int, "%i");
+
+	linphone_core_set_network_reachable(lc, FALSE);
+	local_registrar_destroy(registrar);
+	bctbx_free(server);
+	linphone_core_manager_destroy(mgr);
+}
+
+static void register_many_accounts_with_late_credentials(void) {
+	const int account_count = 20;
+	const char *domain = "bench.example.org";
+	LinphoneCoreManager *mgr = linphone_core_manager_new2("empty_rc", FALSE);
+	LinphoneCore *lc = mgr->lc;
+	LocalRegistrar *registrar = local_registrar_new(lc);
+	char *server = bctbx_strdup_printf("sip:127.0.0.1:%i;transport=udp", registrar->port);
+	bctbx_list_t *auth_infos = NULL;
+	int i;
+
+	for (i = 0; i < account_count; i++) {
+		char *username = bctbx_strdup_printf("bench-%i", i);
+		char *identity = bctbx_strdup_printf("sip:%s@%s", username, domain);
+		LinphoneAddress *identity_address = linphone_address_new(identity);
+		LinphoneProxyConfig *cfg = linphone_core_create_proxy_config(lc);
+
+		linphone_proxy_config_set_identity_address(cfg, identity_address);
+		linphone_proxy_config_set_server_addr(cfg, server);
+		linphone_proxy_config_set_expires(cfg, 3600);
+		linphone_proxy_config_enable_register(cfg, TRUE);
+		linphone_core_add_proxy_config(lc, cfg);
+		auth_infos = bctbx_list_append(auth_infos, linphone_auth_info_new(username, NULL, "secret", NULL, NULL, domain));
+
+		linphone_proxy_config_unref(cfg);
+		linphone_address_unref(identity_address);
+		bctbx_free(identity);
+		bctbx_free(username);
+	}
+
+	/* one request per account, until credentials are supplied */
+	BC_ASSERT_TRUE(wait_for_until(lc, NULL, &mgr->stat.number_of_auth_info_requested, account_count, 10000));
+	BC_ASSERT_TRUE(wait_for_until(lc, NULL, &mgr->stat.number_of_LinphoneRegistrationFailed, account_count, 10000));
+	BC_ASSERT_EQUAL(mgr->stat.number_of_auth_info_requested, account_count, int, "%i");
+	BC_ASSERT_EQUAL(registrar->registered, 0, int, "%i");
+
+	linphone_core_add_auth_infos(lc, auth_infos);
+	BC_ASSERT_EQUAL((int)bctbx_list_size(linphone_core_get_auth_info_list(lc)), account_count, int, "%i");
+	BC_ASSERT_TRUE(wait_for_until(lc, NULL, &mgr->stat.number_of_LinphoneRegistrationOk, account_count, 10000));
+	BC_ASSERT_EQUAL(registrar->registered, account_count, int, "%i");
+	BC_ASSERT_EQUAL(mgr->stat.number_of_auth_info_requested, account_count, int, "%i");
+
+	linphone_core_set_network_reachable(lc, FALSE);
+	bctbx_list_free_with_data(auth_infos, (bctbx_list_free_func)linphone_auth_info_unref);
+	local_registrar_destroy(registrar);
+	bctbx_free(server);
+	linphone_core_manager_destroy(mgr);
+}
+
+static void register_accounts_sharing_credentials_with_late_credentials(void) {
+	const char *domain = "bench.example.org";
+	LinphoneCoreManager *mgr = linphone_core_manager_new2("empty_rc", FALSE);
+	LinphoneCore *lc = mgr->lc;
+	LocalRegistrar *registrar = local_registrar_new(lc);
+	char *server = bctbx_strdup_printf("sip:127.0.0.1:%i;transport=udp", registrar->port);
+	LinphoneAddress *identity_address = linphone_address_new("sip:shared@bench.example.org");
+	LinphoneAuthInfo *ai;
+	int i;
+
+	/* both challenges reach the core before the pending authentication requests are processed */
+	registrar->grouped_challenges = 2;
+	for (i = 0; i < 2; i++) {
+		LinphoneProxyConfig *cfg = linphone_core_create_proxy_config(lc);
+		linphone_proxy_config_set_identity_address(cfg, identity_address);
+		linphone_proxy_config_set_server_addr(cfg, server);
+		linphone_proxy_config_set_expires(cfg, 3600);
+		linphone_proxy_config_enable_register(cfg, TRUE);
+		linphone_core_add_proxy_config(lc, cfg);
+		linphone_proxy_config_unref(cfg);
+	}
+
+	/* the two REGISTERs need the same (realm, username, domain): the application is asked once */
+	BC_ASSERT_TRUE(wait_for_until(lc, NULL, &mgr->stat.number_of_LinphoneRegistrationFailed, 2, 10000));
+	BC_ASSERT_EQUAL(registrar->challenged, 2, int, "%i");
+	wait_for_until(lc, NULL, NULL, 0, 1000);
+	BC_ASSERT_EQUAL(mgr->stat.number_of_auth_info_requested, 1, int, "%i");
+
+	ai = linphone_auth_info_new("shared", NULL, "secret", NULL, NULL, domain);
+	linphone_core_add_auth_info(lc, ai);
+	linphone_auth_info_unref(ai);
+	BC_ASSERT_TRUE(wait_for_until(lc, NULL, &mgr->stat.number_of_LinphoneRegistrationOk, 2, 10000));
+	BC_ASSERT_EQUAL(registrar->registered, 2, int, "%i");
+	BC_ASSERT_EQUAL(mgr->stat.number_of_auth_info_requested, 1, int, "%i");
+
+	linphone_core_set_network_reachable(lc, FALSE);
+	linphone_address_unref(identity_address);
+	local_registrar_destroy(registrar);
+	bctbx_free(server);
+	linphone_core_manager_destroy(mgr);
+}
 
 test_t register_tests[] = {
 	TEST_NO_TAG("Simple register", simple_register),
@@ -1532,7 +1936,13 @@ test_t register_tests[] = {
 	TEST_NO_TAG("Register get GRUU", register_get_gruu),
 	TEST_NO_TAG("Register get GRUU for multi device", multi_devices_register_with_gruu),
 	TEST_NO_TAG("Update contact private IP address", update_contact_private_ip_address),
-	TEST_NO_TAG("Register with specific client port", register_with_specific_client_port)
+	TEST_NO_TAG("Register with specific client port", register_with_specific_client_port),
+	TEST_NO_TAG("Auth info index follows changes", auth_info_index_follows_changes),
+	TEST_NO_TAG("Register many accounts with rate limit", register_many_accounts_with_rate_limit),
+	TEST_NO_TAG("Register backoff per account", register_backoff_per_account),
+	TEST_NO_TAG("Register many accounts with late credentials", register_many_accounts_with_late_credentials),
+	TEST_NO_TAG("Register accounts sharing credentials with late credentials", register_accounts_sharing_credentials_with_late_credentials),
+	TEST_ONE_TAG("Register many accounts benchmark", register_many_accounts_benchmark, "Benchmark")
 };
 
 test_suite_t register_test_suite = {"Register", NULL, NULL, liblinphone_tester_before_each, liblinphone_tester_after_each,
@@ -435,6 +435,266 @@ void linphone_proxy_config_is_server_config_changed_test(void) {
 	linphone_proxy_config_destroy(proxy_config);
 }
 
+static int dispatch_counter = 0;
+
+static void dispatch_counter_call_stats_updated(LinphoneCore *lc, LinphoneCall *call, const LinphoneCallStats *stats) {
+	dispatch_counter++;
+}
+
+static void dispatch_adding_listener_call_stats_updated(LinphoneCore *lc, LinphoneCall *call, const LinphoneCallStats *stats) {
+	LinphoneCoreCbs *cbs = linphone_factory_create_core_cbs(linphone_factory_get());
+	linphone_core_cbs_set_call_stats_updated(cbs, dispatch_counter_call_stats_updated);
+	linphone_core_add_callbacks(lc, cbs);
+	linphone_core_cbs_unref(cbs);
+	linphone_core_remove_callbacks(lc, linphone_core_get_current_callbacks(lc));
+}
+
+static void core_callbacks_dispatch(void) {
+	LinphoneCore *lc = linphone_factory_create_core_2(linphone_factory_get(), NULL, NULL, liblinphone_tester_get_empty_rc(), NULL, system_context);
+	LinphoneCoreCbs *adding_cbs = linphone_factory_create_core_cbs(linphone_factory_get());
+	LinphoneCoreCbs *late_cbs = linphone_factory_create_core_cbs(linphone_factory_get());
+	bctbx_list_t *cbs_list = NULL;
+	const int nb_listeners = 200;
+	const int nb_notifications = 100000;
+	int i;
+	MSTimeSpec start, end;
+	long long elapsed_us;
+
+	for (i = 0; i < nb_listeners; i++) {
+		LinphoneCoreCbs *cbs = linphone_factory_create_core_cbs(linphone_factory_get());
+		if (i % 20 == 0) linphone_core_cbs_set_call_stats_updated(cbs, dispatch_counter_call_stats_updated);
+		linphone_core_add_callbacks(lc, cbs);
+		cbs_list = bctbx_list_append(cbs_list, cbs);
+	}
+
+	dispatch_counter = 0;
+	linphone_core_notify_call_stats_updated(lc, NULL, NULL);
+	BC_ASSERT_EQUAL(dispatch_counter, nb_listeners / 20, int, "%d");
+
+	/* A callback set after the registration of its listener must be taken into account. */
+	linphone_core_add_callbacks(lc, late_cbs);
+	linphone_core_cbs_set_call_stats_updated(late_cbs, dispatch_counter_call_stats_updated);
+	dispatch_counter = 0;
+	linphone_core_notify_call_stats_updated(lc, NULL, NULL);
+	BC_ASSERT_EQUAL(dispatch_counter, nb_listeners / 20 + 1, int, "%d");
+
+	/* A listener added while dispatching is notified, a listener removed while dispatching is not notified again. */
+	linphone_core_cbs_set_call_stats_updated(adding_cbs, dispatch_adding_listener_call_stats_updated);
+	linphone_core_add_callbacks(lc, adding_cbs);
+	dispatch_counter = 0;
+	linphone_core_notify_call_stats_updated(lc, NULL, NULL);
+	BC_ASSERT_EQUAL(dispatch_counter, nb_listeners / 20 + 2, int, "%d");
+	dispatch_counter = 0;
+	linphone_core_notify_call_stats_updated(lc, NULL, NULL);
+	BC_ASSERT_EQUAL(dispatch_counter, nb_listeners / 20 + 2, int, "%d");
+
+	liblinphone_tester_clock_start(&start);
+	for (i = 0; i < nb_notifications; i++)
+		linphone_core_notify_call_stats_updated(lc, NULL, NULL);
+	ms_get_cur_time(&end);
+	elapsed_us = ((end.tv_sec - start.tv_sec) * 1000000LL) + ((end.tv_nsec - start.tv_nsec) / 1000LL);
+	ms_message("Dispatched %d notifications to %d listeners in %lld us (%lld ns per notification)",
+		nb_notifications, nb_listeners, elapsed_us, elapsed_us * 1000LL / nb_notifications);
+
+	linphone_core_cbs_unref(adding_cbs);
+	linphone_core_cbs_unref(late_cbs);
+	bctbx_list_free_with_data(cbs_list, (bctbx_list_free_func)linphone_core_cbs_unref);
+	linphone_core_unref(lc);
+}
+
+static void core_iterate_stats(void) {
+	LinphoneCore *lc = linphone_factory_create_core_2(linphone_factory_get(), NULL, NULL, liblinphone_tester_get_empty_rc(), NULL, system_context);
+	LinphoneIterateStats *stats;
+	int i;
+
+	BC_ASSERT_PTR_NULL(linphone_core_get_iterate_stats(lc));
+	linphone_core_enable_iterate_stats(lc, TRUE);
+	BC_ASSERT_TRUE(linphone_core_iterate_stats_enabled(lc));
+	linphone_core_set_iterate_budget(lc, 1000);
+
+	for (i = 0; i < 100; i++) linphone_core_iterate(lc);
+
+	stats = linphone_core_get_iterate_stats(lc);
+	if (BC_ASSERT_PTR_NOT_NULL(stats)) {
+		unsigned int max = linphone_iterate_stats_get_max(stats, LinphoneIterateStepTotal);
+		BC_ASSERT_EQUAL(linphone_iterate_stats_get_count(stats, LinphoneIterateStepTotal), 100, unsigned int, "%u");
+		BC_ASSERT_EQUAL(linphone_iterate_stats_get_count(stats, LinphoneIterateStepSal), 100, unsigned int, "%u");
+		BC_ASSERT_LOWER(linphone_iterate_stats_get_percentile(stats, LinphoneIterateStepTotal, 50.f), max, unsigned int, "%u");
+		BC_ASSERT_EQUAL(linphone_iterate_stats_get_percentile(stats, LinphoneIterateStepTotal, 100.f), max, unsigned int, "%u");
+		BC_ASSERT_LOWER(linphone_iterate_stats_get_mean(stats, LinphoneIterateStepSal), max, unsigned int, "%u");
+		BC_ASSERT_EQUAL(linphone_iterate_stats_get_over_budget_count(stats), 0, unsigned int, "%u");
+		ms_message("linphone_core_iterate() p50=%uus p99=%uus max=%uus",
+			linphone_iterate_stats_get_percentile(stats, LinphoneIterateStepTotal, 50.f),
+			linphone_iterate_stats_get_percentile(stats, LinphoneIterateStepTotal, 99.f), max);
+		linphone_iterate_stats_unref(stats);
+	}
+
+	linphone_core_reset_iterate_stats(lc);
+	stats = linphone_core_get_iterate_stats(lc);
+	if (BC_ASSERT_PTR_NOT_NULL(stats)) {
+		BC_ASSERT_EQUAL(linphone_iterate_stats_get_count(stats, LinphoneIterateStepTotal), 0, unsigned int, "%u");
+		linphone_iterate_stats_unref(stats);
+	}
+
+	linphone_core_enable_iterate_stats(lc, FALSE);
+	BC_ASSERT_PTR_NULL(linphone_core_get_iterate_stats(lc));
+	linphone_core_unref(lc);
+}
+
+typedef struct _CoreShardsTestData {
+	LinphoneCoreShards *shards;
+	ms_mutex_t mutex;
+	int task_counts[3];
+	int wrong_core_count;
+	int forward_count;
+	int forward_failure_count;
+} CoreShardsTestData;
+
+static void core_shards_count_task(LinphoneCore *lc, void *user_data) {
+	CoreShardsTestData *data = (CoreShardsTestData *)user_data;
+	int index = linphone_core_shards_get_current_index();
+	ms_mutex_lock(&data->mutex);
+	if (index < 0 || lc != linphone_core_shards_get_core(data->shards, index)) data->wrong_core_count++;
+	else data->task_counts[index]++;
+	ms_mutex_unlock(&data->mutex);
+}
+
+/* Goes through all the shards, each one posting the task to the next one. */
+static void core_shards_forward_task(LinphoneCore *lc, void *user_data) {
+	CoreShardsTestData *data = (CoreShardsTestData *)user_data;
+	int next = linphone_core_shards_get_current_index() + 1;
+	bool_t failed = next < linphone_core_shards_get_count(data->shards)
+		&& linphone_core_shards_post(data->shards, next, core_shards_forward_task, data) != 0;
+	/* Results are checked on the main thread, the tester asserts are not thread safe. */
+	ms_mutex_lock(&data->mutex);
+	data->forward_count++;
+	if (failed) data->forward_failure_count++;
+	ms_mutex_unlock(&data->mutex);
+}
+
+static bool_t core_shards_wait(CoreShardsTestData *data, int task_count, int forward_count) {
+	int i, j;
+	for (i = 0; i < 500; i++) {
+		bool_t done;
+		ms_mutex_lock(&data->mutex);
+		done = data->forward_count == forward_count;
+		for (j = 0; j < 3; j++) done = done && data->task_counts[j] == task_count;
+		ms_mutex_unlock(&data->mutex);
+		if (done) return TRUE;
+		ms_usleep(10000);
+	}
+	return FALSE;
+}
+
+static void core_shards(void) {
+	CoreShardsTestData data = {0};
+	LinphoneAddress *conference = linphone_address_new("sip:conference@sip.example.org");
+	LinphoneAddress *local = linphone_address_new("sip:server@sip.example.org");
+	int used_shards[3] = {0};
+	int i, j;
+
+	ms_mutex_init(&data.mutex, NULL);
+	data.shards = linphone_factory_create_core_shards(linphone_factory_get(), 3, liblinphone_tester_get_empty_rc(), NULL, system_context);
+	BC_ASSERT_EQUAL(linphone_core_shards_get_count(data.shards), 3, int, "%d");
+	BC_ASSERT_PTR_NULL(linphone_core_shards_get_core(data.shards, 0));
+	BC_ASSERT_EQUAL(linphone_core_shards_post(data.shards, 0, core_shards_count_task, &data), -1, int, "%d");
+
+	/* The shard of a conference only depends on its addresses. */
+	i = linphone_core_shards_get_index_for_conference(data.shards, conference, local);
+	BC_ASSERT_TRUE(i >= 0 && i < 3);
+	BC_ASSERT_EQUAL(linphone_core_shards_get_index_for_conference(data.shards, conference, local), i, int, "%d");
+	for (j = 0; j < 30; j++) {
+		char *uri = bctbx_strdup_printf("sip:conference-%d@sip.example.org", j);
+		LinphoneAddress *addr = linphone_address_new(uri);
+		used_shards[linphone_core_shards_get_index_for_conference(data.shards, addr, NULL)] = 1;
+		linphone_address_unref(addr);
+		bctbx_free(uri);
+	}
+	BC_ASSERT_EQUAL(used_shards[0] + used_shards[1] + used_shards[2], 3, int, "%d");
+
+	if (!BC_ASSERT_TRUE(linphone_core_shards_start(data.shards) == 0)) goto end;
+	BC_ASSERT_EQUAL(linphone_core_shards_get_current_index(), -1, int, "%d");
+	for (i = 0; i < 3; i++) {
+		BC_ASSERT_PTR_NOT_NULL(linphone_core_shards_get_core(data.shards, i));
+		for (j = 0; j < 10; j++)
+			BC_ASSERT_EQUAL(linphone_core_shards_post(data.shards, i, core_shards_count_task, &data), 0, int, "%d");
+	}
+	BC_ASSERT_EQUAL(linphone_core_shards_post(data.shards, 3, core_shards_count_task, &data), -1, int, "%d");
+	BC_ASSERT_EQUAL(linphone_core_shards_post(data.shards, 0, core_shards_forward_task, &data), 0, int, "%d");
+	BC_ASSERT_TRUE(core_shards_wait(&data, 10, 3));
+	BC_ASSERT_EQUAL(data.wrong_core_count, 0, int, "%d");
+	BC_ASSERT_EQUAL(data.forward_failure_count, 0, int, "%d");
+
+	/* Tasks posted before stopping are run. */
+	for (i = 0; i < 3; i++)
+		linphone_core_shards_post(data.shards, i, core_shards_count_task, &data);
+	linphone_core_shards_stop(data.shards);
+	for (i = 0; i < 3; i++)
+		BC_ASSERT_EQUAL(data.task_counts[i], 11, int, "%d");
+	BC_ASSERT_PTR_NULL(linphone_core_shards_get_core(data.shards, 0));
+	BC_ASSERT_EQUAL(linphone_core_shards_post(data.shards, 0, core_shards_count_task, &data), -1, int, "%d");
+
+end:
+	linphone_core_shards_unref(data.shards);
+	ms_mutex_destroy(&data.mutex);
+	linphone_address_unref(conference);
+	linphone_address_unref(local);
+}
+
+/* Uses the address cache and chat rooms, which are shared or created by all the shards at the same time. */
+static void core_shards_address_task(LinphoneCore *lc, void *user_data) {
+	CoreShardsTestData *data = (CoreShardsTestData *)user_data;
+	int index = linphone_core_shards_get_current_index();
+	int errors = 0;
+	int i;
+
+	for (i = 0; i < 200; i++) {
+		char *uri = bctbx_strdup_printf("sip:user-%d@sip.example.org", i % 20);
+		LinphoneAddress *addr = linphone_address_new(uri);
+		if (addr) {
+			char *str = linphone_address_as_string_uri_only(addr);
+			if (strcmp(str, uri) != 0) errors++;
+			if (i % 20 == index) {
+				LinphoneChatRoom *cr = linphone_core_get_chat_room(lc, addr);
+				LinphoneChatMessage *msg = cr ? linphone_chat_room_create_message(cr, uri) : NULL;
+				if (msg) linphone_chat_message_unref(msg);
+				else errors++;
+			}
+			bctbx_free(str);
+			linphone_address_unref(addr);
+		} else errors++;
+		bctbx_free(uri);
+	}
+	ms_mutex_lock(&data->mutex);
+	data->wrong_core_count += errors;
+	data->task_counts[index]++;
+	ms_mutex_unlock(&data->mutex);
+}
+
+static void core_shards_concurrent_use(void) {
+	CoreShardsTestData data = {0};
+	int i, j;
+
+	ms_mutex_init(&data.mutex, NULL);
+	data.shards = linphone_factory_create_core_shards(linphone_factory_get(), 3, liblinphone_tester_get_empty_rc(), NULL, system_context);
+	if (BC_ASSERT_TRUE(linphone_core_shards_start(data.shards) == 0)) {
+		for (j = 0; j < 5; j++) {
+			for (i = 0; i < 3; i++)
+				BC_ASSERT_EQUAL(linphone_core_shards_post(data.shards, i, core_shards_address_task, &data), 0, int, "%d");
+		}
+		BC_ASSERT_TRUE(core_shards_wait(&data, 5, 0));
+		/* Stopped while the other shards still use addresses: a shard clears the address cache when its core is destroyed. */
+		for (i = 0; i < 3; i++)
+			linphone_core_shards_post(data.shards, i, core_shards_address_task, &data);
+		linphone_core_shards_stop(data.shards);
+		for (i = 0; i < 3; i++)
+			BC_ASSERT_EQUAL(data.task_counts[i], 6, int, "%d");
+		BC_ASSERT_EQUAL(data.wrong_core_count, 0, int, "%d");
+	}
+	linphone_core_shards_unref(data.shards);
+	ms_mutex_destroy(&data.mutex);
+}
+
 static void chat_room_test(void) {
 	LinphoneCore* lc;
 	lc = linphone_factory_create_core_2(linphone_factory_get(),NULL,NULL, liblinphone_tester_get_empty_rc(), NULL, system_context);
@@ -650,6 +910,19 @@ static void search_friend_in_alphabetical_order(void) {
 
 	linphone_magic_search_reset_search_cache(magicSearch);
 
+	{
+		LinphoneObjectArray *resultArray = linphone_magic_search_get_contact_array_from_filter(magicSearch, "", "");
+		if (BC_ASSERT_TRUE(linphone_object_array_get_size(resultArray) == 5)) {
+			const LinphoneSearchResult *sr = (const LinphoneSearchResult *)linphone_object_array_get(resultArray, 0);
+			char *uri = linphone_address_as_string_uri_only(linphone_search_result_get_address(sr));
+			BC_ASSERT_STRING_EQUAL(uri, name3SipUri);
+			ms_free(uri);
+		}
+		linphone_object_array_unref(resultArray);
+	}
+
+	linphone_magic_search_reset_search_cache(magicSearch);
+
 	linphone_friend_list_remove_friend(lfl, friend1);
 	linphone_friend_list_remove_friend(lfl, friend2);
 	linphone_friend_list_remove_friend(lfl, friend3);
@@ -1675,6 +1948,43 @@ static void delete_friend_from_rc(void) {
 	linphone_core_manager_destroy(manager);
 }
 
+static void ldap_search_narrowing(void) {
+	bool_t prefix_only = FALSE;
+	char *attr;
+
+	attr = linphone_ldap_parse_narrowing_filter("uid=*%s*", &prefix_only);
+	if (BC_ASSERT_PTR_NOT_NULL(attr)) {
+		BC_ASSERT_STRING_EQUAL(attr, "uid");
+		BC_ASSERT_FALSE(prefix_only);
+		ms_free(attr);
+	}
+	attr = linphone_ldap_parse_narrowing_filter("(cn=%s*)", &prefix_only);
+	if (BC_ASSERT_PTR_NOT_NULL(attr)) {
+		BC_ASSERT_STRING_EQUAL(attr, "cn");
+		BC_ASSERT_TRUE(prefix_only);
+		ms_free(attr);
+	}
+	/* anything else than a single substring assertion on the predicate can't be matched locally */
+	BC_ASSERT_PTR_NULL(linphone_ldap_parse_narrowing_filter("uid=%s", &prefix_only));
+	BC_ASSERT_PTR_NULL(linphone_ldap_parse_narrowing_filter("uid=*%s", &prefix_only));
+	BC_ASSERT_PTR_NULL(linphone_ldap_parse_narrowing_filter("(|(cn=*%s*)(uid=*%s*))", &prefix_only));
+	BC_ASSERT_PTR_NULL(linphone_ldap_parse_narrowing_filter("(&(objectClass=person)(cn=*%s*))", &prefix_only));
+	BC_ASSERT_PTR_NULL(linphone_ldap_parse_narrowing_filter("uid~=*%s*", &prefix_only));
+	BC_ASSERT_PTR_NULL(linphone_ldap_parse_narrowing_filter("=*%s*", &prefix_only));
+	BC_ASSERT_PTR_NULL(linphone_ldap_parse_narrowing_filter("", &prefix_only));
+
+	/* case insensitive substring match */
+	BC_ASSERT_TRUE(linphone_ldap_narrowing_value_matches("Marie Curie", "cur", FALSE));
+	BC_ASSERT_TRUE(linphone_ldap_narrowing_value_matches("Marie Curie", "MARIE", FALSE));
+	BC_ASSERT_TRUE(linphone_ldap_narrowing_value_matches("Marie Curie", "", FALSE));
+	BC_ASSERT_FALSE(linphone_ldap_narrowing_value_matches("Marie Curie", "curies", FALSE));
+	BC_ASSERT_FALSE(linphone_ldap_narrowing_value_matches("", "a", FALSE));
+	/* prefix match */
+	BC_ASSERT_TRUE(linphone_ldap_narrowing_value_matches("Marie Curie", "mar", TRUE));
+	BC_ASSERT_FALSE(linphone_ldap_narrowing_value_matches("Marie Curie", "cur", TRUE));
+	BC_ASSERT_FALSE(linphone_ldap_narrowing_value_matches("Ma", "Marie", TRUE));
+}
+
 static void dial_plan(void) {
 	bctbx_list_t *dial_plans = linphone_dial_plan_get_all_list();
 	bctbx_list_t *it;
@@ -1714,6 +2024,10 @@ test_t setup_tests[] = {
 	TEST_NO_TAG("LPConfig invalid friend", linphone_lpconfig_invalid_friend),
 	TEST_NO_TAG("LPConfig invalid friend remote provisoning", linphone_lpconfig_invalid_friend_remote_provisioning),
 	TEST_NO_TAG("Chat room", chat_room_test),
+	TEST_ONE_TAG("Core callbacks dispatch", core_callbacks_dispatch, "Benchmark"),
+	TEST_NO_TAG("Core iterate stats", core_iterate_stats),
+	TEST_NO_TAG("Core shards", core_shards),
+	TEST_NO_TAG("Core shards concurrent use", core_shards_concurrent_use),
 	TEST_NO_TAG("Devices reload", devices_reload_test),
 	TEST_NO_TAG("Codec usability", codec_usability_test),
 	TEST_NO_TAG("Codec setup", codec_setup),
@@ -1740,6 +2054,7 @@ test_t setup_tests[] = {
 	TEST_ONE_TAG("Search friend result has capabilities", search_friend_get_capabilities, "MagicSearch"),
 	TEST_ONE_TAG("Search friend result chat room remote", search_friend_chat_room_remote, "MagicSearch"),
 	TEST_NO_TAG("Delete friend in linphone rc", delete_friend_from_rc),
+	TEST_NO_TAG("LDAP search narrowing", ldap_search_narrowing),
 	TEST_NO_TAG("Dialplan", dial_plan)
 };
 
@@ -29,6 +29,16 @@
 #include <bctoolbox/map.h>
 
 #include <time.h>
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 #define CARDDAV_SERVER "http://dav.linphone.org/card.php/addressbooks/tester/default"
 #define CARDDAV_SYNC_TIMEOUT 15000
 
@@ -514,6 +524,264 @@ static void friends_sqlite_find_friend_in_lot_of_friends(void) {
 	linphone_core_unref(lc);
 }
 
+static void linphone_vcard_clone_test(void) {
+	LinphoneVcard *lvc = linphone_factory_create_vcard(linphone_factory_get());
+	LinphoneVcard *clone;
+	bctbx_list_t *phone_numbers;
+
+	linphone_vcard_set_full_name(lvc, "Sylvain");
+	linphone_vcard_add_sip_address(lvc, "sip:sylvain@sip.linphone.org");
+	linphone_vcard_add_phone_number(lvc, "+33952636505");
+	clone = linphone_vcard_clone(lvc);
+	BC_ASSERT_STRING_EQUAL(linphone_vcard_get_full_name(clone), "Sylvain");
+	BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(linphone_vcard_get_sip_addresses(clone)), 1, unsigned int, "%u");
+
+	// Modifying the clone must not modify the original vCard, and the other way round.
+	linphone_vcard_set_full_name(clone, "Margaux");
+	linphone_vcard_add_phone_number(clone, "+33952636506");
+	linphone_vcard_set_organization(lvc, "Belledonne Communications");
+	BC_ASSERT_STRING_EQUAL(linphone_vcard_get_full_name(lvc), "Sylvain");
+	BC_ASSERT_STRING_EQUAL(linphone_vcard_get_full_name(clone), "Margaux");
+	phone_numbers = linphone_vcard_get_phone_numbers(lvc);
+	BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(phone_numbers), 1, unsigned int, "%u");
+	bctbx_list_free(phone_numbers);
+	phone_numbers = linphone_vcard_get_phone_numbers(clone);
+	BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(phone_numbers), 2, unsigned int, "%u");
+	bctbx_list_free(phone_numbers);
+	BC_ASSERT_PTR_NULL(linphone_vcard_get_organization(clone));
+	linphone_vcard_unref(clone);
+
+	// The copy made when a clone is modified keeps the validation setting.
+	linphone_vcard_set_skip_validation(lvc, TRUE);
+	clone = linphone_vcard_clone(lvc);
+	linphone_vcard_set_full_name(clone, "Margaux");
+	BC_ASSERT_TRUE(linphone_vcard_get_skip_validation(clone));
+	BC_ASSERT_STRING_EQUAL(linphone_vcard_get_full_name(lvc), "Sylvain");
+
+	linphone_vcard_unref(clone);
+	linphone_vcard_unref(lvc);
+}
+
+static void friends_sqlite_lazy_vcards_benchmark(void) {
+	const int friend_count = 10000;
+	char *friends_db = bc_tester_file("friends.db");
+	LinphoneCore *lc;
+	sqlite3 *db;
+	char *errmsg = NULL;
+	uint64_t start;
+	int lazy;
+	int i;
+
+	// Let the core create the schema, then fill it directly, storing the friends one by one would be too slow.
+	unlink(friends_db);
+	lc = linphone_factory_create_core_2(linphone_factory_get(), NULL, NULL, liblinphone_tester_get_empty_rc(), NULL, system_context);
+	linphone_core_set_friends_database_path(lc, friends_db);
+	linphone_core_unref(lc);
+
+	if (!BC_ASSERT_EQUAL(sqlite3_open(friends_db, &db), SQLITE_OK, int, "%i")) goto end;
+	BC_ASSERT_EQUAL(sqlite3_exec(db, "BEGIN", 0, 0, &errmsg), SQLITE_OK, int, "%i");
+	BC_ASSERT_EQUAL(sqlite3_exec(db, "INSERT INTO friends_lists VALUES(1,'Benchmark',NULL,NULL,0,NULL);", 0, 0, &errmsg), SQLITE_OK, int, "%i");
+	for (i = 0; i < friend_count; i++) {
+		char *vcard = bctbx_strdup_printf(
+			"BEGIN:VCARD\r\nVERSION:4.0\r\nUID:urn:uuid:%08d-0000-0000-0000-000000000000\r\n"
+			"FN:Contact %d\r\nN:%d;Contact;;;\r\nIMPP:sip:contact%d@sip.example.org\r\nIMPP:sip:contact%d@other.example.org\r\n"
+			"TEL;TYPE=work:+3395263%04d\r\nTEL;TYPE=home:+3395264%04d\r\nORG:Example %d\r\n"
+			"EMAIL:contact%d@example.org\r\nNOTE:Generated contact number %d\r\nEND:VCARD\r\n",
+			i, i, i, i, i, i, i, i % 100, i, i);
+		char *sip_uri = bctbx_strdup_printf("sip:contact%d@sip.example.org", i);
+		char *name = bctbx_strdup_printf("Contact %d", i);
+		char *buf = sqlite3_mprintf("INSERT INTO friends VALUES(NULL,1,%Q,%i,%i,'key_%i',%Q,%Q,%Q,%i,%Q);",
+			sip_uri, 0, 0, i, vcard, NULL, NULL, 0, name);
+		BC_ASSERT_EQUAL(sqlite3_exec(db, buf, 0, 0, &errmsg), SQLITE_OK, int, "%i");
+		sqlite3_free(buf);
+		bctbx_free(name);
+		bctbx_free(sip_uri);
+		bctbx_free(vcard);
+	}
+	BC_ASSERT_EQUAL(sqlite3_exec(db, "END", 0, 0, &errmsg), SQLITE_OK, int, "%i");
+	sqlite3_close(db);
+
+	for (lazy = 0; lazy <= 1; lazy++) {
+		LinphoneFriendList *lfl;
+		const bctbx_list_t *friends;
+		const bctbx_list_t *it;
+		LinphoneFriend *lf;
+		bctbx_list_t *phone_numbers;
+		unsigned int count;
+
+		lc = linphone_factory_create_core_2(linphone_factory_get(), NULL, NULL, liblinphone_tester_get_empty_rc(), NULL, system_context);
+		lp_config_set_int(linphone_core_get_config(lc), "misc", "lazy_vcard_loading", lazy);
+		start = ms_get_cur_time_ms();
+		linphone_core_set_friends_database_path(lc, friends_db);
+		lfl = linphone_core_get_default_friend_list(lc);
+		friends = linphone_friend_list_get_friends(lfl);
+		count = (unsigned int)bctbx_list_size(friends);
+		ms_message("[vCard] Loading %u friends with %s vCards took %u ms", count, lazy ? "lazy" : "parsed", (unsigned int)(ms_get_cur_time_ms() - start));
+		BC_ASSERT_EQUAL(count, (unsigned int)friend_count, unsigned int, "%u");
+		if (count == 0) {
+			linphone_core_unref(lc);
+			continue;
+		}
+
+		lf = linphone_friend_list_find_friend_by_uri(lfl, "sip:contact42@sip.example.org");
+		if (BC_ASSERT_PTR_NOT_NULL(lf)) {
+			BC_ASSERT_STRING_EQUAL(linphone_friend_get_name(lf), "Contact 42");
+			BC_ASSERT_EQUAL(linphone_vcard_is_parsed(linphone_friend_get_vcard(lf)), !lazy, int, "%i");
+			// Accessing the other fields parses a lazy vCard.
+			BC_ASSERT_STRING_EQUAL(linphone_vcard_get_organization(linphone_friend_get_vcard(lf)), "Example 42");
+			phone_numbers = linphone_friend_get_phone_numbers(lf);
+			BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(phone_numbers), 2, unsigned int, "%u");
+			bctbx_list_free(phone_numbers);
+			BC_ASSERT_TRUE(linphone_vcard_is_parsed(linphone_friend_get_vcard(lf)));
+			// The secondary addresses of a lazy vCard are indexed once it is parsed.
+			BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_uri(lfl, "sip:contact42@other.example.org"), lf);
+		}
+
+		start = ms_get_cur_time_ms();
+		for (it = friends; it != NULL; it = bctbx_list_next(it)) {
+			LinphoneVcard *clone = linphone_vcard_clone(linphone_friend_get_vcard((LinphoneFriend *)bctbx_list_get_data(it)));
+			linphone_vcard_unref(clone);
+		}
+		ms_message("[vCard] Cloning %u %s vCards took %u ms", count, lazy ? "lazy" : "parsed", (unsigned int)(ms_get_cur_time_ms() - start));
+
+		linphone_core_unref(lc);
+	}
+
+end:
+	unlink(friends_db);
+	bc_free(friends_db);
+}
+
+static void friends_sqlite_bulk_import_benchmark(void) {
+	const int friend_count = 10000;
+	char *friends_db = bc_tester_file("friends.db");
+	LinphoneCore *lc;
+	LinphoneFriendList *lfl;
+	bctbx_list_t *friends_from_db;
+	char *buffer = NULL;
+	size_t buffer_size = 0;
+	uint64_t start;
+	int i;
+
+	for (i = 0; i < friend_count; i++) {
+		char *vcard = bctbx_strdup_printf(
+			"BEGIN:VCARD\r\nVERSION:4.0\r\nFN:Contact %d\r\nIMPP:sip:contact%d@sip.example.org\r\n"
+			"TEL;TYPE=work:+3395263%04d\r\nEND:VCARD\r\n", i, i, i);
+		size_t size = strlen(vcard);
+		buffer = (char *)bctbx_realloc(buffer, buffer_size + size + 1);
+		memcpy(buffer + buffer_size, vcard, size + 1);
+		buffer_size += size;
+		bctbx_free(vcard);
+	}
+
+	unlink(friends_db);
+	lc = linphone_factory_create_core_2(linphone_factory_get(), NULL, NULL, liblinphone_tester_get_empty_rc(), NULL, system_context);
+	linphone_core_set_friends_database_path(lc, friends_db);
+	lfl = linphone_core_get_default_friend_list(lc);
+
+	start = ms_get_cur_time_ms();
+	BC_ASSERT_EQUAL(linphone_friend_list_import_friends_from_vcard4_buffer(lfl, buffer), friend_count, int, "%i");
+	ms_message("[vCard] Importing %d friends took %u ms, %u rows written in %u ms", friend_count,
+		(unsigned int)(ms_get_cur_time_ms() - start),
+		linphone_core_get_friends_database_rows_written(lc),
+		linphone_core_get_friends_database_write_time(lc));
+	BC_ASSERT_GREATER(linphone_core_get_friends_database_rows_written(lc), (unsigned int)friend_count, unsigned int, "%u");
+
+	friends_from_db = linphone_core_fetch_friends_from_db(lc, lfl);
+	BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(friends_from_db), (unsigned int)friend_count, unsigned int, "%u");
+	bctbx_list_free_with_data(friends_from_db, (void (*)(void *))linphone_friend_unref);
+
+	linphone_core_unref(lc);
+	bctbx_free(buffer);
+	unlink(friends_db);
+	bc_free(friends_db);
+}
+
+static void friends_sqlite_bulk_add_friends(void) {
+	const int friend_count = 50;
+	char *friends_db = bc_tester_file("friends.db");
+	LinphoneCore *lc;
+	LinphoneFriendList *lfl;
+	LinphoneFriend *lf;
+	bctbx_list_t *friends = NULL;
+	int i;
+
+	unlink(friends_db);
+	lc = linphone_factory_create_core_2(linphone_factory_get(), NULL, NULL, liblinphone_tester_get_empty_rc(), NULL, system_context);
+	linphone_core_set_friends_database_path(lc, friends_db);
+	lfl = linphone_core_get_default_friend_list(lc);
+
+	for (i = 0; i < friend_count; i++) {
+		char *name = bctbx_strdup_printf("Contact %d", i);
+		char *ref_key = bctbx_strdup_printf("key_%d", i);
+		char *uri = bctbx_strdup_printf("sip:contact%d@sip.example.org", i);
+		char *other_uri = bctbx_strdup_printf("sip:contact%d@other.example.org", i);
+		LinphoneAddress *addr = linphone_address_new(uri);
+		LinphoneAddress *other_addr = linphone_address_new(other_uri);
+
+		lf = linphone_core_create_friend(lc);
+		linphone_friend_set_name(lf, name);
+		linphone_friend_set_ref_key(lf, ref_key);
+		linphone_friend_set_address(lf, addr);
+		linphone_friend_add_address(lf, other_addr);
+		friends = bctbx_list_append(friends, lf);
+
+		linphone_address_unref(other_addr);
+		linphone_address_unref(addr);
+		bctbx_free(other_uri);
+		bctbx_free(uri);
+		bctbx_free(ref_key);
+		bctbx_free(name);
+	}
+	// A friend whose ref key is already used is not added.
+	lf = linphone_core_create_friend(lc);
+	linphone_friend_set_name(lf, "Duplicate");
+	linphone_friend_set_ref_key(lf, "key_0");
+	friends = bctbx_list_append(friends, lf);
+
+	BC_ASSERT_EQUAL(linphone_friend_list_add_friends(lfl, friends), friend_count, int, "%i");
+	BC_ASSERT_PTR_NULL(linphone_friend_get_friend_list(lf));
+	BC_ASSERT_GREATER(linphone_core_get_friends_database_rows_written(lc), (unsigned int)friend_count, unsigned int, "%u");
+	BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(linphone_friend_list_get_friends(lfl)), (unsigned int)friend_count, unsigned int, "%u");
+	lf = linphone_friend_list_find_friend_by_uri(lfl, "sip:contact7@other.example.org");
+	if (BC_ASSERT_PTR_NOT_NULL(lf)) {
+		BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_ref_key(lfl, "key_7"), lf);
+		BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_uri(lfl, "sip:contact7@sip.example.org"), lf);
+		BC_ASSERT_GREATER(linphone_friend_get_storage_id(lf), 0, unsigned int, "%u");
+	}
+	bctbx_list_free_with_data(friends, (void (*)(void *))linphone_friend_unref);
+	linphone_core_unref(lc);
+
+	// Reload the friends from the database and check they were all stored and indexed.
+	lc = linphone_factory_create_core_2(linphone_factory_get(), NULL, NULL, liblinphone_tester_get_empty_rc(), NULL, system_context);
+	linphone_core_set_friends_database_path(lc, friends_db);
+	lfl = linphone_core_get_default_friend_list(lc);
+	BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(linphone_friend_list_get_friends(lfl)), (unsigned int)friend_count, unsigned int, "%u");
+	for (i = 0; i < friend_count; i++) {
+		char *name = bctbx_strdup_printf("Contact %d", i);
+		char *ref_key = bctbx_strdup_printf("key_%d", i);
+		char *uri = bctbx_strdup_printf("sip:contact%d@sip.example.org", i);
+		char *other_uri = bctbx_strdup_printf("sip:contact%d@other.example.org", i);
+
+		lf = linphone_friend_list_find_friend_by_ref_key(lfl, ref_key);
+		if (BC_ASSERT_PTR_NOT_NULL(lf)) {
+			BC_ASSERT_STRING_EQUAL(linphone_friend_get_name(lf), name);
+			BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_uri(lfl, uri), lf);
+			BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_uri(lfl, other_uri), lf);
+		}
+
+		bctbx_free(other_uri);
+		bctbx_free(uri);
+		bctbx_free(ref_key);
+		bctbx_free(name);
+	}
+	BC_ASSERT_PTR_NULL(linphone_friend_list_find_friend_by_uri(lfl, "sip:contact50@sip.example.org"));
+	linphone_core_unref(lc);
+
+	unlink(friends_db);
+	bc_free(friends_db);
+}
+
 typedef struct _LinphoneCardDAVStats {
 	int sync_done_count;
 	int new_contact_count;
@@ -938,6 +1206,492 @@ static void carddav_server_to_client_and_client_to_sever_sync(void) {
 	linphone_core_manager_destroy(manager);
 }
 
+#ifndef _WIN32
+
+/*
+ * Minimal CardDAV server on the loopback interface, to check which requests a synchronization sends.
+ * It serves one address book and answers PROPFIND, addressbook-query, addressbook-multiget and
+ * sync-collection requests, the sync-token being the revision of the address book.
+ */
+
+#define FAKE_CARDDAV_MAX_CLIENTS 8
+#define FAKE_CARDDAV_SYNC_TOKEN "http://127.0.0.1/sync/%d"
+#define CARDDAV_BENCHMARK_TIMEOUT 60000
+
+#ifdef MSG_NOSIGNAL
+#define FAKE_CARDDAV_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define FAKE_CARDDAV_SEND_FLAGS 0
+#endif
+
+typedef struct _FakeCardDavBuffer {
+	char *data;
+	size_t len;
+	size_t size;
+} FakeCardDavBuffer;
+
+typedef struct _FakeCardDavContact {
+	int version;
+	int revision; /* Revision of the address book at the last change of the contact. */
+	bool_t deleted;
+} FakeCardDavContact;
+
+typedef struct _FakeCardDavRequestCounts {
+	int propfind;
+	int query;
+	int multiget;
+	int sync_collection;
+} FakeCardDavRequestCounts;
+
+typedef struct _FakeCardDavServer {
+	ms_mutex_t mutex;
+	ms_thread_t thread;
+	bool_t running;
+	int listen_fd;
+	int port;
+	int client_fds[FAKE_CARDDAV_MAX_CLIENTS];
+	FakeCardDavBuffer client_buffers[FAKE_CARDDAV_MAX_CLIENTS];
+	FakeCardDavContact *contacts;
+	int contact_count;
+	int revision;
+	int first_valid_revision; /* Older sync-tokens are refused. */
+	FakeCardDavRequestCounts counts;
+} FakeCardDavServer;
+
+static void fake_carddav_buffer_reserve(FakeCardDavBuffer *buffer, size_t len) {
+	size_t size = buffer->size ? buffer->size : 4096;
+	if (buffer->len + len + 1 <= buffer->size) return;
+	while (buffer->len + len + 1 > size) size *= 2;
+	buffer->data = (char *)ms_realloc(buffer->data, size);
+	buffer->size = size;
+}
+
+static void fake_carddav_buffer_append_bytes(FakeCardDavBuffer *buffer, const char *data, size_t len) {
+	fake_carddav_buffer_reserve(buffer, len);
+	memcpy(buffer->data + buffer->len, data, len);
+	buffer->len += len;
+	buffer->data[buffer->len] = '\0';
+}
+
+static void fake_carddav_buffer_append(FakeCardDavBuffer *buffer, const char *fmt, ...) {
+	va_list args;
+	int len;
+	va_start(args, fmt);
+	len = vsnprintf(NULL, 0, fmt, args);
+	va_end(args);
+	if (len < 0) return;
+	fake_carddav_buffer_reserve(buffer, (size_t)len);
+	va_start(args, fmt);
+	vsnprintf(buffer->data + buffer->len, (size_t)len + 1, fmt, args);
+	va_end(args);
+	buffer->len += (size_t)len;
+}
+
+/* Returns the length of the first request of the buffer, 0 if it is not complete yet. */
+static size_t fake_carddav_request_length(const FakeCardDavBuffer *buffer) {
+	const char *headers_end;
+	const char *content_length;
+	size_t headers_len;
+	size_t body_len = 0;
+
+	if (!buffer->data) return 0;
+	headers_end = strstr(buffer->data, "\r\n\r\n");
+	if (!headers_end) return 0;
+	headers_len = (size_t)(headers_end - buffer->data) + 4;
+	content_length = strstr(buffer->data, "Content-Length:");
+	if (content_length && content_length < headers_end)
+		body_len = (size_t)atoi(content_length + strlen("Content-Length:"));
+	return buffer->len >= headers_len + body_len ? headers_len + body_len : 0;
+}
+
+static void fake_carddav_append_etag_response(FakeCardDavBuffer *xml, const FakeCardDavServer *server, int index) {
+	fake_carddav_buffer_append(xml,
+		"<d:response><d:href>/addressbook/contact-%d.vcf</d:href><d:propstat><d:prop><d:getetag>\"%d-%d\"</d:getetag></d:prop>"
+		"<d:status>HTTP/1.1 200 OK</d:status></d:propstat></d:response>",
+		index, index, server->contacts[index].version);
+}
+
+static void fake_carddav_append_not_found_response(FakeCardDavBuffer *xml, int index) {
+	fake_carddav_buffer_append(xml,
+		"<d:response><d:href>/addressbook/contact-%d.vcf</d:href><d:status>HTTP/1.1 404 Not Found</d:status></d:response>",
+		index);
+}
+
+static void fake_carddav_append_vcard_response(FakeCardDavBuffer *xml, const FakeCardDavServer *server, int index) {
+	fake_carddav_buffer_append(xml,
+		"<d:response><d:href>/addressbook/contact-%d.vcf</d:href><d:propstat><d:prop><d:getetag>\"%d-%d\"</d:getetag>"
+		"<card:address-data>BEGIN:VCARD&#13;\nVERSION:4.0&#13;\nUID:uid-%d&#13;\nFN:Contact %d&#13;\n"
+		"IMPP:sip:contact-%d@sip.example.org&#13;\nEND:VCARD&#13;\n</card:address-data></d:prop>"
+		"<d:status>HTTP/1.1 200 OK</d:status></d:propstat></d:response>",
+		index, index, server->contacts[index].version, index, index, index);
+}
+
+static int fake_carddav_server_handle_request(FakeCardDavServer *server, const char *request, FakeCardDavBuffer *xml) {
+	const char *body = strstr(request, "\r\n\r\n") + 4;
+	int status = 207;
+	int i;
+
+	ms_mutex_lock(&server->mutex);
+	if (strncmp(request, "PROPFIND ", 9) == 0) {
+		server->counts.propfind++;
+		fake_carddav_buffer_append(xml,
+			"<d:multistatus xmlns:d=\"DAV:\" xmlns:cs=\"http://calendarserver.org/ns/\"><d:response><d:href>/addressbook/</d:href>"
+			"<d:propstat><d:prop><cs:getctag>%d</cs:getctag><d:sync-token>" FAKE_CARDDAV_SYNC_TOKEN "</d:sync-token></d:prop>"
+			"<d:status>HTTP/1.1 200 OK</d:status></d:propstat></d:response></d:multistatus>",
+			server->revision, server->revision);
+	} else if (strncmp(request, "REPORT ", 7) == 0 && strstr(body, "addressbook-query")) {
+		server->counts.query++;
+		fake_carddav_buffer_append(xml, "<d:multistatus xmlns:d=\"DAV:\">");
+		for (i = 0; i < server->contact_count; i++) {
+			if (!server->contacts[i].deleted) fake_carddav_append_etag_response(xml, server, i);
+		}
+		fake_carddav_buffer_append(xml, "</d:multistatus>");
+	} else if (strncmp(request, "REPORT ", 7) == 0 && strstr(body, "addressbook-multiget")) {
+		const char *href = body;
+		server->counts.multiget++;
+		fake_carddav_buffer_append(xml, "<d:multistatus xmlns:d=\"DAV:\" xmlns:card=\"urn:ietf:params:xml:ns:carddav\">");
+		while ((href = strstr(href, "/addressbook/contact-")) != NULL) {
+			href += strlen("/addressbook/contact-");
+			i = atoi(href);
+			if (i >= 0 && i < server->contact_count && !server->contacts[i].deleted)
+				fake_carddav_append_vcard_response(xml, server, i);
+			else
+				fake_carddav_append_not_found_response(xml, i);
+		}
+		fake_carddav_buffer_append(xml, "</d:multistatus>");
+	} else if (strncmp(request, "REPORT ", 7) == 0 && strstr(body, "sync-collection")) {
+		const char *token = strstr(body, "/sync/");
+		int since = token ? atoi(token + strlen("/sync/")) : -1;
+		server->counts.sync_collection++;
+		if (since < server->first_valid_revision || since > server->revision) {
+			status = 403;
+			fake_carddav_buffer_append(xml, "<d:error xmlns:d=\"DAV:\"><d:valid-sync-token /></d:error>");
+		} else {
+			fake_carddav_buffer_append(xml, "<d:multistatus xmlns:d=\"DAV:\">");
+			for (i = 0; i < server->contact_count; i++) {
+				if (server->contacts[i].revision <= since) continue;
+				if (server->contacts[i].deleted)
+					fake_carddav_append_not_found_response(xml, i);
+				else
+					fake_carddav_append_etag_response(xml, server, i);
+			}
+			fake_carddav_buffer_append(xml, "<d:sync-token>" FAKE_CARDDAV_SYNC_TOKEN "</d:sync-token></d:multistatus>", server->revision);
+		}
+	} else {
+		status = 405;
+	}
+	ms_mutex_unlock(&server->mutex);
+	return status;
+}
+
+static void fake_carddav_server_send(int fd, const FakeCardDavBuffer *buffer) {
+	size_t sent = 0;
+	while (sent < buffer->len) {
+		ssize_t len = send(fd, buffer->data + sent, buffer->len - sent, FAKE_CARDDAV_SEND_FLAGS);
+		if (len <= 0) return;
+		sent += (size_t)len;
+	}
+}
+
+static void fake_carddav_server_read(FakeCardDavServer *server, int client) {
+	FakeCardDavBuffer *buffer = &server->client_buffers[client];
+	char chunk[4096];
+	size_t request_len;
+	ssize_t received = recv(server->client_fds[client], chunk, sizeof(chunk), 0);
+
+	if (received <= 0) {
+		close(server->client_fds[client]);
+		server->client_fds[client] = -1;
+		buffer->len = 0;
+		return;
+	}
+	fake_carddav_buffer_append_bytes(buffer, chunk, (size_t)received);
+	while ((request_len = fake_carddav_request_length(buffer)) > 0) {
+		FakeCardDavBuffer request = {0};
+		FakeCardDavBuffer xml = {0};
+		FakeCardDavBuffer response = {0};
+		int status;
+
+		fake_carddav_buffer_append_bytes(&request, buffer->data, request_len);
+		status = fake_carddav_server_handle_request(server, request.data, &xml);
+		fake_carddav_buffer_append(&response,
+			"HTTP/1.1 %d %s\r\nContent-Type: application/xml; charset=utf-8\r\nContent-Length: %u\r\n\r\n",
+			status, status == 207 ? "Multi-Status" : (status == 403 ? "Forbidden" : "Method Not Allowed"), (unsigned int)xml.len);
+		if (xml.len > 0) fake_carddav_buffer_append_bytes(&response, xml.data, xml.len);
+		fake_carddav_server_send(server->client_fds[client], &response);
+		ms_free(request.data);
+		if (xml.data) ms_free(xml.data);
+		ms_free(response.data);
+
+		memmove(buffer->data, buffer->data + request_len, buffer->len - request_len + 1);
+		buffer->len -= request_len;
+	}
+}
+
+static void *fake_carddav_server_run(void *data) {
+	FakeCardDavServer *server = (FakeCardDavServer *)data;
+	for (;;) {
+		struct pollfd fds[FAKE_CARDDAV_MAX_CLIENTS + 1];
+		bool_t running;
+		int i;
+
+		ms_mutex_lock(&server->mutex);
+		running = server->running;
+		ms_mutex_unlock(&server->mutex);
+		if (!running) break;
+
+		fds[0].fd = server->listen_fd;
+		fds[0].events = POLLIN;
+		fds[0].revents = 0;
+		for (i = 0; i < FAKE_CARDDAV_MAX_CLIENTS; i++) {
+			fds[i + 1].fd = server->client_fds[i];
+			fds[i + 1].events = POLLIN;
+			fds[i + 1].revents = 0;
+		}
+		if (poll(fds, FAKE_CARDDAV_MAX_CLIENTS + 1, 100) <= 0) continue;
+
+		if (fds[0].revents & POLLIN) {
+			int fd = accept(server->listen_fd, NULL, NULL);
+			if (fd >= 0) {
+				for (i = 0; i < FAKE_CARDDAV_MAX_CLIENTS && server->client_fds[i] >= 0; i++);
+				if (i < FAKE_CARDDAV_MAX_CLIENTS) server->client_fds[i] = fd;
+				else close(fd);
+			}
+		}
+		for (i = 0; i < FAKE_CARDDAV_MAX_CLIENTS; i++) {
+			if (server->client_fds[i] >= 0 && (fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR)))
+				fake_carddav_server_read(server, i);
+		}
+	}
+	return NULL;
+}
+
+static FakeCardDavServer *fake_carddav_server_new(void) {
+	FakeCardDavServer *server = ms_new0(FakeCardDavServer, 1);
+	struct sockaddr_in addr;
+	socklen_t addr_len = sizeof(addr);
+	int i;
+
+	for (i = 0; i < FAKE_CARDDAV_MAX_CLIENTS; i++) server->client_fds[i] = -1;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	server->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (server->listen_fd < 0
+		|| bind(server->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0
+		|| listen(server->listen_fd, FAKE_CARDDAV_MAX_CLIENTS) != 0
+		|| getsockname(server->listen_fd, (struct sockaddr *)&addr, &addr_len) != 0) {
+		ms_error("Could not start the fake CardDAV server: %s", strerror(errno));
+		if (server->listen_fd >= 0) close(server->listen_fd);
+		ms_free(server);
+		return NULL;
+	}
+	server->port = ntohs(addr.sin_port);
+	server->revision = 1;
+	server->first_valid_revision = 1;
+	server->running = TRUE;
+	ms_mutex_init(&server->mutex, NULL);
+	ms_thread_create(&server->thread, NULL, fake_carddav_server_run, server);
+	return server;
+}
+
+static void fake_carddav_server_destroy(FakeCardDavServer *server) {
+	int i;
+	ms_mutex_lock(&server->mutex);
+	server->running = FALSE;
+	ms_mutex_unlock(&server->mutex);
+	ms_thread_join(server->thread, NULL);
+	for (i = 0; i < FAKE_CARDDAV_MAX_CLIENTS; i++) {
+		if (server->client_fds[i] >= 0) close(server->client_fds[i]);
+		if (server->client_buffers[i].data) ms_free(server->client_buffers[i].data);
+	}
+	close(server->listen_fd);
+	if (server->contacts) ms_free(server->contacts);
+	ms_mutex_destroy(&server->mutex);
+	ms_free(server);
+}
+
+static char *fake_carddav_server_get_uri(const FakeCardDavServer *server) {
+	return bctbx_strdup_printf("http://127.0.0.1:%d/addressbook/", server->port);
+}
+
+static void fake_carddav_server_add_contacts(FakeCardDavServer *server, int count) {
+	int i;
+	ms_mutex_lock(&server->mutex);
+	server->revision++;
+	server->contacts = (FakeCardDavContact *)ms_realloc(server->contacts, (size_t)(server->contact_count + count) * sizeof(FakeCardDavContact));
+	for (i = server->contact_count; i < server->contact_count + count; i++) {
+		server->contacts[i].version = 1;
+		server->contacts[i].revision = server->revision;
+		server->contacts[i].deleted = FALSE;
+	}
+	server->contact_count += count;
+	ms_mutex_unlock(&server->mutex);
+}
+
+static void fake_carddav_server_update_contact(FakeCardDavServer *server, int index) {
+	ms_mutex_lock(&server->mutex);
+	server->contacts[index].version++;
+	server->contacts[index].revision = ++server->revision;
+	ms_mutex_unlock(&server->mutex);
+}
+
+static void fake_carddav_server_delete_contact(FakeCardDavServer *server, int index) {
+	ms_mutex_lock(&server->mutex);
+	server->contacts[index].deleted = TRUE;
+	server->contacts[index].revision = ++server->revision;
+	ms_mutex_unlock(&server->mutex);
+}
+
+/* Makes the server refuse all the sync-tokens given until now, as if its change log had been purged. */
+static void fake_carddav_server_invalidate_sync_tokens(FakeCardDavServer *server) {
+	ms_mutex_lock(&server->mutex);
+	server->first_valid_revision = ++server->revision;
+	ms_mutex_unlock(&server->mutex);
+}
+
+static FakeCardDavRequestCounts fake_carddav_server_get_counts(FakeCardDavServer *server) {
+	FakeCardDavRequestCounts counts;
+	ms_mutex_lock(&server->mutex);
+	counts = server->counts;
+	ms_mutex_unlock(&server->mutex);
+	return counts;
+}
+
+static LinphoneFriendList *carddav_create_fake_server_friend_list(LinphoneCoreManager *manager, FakeCardDavServer *server, LinphoneCardDAVStats *stats) {
+	LinphoneFriendList *lfl = linphone_core_create_friend_list(manager->lc);
+	LinphoneFriendListCbs *cbs = linphone_friend_list_get_callbacks(lfl);
+	char *uri = fake_carddav_server_get_uri(server);
+
+	linphone_friend_list_cbs_set_user_data(cbs, stats);
+	linphone_friend_list_cbs_set_contact_created(cbs, carddav_contact_created);
+	linphone_friend_list_cbs_set_contact_deleted(cbs, carddav_contact_deleted);
+	linphone_friend_list_cbs_set_contact_updated(cbs, carddav_contact_updated);
+	linphone_friend_list_cbs_set_sync_status_changed(cbs, carddav_sync_status_changed);
+	linphone_core_add_friend_list(manager->lc, lfl);
+	linphone_friend_list_set_uri(lfl, uri);
+	bctbx_free(uri);
+	return lfl;
+}
+
+static void carddav_incremental_sync(void) {
+	FakeCardDavServer *server = fake_carddav_server_new();
+	LinphoneCoreManager *manager;
+	LinphoneFriendList *lfl;
+	LinphoneCardDAVStats *stats;
+	FakeCardDavRequestCounts counts;
+	const char *sync_token;
+
+	if (!BC_ASSERT_PTR_NOT_NULL(server)) return;
+	manager = linphone_core_manager_new2("empty_rc", FALSE);
+	stats = (LinphoneCardDAVStats *)ms_new0(LinphoneCardDAVStats, 1);
+	fake_carddav_server_add_contacts(server, 3);
+	lfl = carddav_create_fake_server_friend_list(manager, server, stats);
+
+	/* The first synchronization fetches the whole address book and keeps its sync-token. */
+	linphone_friend_list_synchronize_friends_from_server(lfl);
+	BC_ASSERT_TRUE(wait_for_until(manager->lc, NULL, &stats->sync_done_count, 1, CARDDAV_SYNC_TIMEOUT));
+	BC_ASSERT_EQUAL(stats->new_contact_count, 3, int, "%i");
+	BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(linphone_friend_list_get_friends(lfl)), 3, unsigned int, "%u");
+	sync_token = linphone_friend_list_get_sync_token(lfl);
+	if (BC_ASSERT_PTR_NOT_NULL(sync_token))
+		BC_ASSERT_STRING_EQUAL(sync_token, "http://127.0.0.1/sync/2");
+	counts = fake_carddav_server_get_counts(server);
+	BC_ASSERT_EQUAL(counts.query, 1, int, "%i");
+	BC_ASSERT_EQUAL(counts.multiget, 1, int, "%i");
+	BC_ASSERT_EQUAL(counts.sync_collection, 0, int, "%i");
+
+	/* Then only the changed vCards are listed and downloaded. */
+	fake_carddav_server_update_contact(server, 0);
+	fake_carddav_server_delete_contact(server, 1);
+	fake_carddav_server_add_contacts(server, 1);
+	linphone_friend_list_synchronize_friends_from_server(lfl);
+	BC_ASSERT_TRUE(wait_for_until(manager->lc, NULL, &stats->sync_done_count, 2, CARDDAV_SYNC_TIMEOUT));
+	BC_ASSERT_EQUAL(stats->new_contact_count, 4, int, "%i");
+	BC_ASSERT_EQUAL(stats->updated_contact_count, 1, int, "%i");
+	BC_ASSERT_EQUAL(stats->removed_contact_count, 1, int, "%i");
+	BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(linphone_friend_list_get_friends(lfl)), 3, unsigned int, "%u");
+	counts = fake_carddav_server_get_counts(server);
+	BC_ASSERT_EQUAL(counts.query, 1, int, "%i");
+	BC_ASSERT_EQUAL(counts.multiget, 2, int, "%i");
+	BC_ASSERT_EQUAL(counts.sync_collection, 1, int, "%i");
+
+	/* Nothing changed, the sync-token is enough to know it. */
+	linphone_friend_list_synchronize_friends_from_server(lfl);
+	BC_ASSERT_TRUE(wait_for_until(manager->lc, NULL, &stats->sync_done_count, 3, CARDDAV_SYNC_TIMEOUT));
+	counts = fake_carddav_server_get_counts(server);
+	BC_ASSERT_EQUAL(counts.propfind, 3, int, "%i");
+	BC_ASSERT_EQUAL(counts.query, 1, int, "%i");
+	BC_ASSERT_EQUAL(counts.multiget, 2, int, "%i");
+	BC_ASSERT_EQUAL(counts.sync_collection, 1, int, "%i");
+
+	/* A sync-token refused by the server falls back to a full synchronization. */
+	fake_carddav_server_update_contact(server, 2);
+	fake_carddav_server_invalidate_sync_tokens(server);
+	linphone_friend_list_synchronize_friends_from_server(lfl);
+	BC_ASSERT_TRUE(wait_for_until(manager->lc, NULL, &stats->sync_done_count, 4, CARDDAV_SYNC_TIMEOUT));
+	BC_ASSERT_EQUAL(stats->new_contact_count, 4, int, "%i");
+	BC_ASSERT_EQUAL(stats->updated_contact_count, 2, int, "%i");
+	BC_ASSERT_EQUAL(stats->removed_contact_count, 1, int, "%i");
+	BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(linphone_friend_list_get_friends(lfl)), 3, unsigned int, "%u");
+	counts = fake_carddav_server_get_counts(server);
+	BC_ASSERT_EQUAL(counts.query, 2, int, "%i");
+	BC_ASSERT_EQUAL(counts.multiget, 3, int, "%i");
+	BC_ASSERT_EQUAL(counts.sync_collection, 2, int, "%i");
+
+	ms_free(stats);
+	linphone_friend_list_unref(lfl);
+	linphone_core_manager_destroy(manager);
+	fake_carddav_server_destroy(server);
+}
+
+static void carddav_incremental_sync_benchmark(void) {
+	const int contact_count = 20000;
+	const int change_count = 20;
+	FakeCardDavServer *server = fake_carddav_server_new();
+	LinphoneCoreManager *manager;
+	LinphoneFriendList *lfl;
+	LinphoneCardDAVStats *stats;
+	FakeCardDavRequestCounts counts;
+	uint64_t start;
+	int i;
+
+	if (!BC_ASSERT_PTR_NOT_NULL(server)) return;
+	manager = linphone_core_manager_new2("empty_rc", FALSE);
+	stats = (LinphoneCardDAVStats *)ms_new0(LinphoneCardDAVStats, 1);
+	fake_carddav_server_add_contacts(server, contact_count);
+	lfl = carddav_create_fake_server_friend_list(manager, server, stats);
+
+	start = ms_get_cur_time_ms();
+	linphone_friend_list_synchronize_friends_from_server(lfl);
+	BC_ASSERT_TRUE(wait_for_until(manager->lc, NULL, &stats->sync_done_count, 1, CARDDAV_BENCHMARK_TIMEOUT));
+	ms_message("[CardDAV] Full synchronization of %d contacts took %u ms", contact_count, (unsigned int)(ms_get_cur_time_ms() - start));
+	BC_ASSERT_EQUAL(stats->new_contact_count, contact_count, int, "%i");
+
+	for (i = 0; i < change_count / 2; i++) {
+		fake_carddav_server_update_contact(server, (i * 997) % contact_count);
+		fake_carddav_server_delete_contact(server, contact_count - 1 - i);
+	}
+	start = ms_get_cur_time_ms();
+	linphone_friend_list_synchronize_friends_from_server(lfl);
+	BC_ASSERT_TRUE(wait_for_until(manager->lc, NULL, &stats->sync_done_count, 2, CARDDAV_BENCHMARK_TIMEOUT));
+	ms_message("[CardDAV] Incremental synchronization of %d changes among %d contacts took %u ms",
+		change_count, contact_count, (unsigned int)(ms_get_cur_time_ms() - start));
+	BC_ASSERT_EQUAL(stats->updated_contact_count, change_count / 2, int, "%i");
+	BC_ASSERT_EQUAL(stats->removed_contact_count, change_count / 2, int, "%i");
+	BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(linphone_friend_list_get_friends(lfl)), (unsigned int)(contact_count - change_count / 2), unsigned int, "%u");
+	counts = fake_carddav_server_get_counts(server);
+	BC_ASSERT_EQUAL(counts.query, 1, int, "%i");
+	BC_ASSERT_EQUAL(counts.sync_collection, 1, int, "%i");
+
+	ms_free(stats);
+	linphone_friend_list_unref(lfl);
+	linphone_core_manager_destroy(manager);
+	fake_carddav_server_destroy(server);
+}
+
+#endif // _WIN32
+
 static void find_friend_by_ref_key_test(void) {
 	LinphoneCoreManager* manager = linphone_core_manager_new2("empty_rc", FALSE);
 	LinphoneFriendList *lfl = linphone_core_get_default_friend_list(manager->lc);
@@ -1023,10 +1777,14 @@ test_t vcard_tests[] = {
 	TEST_NO_TAG("Import a lot of friends from vCards", linphone_vcard_import_a_lot_of_friends_test),
 	TEST_NO_TAG("vCard creation for existing friends", linphone_vcard_update_existing_friends_test),
 	TEST_NO_TAG("vCard phone numbers and SIP addresses", linphone_vcard_phone_numbers_and_sip_addresses),
+	TEST_NO_TAG("vCard clone", linphone_vcard_clone_test),
 	TEST_NO_TAG("Friends working if no db set", friends_if_no_db_set),
 	TEST_NO_TAG("Friends storage in sqlite database", friends_sqlite_storage),
 	TEST_NO_TAG("20000 Friends storage in sqlite database", friends_sqlite_store_lot_of_friends),
 	TEST_NO_TAG("Find friend in database of 20000 objects", friends_sqlite_find_friend_in_lot_of_friends),
+	TEST_ONE_TAG("Lazy vCards loading benchmark", friends_sqlite_lazy_vcards_benchmark, "Benchmark"),
+	TEST_ONE_TAG("Friends bulk import benchmark", friends_sqlite_bulk_import_benchmark, "Benchmark"),
+	TEST_NO_TAG("Friends bulk add", friends_sqlite_bulk_add_friends),
 	TEST_NO_TAG("CardDAV clean", carddav_clean), // This is to ensure the content of the test addressbook is in the correct state for the following tests
 	TEST_NO_TAG("CardDAV synchronization", carddav_sync),
 	TEST_NO_TAG("CardDAV synchronization 2", carddav_sync_2),
@@ -1035,6 +1793,10 @@ test_t vcard_tests[] = {
 	TEST_NO_TAG("CardDAV integration", carddav_integration),
 	TEST_NO_TAG("CardDAV multiple synchronizations", carddav_multiple_sync),
 	TEST_NO_TAG("CardDAV client to server and server to client sync", carddav_server_to_client_and_client_to_sever_sync),
+#ifndef _WIN32
+	TEST_NO_TAG("CardDAV incremental synchronization", carddav_incremental_sync),
+	TEST_ONE_TAG("CardDAV incremental synchronization benchmark", carddav_incremental_sync_benchmark, "Benchmark"),
+#endif
 	TEST_NO_TAG("Find friend by ref key", find_friend_by_ref_key_test),
 	TEST_NO_TAG("create a map and insert 20000 objects", insert_lot_of_friends_map_test),
 	TEST_NO_TAG("Find ref key in 20000 objects map", find_friend_by_ref_key_in_lot_of_friends_test),